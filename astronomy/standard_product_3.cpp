@@ -1,9 +1,13 @@
 #include "astronomy/standard_product_3.hpp"
 
 #include <algorithm>
+#include <deque>
 #include <fstream>
+#include <future>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #include "absl/strings/numbers.h"
@@ -11,6 +15,7 @@
 #include "astronomy/time_scales.hpp"
 #include "base/map_util.hpp"
 #include "base/status_utilities.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/space.hpp"
 #include "glog/logging.h"
@@ -24,6 +29,7 @@ namespace internal {
 using namespace principia::astronomy::_time_scales;
 using namespace principia::base::_map_util;
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_space;
 using namespace principia::numerics::_finite_difference;
@@ -77,98 +83,377 @@ not_null<std::unique_ptr<DiscreteTrajectory<ITRS>>> ComputeVelocities(
   return result;
 }
 
+namespace {
+
+// The number of epochs parsed by a task of the pool.
+constexpr int epochs_per_chunk = 16;
+
+ThreadPool<std::vector<StandardProduct3::Epoch>>& ParsingThreadPool() {
+  static auto* const pool =
+      new ThreadPool<std::vector<StandardProduct3::Epoch>>(
+          std::thread::hardware_concurrency());
+  return *pool;
+}
+
+// Returns the lines of the file, as |std::getline| would, except that a final
+// carriage return is dropped from each line.  The views point into |contents|.
+std::vector<std::string_view> SplitLines(std::string const& contents) {
+  std::vector<std::string_view> lines;
+  std::string_view rest = contents;
+  while (!rest.empty()) {
+    std::size_t const end_of_line = rest.find('\n');
+    std::string_view line = rest.substr(0, end_of_line);
+    if (line.ends_with('\r')) {
+      line.remove_suffix(1);
+    }
+    lines.push_back(line);
+    rest = end_of_line == std::string_view::npos
+               ? std::string_view()
+               : rest.substr(end_of_line + 1);
+  }
+  return lines;
+}
+
+// A cursor on the lines of a file, with the utilities to parse the current
+// line.  The specification uses 1-based column indices, and column ranges with
+// bounds included.  Several cursors may be used concurrently on the same
+// lines.
+class LineCursor {
+ public:
+  LineCursor(std::filesystem::path const& filename,
+             std::vector<std::string_view> const& lines,
+             std::int64_t index);
+
+  void read_line();
+  bool has_line() const;
+  std::int64_t index() const;
+
+  char column(int index) const;
+  std::string_view columns(int first, int last) const;
+  double float_columns(int first, int last) const;
+  int integer_columns(int first, int last) const;
+
+  // A description of the current line, for error messages.  It is only built
+  // when needed, since |CHECK| only evaluates its message on failure.
+  std::string location() const;
+
+ private:
+  std::filesystem::path const& filename_;
+  std::vector<std::string_view> const& lines_;
+  std::int64_t index_;
+};
+
+LineCursor::LineCursor(std::filesystem::path const& filename,
+                       std::vector<std::string_view> const& lines,
+                       std::int64_t const index)
+    : filename_(filename), lines_(lines), index_(index) {}
+
+void LineCursor::read_line() {
+  CHECK(has_line()) << location();
+  ++index_;
+}
+
+bool LineCursor::has_line() const {
+  return index_ < lines_.size();
+}
+
+std::int64_t LineCursor::index() const {
+  return index_;
+}
+
+char LineCursor::column(int const index) const {
+  CHECK(has_line()) << location();
+  CHECK_LT(index - 1, lines_[index_].size()) << location();
+  return lines_[index_][index - 1];
+}
+
+std::string_view LineCursor::columns(int const first, int const last) const {
+  CHECK(has_line()) << location();
+  CHECK_LT(last - 1, lines_[index_].size()) << location();
+  CHECK_LE(first, last) << location();
+  return lines_[index_].substr(first - 1, last - first + 1);
+}
+
+double LineCursor::float_columns(int const first, int const last) const {
+  double result;
+  CHECK(absl::SimpleAtod(columns(first, last), &result))
+      << location() << " columns " << first << "-" << last;
+  return result;
+}
+
+int LineCursor::integer_columns(int const first, int const last) const {
+  int result;
+  CHECK(absl::SimpleAtoi(columns(first, last), &result))
+      << location() << " columns " << first << "-" << last;
+  return result;
+}
+
+std::string LineCursor::location() const {
+  if (has_line()) {
+    return absl::StrCat(
+        filename_.string(), " line ", index_ + 1, ": ", lines_[index_]);
+  } else {
+    return absl::StrCat(filename_.string(), " at end of file");
+  }
+}
+
+// Parses the epoch starting at the current line of |cursor|, and leaves
+// |cursor| on the line that follows it.
+StandardProduct3::Epoch ParseEpoch(
+    LineCursor& cursor,
+    StandardProduct3::Version const version,
+    StandardProduct3::Dialect const dialect,
+    bool const has_velocities,
+    std::vector<StandardProduct3::SatelliteIdentifier> const& satellites,
+    std::function<Instant(std::string const&)> const& parse_time) {
+  using Dialect = StandardProduct3::Dialect;
+  using SatelliteGroup = StandardProduct3::SatelliteGroup;
+  using Version = StandardProduct3::Version;
+
+  // *␣ record: the epoch header record.
+  CHECK_EQ(cursor.columns(1, 2), "* ") << cursor.location();
+  std::string epoch_string;
+  if (dialect == Dialect::ILRSB) {
+    int minutes = cursor.integer_columns(17, 18);
+    int hours = cursor.integer_columns(14, 15);
+    if (minutes == 60) {
+      minutes = 0;
+      ++hours;
+    }
+    epoch_string = absl::StrCat(
+        cursor.columns(3, 6), "-", cursor.columns(8, 9), "-",
+        cursor.columns(11, 12), "T", absl::Dec(hours, absl::kZeroPad2), ":",
+        absl::Dec(minutes, absl::kZeroPad2), ":", cursor.columns(20, 25));
+  } else {
+    // Note: the seconds field is an F11.8, spanning columns 21..31, but our
+    // time parser only supports milliseconds.
+    epoch_string = absl::StrCat(
+        cursor.columns(4, 7), "-", cursor.columns(9, 10), "-",
+        cursor.columns(12, 13), "T", cursor.columns(15, 16), ":",
+        cursor.columns(18, 19), ":", cursor.columns(21, 26));
+  }
+  for (char& c : epoch_string) {
+    if (c == ' ') {
+      c = '0';
+    }
+  }
+  StandardProduct3::Epoch epoch{.time = parse_time(epoch_string)};
+  epoch.points.reserve(satellites.size());
+  cursor.read_line();
+  for (int i = 0; i < satellites.size(); ++i) {
+    // P record: the position and clock record.
+    CHECK_EQ(cursor.column(1), 'P') << cursor.location();
+    StandardProduct3::SatelliteIdentifier id;
+    id.group = version == Version::A ? SatelliteGroup::GPS
+                                     : SatelliteGroup{cursor.column(2)};
+    id.index = cursor.integer_columns(3, 4);
+
+    // The SP3-c and SP3-d specification require that the satellite order of
+    // the P, EP, V, and EV records be the same as the order of the satellite
+    // ID records.
+    // This wording was added to the SP3-c specification by the 2006-09-27
+    // amendment, which describes it as a “clarification”, so the intent seems
+    // to be that this was required from the start for SP3-c, and perhaps for
+    // earlier versions as well.
+    // If this breaks for SP3-a or SP3-b, consider exempting these versions
+    // from the check.
+    CHECK_EQ(id, satellites[i]) << cursor.location();
+
+    Position<ITRS> const position =
+        Displacement<ITRS>({cursor.float_columns(5, 18) * Kilo(Metre),
+                            cursor.float_columns(19, 32) * Kilo(Metre),
+                            cursor.float_columns(33, 46) * Kilo(Metre)}) +
+        ITRS::origin;
+    std::optional<Velocity<ITRS>> velocity;
+
+    cursor.read_line();
+    if (version >= Version::C && cursor.has_line() &&
+        cursor.columns(1, 2) == "EP") {
+      // Ignore the optional EP record (the position and clock correlation
+      // record).
+      cursor.read_line();
+    }
+
+    if (has_velocities) {
+      // V record: the velocity and clock rate-of-change record.
+      CHECK_EQ(cursor.column(1), 'V') << cursor.location();
+      if (version > Version::A) {
+        CHECK_EQ(SatelliteGroup{cursor.column(2)}, id.group)
+            << cursor.location();
+      }
+      CHECK_EQ(cursor.integer_columns(3, 4), id.index) << cursor.location();
+      Speed const speed_unit =
+          dialect == Dialect::GRGS ? Metre / Second : Deci(Metre) / Second;
+      velocity = Velocity<ITRS>({cursor.float_columns(5, 18) * speed_unit,
+                                 cursor.float_columns(19, 32) * speed_unit,
+                                 cursor.float_columns(33, 46) * speed_unit});
+
+      cursor.read_line();
+      if (version >= Version::C && cursor.has_line() &&
+          cursor.columns(1, 2) == "EV") {
+        // Ignore the optional EV record (the velocity and clock
+        // rate-of-change correlation record).
+        cursor.read_line();
+      }
+    }
+
+    // Bad or absent positional and velocity values are to be set to 0.000000.
+    if (position == ITRS::origin || velocity == ITRS::unmoving) {
+      epoch.points.emplace_back();
+    } else {
+      epoch.points.emplace_back(StandardProduct3::OrbitPoint{
+          .time = epoch.time, .position = position, .velocity = velocity});
+    }
+  }
+  return epoch;
+}
+
+}  // namespace
+
 StandardProduct3::StandardProduct3(
     std::filesystem::path const& filename,
     StandardProduct3::Dialect const dialect) {
-  std::ifstream file(filename);
-  CHECK(file.good()) << filename;
-  std::optional<std::string> line;
-
-  std::string location;
-  int line_number = 0;
-  auto const read_line = [&file, &filename, &line, &line_number, &location]() {
-    if (!line.has_value()) {
-      line.emplace();
+  // The arcs of the satellites, in the order of |satellites_|.
+  std::vector<std::vector<not_null<std::unique_ptr<DiscreteTrajectory<ITRS>>>>>
+      orbits;
+  Read(filename,
+       dialect,
+       [&orbits](std::vector<SatelliteIdentifier> const& satellites,
+                 Epoch const& epoch) {
+         if (orbits.empty()) {
+           orbits.resize(satellites.size());
+           for (auto& orbit : orbits) {
+             orbit.push_back(make_not_null_unique<DiscreteTrajectory<ITRS>>());
+           }
+         }
+         for (int i = 0; i < satellites.size(); ++i) {
+           auto& orbit = orbits[i];
+           DiscreteTrajectory<ITRS>& arc = *orbit.back();
+           auto const& point = epoch.points[i];
+           if (point.has_value()) {
+             // If the file does not provide velocities, fill the trajectory
+             // with NaN velocities; we then replace it with another trajectory
+             // whose velocities are computed using a finite difference
+             // formula.
+             CHECK_OK(arc.Append(
+                 epoch.time,
+                 {point->position,
+                  point->velocity.value_or(Velocity<ITRS>(
+                      {NaN<Speed>, NaN<Speed>, NaN<Speed>}))}));
+           } else if (!arc.empty()) {
+             orbit.push_back(make_not_null_unique<DiscreteTrajectory<ITRS>>());
+           }
+         }
+       });
+  orbits.resize(satellites_.size());
+  for (int i = 0; i < satellites_.size(); ++i) {
+    auto& orbit = orbits[i];
+    // Do not leave a final empty trajectory if the orbit ends with missing
+    // data.
+    if (!orbit.empty() && orbit.back()->empty()) {
+      orbit.pop_back();
     }
-    std::getline(file, *line);
-    if (file.fail()) {
-      CHECK(file.eof()) << "Non-EOF failure after " << location;
-      line.reset();
-      location = absl::StrCat(filename.string(), " at end of file");
-    } else {
-      ++line_number;
-      location =
-          absl::StrCat(filename.string(), " line ", line_number, ": ", *line);
+    orbits_.emplace(satellites_[i], std::move(orbit));
+  }
+  if (!has_velocities_) {
+    for (auto& [id, orbit] : orbits_) {
+      for (auto& arc : orbit) {
+#define COMPUTE_VELOCITIES_CASE(n)            \
+          case n:                             \
+            arc = ComputeVelocities<n>(*arc); \
+            break
+
+        switch (arc->size()) {
+          COMPUTE_VELOCITIES_CASE(1);
+          COMPUTE_VELOCITIES_CASE(2);
+          COMPUTE_VELOCITIES_CASE(3);
+          COMPUTE_VELOCITIES_CASE(4);
+          COMPUTE_VELOCITIES_CASE(5);
+          COMPUTE_VELOCITIES_CASE(6);
+          COMPUTE_VELOCITIES_CASE(7);
+          COMPUTE_VELOCITIES_CASE(8);
+          default:
+            arc = ComputeVelocities<9>(*arc);
+            break;
+        }
+
+#undef COMPUTE_VELOCITIES_CASE
+      }
     }
-  };
+  }
+  for (auto const& [id, orbit] : orbits_) {
+    auto const [it, inserted] =
+        const_orbits_.emplace(std::piecewise_construct,
+                              std::forward_as_tuple(id),
+                              std::forward_as_tuple());
+    CHECK(inserted) << id;
+    auto& const_orbit = it->second;
+    for (auto const& arc : orbit) {
+      const_orbit.push_back(arc.get());
+    }
+  }
+}
 
-  // The specification uses 1-based column indices, and column ranges with
-  // bounds included.
-  auto const column = [&line, &location](int const index) {
-    CHECK(line.has_value()) << location;
-    CHECK_LT(index - 1, line->size()) << location;
-    return (*line)[index - 1];
-  };
-  auto const columns = [&line, &location](int const first, int const last) {
-    CHECK(line.has_value()) << location;
-    CHECK_LT(last - 1, line->size()) << location;
-    CHECK_LE(first, last) << location;
-    return std::string_view(&(*line)[first - 1], last - first + 1);
-  };
-  auto const float_columns = [&columns, &location](int const first,
-                                                   int const last) {
-    double result;
-    CHECK(absl::SimpleAtod(columns(first, last), &result))
-        << location << " columns " << first << "-" << last;
-    return result;
-  };
-  auto const integer_columns = [&columns, &location](int const first,
-                                                     int const last) {
-    int result;
-    CHECK(absl::SimpleAtoi(columns(first, last), &result))
-        << location << " columns " << first << "-" << last;
-    return result;
-  };
+StandardProduct3::StandardProduct3(std::filesystem::path const& filename,
+                                   Dialect const dialect,
+                                   EpochCallback const& callback) {
+  Read(filename, dialect, callback);
+}
+
+void StandardProduct3::Read(std::filesystem::path const& filename,
+                            Dialect const dialect,
+                            EpochCallback const& callback) {
+  // The file is read in one block, and parsed from views into it.
+  std::string contents;
+  {
+    std::ifstream file(filename, std::ios::binary);
+    CHECK(file.good()) << filename;
+    contents.resize(std::filesystem::file_size(filename));
+    file.read(contents.data(), contents.size());
+    CHECK(file.good()) << filename;
+  }
+  std::vector<std::string_view> const lines = SplitLines(contents);
+  LineCursor cursor(filename, lines, /*index=*/0);
 
   int number_of_epochs;
   int number_of_satellites;
 
   // Header: # record.
-  read_line();
-  CHECK_EQ(column(1), '#') << location;
-  CHECK_GE(Version{column(2)}, Version::A) << location;
-  CHECK_LE(Version{column(2)}, Version::D) << location;
-  version_ = Version{column(2)};
-  CHECK(column(3) == 'P' || column(3) == 'V') << location;
-  has_velocities_ = column(3) == 'V';
-  number_of_epochs = integer_columns(33, 39);
+  CHECK_EQ(cursor.column(1), '#') << cursor.location();
+  CHECK_GE(Version{cursor.column(2)}, Version::A) << cursor.location();
+  CHECK_LE(Version{cursor.column(2)}, Version::D) << cursor.location();
+  version_ = Version{cursor.column(2)};
+  CHECK(cursor.column(3) == 'P' || cursor.column(3) == 'V')
+      << cursor.location();
+  has_velocities_ = cursor.column(3) == 'V';
+  number_of_epochs = cursor.integer_columns(33, 39);
   if (dialect == Dialect::ILRSB) {
     --number_of_epochs;
   }
 
   // Header: ## record.
-  read_line();
-  CHECK_EQ(columns(1, 2), "##") << location;
+  cursor.read_line();
+  CHECK_EQ(cursor.columns(1, 2), "##") << cursor.location();
 
   // Header: +␣ records.
-  read_line();
-  CHECK_EQ(columns(1, 2), "+ ") << location;
-  number_of_satellites = integer_columns(4, 6);
+  cursor.read_line();
+  CHECK_EQ(cursor.columns(1, 2), "+ ") << cursor.location();
+  number_of_satellites = cursor.integer_columns(4, 6);
 
   int number_of_satellite_id_records = 0;
-  while (columns(1, 2) == "+ ") {
+  while (cursor.columns(1, 2) == "+ ") {
     ++number_of_satellite_id_records;
     for (int c = 10; c <= 58; c += 3) {
       auto const full_location =
-          absl::StrCat(location, " columns ", c, "-", c + 2);
-      if (orbits_.size() != number_of_satellites) {
+          absl::StrCat(cursor.location(), " columns ", c, "-", c + 2);
+      if (satellites_.size() != number_of_satellites) {
         SatelliteIdentifier id;
         if (version_ == Version::A) {
           // Satellite IDs are purely numeric (and implicitly GPS) in SP3-a.
-          CHECK_EQ(column(c), ' ') << full_location;
+          CHECK_EQ(cursor.column(c), ' ') << full_location;
           id.group = SatelliteGroup::GPS;
         } else {
-          id.group = SatelliteGroup{column(c)};
+          id.group = SatelliteGroup{cursor.column(c)};
           switch (id.group) {
             case SatelliteGroup::GPS:
             case SatelliteGroup::ГЛОНАСС:
@@ -187,51 +472,48 @@ StandardProduct3::StandardProduct3(
                          << full_location;
           }
         }
-        id.index = integer_columns(c + 1, c + 2);
+        id.index = cursor.integer_columns(c + 1, c + 2);
         CHECK_GT(id.index, 0) << full_location;
-        auto const [it, inserted] =
-            orbits_.emplace(std::piecewise_construct,
-                            std::forward_as_tuple(id),
-                            std::forward_as_tuple());
-        CHECK(inserted) << "Duplicate satellite identifier " << id << ": "
-                        << full_location;
-        it->second.push_back(make_not_null_unique<DiscreteTrajectory<ITRS>>());
+        CHECK(std::find(satellites_.begin(), satellites_.end(), id) ==
+              satellites_.end())
+            << "Duplicate satellite identifier " << id << ": "
+            << full_location;
         satellites_.push_back(id);
       } else {
-        CHECK_EQ(columns(c, c + 2), "  0") << full_location;
+        CHECK_EQ(cursor.columns(c, c + 2), "  0") << full_location;
       }
     }
-    read_line();
+    cursor.read_line();
   }
   if (number_of_satellite_id_records < 5) {
-    LOG(FATAL) << "at least 5 +␣ records expected: " << location;
+    LOG(FATAL) << "at least 5 +␣ records expected: " << cursor.location();
   }
   if (version_ < Version::D && number_of_satellite_id_records > 5) {
     if (dialect == Dialect::ChineseMGEX) {
       CHECK_EQ(number_of_satellite_id_records, 10)
           << "exactly 10 +␣ records expected in the " << dialect << ": "
-          << location;
+          << cursor.location();
     } else {
       CHECK_EQ(number_of_satellite_id_records, 5)
           << "exactly 5 +␣ records expected in SP3-" << version_ << ": "
-          << location;
+          << cursor.location();
     }
   }
 
   // Header: ++ records.
   // Ignore the satellite accuracy exponents.
   for (int i = 0; i < number_of_satellite_id_records; ++i) {
-    CHECK_EQ(columns(1, 2), "++") << location;
-    read_line();
+    CHECK_EQ(cursor.columns(1, 2), "++") << cursor.location();
+    cursor.read_line();
   }
 
   // Header: first %c record.
   std::function<Instant(std::string const&)> parse_time;
-  CHECK_EQ(columns(1, 2), "%c") << location;
+  CHECK_EQ(cursor.columns(1, 2), "%c") << cursor.location();
   if (version_ < Version::C) {
     parse_time = &ParseGPSTime;
   } else {
-    auto const time_system = columns(10, 12);
+    auto const time_system = cursor.columns(10, 12);
     if (time_system == "GLO" || time_system == "UTC") {
       parse_time = &ParseUTC;
     } else if (time_system == "TAI") {
@@ -244,196 +526,134 @@ StandardProduct3::StandardProduct3(
       parse_time = &ParseGPSTime;
     } else {
       LOG(FATAL) << "Unexpected time system identifier " << time_system << ": "
-                 << location;
+                 << cursor.location();
     }
   }
 
   // Header: second %c record.
-  read_line();
-  CHECK_EQ(columns(1, 2), "%c") << location;
+  cursor.read_line();
+  CHECK_EQ(cursor.columns(1, 2), "%c") << cursor.location();
 
   // Header: %f records.
-  read_line();
-  CHECK_EQ(columns(1, 2), "%f") << location;
-  read_line();
-  CHECK_EQ(columns(1, 2), "%f") << location;
+  cursor.read_line();
+  CHECK_EQ(cursor.columns(1, 2), "%f") << cursor.location();
+  cursor.read_line();
+  CHECK_EQ(cursor.columns(1, 2), "%f") << cursor.location();
 
   // Header: %i records.
-  read_line();
-  CHECK_EQ(columns(1, 2), "%i") << location;
-  read_line();
-  CHECK_EQ(columns(1, 2), "%i") << location;
+  cursor.read_line();
+  CHECK_EQ(cursor.columns(1, 2), "%i") << cursor.location();
+  cursor.read_line();
+  CHECK_EQ(cursor.columns(1, 2), "%i") << cursor.location();
 
   // Header: /* records.
-  read_line();
+  cursor.read_line();
   int number_of_comment_records = 0;
   while ((dialect == Dialect::ILRSA || dialect == Dialect::ILRSB)
-             ? columns(1, 3) == "%/*"
-             : columns(1, 2) == "/*") {
+             ? cursor.columns(1, 3) == "%/*"
+             : cursor.columns(1, 2) == "/*") {
     ++number_of_comment_records;
-    read_line();
+    cursor.read_line();
   }
   if (number_of_comment_records < 4) {
-    LOG(FATAL) << "At least 4 /* records expected: " << location;
+    LOG(FATAL) << "At least 4 /* records expected: " << cursor.location();
   }
   if (version_ < Version::D && number_of_comment_records > 5) {
     LOG(FATAL) << "Exactly 4 /* records expected in SP3-"
-               << version_ << ": " << location;
+               << version_ << ": " << cursor.location();
   }
 
-  for (int i = 0; i < number_of_epochs; ++i) {
-    // *␣ record: the epoch header record.
-    CHECK_EQ(columns(1, 2), "* ") << location;
-    std::string epoch_string;
-    if (dialect == Dialect::ILRSB) {
-      int minutes = integer_columns(17, 18);
-      int hours = integer_columns(14, 15);
-      if (minutes == 60) {
-        minutes = 0;
-        ++hours;
-      }
-      epoch_string = absl::StrCat(
-          columns(3, 6), "-", columns(8, 9), "-", columns(11, 12),
-          "T", absl::Dec(hours, absl::kZeroPad2), ":",
-          absl::Dec(minutes, absl::kZeroPad2), ":", columns(20, 25));
-    } else {
-      // Note: the seconds field is an F11.8, spanning columns 21..31, but our
-      // time parser only supports milliseconds.
-      epoch_string = absl::StrCat(
-          columns(4, 7), "-", columns(9, 10), "-", columns(12, 13),
-          "T", columns(15, 16), ":", columns(18, 19), ":", columns(21, 26));
-    }
-    for (char& c : epoch_string) {
-      if (c == ' ') {
-        c = '0';
-      }
+  // Split the body of the file at the epoch header records.  The first epoch
+  // starts right after the header, even if that line is not an epoch header
+  // record, so that it is diagnosed by |ParseEpoch|.
+  std::vector<std::int64_t> epoch_starts;
+  std::int64_t end_of_epochs = cursor.index();
+  while (end_of_epochs < lines.size() &&
+         !lines[end_of_epochs].starts_with("EOF")) {
+    if (epoch_starts.empty() || lines[end_of_epochs].starts_with("* ")) {
+      epoch_starts.push_back(end_of_epochs);
     }
-    Instant const epoch = parse_time(epoch_string);
-    read_line();
-    for (int i = 0; i < orbits_.size(); ++i) {
-      // P record: the position and clock record.
-      CHECK_EQ(column(1), 'P') << location;
-      SatelliteIdentifier id;
-      id.group = version_ == Version::A ? SatelliteGroup::GPS
-                                        : SatelliteGroup{column(2)};
-      id.index = integer_columns(3, 4);
-      auto const it = orbits_.find(id);
-      CHECK(it != orbits_.end()) << "Unknown satellite identifier "
-                                 << id << ": " << location;
-
-      // The SP3-c and SP3-d specification require that the satellite order of
-      // the P, EP, V, and EV records be the same as the order of the satellite
-      // ID records.
-      // This wording was added to the SP3-c specification by the 2006-09-27
-      // amendment, which describes it as a “clarification”, so the intent seems
-      // to be that this was required from the start for SP3-c, and perhaps for
-      // earlier versions as well.
-      // If this breaks for SP3-a or SP3-b, consider exempting these versions
-      // from the check.
-      CHECK_EQ(id, satellites_[i]) << location;
-
-      std::vector<not_null<std::unique_ptr<DiscreteTrajectory<ITRS>>>>& orbit =
-          it->second;
-      DiscreteTrajectory<ITRS>& arc = *orbit.back();
-
-      Position<ITRS> const position =
-          Displacement<ITRS>({float_columns(5, 18) * Kilo(Metre),
-                              float_columns(19, 32) * Kilo(Metre),
-                              float_columns(33, 46) * Kilo(Metre)}) +
-          ITRS::origin;
-      // If the file does not provide velocities, fill the trajectory with NaN
-      // velocities; we then replace it with another trajectory whose velocities
-      // are computed using a finite difference formula.
-      Velocity<ITRS> velocity({NaN<Speed>, NaN<Speed>, NaN<Speed>});
-
-      read_line();
-      if (version_ >= Version::C && line.has_value() && columns(1, 2) == "EP") {
-        // Ignore the optional EP record (the position and clock correlation
-        // record).
-        read_line();
-      }
-
-      if (has_velocities_) {
-        // V record: the velocity and clock rate-of-change record.
-        CHECK_EQ(column(1), 'V') << location;
-        if (version_ > Version::A) {
-          CHECK_EQ(SatelliteGroup{column(2)}, id.group) << location;
-        }
-        CHECK_EQ(integer_columns(3, 4), id.index) << location;
-        Speed const speed_unit =
-            dialect == Dialect::GRGS ? Metre / Second : Deci(Metre) / Second;
-        velocity = Velocity<ITRS>({float_columns(5, 18) * speed_unit,
-                                   float_columns(19, 32) * speed_unit,
-                                   float_columns(33, 46) * speed_unit});
-
-        read_line();
-        if (version_ >= Version::C && line.has_value() &&
-            columns(1, 2) == "EV") {
-          // Ignore the optional EV record (the velocity and clock
-          // rate-of-change correlation record).
-          read_line();
-        }
-      }
+    ++end_of_epochs;
+  }
+  std::int64_t const epochs_to_parse =
+      std::min<std::int64_t>(number_of_epochs, epoch_starts.size());
+  auto const epoch_end = [&epoch_starts, end_of_epochs](std::int64_t const i) {
+    return i + 1 < epoch_starts.size() ? epoch_starts[i + 1] : end_of_epochs;
+  };
 
-      // Bad or absent positional and velocity values are to be set to 0.000000.
-      if (position == ITRS::origin || velocity == ITRS::unmoving) {
-        if (!arc.empty()) {
-          orbit.push_back(make_not_null_unique<DiscreteTrajectory<ITRS>>());
-        }
-      } else {
-        CHECK_OK(arc.Append(epoch, {position, velocity}));
+  // Parse the epochs in chunks on the pool, keeping a bounded number of chunks
+  // in flight so that the memory used by streaming does not grow with the size
+  // of the file.
+  auto& pool = ParsingThreadPool();
+  std::deque<std::future<std::vector<Epoch>>> chunks;
+  std::int64_t next_epoch = 0;
+  auto const add_chunk = [this,
+                          dialect,
+                          epochs_to_parse,
+                          &epoch_end,
+                          &epoch_starts,
+                          &filename,
+                          &lines,
+                          &next_epoch,
+                          &parse_time,
+                          &pool,
+                          &chunks]() {
+    std::int64_t const first = next_epoch;
+    std::int64_t const last =
+        std::min(epochs_to_parse, first + epochs_per_chunk);
+    chunks.push_back(pool.Add([this,
+                               dialect,
+                               first,
+                               last,
+                               &epoch_end,
+                               &epoch_starts,
+                               &filename,
+                               &lines,
+                               &parse_time]() {
+      std::vector<Epoch> epochs;
+      epochs.reserve(last - first);
+      for (std::int64_t i = first; i < last; ++i) {
+        LineCursor cursor(filename, lines, epoch_starts[i]);
+        epochs.push_back(ParseEpoch(cursor,
+                                    version_,
+                                    dialect,
+                                    has_velocities_,
+                                    satellites_,
+                                    parse_time));
+        CHECK_EQ(cursor.index(), epoch_end(i))
+            << "Unexpected record: " << cursor.location();
       }
-    }
-  }
-  if (dialect != Dialect::ILRSA) {
-    CHECK_EQ(columns(1, 3), "EOF") << location;
-    read_line();
+      return epochs;
+    }));
+    next_epoch = last;
+  };
+  while (next_epoch < epochs_to_parse && chunks.size() < 2 * pool.size()) {
+    add_chunk();
   }
-  for (auto& [id, orbit] : orbits_) {
-    // Do not leave a final empty trajectory if the orbit ends with missing
-    // data.
-    if (orbit.back()->empty()) {
-      orbit.pop_back();
+  while (!chunks.empty()) {
+    for (Epoch const& epoch : chunks.front().get()) {
+      callback(satellites_, epoch);
+    }
+    chunks.pop_front();
+    if (next_epoch < epochs_to_parse) {
+      add_chunk();
     }
   }
-  CHECK(!line.has_value()) << location;
-  if (!has_velocities_) {
-    for (auto& [id, orbit] : orbits_) {
-      for (auto& arc : orbit) {
-#define COMPUTE_VELOCITIES_CASE(n)            \
-          case n:                             \
-            arc = ComputeVelocities<n>(*arc); \
-            break
-
-        switch (arc->size()) {
-          COMPUTE_VELOCITIES_CASE(1);
-          COMPUTE_VELOCITIES_CASE(2);
-          COMPUTE_VELOCITIES_CASE(3);
-          COMPUTE_VELOCITIES_CASE(4);
-          COMPUTE_VELOCITIES_CASE(5);
-          COMPUTE_VELOCITIES_CASE(6);
-          COMPUTE_VELOCITIES_CASE(7);
-          COMPUTE_VELOCITIES_CASE(8);
-          default:
-            arc = ComputeVelocities<9>(*arc);
-            break;
-        }
 
-#undef COMPUTE_VELOCITIES_CASE
-      }
-    }
+  // The trailer, which follows the last epoch parsed.
+  LineCursor trailer(filename,
+                     lines,
+                     epochs_to_parse < epoch_starts.size()
+                         ? epoch_starts[epochs_to_parse]
+                         : end_of_epochs);
+  if (epochs_to_parse < number_of_epochs) {
+    CHECK_EQ(trailer.columns(1, 2), "* ") << trailer.location();
   }
-  for (auto const& [id, orbit] : orbits_) {
-    auto const [it, inserted] =
-        const_orbits_.emplace(std::piecewise_construct,
-                              std::forward_as_tuple(id),
-                              std::forward_as_tuple());
-    CHECK(inserted) << id;
-    auto& const_orbit = it->second;
-    for (auto const& arc : orbit) {
-      const_orbit.push_back(arc.get());
-    }
+  if (dialect != Dialect::ILRSA) {
+    CHECK_EQ(trailer.columns(1, 3), "EOF") << trailer.location();
+    trailer.read_line();
   }
+  CHECK(!trailer.has_line()) << trailer.location();
 }
 
 std::vector<StandardProduct3::SatelliteIdentifier> const&
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <optional>
 #include <string>
@@ -105,8 +106,30 @@ class StandardProduct3 {
     std::optional<Velocity<ITRS>> velocity;
   };
 
+  // The data of the file at one epoch.  The elements of |points| correspond
+  // to those of |satellites()|; a point is absent if the data for that
+  // satellite is bad or absent at that epoch.  The velocity of a point is
+  // absent if the file does not give velocities.
+  struct Epoch {
+    Instant time;
+    std::vector<std::optional<OrbitPoint>> points;
+  };
+
+  using EpochCallback =
+      std::function<void(std::vector<SatelliteIdentifier> const& satellites,
+                         Epoch const& epoch)>;
+
+  // The epochs of the file are parsed concurrently, in chunks; they are
+  // consumed in order on the calling thread.
   StandardProduct3(std::filesystem::path const& filename, Dialect dialect);
 
+  // Streams the epochs of the file to |callback|, in chronological order and on
+  // the calling thread, without building the orbits; |orbit| must not be called
+  // on the resulting object.
+  StandardProduct3(std::filesystem::path const& filename,
+                   Dialect dialect,
+                   EpochCallback const& callback);
+
   // The satellite identifiers in the order in which they appear in the file
   // (that order is the same in the satellite ID records and within each epoch).
   std::vector<SatelliteIdentifier> const& satellites() const;
@@ -124,6 +147,11 @@ class StandardProduct3 {
   bool file_has_velocities() const;
 
  private:
+  // Parses the header of the file, and passes its epochs to |callback|.
+  void Read(std::filesystem::path const& filename,
+            Dialect dialect,
+            EpochCallback const& callback);
+
   std::vector<SatelliteIdentifier> satellites_;
   std::map<SatelliteIdentifier,
            std::vector<not_null<std::unique_ptr<DiscreteTrajectory<ITRS>>>>>
@@ -149,6 +149,55 @@ TEST_F(StandardProduct3Test, PositionAndVelocity) {
                   StandardProduct3::SatelliteGroup::General, 54}));
 }
 
+// The streamed epochs give the same points as the orbits.
+TEST_F(StandardProduct3Test, Streaming) {
+  auto const filename =
+      SOLUTION_DIR / "astronomy" / "standard_product_3" / "nga20342.eph";
+  StandardProduct3 const sp3(filename, StandardProduct3::Dialect::Standard);
+
+  int epochs = 0;
+  std::vector<std::vector<StandardProduct3::OrbitPoint>> streamed_points;
+  StandardProduct3 const streamed_sp3(
+      filename,
+      StandardProduct3::Dialect::Standard,
+      [&epochs, &streamed_points](
+          std::vector<StandardProduct3::SatelliteIdentifier> const& satellites,
+          StandardProduct3::Epoch const& epoch) {
+        EXPECT_THAT(epoch.points, SizeIs(satellites.size()));
+        streamed_points.resize(satellites.size());
+        for (int i = 0; i < epoch.points.size(); ++i) {
+          auto const& point = epoch.points[i];
+          if (point.has_value()) {
+            EXPECT_THAT(point->time, Eq(epoch.time));
+            streamed_points[i].push_back(*point);
+          }
+        }
+        ++epochs;
+      });
+
+  EXPECT_THAT(epochs, Eq(288));
+  EXPECT_THAT(streamed_sp3.version(), Eq(StandardProduct3::Version::A));
+  EXPECT_THAT(streamed_sp3.satellites(), SizeIs(sp3.satellites().size()));
+  ASSERT_THAT(streamed_points, SizeIs(sp3.satellites().size()));
+  for (int i = 0; i < sp3.satellites().size(); ++i) {
+    auto const& satellite = sp3.satellites()[i];
+    EXPECT_THAT(streamed_sp3.satellites()[i].group, Eq(satellite.group));
+    EXPECT_THAT(streamed_sp3.satellites()[i].index, Eq(satellite.index));
+    auto it = streamed_points[i].begin();
+    for (auto const arc : sp3.orbit(satellite)) {
+      for (auto const& [time, degrees_of_freedom] : *arc) {
+        ASSERT_TRUE(it != streamed_points[i].end());
+        EXPECT_THAT(it->time, Eq(time));
+        EXPECT_THAT(it->position, Eq(degrees_of_freedom.position()));
+        ASSERT_TRUE(it->velocity.has_value());
+        EXPECT_THAT(*it->velocity, Eq(degrees_of_freedom.velocity()));
+        ++it;
+      }
+    }
+    EXPECT_TRUE(it == streamed_points[i].end());
+  }
+}
+
 // Test that the nonstandard dialects are nonconformant and distinct.
 
 TEST_F(StandardProduct3DeathTest, ILRSANonConformance) {
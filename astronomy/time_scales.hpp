@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 #include "astronomy/date_time.hpp"
 #include "geometry/instant.hpp"
+#include "quantities/quantities.hpp"
 
 namespace principia {
 namespace astronomy {
@@ -86,6 +89,69 @@ constexpr DateTime TTSecond(Instant const& t);
 
 constexpr Instant DateTimeAsTT(DateTime const& tt);
 
+// Conversions between TT, represented by |Instant|, and the readings of TAI,
+// modern UTC (since 1972), and UT1, represented by the |Time| elapsed on these
+// time scales since 2000-01-01T12:00:00.  As with the |DateTime|s, the UTC
+// reading of a positive leap second is the same as that of the following
+// second; the TT to UTC conversion returns that reading during a leap second.
+// The conversions from TT to UT1 and the Earth rotation angle are only
+// supported within the EOP C04 series.
+// The converter remembers the UTC offset and the pair of EOP C04 entries that
+// it used last, so that the conversion of nearby instants, e.g., of a time
+// series in increasing order, neither searches the tables nor reinterprets
+// their entries.  The results are identical to those of the |constexpr|
+// functions and literals above.  This class is not thread-safe.
+class TimeScaleConverter {
+ public:
+  Instant TAIToTT(Time const& tai) const;
+  Time TTToTAI(Instant const& tt) const;
+
+  Instant UTCToTT(Time const& utc);
+  Time TTToUTC(Instant const& tt);
+
+  Instant UT1ToTT(Time const& ut1);
+  Time TTToUT1(Instant const& tt);
+
+  Angle EarthRotationAngle(Instant const& tt);
+
+ private:
+  // The values derived from the EOP C04 entries at |low_index| and
+  // |low_index + 1|.
+  struct EOPC04Interval {
+    std::ptrdiff_t low_index = -1;
+    Instant low_tt;
+    Instant high_tt;
+    Time low_ut1;
+    Time high_ut1;
+    Time low_ut1_minus_tai;
+    Time high_ut1_minus_tai;
+    Time low_ut1_minus_utc;
+    Time high_ut1_minus_utc;
+    int ut1_julian_day_number_minus_2451545 = 0;
+  };
+
+  // Make |eop_c04_interval_| bracket the given |tt| or |ut1|, stepping to the
+  // next interval or searching the series as needed.
+  void FindEOPC04IntervalForTT(Instant const& tt);
+  void FindEOPC04IntervalForUT1(Time const& ut1);
+  void SetEOPC04Interval(std::ptrdiff_t low_index);
+
+  // The index of the last segment of constant UTC - TAI used.
+  int modern_utc_segment_ = 0;
+  EOPC04Interval eop_c04_interval_;
+};
+
+// Batch versions of the conversions above, using a single
+// |TimeScaleConverter|.  The arguments may be in any order, but sorted
+// arguments are the fastest, as they are converted in a single sweep through
+// the tables.
+std::vector<Instant> TAIToTT(std::vector<Time> const& tai);
+std::vector<Time> TTToTAI(std::vector<Instant> const& tt);
+std::vector<Instant> UTCToTT(std::vector<Time> const& utc);
+std::vector<Time> TTToUTC(std::vector<Instant> const& tt);
+std::vector<Instant> UT1ToTT(std::vector<Time> const& ut1);
+std::vector<Time> TTToUT1(std::vector<Instant> const& tt);
+
 }  // namespace internal
 
 using internal::DateTimeAsTT;
@@ -96,8 +162,15 @@ using internal::ParseTAI;
 using internal::ParseTT;
 using internal::ParseUT1;
 using internal::ParseUTC;
+using internal::TAIToTT;
 using internal::TTDay;
 using internal::TTSecond;
+using internal::TTToTAI;
+using internal::TTToUT1;
+using internal::TTToUTC;
+using internal::TimeScaleConverter;
+using internal::UT1ToTT;
+using internal::UTCToTT;
 using internal::operator""_北斗;
 using internal::operator""_GPS;
 using internal::operator""_TAI;
@@ -2,9 +2,11 @@
 
 #include "astronomy/time_scales.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "astronomy/date_time.hpp"
 #include "astronomy/epoch.hpp"
@@ -364,39 +366,72 @@ constexpr EOPC04Entry const* LookupInEOPC04(Instant const& tt) {
   return LookupTT(tt, &eop_c04[0], eop_c04.size());
 }
 
-// Linear interpolation of TT on the UT1 range [low->ut1(), (low + 1)->ut1()].
-constexpr Instant InterpolatedEOPC04(EOPC04Entry const* low,
-                                     Time const& ut1) {
+// Linear interpolation of UT1 - TAI on the UT1 range [low_ut1, high_ut1].
+// The interpolations below are expressed in terms of the values derived from a
+// pair of entries, so that they may be shared with |TimeScaleConverter|.
+constexpr Time InterpolatedUT1MinusTAI(Time const& low_ut1,
+                                       Time const& high_ut1,
+                                       Time const& low_ut1_minus_tai,
+                                       Time const& high_ut1_minus_tai,
+                                       Time const& ut1) {
   // TODO(egg): figure out whether using the divided difference of the
   // |p->ut1_minus_tai()|s leads to less catastrophic cancellation than using
   // the divided difference of the |DateTimeAsUTC(p->utc())|s.
-  return FromTAI(ut1 -
-                 (low->ut1_minus_tai() +
-                  (ut1 - low->ut1()) *
-                      ((low + 1)->ut1_minus_tai() - low->ut1_minus_tai()) /
-                      ((low + 1)->ut1() - low->ut1())));
+  return low_ut1_minus_tai +
+         (ut1 - low_ut1) * (high_ut1_minus_tai - low_ut1_minus_tai) /
+             (high_ut1 - low_ut1);
+}
+
+// Linear interpolation of TT on the UT1 range [low->ut1(), (low + 1)->ut1()].
+constexpr Instant InterpolatedEOPC04(EOPC04Entry const* low,
+                                     Time const& ut1) {
+  return FromTAI(ut1 - InterpolatedUT1MinusTAI(low->ut1(),
+                                               (low + 1)->ut1(),
+                                               low->ut1_minus_tai(),
+                                               (low + 1)->ut1_minus_tai(),
+                                               ut1));
 }
 
 // UT1 Julian Day fraction in [-1/2 - ε, 1/2 + ε] where ε bounds |UT1-UTC|,
-// obtained by linear interpolation of EOP C04 on the TT range
-// [low->tt(), (low + 1)->tt()].
-// |jd_minus_2451545| is set to the integer such that the Julian UT1 date is
-// jd_minus_2451545 + 2451545 + result.
-constexpr double InterpolatedEOPC04JulianDayFraction(EOPC04Entry const* low,
-                                                     Instant const& tt,
-                                                     int& jd_minus_2451545) {
-  double const λ = (tt - low->tt()) / ((low + 1)->tt() - low->tt());
+// obtained by linear interpolation on the TT range [low_tt, high_tt] of a day
+// of EOP C04.
+constexpr double EOPC04JulianDayFraction(Instant const& low_tt,
+                                         Instant const& high_tt,
+                                         Time const& low_ut1_minus_utc,
+                                         Time const& high_ut1_minus_utc,
+                                         Instant const& tt) {
+  double const λ = (tt - low_tt) / (high_tt - low_tt);
+  return (λ - 0.5) + (low_ut1_minus_utc +
+                      λ * (high_ut1_minus_utc - low_ut1_minus_utc)) /
+                         (1 * Day);
+}
+
+// The integer such that the Julian UT1 date is
+// result + 2451545 + |EOPC04JulianDayFraction(...)| on the day of |low|.
+constexpr int EOPC04JulianDayNumberMinus2451545(EOPC04Entry const& low) {
   // The UTC MJD number for the day of the interpolation interval is
-  //   |low->utc().date().mjd()|.
+  //   |low.utc().date().mjd()|.
   // Up to the second-sized UT1-UTC difference, this is also the UT1 MJD number.
   // MJD = JD - 2400000.5, so that, in the middle of the interval, where the
-  // result is 0,
+  // fraction is 0,
   //   JD - 2451545.0 = (MJD number + 0.5) - 51545 + 0.5
   //                  = (MJD number) - 51545 + 1.
-  jd_minus_2451545 = low->utc().date().mjd() - 51545 + 1;
-  return (λ - 0.5) + (low->ut1_minus_utc +
-                      λ * ((low + 1)->ut1_minus_utc - low->ut1_minus_utc)) /
-                         (1 * Day);
+  return low.utc().date().mjd() - 51545 + 1;
+}
+
+// UT1 Julian Day fraction obtained by linear interpolation of EOP C04 on the TT
+// range [low->tt(), (low + 1)->tt()].
+// |jd_minus_2451545| is set to the integer such that the Julian UT1 date is
+// jd_minus_2451545 + 2451545 + result.
+constexpr double InterpolatedEOPC04JulianDayFraction(EOPC04Entry const* low,
+                                                     Instant const& tt,
+                                                     int& jd_minus_2451545) {
+  jd_minus_2451545 = EOPC04JulianDayNumberMinus2451545(*low);
+  return EOPC04JulianDayFraction(low->tt(),
+                                 (low + 1)->tt(),
+                                 low->ut1_minus_utc,
+                                 (low + 1)->ut1_minus_utc,
+                                 tt);
 }
 
 // Linear interpolation on the UT1 range given by the range of MJDs
@@ -437,13 +472,11 @@ constexpr Instant FromUT1(Time const ut1) {
   }
 }
 
-constexpr Angle EarthRotationAngle(Instant const tt) {
-  CONSTEXPR_CHECK(tt >= eop_c04.front().tt())
-      << "EarthRotationAngle is not implemented before 1962.";
-
-  int ut1_julian_day_number_minus_2451545{};
-  double const ut1_julian_day_fraction = InterpolatedEOPC04JulianDayFraction(
-      LookupInEOPC04(tt), tt, ut1_julian_day_number_minus_2451545);
+// The Earth rotation angle at the Julian UT1 date
+// |ut1_julian_day_number_minus_2451545| + 2451545 + |ut1_julian_day_fraction|.
+constexpr Angle EarthRotationAngle(
+    int const ut1_julian_day_number_minus_2451545,
+    double const ut1_julian_day_fraction) {
   double const Tu =
       ut1_julian_day_number_minus_2451545 + ut1_julian_day_fraction;
   // IERS Conventions (2010), equation (5.15).
@@ -453,6 +486,17 @@ constexpr Angle EarthRotationAngle(Instant const tt) {
           0.00273781191135448 * Tu);
 }
 
+constexpr Angle EarthRotationAngle(Instant const tt) {
+  CONSTEXPR_CHECK(tt >= eop_c04.front().tt())
+      << "EarthRotationAngle is not implemented before 1962.";
+
+  int ut1_julian_day_number_minus_2451545{};
+  double const ut1_julian_day_fraction = InterpolatedEOPC04JulianDayFraction(
+      LookupInEOPC04(tt), tt, ut1_julian_day_number_minus_2451545);
+  return EarthRotationAngle(ut1_julian_day_number_minus_2451545,
+                            ut1_julian_day_fraction);
+}
+
 // Conversions from |DateTime| and |JulianDate| to |Instant|.
 
 constexpr Instant DateTimeAsTT(DateTime const& tt) {
@@ -597,6 +641,226 @@ constexpr DateTime TTSecond(Instant const& t) {
           /*millisecond=*/0));
 }
 
+// A segment of modern UTC over which UTC - TAI is constant.  The starts are
+// readings of UTC and TAI.
+struct ModernUTCSegment final {
+  Time utc_start;
+  Time tai_start;
+  Time utc_minus_tai;
+};
+
+// The segments of modern UTC, in increasing order, computed from the table of
+// leap seconds.  The last one extends indefinitely.
+inline std::vector<ModernUTCSegment> const& ModernUTCSegments() {
+  static auto const* const segments = [] {
+    auto* const segments = new std::vector<ModernUTCSegment>;
+    auto const add_segment_starting_on = [segments](Date const& utc_date) {
+      Time const utc_start =
+          TimeSince20000101T120000Z(DateTime::BeginningOfDay(utc_date));
+      Time const utc_minus_tai = ModernUTCMinusTAI(utc_date);
+      segments->push_back({.utc_start = utc_start,
+                           .tai_start = utc_start - utc_minus_tai,
+                           .utc_minus_tai = utc_minus_tai});
+    };
+    add_segment_starting_on(Date::Calendar(1972, 1, 1));
+    for (int year = 1972; year < 1972 + leap_seconds.size() / 2; ++year) {
+      if (LeapSecond(year, 6) != 0) {
+        add_segment_starting_on(Date::Calendar(year, 7, 1));
+      }
+      if (LeapSecond(year, 12) != 0) {
+        add_segment_starting_on(Date::Calendar(year + 1, 1, 1));
+      }
+    }
+    return segments;
+  }();
+  return *segments;
+}
+
+inline Instant TimeScaleConverter::TAIToTT(Time const& tai) const {
+  return FromTAI(tai);
+}
+
+inline Time TimeScaleConverter::TTToTAI(Instant const& tt) const {
+  return (tt - J2000) - 32.184 * Second;
+}
+
+inline Instant TimeScaleConverter::UTCToTT(Time const& utc) {
+  auto const& segments = ModernUTCSegments();
+  auto const is_in_segment = [&segments, &utc](int const i) {
+    return segments[i].utc_start <= utc &&
+           (i + 1 == segments.size() || utc < segments[i + 1].utc_start);
+  };
+  if (!is_in_segment(modern_utc_segment_)) {
+    CHECK_LE(segments.front().utc_start, utc)
+        << "UTC before 1972 is not supported";
+    modern_utc_segment_ =
+        std::partition_point(segments.begin(),
+                             segments.end(),
+                             [&utc](ModernUTCSegment const& segment) {
+                               return segment.utc_start <= utc;
+                             }) -
+        segments.begin() - 1;
+  }
+  return FromTAI(utc - segments[modern_utc_segment_].utc_minus_tai);
+}
+
+inline Time TimeScaleConverter::TTToUTC(Instant const& tt) {
+  Time const tai = TTToTAI(tt);
+  auto const& segments = ModernUTCSegments();
+  // A positive leap second belongs to the segment that precedes it, since the
+  // next segment starts when it ends.
+  auto const is_in_segment = [&segments, &tai](int const i) {
+    return segments[i].tai_start <= tai &&
+           (i + 1 == segments.size() || tai < segments[i + 1].tai_start);
+  };
+  if (!is_in_segment(modern_utc_segment_)) {
+    CHECK_LE(segments.front().tai_start, tai)
+        << "UTC before 1972 is not supported";
+    modern_utc_segment_ =
+        std::partition_point(segments.begin(),
+                             segments.end(),
+                             [&tai](ModernUTCSegment const& segment) {
+                               return segment.tai_start <= tai;
+                             }) -
+        segments.begin() - 1;
+  }
+  return tai + segments[modern_utc_segment_].utc_minus_tai;
+}
+
+inline Instant TimeScaleConverter::UT1ToTT(Time const& ut1) {
+  auto const& interval = eop_c04_interval_;
+  if (interval.low_index < 0 ||
+      ut1 < interval.low_ut1 ||
+      ut1 >= interval.high_ut1) {
+    if (ut1 < eop_c04.front().ut1()) {
+      // Before EOP C04 we use the experimental series, which is rarely needed
+      // and not worth caching.
+      return FromUT1(ut1);
+    }
+    FindEOPC04IntervalForUT1(ut1);
+  }
+  return FromTAI(ut1 - InterpolatedUT1MinusTAI(interval.low_ut1,
+                                               interval.high_ut1,
+                                               interval.low_ut1_minus_tai,
+                                               interval.high_ut1_minus_tai,
+                                               ut1));
+}
+
+inline Time TimeScaleConverter::TTToUT1(Instant const& tt) {
+  FindEOPC04IntervalForTT(tt);
+  auto const& interval = eop_c04_interval_;
+  double const λ =
+      (tt - interval.low_tt) / (interval.high_tt - interval.low_tt);
+  return interval.low_ut1 + λ * (interval.high_ut1 - interval.low_ut1);
+}
+
+inline Angle TimeScaleConverter::EarthRotationAngle(Instant const& tt) {
+  FindEOPC04IntervalForTT(tt);
+  auto const& interval = eop_c04_interval_;
+  return internal::EarthRotationAngle(
+      interval.ut1_julian_day_number_minus_2451545,
+      EOPC04JulianDayFraction(interval.low_tt,
+                              interval.high_tt,
+                              interval.low_ut1_minus_utc,
+                              interval.high_ut1_minus_utc,
+                              tt));
+}
+
+inline void TimeScaleConverter::FindEOPC04IntervalForTT(Instant const& tt) {
+  auto const& interval = eop_c04_interval_;
+  if (interval.low_index >= 0 && interval.low_tt <= tt) {
+    if (tt < interval.high_tt) {
+      return;
+    }
+    // A sorted series most likely continues in the next interval.
+    if (interval.low_index + 2 < eop_c04.size()) {
+      SetEOPC04Interval(interval.low_index + 1);
+      if (tt < interval.high_tt) {
+        return;
+      }
+    }
+  }
+  CHECK_LE(eop_c04.front().tt(), tt)
+      << "EOP C04 is not available before 1962";
+  CHECK_LT(tt, eop_c04.back().tt()) << "EOP C04 is not available at " << tt;
+  SetEOPC04Interval(LookupInEOPC04(tt) - &eop_c04[0]);
+}
+
+inline void TimeScaleConverter::FindEOPC04IntervalForUT1(Time const& ut1) {
+  auto const& interval = eop_c04_interval_;
+  if (interval.low_index >= 0 && interval.low_ut1 <= ut1) {
+    if (ut1 < interval.high_ut1) {
+      return;
+    }
+    // Same as above.
+    if (interval.low_index + 2 < eop_c04.size()) {
+      SetEOPC04Interval(interval.low_index + 1);
+      if (ut1 < interval.high_ut1) {
+        return;
+      }
+    }
+  }
+  CHECK_LT(ut1, eop_c04.back().ut1()) << "EOP C04 is not available";
+  SetEOPC04Interval(LookupInEOPC04(ut1) - &eop_c04[0]);
+}
+
+inline void TimeScaleConverter::SetEOPC04Interval(
+    std::ptrdiff_t const low_index) {
+  CHECK_LE(0, low_index);
+  CHECK_LT(low_index + 1, eop_c04.size());
+  EOPC04Entry const& low = eop_c04[low_index];
+  EOPC04Entry const& high = eop_c04[low_index + 1];
+  eop_c04_interval_ = {
+      .low_index = low_index,
+      .low_tt = low.tt(),
+      .high_tt = high.tt(),
+      .low_ut1 = low.ut1(),
+      .high_ut1 = high.ut1(),
+      .low_ut1_minus_tai = low.ut1_minus_tai(),
+      .high_ut1_minus_tai = high.ut1_minus_tai(),
+      .low_ut1_minus_utc = low.ut1_minus_utc,
+      .high_ut1_minus_utc = high.ut1_minus_utc,
+      .ut1_julian_day_number_minus_2451545 =
+          EOPC04JulianDayNumberMinus2451545(low)};
+}
+
+// The batch conversions all have the same structure.
+template<typename To, typename From, typename Convert>
+std::vector<To> ConvertAll(std::vector<From> const& from,
+                           Convert const convert) {
+  TimeScaleConverter converter;
+  std::vector<To> to;
+  to.reserve(from.size());
+  for (From const& f : from) {
+    to.push_back((converter.*convert)(f));
+  }
+  return to;
+}
+
+inline std::vector<Instant> TAIToTT(std::vector<Time> const& tai) {
+  return ConvertAll<Instant>(tai, &TimeScaleConverter::TAIToTT);
+}
+
+inline std::vector<Time> TTToTAI(std::vector<Instant> const& tt) {
+  return ConvertAll<Time>(tt, &TimeScaleConverter::TTToTAI);
+}
+
+inline std::vector<Instant> UTCToTT(std::vector<Time> const& utc) {
+  return ConvertAll<Instant>(utc, &TimeScaleConverter::UTCToTT);
+}
+
+inline std::vector<Time> TTToUTC(std::vector<Instant> const& tt) {
+  return ConvertAll<Time>(tt, &TimeScaleConverter::TTToUTC);
+}
+
+inline std::vector<Instant> UT1ToTT(std::vector<Time> const& ut1) {
+  return ConvertAll<Instant>(ut1, &TimeScaleConverter::UT1ToTT);
+}
+
+inline std::vector<Time> TTToUT1(std::vector<Instant> const& tt) {
+  return ConvertAll<Time>(tt, &TimeScaleConverter::TTToUT1);
+}
+
 }  // namespace internal
 }  // namespace _time_scales
 }  // namespace astronomy
@@ -1,5 +1,7 @@
 #include "astronomy/time_scales.hpp"
 
+#include <vector>
+
 #include "geometry/instant.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -458,6 +460,74 @@ TEST_F(TimeScalesTest, EarthRotationAngle) {
               IsNear(-0.0000137_(1) * Degree / Day));
 }
 
+TEST_F(TimeScalesTest, Converter) {
+  TimeScaleConverter converter;
+
+  EXPECT_THAT(converter.TAIToTT(0 * Second), Eq(j2000_tai));
+  EXPECT_THAT(converter.TTToTAI(j2000_tai_from_tt), Eq(0 * Second));
+
+  // Around the leap second at the end of 2016.  The reading of the leap second
+  // is that of the following second.
+  Time const new_year_2017 =
+      "2017-01-01T00:00:00"_TT - "2000-01-01T12:00:00"_TT;
+  EXPECT_THAT(converter.UTCToTT(new_year_2017 - 0.5 * Second),
+              Eq("2016-12-31T23:59:59,500"_UTC));
+  EXPECT_THAT(converter.UTCToTT(new_year_2017 + 0.5 * Second),
+              Eq("2017-01-01T00:00:00,500"_UTC));
+  EXPECT_THAT(converter.TTToUTC("2016-12-31T23:59:59,500"_UTC),
+              AlmostEquals(new_year_2017 - 0.5 * Second, 0, 1));
+  EXPECT_THAT(converter.TTToUTC("2016-12-31T23:59:60,500"_UTC),
+              AlmostEquals(new_year_2017 + 0.5 * Second, 0, 1));
+  EXPECT_THAT(converter.TTToUTC("2017-01-01T00:00:00,500"_UTC),
+              AlmostEquals(new_year_2017 + 0.5 * Second, 0, 1));
+
+  // The results are the same as those of the constexpr functions, whether or
+  // not the cached entries can be reused.
+  Time const ut1 = "2010-01-04T02:57:46"_TT - "2000-01-01T12:00:00"_TT;
+  EXPECT_THAT(converter.UT1ToTT(ut1), Eq("2010-01-04T02:57:46"_UT1));
+  EXPECT_THAT(converter.UT1ToTT(ut1 + 1 * Hour), Eq("2010-01-04T03:57:46"_UT1));
+  EXPECT_THAT(converter.UT1ToTT(ut1 + 1 * Day), Eq("2010-01-05T02:57:46"_UT1));
+  EXPECT_THAT(converter.UT1ToTT(ut1 - 1 * Day), Eq("2010-01-03T02:57:46"_UT1));
+  EXPECT_THAT(converter.TTToUT1("2010-01-04T02:57:46"_UT1),
+              AlmostEquals(ut1, 0, 1));
+  for (Instant const& tt : {"2000-01-01T01:00:00"_TT,
+                            "2000-01-01T23:00:00"_TT,
+                            "2000-01-02T01:00:00"_TT,
+                            "2010-01-01T01:00:00"_TT,
+                            "1999-12-31T01:00:00"_TT}) {
+    EXPECT_THAT(converter.EarthRotationAngle(tt), Eq(EarthRotationAngle(tt)));
+  }
+}
+
+TEST_F(TimeScalesTest, BatchConversions) {
+  // Hourly instants spanning the leap second at the end of 2005.
+  std::vector<Instant> tt;
+  for (int i = 0; i < 24 * 62; ++i) {
+    tt.push_back("2005-12-01T00:00:00"_TT + i * Hour);
+  }
+
+  std::vector<Time> const tai = TTToTAI(tt);
+  std::vector<Time> const utc = TTToUTC(tt);
+  std::vector<Time> const ut1 = TTToUT1(tt);
+  std::vector<Instant> const tt_from_tai = TAIToTT(tai);
+  std::vector<Instant> const tt_from_utc = UTCToTT(utc);
+  std::vector<Instant> const tt_from_ut1 = UT1ToTT(ut1);
+  for (int i = 0; i < tt.size(); ++i) {
+    EXPECT_THAT(tt_from_tai[i], AlmostEquals(tt[i], 0, 1));
+    EXPECT_THAT(tt_from_utc[i], AlmostEquals(tt[i], 0, 1));
+    EXPECT_THAT(tt_from_ut1[i], AlmostEquals(tt[i], 0, 4));
+    // A fresh converter searches the tables.
+    EXPECT_THAT(tt_from_ut1[i], Eq(TimeScaleConverter().UT1ToTT(ut1[i])));
+  }
+  // The leap second happens between these two instants.
+  EXPECT_THAT(utc[24 * 31 + 1] - utc[24 * 31 - 1],
+              AllOf(Gt(2 * Hour - 1.001 * Second),
+                    Lt(2 * Hour - 0.999 * Second)));
+  EXPECT_THAT(tai[24 * 31 + 1] - tai[24 * 31 - 1],
+              AllOf(Gt(2 * Hour - 0.001 * Second),
+                    Lt(2 * Hour + 0.001 * Second)));
+}
+
 TEST_F(TimeScalesTest, GNSS) {
   // BeiDou Navigation Satellite System
   // Signal In Space Interface Control Document
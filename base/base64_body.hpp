@@ -2,21 +2,36 @@
 
 #include "base/base64.hpp"
 
+#include <cstring>
 #include <string>
 
 #include "absl/strings/escaping.h"
+#include "base/encoder_kernels.hpp"
 
 namespace principia {
 namespace base {
 namespace _base64 {
 namespace internal {
 
+using namespace principia::base::_encoder_kernels;
+
 constexpr std::int64_t bits_per_byte = 8;
 constexpr std::int64_t bits_per_char = 6;
 
 template<bool null_terminated>
 void Base64Encoder<null_terminated>::Encode(Array<std::uint8_t const> input,
                                             Array<char> output) {
+  // The vectorized kernels encode a prefix of the input made of groups of 3
+  // bytes, which are encoded independently of what follows them, so the rest
+  // of the input may be encoded separately.
+  if (static_cast<void*>(&output.data[EncodedLength(input)]) <= input.data ||
+      static_cast<void const*>(&input.data[input.size]) <= output.data) {
+    std::int64_t const vectorized_size =
+        EncodeBase64(BestInstructionSet(), input, output);
+    input.data += vectorized_size;
+    input.size -= vectorized_size;
+    output.data += vectorized_size / 3 * 4;
+  }
   std::string_view const input_view(reinterpret_cast<const char*>(input.data),
                                     input.size);
   std::string output_string;
@@ -53,6 +68,16 @@ std::int64_t Base64Encoder<null_terminated>::EncodedLength(
 template<bool null_terminated>
 void Base64Encoder<null_terminated>::Decode(Array<char const> input,
                                             Array<std::uint8_t> output) {
+  // Same as above, with groups of 4 characters.  The kernels stop before
+  // invalid characters, and leave it to absl to deal with them.
+  if (&input.data[input.size] <= static_cast<void*>(output.data) ||
+      static_cast<void*>(&output.data[DecodedLength(input)]) <= input.data) {
+    std::int64_t const vectorized_size =
+        DecodeBase64(BestInstructionSet(), input, output);
+    input.data += vectorized_size;
+    input.size -= vectorized_size;
+    output.data += vectorized_size / 4 * 3;
+  }
   std::string_view const input_view(input.data, input.size);
   std::string output_string;
   absl::WebSafeBase64Unescape(input_view, &output_string);
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "base/array.hpp"
+#include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
+#include "gipfeli/compression.h"
+
+namespace principia {
+namespace base {
+namespace _compression_pipeline {
+namespace internal {
+
+using namespace principia::base::_array;
+using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
+
+using ::google::compression::Compressor;
+
+// A bounded pipeline that compresses or uncompresses chunks of data on a pool
+// of threads and delivers the results in the order in which the chunks were
+// submitted.  It is made of |number_of_slots| slots, each of which owns an
+// input buffer of |input_size| bytes (possibly 0, if the client provides the
+// input data) and an output buffer of |output_size| bytes.  A slot is acquired
+// by the producer, submitted for processing, delivered to the consumer, and
+// freed when the consumer asks for the next one.  There must be exactly one
+// producer thread and one consumer thread.
+class CompressionPipeline final {
+ public:
+  enum class Direction {
+    Compress,
+    Uncompress,
+  };
+
+  // |compressor_factory| is called once for each thread, as compressors are
+  // not thread-safe.
+  CompressionPipeline(
+      Direction direction,
+      std::int64_t input_size,
+      std::int64_t output_size,
+      int number_of_slots,
+      int number_of_threads,
+      std::function<std::unique_ptr<Compressor>()> const& compressor_factory);
+
+  // Blocks until a slot is free, and returns it.
+  int Acquire();
+
+  // Returns the input buffer of |slot|.  Must only be called for a slot that is
+  // acquired but not yet submitted.
+  Array<std::uint8_t> input(int slot);
+
+  // Submits |bytes| for processing in |slot|, which must have been returned by
+  // |Acquire|.  |bytes| must remain valid until |slot| is delivered by |Next|.
+  // If |bytes| is empty, it is delivered unprocessed, which lets the client
+  // mark the end of the data.
+  void Submit(int slot, Array<std::uint8_t> bytes);
+
+  // Frees the slot previously delivered by |Next| (if any) and blocks until the
+  // first slot submitted after it has been processed.  Returns the output of
+  // that slot.
+  Array<std::uint8_t> Next();
+
+ private:
+  struct Slot {
+    UniqueArray<std::uint8_t> input_buffer;
+    UniqueArray<std::uint8_t> output_buffer;
+    Array<std::uint8_t> input;
+    Array<std::uint8_t> output;
+    bool processed = false;
+  };
+
+  void Process(int slot);
+
+  Direction const direction_;
+
+  absl::Mutex lock_;
+  std::vector<Slot> slots_ GUARDED_BY(lock_);
+  std::queue<int> free_ GUARDED_BY(lock_);
+  // The slots that have been submitted but not yet delivered, in the order of
+  // submission.
+  std::queue<int> submitted_ GUARDED_BY(lock_);
+  // The slot last returned by |Next|, still in use by the consumer.
+  std::optional<int> delivered_ GUARDED_BY(lock_);
+  std::vector<std::unique_ptr<Compressor>> idle_compressors_ GUARDED_BY(lock_);
+
+  // Must be destroyed first so that no processing is running when the slots
+  // are destroyed.
+  ThreadPool<void> pool_;
+};
+
+}  // namespace internal
+
+using internal::CompressionPipeline;
+
+}  // namespace _compression_pipeline
+}  // namespace base
+}  // namespace principia
+
+#include "base/compression_pipeline_body.hpp"
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "base/compression_pipeline.hpp"
+
+#include <utility>
+
+#include "base/sink_source.hpp"
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace _compression_pipeline {
+namespace internal {
+
+using namespace principia::base::_sink_source;
+
+inline CompressionPipeline::CompressionPipeline(
+    Direction const direction,
+    std::int64_t const input_size,
+    std::int64_t const output_size,
+    int const number_of_slots,
+    int const number_of_threads,
+    std::function<std::unique_ptr<Compressor>()> const& compressor_factory)
+    : direction_(direction),
+      pool_(number_of_threads) {
+  CHECK_LE(1, number_of_threads);
+  // One slot is being filled by the producer and one is in use by the
+  // consumer, so at least one more is needed for the pipeline to make
+  // progress.
+  CHECK_LE(3, number_of_slots);
+  absl::MutexLock l(&lock_);
+  slots_.resize(number_of_slots);
+  for (int i = 0; i < number_of_slots; ++i) {
+    slots_[i].input_buffer = UniqueArray<std::uint8_t>(input_size);
+    slots_[i].output_buffer = UniqueArray<std::uint8_t>(output_size);
+    free_.push(i);
+  }
+  for (int i = 0; i < number_of_threads; ++i) {
+    idle_compressors_.push_back(compressor_factory());
+    CHECK(idle_compressors_.back() != nullptr);
+  }
+}
+
+inline int CompressionPipeline::Acquire() {
+  absl::MutexLock l(&lock_);
+  auto const has_free_slot = [this]() { return !free_.empty(); };
+  lock_.Await(absl::Condition(&has_free_slot));
+  int const slot = free_.front();
+  free_.pop();
+  slots_[slot].processed = false;
+  return slot;
+}
+
+inline Array<std::uint8_t> CompressionPipeline::input(int const slot) {
+  absl::ReaderMutexLock l(&lock_);
+  return slots_[slot].input_buffer.get();
+}
+
+inline void CompressionPipeline::Submit(int const slot,
+                                        Array<std::uint8_t> const bytes) {
+  {
+    absl::MutexLock l(&lock_);
+    submitted_.push(slot);
+    slots_[slot].input = bytes;
+    if (bytes.size == 0) {
+      slots_[slot].output = bytes;
+      slots_[slot].processed = true;
+      return;
+    }
+  }
+  pool_.Add([this, slot]() { Process(slot); });
+}
+
+inline Array<std::uint8_t> CompressionPipeline::Next() {
+  absl::MutexLock l(&lock_);
+  if (delivered_.has_value()) {
+    free_.push(*delivered_);
+    delivered_.reset();
+  }
+  auto const next_is_processed = [this]() {
+    return !submitted_.empty() && slots_[submitted_.front()].processed;
+  };
+  lock_.Await(absl::Condition(&next_is_processed));
+  delivered_ = submitted_.front();
+  submitted_.pop();
+  return slots_[*delivered_].output;
+}
+
+inline void CompressionPipeline::Process(int const slot) {
+  std::unique_ptr<Compressor> compressor;
+  Array<std::uint8_t> input;
+  Array<std::uint8_t> output_buffer;
+  {
+    absl::MutexLock l(&lock_);
+    CHECK(!idle_compressors_.empty());
+    compressor = std::move(idle_compressors_.back());
+    idle_compressors_.pop_back();
+    input = slots_[slot].input;
+    output_buffer = slots_[slot].output_buffer.get();
+  }
+
+  // The slot is exclusively ours, so we may process it without holding the
+  // lock.
+  ArraySource<std::uint8_t> source(input);
+  ArraySink<std::uint8_t> sink(output_buffer);
+  switch (direction_) {
+    case Direction::Compress:
+      compressor->CompressStream(&source, &sink);
+      break;
+    case Direction::Uncompress:
+      CHECK(compressor->UncompressStream(&source, &sink));
+      break;
+  }
+
+  absl::MutexLock l(&lock_);
+  slots_[slot].output = sink.array();
+  slots_[slot].processed = true;
+  idle_compressors_.push_back(std::move(compressor));
+}
+
+}  // namespace internal
+}  // namespace _compression_pipeline
+}  // namespace base
+}  // namespace principia
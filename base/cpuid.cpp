@@ -1,5 +1,6 @@
 #include "base/cpuid.hpp"
 
+#include <cstring>
 #include <string>
 
 #include "base/macros.hpp"
@@ -58,6 +59,22 @@ bool HasCPUFeatures(CPUFeatureFlags const flags) {
              static_cast<std::uint64_t>(flags)) == flags;
 }
 
+CPUExtendedFeatureFlags operator|(CPUExtendedFeatureFlags const left,
+                                  CPUExtendedFeatureFlags const right) {
+  return static_cast<CPUExtendedFeatureFlags>(
+      static_cast<std::uint32_t>(left) | static_cast<std::uint32_t>(right));
+}
+
+bool HasCPUFeatures(CPUExtendedFeatureFlags const flags) {
+  // Leaf 7 only exists if leaf 0 says so.
+  if (CPUID(0, 0).eax < 7) {
+    return false;
+  }
+  auto const leaf_7 = CPUID(7, 0);
+  return static_cast<CPUExtendedFeatureFlags>(
+             leaf_7.ebx & static_cast<std::uint32_t>(flags)) == flags;
+}
+
 }  // namespace internal
 }  // namespace _cpuid
 }  // namespace base
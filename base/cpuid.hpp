@@ -26,6 +26,7 @@ enum class CPUFeatureFlags : std::uint64_t {
   SSE2 = edx_bit << 26,  // Streaming SIMD Extensions 2.
   // Table 3-10.
   SSE3 = ecx_bit << 0,     // Streaming SIMD Extensions 3.
+  SSSE3 = ecx_bit << 9,    // Supplemental Streaming SIMD Extensions 3.
   FMA = ecx_bit << 12,     // Fused Multiply Add.
   SSE4_1 = ecx_bit << 19,  // Streaming SIMD Extensions 4.1.
   AVX = ecx_bit << 28,     // Advanced Vector eXtensions.
@@ -38,8 +39,24 @@ CPUFeatureFlags operator|(CPUFeatureFlags left, CPUFeatureFlags right);
 // Whether the CPU has all features listed in |flags|.
 bool HasCPUFeatures(CPUFeatureFlags flags);
 
+// Leaf 7, subleaf 0.
+// We represent structured extended feature flags as EBX.
+enum class CPUExtendedFeatureFlags : std::uint32_t {
+  // Table 3-8.
+  AVX2 = 1 << 5,  // Advanced Vector eXtensions 2.
+};
+
+CPUExtendedFeatureFlags operator|(CPUExtendedFeatureFlags left,
+                                  CPUExtendedFeatureFlags right);
+
+// Whether the CPU has all features listed in |flags|.  Note that this does not
+// check that the operating system saves the YMM registers; callers should also
+// check for |CPUFeatureFlags::AVX|.
+bool HasCPUFeatures(CPUExtendedFeatureFlags flags);
+
 }  // namespace internal
 
+using internal::CPUExtendedFeatureFlags;
 using internal::CPUFeatureFlags;
 using internal::CPUVendorIdentificationString;
 using internal::HasCPUFeatures;
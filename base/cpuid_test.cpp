@@ -32,5 +32,16 @@ TEST_F(CPUIDTest, CPUFeatureFlags) {
                               CPUFeatureFlags::PSN));
 }
 
+TEST_F(CPUIDTest, CPUExtendedFeatureFlags) {
+  // AVX2 implies AVX (the converse is not true, e.g., on Sandy Bridge).
+  if (HasCPUFeatures(CPUExtendedFeatureFlags::AVX2)) {
+    EXPECT_TRUE(HasCPUFeatures(CPUFeatureFlags::AVX));
+  }
+  // AVX implies SSSE3.
+  if (HasCPUFeatures(CPUFeatureFlags::AVX)) {
+    EXPECT_TRUE(HasCPUFeatures(CPUFeatureFlags::SSSE3));
+  }
+}
+
 }  // namespace base
 }  // namespace principia
@@ -0,0 +1,502 @@
+#include "base/encoder_kernels.hpp"
+
+#include <immintrin.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#include "base/cpuid.hpp"
+#include "base/macros.hpp"
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace _encoder_kernels {
+namespace internal {
+
+using namespace principia::base::_cpuid;
+
+namespace {
+
+// The kernels below use unaligned loads and stores throughout: the buffers
+// come from the C# marshaller or from the serializer, and we don't control
+// their alignment.
+
+// Hexadecimal.
+
+// Returns a vector of nibbles for a vector of hexadecimal digits.  Invalid
+// digits produce 0.  The comparisons are signed, which is fine because all the
+// characters of interest are ASCII.
+PRINCIPIA_TARGET("ssse3")
+__m128i HexadecimalDigitsToNibbles(__m128i const digits) {
+  __m128i const is_decimal_digit =
+      _mm_and_si128(_mm_cmpgt_epi8(digits, _mm_set1_epi8('0' - 1)),
+                    _mm_cmplt_epi8(digits, _mm_set1_epi8('9' + 1)));
+  // Folds upper case to lower case, and doesn't turn anything else into a
+  // lower-case hexadecimal digit.
+  __m128i const lower = _mm_or_si128(digits, _mm_set1_epi8(0x20));
+  __m128i const is_letter_digit =
+      _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                    _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+  return _mm_or_si128(
+      _mm_and_si128(is_decimal_digit,
+                    _mm_sub_epi8(digits, _mm_set1_epi8('0'))),
+      _mm_and_si128(is_letter_digit,
+                    _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+}
+
+PRINCIPIA_TARGET("avx2")
+__m256i HexadecimalDigitsToNibbles(__m256i const digits) {
+  __m256i const is_decimal_digit =
+      _mm256_and_si256(_mm256_cmpgt_epi8(digits, _mm256_set1_epi8('0' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), digits));
+  __m256i const lower = _mm256_or_si256(digits, _mm256_set1_epi8(0x20));
+  __m256i const is_letter_digit =
+      _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+  return _mm256_or_si256(
+      _mm256_and_si256(is_decimal_digit,
+                       _mm256_sub_epi8(digits, _mm256_set1_epi8('0'))),
+      _mm256_and_si256(is_letter_digit,
+                       _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10))));
+}
+
+PRINCIPIA_TARGET("ssse3")
+std::int64_t EncodeHexadecimalSSSE3(Array<std::uint8_t const> const input,
+                                    Array<char> const output) {
+  __m128i const digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                       '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+  __m128i const nibble_mask = _mm_set1_epi8(0x0F);
+  std::int64_t i = 0;
+  for (; i + 16 <= input.size; i += 16) {
+    __m128i const bytes =
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(&input.data[i]));
+    __m128i const high_digits = _mm_shuffle_epi8(
+        digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble_mask));
+    __m128i const low_digits =
+        _mm_shuffle_epi8(digits, _mm_and_si128(bytes, nibble_mask));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output.data[i << 1]),
+                     _mm_unpacklo_epi8(high_digits, low_digits));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output.data[(i << 1) + 16]),
+                     _mm_unpackhi_epi8(high_digits, low_digits));
+  }
+  return i;
+}
+
+PRINCIPIA_TARGET("avx2")
+std::int64_t EncodeHexadecimalAVX2(Array<std::uint8_t const> const input,
+                                   Array<char> const output) {
+  __m256i const digits = _mm256_setr_epi8(
+      '0', '1', '2', '3', '4', '5', '6', '7',
+      '8', '9', 'A', 'B', 'C', 'D', 'E', 'F',
+      '0', '1', '2', '3', '4', '5', '6', '7',
+      '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+  __m256i const nibble_mask = _mm256_set1_epi8(0x0F);
+  std::int64_t i = 0;
+  for (; i + 32 <= input.size; i += 32) {
+    __m256i const bytes =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const*>(&input.data[i]));
+    __m256i const high_digits = _mm256_shuffle_epi8(
+        digits, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble_mask));
+    __m256i const low_digits =
+        _mm256_shuffle_epi8(digits, _mm256_and_si256(bytes, nibble_mask));
+    // The unpacking operates within each 128-bit lane: |low| has the digits of
+    // bytes 0-7 and 16-23, |high| those of bytes 8-15 and 24-31.
+    __m256i const low = _mm256_unpacklo_epi8(high_digits, low_digits);
+    __m256i const high = _mm256_unpackhi_epi8(high_digits, low_digits);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&output.data[i << 1]),
+                        _mm256_permute2x128_si256(low, high, 0x20));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(&output.data[(i << 1) + 32]),
+        _mm256_permute2x128_si256(low, high, 0x31));
+  }
+  return i;
+}
+
+PRINCIPIA_TARGET("ssse3")
+std::int64_t DecodeHexadecimalSSSE3(Array<char const> const input,
+                                    Array<std::uint8_t> const output) {
+  // Multiplies the high nibble of each pair by 16 and adds the low one.
+  __m128i const nibble_weights = _mm_set1_epi16(0x01'10);
+  std::int64_t i = 0;
+  for (; i + 32 <= input.size; i += 32) {
+    __m128i const nibbles_0 = HexadecimalDigitsToNibbles(
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(&input.data[i])));
+    __m128i const nibbles_1 = HexadecimalDigitsToNibbles(_mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(&input.data[i + 16])));
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(&output.data[i >> 1]),
+        _mm_packus_epi16(_mm_maddubs_epi16(nibbles_0, nibble_weights),
+                         _mm_maddubs_epi16(nibbles_1, nibble_weights)));
+  }
+  return i;
+}
+
+PRINCIPIA_TARGET("avx2")
+std::int64_t DecodeHexadecimalAVX2(Array<char const> const input,
+                                   Array<std::uint8_t> const output) {
+  __m256i const nibble_weights = _mm256_set1_epi16(0x01'10);
+  std::int64_t i = 0;
+  for (; i + 64 <= input.size; i += 64) {
+    __m256i const nibbles_0 = HexadecimalDigitsToNibbles(_mm256_loadu_si256(
+        reinterpret_cast<__m256i const*>(&input.data[i])));
+    __m256i const nibbles_1 = HexadecimalDigitsToNibbles(_mm256_loadu_si256(
+        reinterpret_cast<__m256i const*>(&input.data[i + 32])));
+    // The packing interleaves the 64-bit quarters of its operands; restore
+    // their order.
+    __m256i const bytes = _mm256_permute4x64_epi64(
+        _mm256_packus_epi16(_mm256_maddubs_epi16(nibbles_0, nibble_weights),
+                            _mm256_maddubs_epi16(nibbles_1, nibble_weights)),
+        0b11'01'10'00);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&output.data[i >> 1]),
+                        bytes);
+  }
+  return i;
+}
+
+// Base64.  The algorithms are those of Muła and Lemire, Faster Base64 Encoding
+// and Decoding Using AVX2 Instructions, with the alphabet of base64url.  The
+// AVX2 versions simply process two blocks at a time, one in each lane.
+
+// Spreads the 12 bytes of each lane into 16 6-bit indices, one per byte.
+PRINCIPIA_TARGET("ssse3")
+__m128i Base64Indices(__m128i const bytes) {
+  __m128i const in = _mm_shuffle_epi8(
+      bytes,
+      _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  __m128i const t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+  __m128i const t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  __m128i const t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+  __m128i const t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
+
+PRINCIPIA_TARGET("avx2")
+__m256i Base64Indices(__m256i const bytes) {
+  __m256i const in = _mm256_shuffle_epi8(
+      bytes,
+      _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                       1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  __m256i const t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00));
+  __m256i const t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+  __m256i const t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0));
+  __m256i const t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+  return _mm256_or_si256(t1, t3);
+}
+
+// Maps the indices to the alphabet by adding an offset that depends on the
+// range of the index: [0, 26[ → 'A', [26, 52[ → 'a', [52, 62[ → '0', 62 → '-',
+// 63 → '_'.
+PRINCIPIA_TARGET("ssse3")
+__m128i Base64Characters(__m128i const indices) {
+  __m128i const offsets = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0);
+  __m128i const reduced = _mm_or_si128(
+      _mm_subs_epu8(indices, _mm_set1_epi8(51)),
+      _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices),
+                    _mm_set1_epi8(13)));
+  return _mm_add_epi8(_mm_shuffle_epi8(offsets, reduced), indices);
+}
+
+PRINCIPIA_TARGET("avx2")
+__m256i Base64Characters(__m256i const indices) {
+  __m256i const offsets = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0,
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0);
+  __m256i const reduced = _mm256_or_si256(
+      _mm256_subs_epu8(indices, _mm256_set1_epi8(51)),
+      _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices),
+                       _mm256_set1_epi8(13)));
+  return _mm256_add_epi8(_mm256_shuffle_epi8(offsets, reduced), indices);
+}
+
+// Returns a mask of the characters in [first, last].
+PRINCIPIA_TARGET("ssse3")
+__m128i InRange(__m128i const characters, char const first, char const last) {
+  return _mm_and_si128(_mm_cmpgt_epi8(characters, _mm_set1_epi8(first - 1)),
+                       _mm_cmplt_epi8(characters, _mm_set1_epi8(last + 1)));
+}
+
+PRINCIPIA_TARGET("avx2")
+__m256i InRange(__m256i const characters, char const first, char const last) {
+  return _mm256_and_si256(
+      _mm256_cmpgt_epi8(characters, _mm256_set1_epi8(first - 1)),
+      _mm256_cmpgt_epi8(_mm256_set1_epi8(last + 1), characters));
+}
+
+// Maps the characters to their 6-bit values.  Sets |valid| to false if any
+// character is not in the alphabet.
+PRINCIPIA_TARGET("ssse3")
+__m128i Base64Values(__m128i const characters, bool& valid) {
+  __m128i const is_upper = InRange(characters, 'A', 'Z');
+  __m128i const is_lower = InRange(characters, 'a', 'z');
+  __m128i const is_digit = InRange(characters, '0', '9');
+  __m128i const is_minus = _mm_cmpeq_epi8(characters, _mm_set1_epi8('-'));
+  __m128i const is_underscore = _mm_cmpeq_epi8(characters, _mm_set1_epi8('_'));
+  __m128i const offsets = _mm_or_si128(
+      _mm_or_si128(_mm_and_si128(is_upper, _mm_set1_epi8(-'A')),
+                   _mm_and_si128(is_lower, _mm_set1_epi8(26 - 'a'))),
+      _mm_or_si128(
+          _mm_and_si128(is_digit, _mm_set1_epi8(52 - '0')),
+          _mm_or_si128(_mm_and_si128(is_minus, _mm_set1_epi8(62 - '-')),
+                       _mm_and_si128(is_underscore,
+                                     _mm_set1_epi8(63 - '_')))));
+  __m128i const is_valid = _mm_or_si128(
+      _mm_or_si128(is_upper, is_lower),
+      _mm_or_si128(is_digit, _mm_or_si128(is_minus, is_underscore)));
+  valid = _mm_movemask_epi8(is_valid) == 0xFFFF;
+  return _mm_add_epi8(characters, offsets);
+}
+
+PRINCIPIA_TARGET("avx2")
+__m256i Base64Values(__m256i const characters, bool& valid) {
+  __m256i const is_upper = InRange(characters, 'A', 'Z');
+  __m256i const is_lower = InRange(characters, 'a', 'z');
+  __m256i const is_digit = InRange(characters, '0', '9');
+  __m256i const is_minus =
+      _mm256_cmpeq_epi8(characters, _mm256_set1_epi8('-'));
+  __m256i const is_underscore =
+      _mm256_cmpeq_epi8(characters, _mm256_set1_epi8('_'));
+  __m256i const offsets = _mm256_or_si256(
+      _mm256_or_si256(_mm256_and_si256(is_upper, _mm256_set1_epi8(-'A')),
+                      _mm256_and_si256(is_lower, _mm256_set1_epi8(26 - 'a'))),
+      _mm256_or_si256(
+          _mm256_and_si256(is_digit, _mm256_set1_epi8(52 - '0')),
+          _mm256_or_si256(
+              _mm256_and_si256(is_minus, _mm256_set1_epi8(62 - '-')),
+              _mm256_and_si256(is_underscore, _mm256_set1_epi8(63 - '_')))));
+  __m256i const is_valid = _mm256_or_si256(
+      _mm256_or_si256(is_upper, is_lower),
+      _mm256_or_si256(is_digit, _mm256_or_si256(is_minus, is_underscore)));
+  valid = _mm256_movemask_epi8(is_valid) == -1;
+  return _mm256_add_epi8(characters, offsets);
+}
+
+// Packs the 16 6-bit values of each lane into 12 bytes, at the beginning of
+// the lane.
+PRINCIPIA_TARGET("ssse3")
+__m128i Base64Bytes(__m128i const values) {
+  __m128i const pairs =
+      _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  __m128i const quadruples = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(
+      quadruples,
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+PRINCIPIA_TARGET("avx2")
+__m256i Base64Bytes(__m256i const values) {
+  __m256i const pairs =
+      _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+  __m256i const quadruples =
+      _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+  return _mm256_shuffle_epi8(
+      quadruples,
+      _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                       2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+PRINCIPIA_TARGET("ssse3")
+std::int64_t EncodeBase64SSSE3(Array<std::uint8_t const> const input,
+                               Array<char> const output) {
+  std::int64_t i = 0;
+  std::int64_t j = 0;
+  // We load 16 bytes to use 12 of them.
+  for (; i + 16 <= input.size; i += 12, j += 16) {
+    __m128i const bytes =
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(&input.data[i]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output.data[j]),
+                     Base64Characters(Base64Indices(bytes)));
+  }
+  return i;
+}
+
+PRINCIPIA_TARGET("avx2")
+std::int64_t EncodeBase64AVX2(Array<std::uint8_t const> const input,
+                              Array<char> const output) {
+  std::int64_t i = 0;
+  std::int64_t j = 0;
+  // We load 12 bytes in each lane, reading 4 bytes past the end of the second
+  // block.
+  for (; i + 28 <= input.size; i += 24, j += 32) {
+    __m256i const bytes = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(&input.data[i]))),
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(&input.data[i + 12])),
+        1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&output.data[j]),
+                        Base64Characters(Base64Indices(bytes)));
+  }
+  return i;
+}
+
+PRINCIPIA_TARGET("ssse3")
+std::int64_t DecodeBase64SSSE3(Array<char const> const input,
+                               Array<std::uint8_t> const output) {
+  std::int64_t i = 0;
+  std::int64_t j = 0;
+  for (; i + 16 <= input.size; i += 16, j += 12) {
+    bool valid;
+    __m128i const values = Base64Values(
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(&input.data[i])),
+        valid);
+    if (!valid) {
+      break;
+    }
+    __m128i const bytes = Base64Bytes(values);
+    // Don't write past the 12 bytes that we produce, the output may be
+    // exactly sized.
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&output.data[j]), bytes);
+    std::int32_t const last_bytes = _mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+    std::memcpy(&output.data[j + 8], &last_bytes, sizeof(last_bytes));
+  }
+  return i;
+}
+
+PRINCIPIA_TARGET("avx2")
+std::int64_t DecodeBase64AVX2(Array<char const> const input,
+                              Array<std::uint8_t> const output) {
+  std::int64_t i = 0;
+  std::int64_t j = 0;
+  for (; i + 32 <= input.size; i += 32, j += 24) {
+    bool valid;
+    __m256i const values = Base64Values(
+        _mm256_loadu_si256(reinterpret_cast<__m256i const*>(&input.data[i])),
+        valid);
+    if (!valid) {
+      break;
+    }
+    // Gather the 24 useful bytes at the beginning of the register.
+    __m256i const bytes = _mm256_permutevar8x32_epi32(
+        Base64Bytes(values), _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output.data[j]),
+                     _mm256_castsi256_si128(bytes));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&output.data[j + 16]),
+                     _mm256_extracti128_si256(bytes, 1));
+  }
+  // Finish with the narrower kernel, which will stop at the invalid block, if
+  // any.
+  return i + DecodeBase64SSSE3({input.data + i, input.size - i},
+                               {output.data + j, output.size - j});
+}
+
+}  // namespace
+
+bool IsSupported(InstructionSet const instruction_set) {
+  switch (instruction_set) {
+    case InstructionSet::Scalar:
+      return true;
+    case InstructionSet::SSSE3:
+      return HasCPUFeatures(CPUFeatureFlags::SSSE3);
+    case InstructionSet::AVX2:
+      return HasCPUFeatures(CPUFeatureFlags::SSSE3 | CPUFeatureFlags::AVX) &&
+             HasCPUFeatures(CPUExtendedFeatureFlags::AVX2);
+  }
+  LOG(FATAL) << "Unexpected instruction set "
+             << static_cast<int>(instruction_set);
+  std::abort();
+}
+
+InstructionSet BestInstructionSet() {
+  static InstructionSet const best_instruction_set = []() {
+    for (auto const instruction_set :
+         {InstructionSet::AVX2, InstructionSet::SSSE3}) {
+      if (IsSupported(instruction_set)) {
+        return instruction_set;
+      }
+    }
+    return InstructionSet::Scalar;
+  }();
+  return best_instruction_set;
+}
+
+std::int64_t EncodeHexadecimal(InstructionSet const instruction_set,
+                               Array<std::uint8_t const> const input,
+                               Array<char> const output) {
+  switch (instruction_set) {
+    case InstructionSet::Scalar:
+      return 0;
+    case InstructionSet::SSSE3:
+      return EncodeHexadecimalSSSE3(input, output);
+    case InstructionSet::AVX2: {
+      // Use the narrower kernel for a possible remaining block of 16 bytes.
+      std::int64_t const consumed = EncodeHexadecimalAVX2(input, output);
+      return consumed +
+             EncodeHexadecimalSSSE3(
+                 {input.data + consumed, input.size - consumed},
+                 {output.data + (consumed << 1),
+                  output.size - (consumed << 1)});
+    }
+  }
+  LOG(FATAL) << "Unexpected instruction set "
+             << static_cast<int>(instruction_set);
+  std::abort();
+}
+
+std::int64_t DecodeHexadecimal(InstructionSet const instruction_set,
+                               Array<char const> const input,
+                               Array<std::uint8_t> const output) {
+  switch (instruction_set) {
+    case InstructionSet::Scalar:
+      return 0;
+    case InstructionSet::SSSE3:
+      return DecodeHexadecimalSSSE3(input, output);
+    case InstructionSet::AVX2: {
+      std::int64_t const consumed = DecodeHexadecimalAVX2(input, output);
+      return consumed +
+             DecodeHexadecimalSSSE3(
+                 {input.data + consumed, input.size - consumed},
+                 {output.data + (consumed >> 1),
+                  output.size - (consumed >> 1)});
+    }
+  }
+  LOG(FATAL) << "Unexpected instruction set "
+             << static_cast<int>(instruction_set);
+  std::abort();
+}
+
+std::int64_t EncodeBase64(InstructionSet const instruction_set,
+                          Array<std::uint8_t const> const input,
+                          Array<char> const output) {
+  switch (instruction_set) {
+    case InstructionSet::Scalar:
+      return 0;
+    case InstructionSet::SSSE3:
+      return EncodeBase64SSSE3(input, output);
+    case InstructionSet::AVX2: {
+      std::int64_t const consumed = EncodeBase64AVX2(input, output);
+      std::int64_t const produced = consumed / 3 * 4;
+      return consumed +
+             EncodeBase64SSSE3({input.data + consumed, input.size - consumed},
+                               {output.data + produced,
+                                output.size - produced});
+    }
+  }
+  LOG(FATAL) << "Unexpected instruction set "
+             << static_cast<int>(instruction_set);
+  std::abort();
+}
+
+std::int64_t DecodeBase64(InstructionSet const instruction_set,
+                          Array<char const> const input,
+                          Array<std::uint8_t> const output) {
+  switch (instruction_set) {
+    case InstructionSet::Scalar:
+      return 0;
+    case InstructionSet::SSSE3:
+      return DecodeBase64SSSE3(input, output);
+    case InstructionSet::AVX2:
+      return DecodeBase64AVX2(input, output);
+  }
+  LOG(FATAL) << "Unexpected instruction set "
+             << static_cast<int>(instruction_set);
+  std::abort();
+}
+
+}  // namespace internal
+}  // namespace _encoder_kernels
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+#include "base/array.hpp"
+
+namespace principia {
+namespace base {
+namespace _encoder_kernels {
+namespace internal {
+
+using namespace principia::base::_array;
+
+// Vectorized kernels for the encoders.  Each kernel processes the longest
+// prefix of its input made of whole blocks that it can handle, and returns the
+// number of elements of |input| that it consumed; the caller is responsible for
+// processing the rest of the input with its scalar code.  The input and output
+// must not overlap.  The kernels consume nothing for |InstructionSet::Scalar|.
+
+enum class InstructionSet {
+  Scalar,
+  SSSE3,
+  AVX2,
+};
+
+// Whether the processor supports |instruction_set|.
+bool IsSupported(InstructionSet instruction_set);
+
+// The best instruction set supported by the processor.  The result is computed
+// on the first call.
+InstructionSet BestInstructionSet();
+
+// Same semantics as |HexadecimalEncoder::Encode|: upper-case digits, no null
+// terminator.  The number of bytes consumed is a multiple of 16.
+std::int64_t EncodeHexadecimal(InstructionSet instruction_set,
+                               Array<std::uint8_t const> input,
+                               Array<char> output);
+
+// Same semantics as |HexadecimalEncoder::Decode|: invalid digits are read as
+// 0, case is ignored.  The number of characters consumed is a multiple of 32.
+std::int64_t DecodeHexadecimal(InstructionSet instruction_set,
+                               Array<char const> input,
+                               Array<std::uint8_t> output);
+
+// Encodes using the alphabet of RFC 4648 section 5 (base64url).  The number of
+// bytes consumed is a multiple of 12, and each 3 bytes produce 4 characters.
+std::int64_t EncodeBase64(InstructionSet instruction_set,
+                          Array<std::uint8_t const> input,
+                          Array<char> output);
+
+// Decodes using the alphabet of RFC 4648 section 5 (base64url).  The number of
+// characters consumed is a multiple of 16, and each 4 characters produce 3
+// bytes.  Stops before the first block that contains a character outside of
+// the alphabet (e.g., padding), so that the caller may report the error.
+std::int64_t DecodeBase64(InstructionSet instruction_set,
+                          Array<char const> input,
+                          Array<std::uint8_t> output);
+
+}  // namespace internal
+
+using internal::BestInstructionSet;
+using internal::DecodeBase64;
+using internal::DecodeHexadecimal;
+using internal::EncodeBase64;
+using internal::EncodeHexadecimal;
+using internal::InstructionSet;
+using internal::IsSupported;
+
+}  // namespace _encoder_kernels
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,173 @@
+#include "base/encoder_kernels.hpp"
+
+#include <cctype>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace principia {
+namespace base {
+
+using ::testing::Eq;
+using namespace principia::base::_array;
+using namespace principia::base::_encoder_kernels;
+
+class EncoderKernelsTest : public ::testing::Test {
+ protected:
+  EncoderKernelsTest() {
+    std::mt19937_64 random(42);
+    bytes_.resize(1000);
+    for (auto& byte : bytes_) {
+      byte = random();
+    }
+  }
+
+  // Straightforward implementations used as references.
+  static std::string HexadecimalReference(
+      std::vector<std::uint8_t> const& bytes,
+      std::int64_t const size) {
+    constexpr char digits[] = "0123456789ABCDEF";
+    std::string result;
+    for (std::int64_t i = 0; i < size; ++i) {
+      result.push_back(digits[bytes[i] >> 4]);
+      result.push_back(digits[bytes[i] & 0xF]);
+    }
+    return result;
+  }
+
+  static std::string Base64Reference(std::vector<std::uint8_t> const& bytes,
+                                     std::int64_t const size) {
+    constexpr char alphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::string result;
+    for (std::int64_t i = 0; i + 3 <= size; i += 3) {
+      std::uint32_t const group =
+          bytes[i] << 16 | bytes[i + 1] << 8 | bytes[i + 2];
+      for (int shift = 18; shift >= 0; shift -= 6) {
+        result.push_back(alphabet[(group >> shift) & 0x3F]);
+      }
+    }
+    return result;
+  }
+
+  static std::vector<InstructionSet> SupportedInstructionSets() {
+    std::vector<InstructionSet> result;
+    for (auto const instruction_set :
+         {InstructionSet::SSSE3, InstructionSet::AVX2}) {
+      if (IsSupported(instruction_set)) {
+        result.push_back(instruction_set);
+      }
+    }
+    return result;
+  }
+
+  std::vector<std::uint8_t> bytes_;
+};
+
+TEST_F(EncoderKernelsTest, Scalar) {
+  std::string characters(2 * bytes_.size(), '\0');
+  EXPECT_EQ(0,
+            EncodeHexadecimal(InstructionSet::Scalar,
+                              {bytes_.data(), bytes_.size()},
+                              {characters.data(), characters.size()}));
+  EXPECT_EQ(0,
+            EncodeBase64(InstructionSet::Scalar,
+                         {bytes_.data(), bytes_.size()},
+                         {characters.data(), characters.size()}));
+}
+
+TEST_F(EncoderKernelsTest, Hexadecimal) {
+  for (auto const instruction_set : SupportedInstructionSets()) {
+    for (std::int64_t const size : {0, 15, 16, 31, 32, 48, 63, 64, 1000}) {
+      std::string characters(2 * size, '?');
+      std::int64_t const encoded = EncodeHexadecimal(
+          instruction_set,
+          {bytes_.data(), size},
+          {characters.data(), characters.size()});
+      EXPECT_EQ(size / 16 * 16, encoded) << size;
+      characters.resize(2 * encoded);
+      EXPECT_THAT(characters, Eq(HexadecimalReference(bytes_, encoded)));
+
+      // Lower case must decode identically.
+      for (std::int64_t i = 0; i < characters.size(); i += 3) {
+        characters[i] = std::tolower(characters[i]);
+      }
+      std::vector<std::uint8_t> bytes(encoded);
+      std::int64_t const decoded = DecodeHexadecimal(
+          instruction_set,
+          {characters.data(), characters.size()},
+          {bytes.data(), bytes.size()});
+      EXPECT_EQ(characters.size() / 32 * 32, decoded) << size;
+      bytes.resize(decoded / 2);
+      EXPECT_THAT(bytes,
+                  Eq(std::vector<std::uint8_t>(bytes_.begin(),
+                                               bytes_.begin() + decoded / 2)));
+    }
+  }
+}
+
+TEST_F(EncoderKernelsTest, HexadecimalInvalid) {
+  for (auto const instruction_set : SupportedInstructionSets()) {
+    std::string const characters = "0g1G2:3@4`5/6\xFF" "7z89AbCdEfFF  zz!!";
+    std::vector<std::uint8_t> bytes(16);
+    EXPECT_EQ(32,
+              DecodeHexadecimal(instruction_set,
+                                {characters.data(), characters.size()},
+                                {bytes.data(), bytes.size()}));
+    EXPECT_THAT(bytes,
+                Eq(std::vector<std::uint8_t>{0x00, 0x10, 0x20, 0x30,
+                                             0x40, 0x50, 0x60, 0x70,
+                                             0x89, 0xAB, 0xCD, 0xEF,
+                                             0xFF, 0x00, 0x00, 0x00}));
+  }
+}
+
+TEST_F(EncoderKernelsTest, Base64) {
+  for (auto const instruction_set : SupportedInstructionSets()) {
+    for (std::int64_t const size : {0, 15, 16, 27, 28, 40, 999, 1000}) {
+      std::string characters(2 * size, '?');
+      std::int64_t const encoded = EncodeBase64(
+          instruction_set,
+          {bytes_.data(), size},
+          {characters.data(), characters.size()});
+      EXPECT_EQ(0, encoded % 12) << size;
+      EXPECT_LT(size - encoded, 28) << size;
+      characters.resize(encoded / 3 * 4);
+      EXPECT_THAT(characters, Eq(Base64Reference(bytes_, encoded)));
+
+      std::vector<std::uint8_t> bytes(encoded);
+      std::int64_t const decoded = DecodeBase64(
+          instruction_set,
+          {characters.data(), characters.size()},
+          {bytes.data(), bytes.size()});
+      EXPECT_EQ(characters.size() / 16 * 16, decoded) << size;
+      bytes.resize(decoded / 4 * 3);
+      EXPECT_THAT(
+          bytes,
+          Eq(std::vector<std::uint8_t>(bytes_.begin(),
+                                       bytes_.begin() + decoded / 4 * 3)));
+    }
+  }
+}
+
+TEST_F(EncoderKernelsTest, Base64Invalid) {
+  for (auto const instruction_set : SupportedInstructionSets()) {
+    std::string characters = Base64Reference(bytes_, 96);
+    ASSERT_EQ(128, characters.size());
+    characters[70] = '=';
+    std::vector<std::uint8_t> bytes(96);
+    // Decoding stops at the beginning of the block of 16 characters that
+    // contains the invalid character.
+    EXPECT_EQ(64,
+              DecodeBase64(instruction_set,
+                           {characters.data(), characters.size()},
+                           {bytes.data(), bytes.size()}));
+  }
+}
+
+}  // namespace base
+}  // namespace principia
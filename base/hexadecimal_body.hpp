@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <cstring>
 
+#include "base/encoder_kernels.hpp"
 #include "glog/logging.h"
 
 namespace principia {
@@ -12,6 +13,8 @@ namespace base {
 namespace _hexadecimal {
 namespace internal {
 
+using namespace principia::base::_encoder_kernels;
+
 constexpr char byte_to_hexadecimal_digits[] =
     "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F2021222324"
     "25262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F40414243444546474849"
@@ -54,13 +57,21 @@ void HexadecimalEncoder<null_terminated>::Encode(
         static_cast<void*>(&output.data[input.size << 1]) <= input.data)
       << "bad overlap";
   CHECK_GE(output.size, EncodedLength(input)) << "output too small";
+  // The vectorized kernels iterate forward, so they may only be used if there
+  // is no overlap.  They encode a prefix of the input.
+  std::int64_t vectorized_size = 0;
+  if (static_cast<void*>(&output.data[input.size << 1]) <= input.data ||
+      static_cast<void const*>(&input.data[input.size]) <= output.data) {
+    vectorized_size = EncodeHexadecimal(BestInstructionSet(), input, output);
+  }
   // We want the result to start at |output.data[0]|.
   output.data += ((input.size - 1) << 1);
   if constexpr (null_terminated) {
     output.data[2] = 0;
   }
   input.data += input.size - 1;
-  for (std::uint8_t const* const input_rend = input.data - input.size;
+  for (std::uint8_t const* const input_rend =
+           input.data - (input.size - vectorized_size);
        input.data != input_rend;
        --input.data, output.data -= 2) {
     std::memcpy(output.data, &byte_to_hexadecimal_digits[*input.data << 1], 2);
@@ -102,6 +113,17 @@ void HexadecimalEncoder<null_terminated>::Decode(Array<char const> input,
         &input.data[input.size] <= static_cast<void*>(output.data))
       << "bad overlap";
   CHECK_GE(output.size, input.size / 2) << "output too small";
+  // The vectorized kernels read 32 or 64 characters before writing, so they
+  // may only be used if there is no overlap.  They decode a prefix of the
+  // input.
+  if (&input.data[input.size] <= static_cast<void*>(output.data) ||
+      static_cast<void*>(&output.data[input.size >> 1]) <= input.data) {
+    std::int64_t const vectorized_size =
+        DecodeHexadecimal(BestInstructionSet(), input, output);
+    input.data += vectorized_size;
+    input.size -= vectorized_size;
+    output.data += vectorized_size >> 1;
+  }
   for (char const* const input_end = input.data + input.size;
        input.data != input_end;
        input.data += 2, ++output.data) {
@@ -124,6 +124,21 @@ inline void noreturn() { std::exit(0); }
 #  error "What compiler is this?"
 #endif
 
+// Used to compile a function for an instruction set that the rest of the
+// translation unit may not assume, e.g., |PRINCIPIA_TARGET("avx2")|.  The
+// function must only be called after checking with CPUID that the instruction
+// set is available.  MSVC lets us use any intrinsic anywhere.
+#if PRINCIPIA_COMPILER_CLANG    ||  \
+    PRINCIPIA_COMPILER_CLANG_CL ||  \
+    PRINCIPIA_COMPILER_GCC
+#  define PRINCIPIA_TARGET(instruction_set) \
+       __attribute__((target(instruction_set)))
+#elif PRINCIPIA_COMPILER_MSVC || PRINCIPIA_COMPILER_ICC
+#  define PRINCIPIA_TARGET(instruction_set)
+#else
+#  error "What compiler is this?"
+#endif
+
 // We assume that the processor is at least a Prescott since we only support
 // 64-bit architectures.
 #define PRINCIPIA_USE_SSE3_INTRINSICS !_DEBUG
@@ -0,0 +1,135 @@
+#include "base/mapped_file.hpp"
+
+#include <filesystem>
+#include <utility>
+
+#if OS_WIN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace _mapped_file {
+namespace internal {
+
+MappedFile::MappedFile(std::filesystem::path const& path) {
+#if OS_WIN
+  file_ = CreateFileW(path.c_str(),
+                      GENERIC_READ,
+                      FILE_SHARE_READ,
+                      /*lpSecurityAttributes=*/nullptr,
+                      OPEN_EXISTING,
+                      FILE_ATTRIBUTE_NORMAL,
+                      /*hTemplateFile=*/nullptr);
+  CHECK(file_ != INVALID_HANDLE_VALUE) << path << " " << GetLastError();
+  LARGE_INTEGER file_size;
+  CHECK(GetFileSizeEx(file_, &file_size)) << path << " " << GetLastError();
+  size_ = file_size.QuadPart;
+  // It is not possible to map an empty file.
+  if (size_ > 0) {
+    mapping_ = CreateFileMappingW(file_,
+                                  /*lpFileMappingAttributes=*/nullptr,
+                                  PAGE_READONLY,
+                                  /*dwMaximumSizeHigh=*/0,
+                                  /*dwMaximumSizeLow=*/0,
+                                  /*lpName=*/nullptr);
+    CHECK(mapping_ != nullptr) << path << " " << GetLastError();
+    data_ = static_cast<std::uint8_t const*>(
+        MapViewOfFile(mapping_,
+                      FILE_MAP_READ,
+                      /*dwFileOffsetHigh=*/0,
+                      /*dwFileOffsetLow=*/0,
+                      /*dwNumberOfBytesToMap=*/0));
+    CHECK(data_ != nullptr) << path << " " << GetLastError();
+  }
+#else
+  file_descriptor_ = open(path.c_str(), O_RDONLY);
+  PCHECK(file_descriptor_ >= 0) << path;
+  struct stat file_status;
+  PCHECK(fstat(file_descriptor_, &file_status) == 0) << path;
+  size_ = file_status.st_size;
+  // It is not possible to map an empty file.
+  if (size_ > 0) {
+    void* const data = mmap(/*addr=*/nullptr,
+                            size_,
+                            PROT_READ,
+                            MAP_PRIVATE,
+                            file_descriptor_,
+                            /*offset=*/0);
+    PCHECK(data != MAP_FAILED) << path;
+    data_ = static_cast<std::uint8_t const*>(data);
+  }
+#endif
+}
+
+MappedFile::~MappedFile() {
+  Unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other)
+#if OS_WIN
+    : file_(std::exchange(other.file_, nullptr)),
+      mapping_(std::exchange(other.mapping_, nullptr)),
+#else
+    : file_descriptor_(std::exchange(other.file_descriptor_, -1)),
+#endif
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) {
+  if (this != &other) {
+    Unmap();
+#if OS_WIN
+    file_ = std::exchange(other.file_, nullptr);
+    mapping_ = std::exchange(other.mapping_, nullptr);
+#else
+    file_descriptor_ = std::exchange(other.file_descriptor_, -1);
+#endif
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+Array<std::uint8_t const> MappedFile::bytes() const {
+  return Array<std::uint8_t const>(data_, size_);
+}
+
+void MappedFile::Unmap() {
+#if OS_WIN
+  if (data_ != nullptr) {
+    CHECK(UnmapViewOfFile(data_));
+  }
+  if (mapping_ != nullptr) {
+    CHECK(CloseHandle(mapping_));
+  }
+  if (file_ != nullptr) {
+    CHECK(CloseHandle(file_));
+  }
+  file_ = nullptr;
+  mapping_ = nullptr;
+#else
+  if (data_ != nullptr) {
+    PCHECK(munmap(const_cast<std::uint8_t*>(data_), size_) == 0);
+  }
+  if (file_descriptor_ >= 0) {
+    PCHECK(close(file_descriptor_) == 0);
+  }
+  file_descriptor_ = -1;
+#endif
+  data_ = nullptr;
+  size_ = 0;
+}
+
+}  // namespace internal
+}  // namespace _mapped_file
+}  // namespace base
+}  // namespace principia
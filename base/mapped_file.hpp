@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+#include "base/array.hpp"
+#include "base/macros.hpp"
+
+namespace principia {
+namespace base {
+namespace _mapped_file {
+namespace internal {
+
+using namespace principia::base::_array;
+
+// A RAII wrapper for a read-only memory mapping of an entire file.  The file
+// must not be modified while it is mapped.  The mapping is established at
+// construction and released at destruction; the data returned by |bytes| is
+// only valid during the lifetime of this object.
+class MappedFile final {
+ public:
+  explicit MappedFile(std::filesystem::path const& path);
+  ~MappedFile();
+
+  MappedFile(MappedFile&& other);
+  MappedFile& operator=(MappedFile&& other);
+  MappedFile(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+
+  // No transfer of ownership.
+  Array<std::uint8_t const> bytes() const;
+
+ private:
+  void Unmap();
+
+#if OS_WIN
+  // These are HANDLEs, but we don't want to include <windows.h> here.
+  void* file_ = nullptr;
+  void* mapping_ = nullptr;
+#else
+  int file_descriptor_ = -1;
+#endif
+
+  std::uint8_t const* data_ = nullptr;
+  std::int64_t size_ = 0;
+};
+
+}  // namespace internal
+
+using internal::MappedFile;
+
+}  // namespace _mapped_file
+}  // namespace base
+}  // namespace principia
@@ -9,6 +9,7 @@
 #include "absl/base/thread_annotations.h"
 #include "absl/synchronization/mutex.h"
 #include "base/array.hpp"
+#include "base/compression_pipeline.hpp"
 #include "base/macros.hpp"
 #include "base/not_null.hpp"
 #include "gipfeli/compression.h"
@@ -21,6 +22,7 @@ namespace _pull_serializer {
 namespace internal {
 
 using namespace principia::base::_array;
+using namespace principia::base::_compression_pipeline;
 using namespace principia::base::_not_null;
 
 using ::google::compression::Compressor;
@@ -72,6 +74,20 @@ class PullSerializer final {
   PullSerializer(int chunk_size,
                  int number_of_chunks,
                  std::unique_ptr<Compressor> compressor);
+
+  // Same as above, but the chunks are compressed in parallel with the
+  // serialization by |number_of_compression_threads| threads, each of which
+  // uses a compressor returned by |compressor_factory|.  |Pull| returns the
+  // compressed chunks in order, so the output is the same as that of a
+  // serializer using a single compressor.  This class uses at most
+  // |number_of_chunks * (chunk_size + compressed_chunk_size + O(1)) + O(1)|
+  // bytes.
+  PullSerializer(
+      int chunk_size,
+      int number_of_chunks,
+      int number_of_compression_threads,
+      std::function<std::unique_ptr<Compressor>()> const& compressor_factory);
+
   ~PullSerializer();
 
   // Starts the serializer, which will proceed to serialize |message|.  This
@@ -120,6 +136,13 @@ class PullSerializer final {
   // compression.
   int const number_of_compression_chunks_;
 
+  // Only used for parallel compression, in which case the chunks are owned by
+  // the pipeline and |data_|, |queue_| and |free_| are unused.
+  // |filling_slot_| is the slot of the pipeline currently being filled by the
+  // stream.
+  std::unique_ptr<CompressionPipeline> const pipeline_;
+  int filling_slot_ = -1;
+
   // The array supporting the stream and the stream itself.
   std::unique_ptr<std::uint8_t[]> data_;
   DelegatingArrayOutputStream stream_;
@@ -93,6 +93,27 @@ inline PullSerializer::PullSerializer(int const chunk_size,
       data_.get() + (number_of_chunks_ - 1) * compressed_chunk_size_, 0));
 }
 
+inline PullSerializer::PullSerializer(
+    int const chunk_size,
+    int const number_of_chunks,
+    int const number_of_compression_threads,
+    std::function<std::unique_ptr<Compressor>()> const& compressor_factory)
+    : chunk_size_(chunk_size),
+      compressed_chunk_size_(
+          compressor_factory()->MaxCompressedLength(chunk_size_)),
+      number_of_chunks_(number_of_chunks),
+      number_of_compression_chunks_(0),
+      pipeline_(std::make_unique<CompressionPipeline>(
+          CompressionPipeline::Direction::Compress,
+          /*input_size=*/chunk_size_,
+          /*output_size=*/compressed_chunk_size_,
+          /*number_of_slots=*/number_of_chunks_,
+          number_of_compression_threads,
+          compressor_factory)),
+      filling_slot_(pipeline_->Acquire()),
+      stream_(pipeline_->input(filling_slot_),
+              std::bind(&PullSerializer::Push, this, _1)) {}
+
 inline PullSerializer::~PullSerializer() {
   if (thread_ != nullptr) {
     thread_->join();
@@ -113,6 +134,12 @@ inline void PullSerializer::Start(
     CHECK(message_->SerializeToZeroCopyStream(&stream_));
     // Put a sentinel at the end of the serialized stream so that the client
     // knows that this is the end.
+    if (pipeline_ != nullptr) {
+      pipeline_->Submit(
+          filling_slot_,
+          Array<std::uint8_t>(pipeline_->input(filling_slot_).data, 0));
+      return;
+    }
     Array<std::uint8_t> bytes;
     {
       absl::MutexLock l(&lock_);
@@ -124,6 +151,9 @@ inline void PullSerializer::Start(
 }
 
 inline Array<std::uint8_t> PullSerializer::Pull() {
+  if (pipeline_ != nullptr) {
+    return pipeline_->Next();
+  }
   Array<std::uint8_t> result;
   {
     absl::MutexLock l(&lock_);
@@ -145,6 +175,14 @@ inline Array<std::uint8_t> PullSerializer::Pull() {
 inline Array<std::uint8_t> PullSerializer::Push(Array<std::uint8_t> bytes) {
   Array<std::uint8_t> result;
   CHECK_GE(chunk_size_, bytes.size);
+  if (pipeline_ != nullptr) {
+    // Hand the chunk over to the compression threads and start filling the
+    // next one.  This blocks if all the chunks are in use.
+    CHECK_EQ(pipeline_->input(filling_slot_).data, bytes.data);
+    pipeline_->Submit(filling_slot_, bytes);
+    filling_slot_ = pipeline_->Acquire();
+    return pipeline_->input(filling_slot_);
+  }
   if (bytes.size > 0 && compressor_ != nullptr) {
     Array<std::uint8_t> compressed_bytes;
     {
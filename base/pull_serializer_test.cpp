@@ -169,6 +169,37 @@ TEST_F(PullSerializerTest, SerializationGipfeli) {
   EXPECT_EQ(uncompressed1, uncompressed2);
 }
 
+TEST_F(PullSerializerTest, SerializationParallelGipfeli) {
+  // The parallel compression must produce exactly the same chunks as the
+  // sequential one.
+  std::vector<std::string> sequential_chunks;
+  std::vector<std::string> parallel_chunks;
+  for (auto* const chunks : {&sequential_chunks, &parallel_chunks}) {
+    auto const compressed_pull_serializer =
+        chunks == &sequential_chunks
+            ? std::make_unique<PullSerializer>(
+                  chunk_size,
+                  /*number_of_chunks=*/4,
+                  google::compression::NewGipfeliCompressor())
+            : std::make_unique<PullSerializer>(
+                  chunk_size,
+                  /*number_of_chunks=*/4,
+                  /*number_of_compression_threads=*/3,
+                  &google::compression::NewGipfeliCompressor);
+    compressed_pull_serializer->Start(BuildTrajectory());
+    for (;;) {
+      Array<std::uint8_t> const bytes = compressed_pull_serializer->Pull();
+      if (bytes.size == 0) {
+        break;
+      }
+      chunks->emplace_back(reinterpret_cast<char const*>(bytes.data),
+                           static_cast<std::size_t>(bytes.size));
+    }
+  }
+  EXPECT_EQ(54, parallel_chunks.size());
+  EXPECT_EQ(sequential_chunks, parallel_chunks);
+}
+
 TEST_F(PullSerializerTest, SerializationThreading) {
   DiscreteTrajectory read_trajectory;
   auto const trajectory = BuildTrajectory();
@@ -10,6 +10,7 @@
 #include "absl/base/thread_annotations.h"
 #include "absl/synchronization/mutex.h"
 #include "base/array.hpp"
+#include "base/compression_pipeline.hpp"
 #include "base/macros.hpp"
 #include "base/not_null.hpp"
 #include "gipfeli/compression.h"
@@ -22,6 +23,7 @@ namespace _push_deserializer {
 namespace internal {
 
 using namespace principia::base::_array;
+using namespace principia::base::_compression_pipeline;
 using namespace principia::base::_not_null;
 
 using ::google::compression::Compressor;
@@ -74,6 +76,20 @@ class PushDeserializer final {
   PushDeserializer(int chunk_size,
                    int number_of_chunks,
                    std::unique_ptr<Compressor> compressor);
+
+  // Same as above, but the chunks are uncompressed in parallel with the
+  // deserialization by |number_of_decompression_threads| threads, each of
+  // which uses a compressor returned by |compressor_factory|.  |Push| only
+  // blocks when |number_of_chunks| chunks are being uncompressed or waiting to
+  // be deserialized.  This class uses at most
+  // |number_of_chunks * (chunk_size + O(1)) + O(1)| bytes, in addition to the
+  // chunks owned by the client until their |done| callback is called.
+  PushDeserializer(
+      int chunk_size,
+      int number_of_chunks,
+      int number_of_decompression_threads,
+      std::function<std::unique_ptr<Compressor>()> const& compressor_factory);
+
   ~PushDeserializer();
 
   // Starts the deserializer, which will proceed to deserialize data into
@@ -125,6 +141,9 @@ class PushDeserializer final {
 
   UniqueArray<std::uint8_t> uncompressed_data_;
 
+  // Only used for parallel decompression, in which case |queue_| is unused.
+  std::unique_ptr<CompressionPipeline> const pipeline_;
+
   DelegatingArrayInputStream stream_;
   std::unique_ptr<std::thread> thread_;
 
@@ -121,6 +121,27 @@ inline PushDeserializer::PushDeserializer(
   done_.push(nullptr);
 }
 
+inline PushDeserializer::PushDeserializer(
+    int const chunk_size,
+    int const number_of_chunks,
+    int const number_of_decompression_threads,
+    std::function<std::unique_ptr<Compressor>()> const& compressor_factory)
+    : chunk_size_(chunk_size),
+      compressed_chunk_size_(
+          compressor_factory()->MaxCompressedLength(chunk_size_)),
+      number_of_chunks_(number_of_chunks),
+      pipeline_(std::make_unique<CompressionPipeline>(
+          CompressionPipeline::Direction::Uncompress,
+          /*input_size=*/0,
+          /*output_size=*/chunk_size_,
+          /*number_of_slots=*/number_of_chunks_,
+          number_of_decompression_threads,
+          compressor_factory)),
+      stream_(std::bind(&PushDeserializer::Pull, this)) {
+  // This sentinel ensures that the two queues are correctly out of step.
+  done_.push(nullptr);
+}
+
 inline PushDeserializer::~PushDeserializer() {
   if (thread_ != nullptr) {
     thread_->join();
@@ -173,6 +194,21 @@ inline void PushDeserializer::Push(Array<std::uint8_t> const bytes,
   Array<std::uint8_t> current = bytes;
   CHECK_LE(0, bytes.size);
 
+  if (pipeline_ != nullptr) {
+    // The incoming data is a compressed block, which is uncompressed as a
+    // whole by one of the threads of the pipeline.  The callback is queued
+    // before the block is submitted, so that it is present when |Pull|
+    // receives the uncompressed block.
+    CHECK_LE(bytes.size, compressed_chunk_size_);
+    int const slot = pipeline_->Acquire();
+    {
+      absl::MutexLock l(&lock_);
+      done_.emplace(std::move(done));
+    }
+    pipeline_->Submit(slot, bytes);
+    return;
+  }
+
   // Decide how much data we are going to push on the queue.  In the presence of
   // compression we have to respect the boundary of the incoming block.  In the
   // absence of compression we have a stream so we can cut into as many chunks
@@ -215,6 +251,18 @@ inline void PushDeserializer::Push(UniqueArray<std::uint8_t> bytes) {
 
 inline Array<std::uint8_t> PushDeserializer::Pull() {
   Array<std::uint8_t> result;
+  if (pipeline_ != nullptr) {
+    // Block outside of the lock to let |Push| queue more callbacks.
+    result = pipeline_->Next();
+    absl::MutexLock l(&lock_);
+    CHECK(!done_.empty());
+    auto const done = done_.front();
+    if (done != nullptr) {
+      done();
+    }
+    done_.pop();
+    return result;
+  }
   {
     absl::MutexLock l(&lock_);
 
@@ -309,6 +309,49 @@ TEST_F(PushDeserializerTest, SerializationDeserialization) {
       /*deserializer_compressor=*/google::compression::NewGipfeliCompressor());
 }
 
+TEST_F(PushDeserializerTest, SerializationDeserializationParallelCompression) {
+  auto const trajectory = BuildTrajectory();
+  int const byte_size = trajectory->ByteSize();
+  for (int i = 0; i < runs_per_test; ++i) {
+    auto read_trajectory = make_not_null_unique<DiscreteTrajectory>();
+    auto written_trajectory = BuildTrajectory();
+    // The compressed chunks are stored contiguously, and may be slightly
+    // larger than the uncompressed data.
+    auto storage = std::make_unique<std::uint8_t[]>(2 * byte_size);
+    std::uint8_t* data = &storage[0];
+
+    pull_serializer_ = std::make_unique<PullSerializer>(
+        serializer_chunk_size,
+        /*number_of_chunks=*/4,
+        /*number_of_compression_threads=*/3,
+        &google::compression::NewGipfeliCompressor);
+    push_deserializer_ = std::make_unique<PushDeserializer>(
+        deserializer_chunk_size,
+        /*number_of_chunks=*/4,
+        /*number_of_decompression_threads=*/3,
+        &google::compression::NewGipfeliCompressor);
+
+    pull_serializer_->Start(std::move(written_trajectory));
+    push_deserializer_->Start(std::move(read_trajectory),
+                              PushDeserializerTest::CheckSerialization);
+    for (;;) {
+      Array<std::uint8_t> const bytes = pull_serializer_->Pull();
+      std::memcpy(data, bytes.data, static_cast<std::size_t>(bytes.size));
+      push_deserializer_->Push(
+          Array<std::uint8_t>(data, bytes.size),
+          std::bind(&PushDeserializerTest::Stomp,
+                    Array<std::uint8_t>(data, bytes.size)));
+      data = &data[bytes.size];
+      if (bytes.size == 0) {
+        break;
+      }
+    }
+
+    pull_serializer_.reset();
+    push_deserializer_.reset();
+  }
+}
+
 // Check that deserialization fails if we stomp on one extra byte.
 TEST_F(PushDeserializerDeathTest, Stomp) {
   EXPECT_DEATH({
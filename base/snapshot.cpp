@@ -0,0 +1,210 @@
+#include "base/snapshot.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+#include <vector>
+
+#include "base/macros.hpp"
+#include "glog/logging.h"
+
+namespace principia {
+namespace base {
+namespace _snapshot {
+namespace internal {
+
+#if !ARCH_CPU_LITTLE_ENDIAN
+#error "The snapshot format assumes a little-endian architecture"
+#endif
+
+namespace {
+
+constexpr char magic[8] = {'P', 'R', 'N', 'C', 'S', 'N', 'A', 'P'};
+
+struct Header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t padding;
+};
+
+struct Trailer {
+  std::int64_t table_of_contents_offset;
+  std::int64_t number_of_sections;
+  char magic[8];
+};
+
+static_assert(std::is_trivially_copyable_v<Header>);
+static_assert(std::is_trivially_copyable_v<SnapshotSection>);
+static_assert(std::is_trivially_copyable_v<Trailer>);
+static_assert(sizeof(Header) == 16);
+static_assert(sizeof(SnapshotSection) == 24);
+static_assert(sizeof(Trailer) == 24);
+
+constexpr std::int64_t section_size = sizeof(SnapshotSection);
+constexpr std::int64_t trailer_size = sizeof(Trailer);
+
+template<typename T>
+Array<std::uint8_t const> AsBytes(T const& t) {
+  return Array<std::uint8_t const>(reinterpret_cast<std::uint8_t const*>(&t),
+                                   sizeof(T));
+}
+
+template<typename T>
+T FromBytes(Array<std::uint8_t const> const bytes, std::int64_t const offset) {
+  CHECK_LE(0, offset);
+  CHECK_LE(offset + static_cast<std::int64_t>(sizeof(T)), bytes.size);
+  T t;
+  std::memcpy(&t, bytes.data + offset, sizeof(T));
+  return t;
+}
+
+}  // namespace
+
+SnapshotWriter::SnapshotWriter(std::filesystem::path const& path)
+    : stream_(path, std::ios::binary | std::ios::trunc) {
+  CHECK(stream_.good()) << path;
+  Header header{.version = snapshot_version, .padding = 0};
+  std::memcpy(header.magic, magic, sizeof(magic));
+  WriteBytes(AsBytes(header));
+}
+
+SnapshotWriter::~SnapshotWriter() {
+  if (!closed_) {
+    Close();
+  }
+}
+
+void SnapshotWriter::WriteMessage(
+    std::uint32_t const tag,
+    google::protobuf::MessageLite const& message) {
+  CHECK(!closed_);
+  Align();
+  std::int64_t const offset = position_;
+  std::int64_t const size = message.ByteSizeLong();
+  CHECK(message.SerializePartialToOstream(&stream_));
+  position_ += size;
+  CHECK_EQ(position_, static_cast<std::int64_t>(stream_.tellp()));
+  table_of_contents_.push_back({.kind = SnapshotSectionKind::Message,
+                                .tag = tag,
+                                .offset = offset,
+                                .size = size});
+}
+
+void SnapshotWriter::WriteDoubles(std::uint32_t const tag,
+                                  Array<double const> const doubles) {
+  CHECK(!closed_);
+  Align();
+  std::int64_t const offset = position_;
+  std::int64_t const size = doubles.size * sizeof(double);
+  WriteBytes(Array<std::uint8_t const>(
+      reinterpret_cast<std::uint8_t const*>(doubles.data), size));
+  table_of_contents_.push_back({.kind = SnapshotSectionKind::Doubles,
+                                .tag = tag,
+                                .offset = offset,
+                                .size = size});
+}
+
+void SnapshotWriter::Close() {
+  CHECK(!closed_);
+  Align();
+  Trailer trailer{.table_of_contents_offset = position_,
+                  .number_of_sections =
+                      static_cast<std::int64_t>(table_of_contents_.size())};
+  std::memcpy(trailer.magic, magic, sizeof(magic));
+  for (auto const& section : table_of_contents_) {
+    WriteBytes(AsBytes(section));
+  }
+  WriteBytes(AsBytes(trailer));
+  stream_.close();
+  CHECK(!stream_.fail());
+  closed_ = true;
+}
+
+void SnapshotWriter::WriteBytes(Array<std::uint8_t const> const bytes) {
+  stream_.write(reinterpret_cast<char const*>(bytes.data), bytes.size);
+  CHECK(stream_.good());
+  position_ += bytes.size;
+}
+
+void SnapshotWriter::Align() {
+  static constexpr std::uint8_t zeroes[snapshot_alignment] = {};
+  std::int64_t const padding =
+      (snapshot_alignment - position_ % snapshot_alignment) %
+      snapshot_alignment;
+  WriteBytes(Array<std::uint8_t const>(zeroes, padding));
+}
+
+SnapshotReader::SnapshotReader(std::filesystem::path const& path)
+    : file_(path) {
+  auto const bytes = file_.bytes();
+
+  auto const header = FromBytes<Header>(bytes, /*offset=*/0);
+  CHECK_EQ(0, std::memcmp(header.magic, magic, sizeof(magic)))
+      << path << " is not a snapshot";
+  CHECK_LE(header.version, snapshot_version)
+      << path << " was written by a more recent version";
+
+  auto const trailer = FromBytes<Trailer>(bytes, bytes.size - trailer_size);
+  CHECK_EQ(0, std::memcmp(trailer.magic, magic, sizeof(magic)))
+      << path << " is truncated";
+  CHECK_EQ(trailer.table_of_contents_offset +
+               trailer.number_of_sections * section_size,
+           bytes.size - trailer_size)
+      << path << " has an inconsistent table of contents";
+
+  sections_.reserve(trailer.number_of_sections);
+  for (std::int64_t i = 0; i < trailer.number_of_sections; ++i) {
+    auto const section = FromBytes<SnapshotSection>(
+        bytes,
+        trailer.table_of_contents_offset + i * section_size);
+    CHECK_EQ(0, section.offset % snapshot_alignment) << path;
+    CHECK_LE(section.offset + section.size,
+             trailer.table_of_contents_offset) << path;
+    sections_.push_back(section);
+  }
+}
+
+std::vector<SnapshotSection> const& SnapshotReader::sections() const {
+  return sections_;
+}
+
+std::vector<int> SnapshotReader::FindSections(std::uint32_t const tag) const {
+  std::vector<int> result;
+  for (int i = 0; i < sections_.size(); ++i) {
+    if (sections_[i].tag == tag) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+void SnapshotReader::ReadMessage(
+    int const section,
+    not_null<google::protobuf::MessageLite*> const message) const {
+  auto const bytes = SectionBytes(section, SnapshotSectionKind::Message);
+  CHECK(message->ParsePartialFromArray(bytes.data, bytes.size));
+}
+
+Array<double const> SnapshotReader::ReadDoubles(int const section) const {
+  auto const bytes = SectionBytes(section, SnapshotSectionKind::Doubles);
+  CHECK_EQ(0, bytes.size % sizeof(double));
+  return Array<double const>(reinterpret_cast<double const*>(bytes.data),
+                             bytes.size / sizeof(double));
+}
+
+Array<std::uint8_t const> SnapshotReader::SectionBytes(
+    int const section,
+    SnapshotSectionKind const kind) const {
+  CHECK_LE(0, section);
+  CHECK_LT(section, sections_.size());
+  auto const& snapshot_section = sections_[section];
+  CHECK(snapshot_section.kind == kind) << "Section " << section;
+  return Array<std::uint8_t const>(
+      file_.bytes().data + snapshot_section.offset, snapshot_section.size);
+}
+
+}  // namespace internal
+}  // namespace _snapshot
+}  // namespace base
+}  // namespace principia
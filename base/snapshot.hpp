@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "base/array.hpp"
+#include "base/mapped_file.hpp"
+#include "base/not_null.hpp"
+#include "google/protobuf/message_lite.h"
+
+namespace principia {
+namespace base {
+namespace _snapshot {
+namespace internal {
+
+using namespace principia::base::_array;
+using namespace principia::base::_mapped_file;
+using namespace principia::base::_not_null;
+
+// A snapshot is a versioned binary file made of independent sections.  It is
+// written incrementally, one section at a time, and is read through a memory
+// mapping, without copying the contents of the sections.  The layout is:
+//   header: magic (8 bytes), version (4 bytes), padding (4 bytes);
+//   sections, each starting at a multiple of |snapshot_alignment| bytes;
+//   table of contents: one |SnapshotSection| per section;
+//   trailer: offset of the table of contents (8 bytes), number of sections
+//     (8 bytes), magic (8 bytes).
+// All integers are little-endian.  Because the sections are aligned, arrays of
+// doubles may be used in place.
+
+// The version of the snapshot format.  Must be incremented for any
+// incompatible change of the layout.
+constexpr std::uint32_t snapshot_version = 1;
+
+// The alignment of the sections.  This is at least the size of a cache line.
+constexpr std::int64_t snapshot_alignment = 64;
+
+enum class SnapshotSectionKind : std::uint32_t {
+  Message = 1,
+  Doubles = 2,
+};
+
+// An entry in the table of contents.  |tag| is chosen by the client to identify
+// the section.  |offset| and |size| are in bytes.
+struct SnapshotSection {
+  SnapshotSectionKind kind;
+  std::uint32_t tag;
+  std::int64_t offset;
+  std::int64_t size;
+};
+
+class SnapshotWriter final {
+ public:
+  // Creates a snapshot at |path|, replacing any existing file.
+  explicit SnapshotWriter(std::filesystem::path const& path);
+  // Closes the snapshot if |Close| was not called.
+  ~SnapshotWriter();
+
+  // Appends a section containing the serialization of |message|.  The message
+  // is streamed to the file, so no serialized copy of it is held in memory.
+  // Required fields are not checked, so that a message may be split across
+  // several sections.
+  void WriteMessage(std::uint32_t tag,
+                    google::protobuf::MessageLite const& message);
+
+  // Appends a section containing |doubles|.
+  void WriteDoubles(std::uint32_t tag, Array<double const> doubles);
+
+  // Writes the table of contents and closes the file.  No calls to |Write*|
+  // may follow.
+  void Close();
+
+ private:
+  void WriteBytes(Array<std::uint8_t const> bytes);
+
+  // Pads the file with zeroes up to the next multiple of |snapshot_alignment|.
+  void Align();
+
+  std::ofstream stream_;
+  std::int64_t position_ = 0;
+  std::vector<SnapshotSection> table_of_contents_;
+  bool closed_ = false;
+};
+
+class SnapshotReader final {
+ public:
+  // Maps the snapshot at |path| and checks its format and version.
+  explicit SnapshotReader(std::filesystem::path const& path);
+
+  std::vector<SnapshotSection> const& sections() const;
+
+  // Returns the indices in |sections()| of the sections that have the given
+  // |tag|, in the order in which they were written.
+  std::vector<int> FindSections(std::uint32_t tag) const;
+
+  // Parses the message stored in the given section directly from the mapped
+  // file.  The section must be of kind |Message|.  Required fields are not
+  // checked.
+  void ReadMessage(int section,
+                   not_null<google::protobuf::MessageLite*> message) const;
+
+  // Returns a view of the doubles stored in the given section.  No copy takes
+  // place, and the result is only valid during the lifetime of this object.
+  // The section must be of kind |Doubles|.
+  Array<double const> ReadDoubles(int section) const;
+
+ private:
+  Array<std::uint8_t const> SectionBytes(int section,
+                                         SnapshotSectionKind kind) const;
+
+  MappedFile file_;
+  std::vector<SnapshotSection> sections_;
+};
+
+}  // namespace internal
+
+using internal::snapshot_alignment;
+using internal::snapshot_version;
+using internal::SnapshotReader;
+using internal::SnapshotSection;
+using internal::SnapshotSectionKind;
+using internal::SnapshotWriter;
+
+}  // namespace _snapshot
+}  // namespace base
+}  // namespace principia
@@ -0,0 +1,100 @@
+#include "base/snapshot.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "serialization/geometry.pb.h"
+
+namespace principia {
+namespace base {
+
+using ::testing::ElementsAre;
+using namespace principia::base::_array;
+using namespace principia::base::_snapshot;
+
+class SnapshotTest : public ::testing::Test {
+ protected:
+  SnapshotTest()
+      : path_(std::string(testing::UnitTest::GetInstance()
+                              ->current_test_info()
+                              ->name()) +
+              ".snapshot") {}
+
+  ~SnapshotTest() override {
+    std::filesystem::remove(path_);
+  }
+
+  std::filesystem::path const path_;
+};
+
+TEST_F(SnapshotTest, Empty) {
+  {
+    SnapshotWriter writer(path_);
+    writer.Close();
+  }
+  SnapshotReader const reader(path_);
+  EXPECT_TRUE(reader.sections().empty());
+}
+
+TEST_F(SnapshotTest, RoundTrip) {
+  serialization::Point point1;
+  point1.mutable_scalar()->set_dimensions(3);
+  point1.mutable_scalar()->set_magnitude(1.5);
+  serialization::Point point2;
+  point2.mutable_scalar()->set_dimensions(2);
+  point2.mutable_scalar()->set_magnitude(-7);
+  std::vector<double> const doubles = {1, 2, 3, 4, 5};
+
+  {
+    SnapshotWriter writer(path_);
+    writer.WriteMessage(/*tag=*/1, point1);
+    writer.WriteDoubles(/*tag=*/2, doubles);
+    writer.WriteMessage(/*tag=*/1, point2);
+    // The destructor closes the snapshot.
+  }
+
+  SnapshotReader const reader(path_);
+  EXPECT_EQ(3, reader.sections().size());
+  for (auto const& section : reader.sections()) {
+    EXPECT_EQ(0, section.offset % snapshot_alignment);
+  }
+  EXPECT_THAT(reader.FindSections(1), ElementsAre(0, 2));
+  EXPECT_THAT(reader.FindSections(2), ElementsAre(1));
+  EXPECT_THAT(reader.FindSections(3), ElementsAre());
+
+  serialization::Point read_point1;
+  serialization::Point read_point2;
+  reader.ReadMessage(0, &read_point1);
+  reader.ReadMessage(2, &read_point2);
+  EXPECT_EQ(1.5, read_point1.scalar().magnitude());
+  EXPECT_EQ(-7, read_point2.scalar().magnitude());
+
+  Array<double const> const read_doubles = reader.ReadDoubles(1);
+  EXPECT_EQ(0,
+            reinterpret_cast<std::uintptr_t>(read_doubles.data) %
+                alignof(double));
+  EXPECT_THAT(std::vector<double>(read_doubles.data,
+                                  read_doubles.data + read_doubles.size),
+              ElementsAre(1, 2, 3, 4, 5));
+}
+
+using SnapshotDeathTest = SnapshotTest;
+
+TEST_F(SnapshotDeathTest, Errors) {
+  EXPECT_DEATH({
+    {
+      SnapshotWriter writer(path_);
+      writer.WriteDoubles(/*tag=*/1, std::vector<double>{1, 2});
+    }
+    SnapshotReader const reader(path_);
+    serialization::Point point;
+    reader.ReadMessage(0, &point);
+  }, "kind == kind");
+}
+
+}  // namespace base
+}  // namespace principia
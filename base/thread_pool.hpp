@@ -29,6 +29,9 @@ class ThreadPool final {
   // the result.
   std::future<T> Add(std::function<T()> function);
 
+  // Returns the number of threads in this pool.
+  std::int64_t size() const;
+
  private:
   // The queue element contains a |function| to execute and a |promise| used to
   // communicate the result to the caller.
@@ -51,6 +51,11 @@ std::future<T> ThreadPool<T>::Add(std::function<T()> function) {
   return result;
 }
 
+template<typename T>
+std::int64_t ThreadPool<T>::size() const {
+  return threads_.size();
+}
+
 template<typename T>
 void ThreadPool<T>::DequeueCallAndExecute() {
   for (;;) {
@@ -1,5 +1,6 @@
 #include "base/zfp_compressor.hpp"
 
+#include <cmath>
 #include <functional>
 #include <memory>
 #include <string>
@@ -22,6 +23,17 @@ static constexpr uint header_mask = ZFP_HEADER_MODE | ZFP_HEADER_MAGIC;
 
 ZfpCompressor::ZfpCompressor(double const accuracy) : accuracy_(accuracy) {}
 
+ZfpCompressor ZfpCompressor::WithAdaptiveAccuracy(double const tolerance,
+                                                  double const scale) {
+  CHECK_LE(0, tolerance);
+  CHECK_LE(0, scale);
+  if (tolerance == 0 || scale == 0) {
+    return ZfpCompressor(0);
+  }
+  double const accuracy = tolerance / scale;
+  return ZfpCompressor(std::isfinite(accuracy) ? accuracy : 0);
+}
+
 void ZfpCompressor::WriteToMessage(const zfp_field* const field,
                                    not_null<std::string*> message) const {
   std::unique_ptr<zfp_stream, std::function<void(zfp_stream*)>> const zfp(
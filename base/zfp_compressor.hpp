@@ -28,6 +28,13 @@ class ZfpCompressor {
   // A compressor created with this constructor can both read and write.
   explicit ZfpCompressor(double accuracy);
 
+  // Returns a compressor whose accuracy adapts to the data being compressed:
+  // the absolute |tolerance| is divided by a |scale| characteristic of the data
+  // (e.g., the maximum time step when compressing velocities with a tolerance
+  // expressed as a length).  If either argument is zero, or if the resulting
+  // accuracy is not finite, the compressor is lossless.
+  static ZfpCompressor WithAdaptiveAccuracy(double tolerance, double scale);
+
   // Read/write the version of ZFP from/to the message.
   template<typename Message>
   static void WriteVersion(not_null<Message*> message);
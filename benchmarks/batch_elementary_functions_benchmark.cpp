@@ -0,0 +1,133 @@
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=10 --benchmark_min_time=2 --benchmark_filter=Batch  // NOLINT(whitespace/line_length)
+
+#include "numerics/batch_elementary_functions.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+namespace principia {
+namespace numerics {
+
+using namespace principia::numerics::_batch_elementary_functions;
+
+namespace {
+
+constexpr int size = 1000;
+
+std::vector<double> RandomVector(double const min, double const max) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(min, max);
+  std::vector<double> result;
+  for (int i = 0; i < size; ++i) {
+    result.push_back(distribution(random));
+  }
+  return result;
+}
+
+}  // namespace
+
+// The first argument is 0 for |Mode::Accurate|, 1 for |Mode::Fast|, and 2 for
+// a loop calling the standard library.
+
+void BM_BatchSinCos(benchmark::State& state) {
+  std::vector<double> const x = RandomVector(-10.0, 10.0);
+  std::vector<double> sin(size);
+  std::vector<double> cos(size);
+  for (auto _ : state) {
+    switch (state.range(0)) {
+      case 0:
+        SinCos(Mode::Accurate, x, sin, cos);
+        break;
+      case 1:
+        SinCos(Mode::Fast, x, sin, cos);
+        break;
+      case 2:
+        for (int i = 0; i < size; ++i) {
+          sin[i] = std::sin(x[i]);
+          cos[i] = std::cos(x[i]);
+        }
+        break;
+    }
+    benchmark::DoNotOptimize(sin.data());
+    benchmark::DoNotOptimize(cos.data());
+  }
+}
+
+void BM_BatchArcTan(benchmark::State& state) {
+  std::vector<double> const y = RandomVector(-10.0, 10.0);
+  std::vector<double> const x = RandomVector(-20.0, 10.0);
+  std::vector<double> arctan(size);
+  for (auto _ : state) {
+    switch (state.range(0)) {
+      case 0:
+        ArcTan(Mode::Accurate, y, x, arctan);
+        break;
+      case 1:
+        ArcTan(Mode::Fast, y, x, arctan);
+        break;
+      case 2:
+        for (int i = 0; i < size; ++i) {
+          arctan[i] = std::atan2(y[i], x[i]);
+        }
+        break;
+    }
+    benchmark::DoNotOptimize(arctan.data());
+  }
+}
+
+void BM_BatchExp(benchmark::State& state) {
+  std::vector<double> const x = RandomVector(-100.0, 100.0);
+  std::vector<double> exp(size);
+  for (auto _ : state) {
+    switch (state.range(0)) {
+      case 0:
+        Exp(Mode::Accurate, x, exp);
+        break;
+      case 1:
+        Exp(Mode::Fast, x, exp);
+        break;
+      case 2:
+        for (int i = 0; i < size; ++i) {
+          exp[i] = std::exp(x[i]);
+        }
+        break;
+    }
+    benchmark::DoNotOptimize(exp.data());
+  }
+}
+
+void BM_BatchLog(benchmark::State& state) {
+  std::vector<double> const x = RandomVector(1e-3, 1e3);
+  std::vector<double> log(size);
+  for (auto _ : state) {
+    switch (state.range(0)) {
+      case 0:
+        Log(Mode::Accurate, x, log);
+        break;
+      case 1:
+        Log(Mode::Fast, x, log);
+        break;
+      case 2:
+        for (int i = 0; i < size; ++i) {
+          log[i] = std::log(x[i]);
+        }
+        break;
+    }
+    benchmark::DoNotOptimize(log.data());
+  }
+}
+
+BENCHMARK(BM_BatchSinCos)->Arg(0)->Arg(1)->Arg(2)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BatchArcTan)->Arg(0)->Arg(1)->Arg(2)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BatchExp)->Arg(0)->Arg(1)->Arg(2)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BatchLog)->Arg(0)->Arg(1)->Arg(2)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace numerics
+}  // namespace principia
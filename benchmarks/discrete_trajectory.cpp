@@ -2,6 +2,7 @@
 
 #include "physics/discrete_trajectory.hpp"
 
+#include <cstdint>
 #include <vector>
 
 #include "astronomy/epoch.hpp"
@@ -12,10 +13,12 @@
 #include "geometry/instant.hpp"
 #include "geometry/space.hpp"
 #include "ksp_plugin/frames.hpp"
+#include "physics/discrete_trajectory_segment.hpp"
 #include "physics/discrete_trajectory_types.hpp"
 #include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
 #include "testing_utilities/discrete_trajectory_factories.hpp"
 
 namespace principia {
@@ -29,6 +32,7 @@ using namespace principia::geometry::_space;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_discrete_trajectory;
+using namespace principia::physics::_discrete_trajectory_segment;
 using namespace principia::physics::_discrete_trajectory_types;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_named_quantities;
@@ -400,6 +404,89 @@ void BM_DiscreteTrajectoryEvaluateDegreesOfFreedomInterpolated(
   }
 }
 
+// Measures the time to serialize a downsampled circular segment.  The counter
+// |bytes| is the size of the serialized timeline.
+void BM_DiscreteTrajectorySegmentSerialization(benchmark::State& state) {
+  Instant const t0;
+  int const steps = state.range(0);
+  DiscreteTrajectory<World> trajectory;
+  trajectory.segments().front().SetDownsampling(
+      {.max_dense_intervals = 10'000, .tolerance = 1 * Milli(Metre)});
+  auto const timeline =
+      NewCircularTrajectoryTimeline<World>(/*ω=*/1 * Radian / Second,
+                                           /*r=*/1 * Metre,
+                                           /*Δt=*/10 * Milli(Second),
+                                           /*t1=*/t0,
+                                           /*t2=*/t0 + steps * Second);
+  for (auto const& [t, degrees_of_freedom] : timeline) {
+    CHECK_OK(trajectory.Append(t, degrees_of_freedom));
+  }
+  auto const& segment = trajectory.segments().front();
+
+  std::int64_t bytes = 0;
+  for (auto _ : state) {
+    serialization::DiscreteTrajectorySegment message;
+    segment.WriteToMessage(&message, /*exact=*/{});
+    bytes = message.zfp().timeline().size();
+  }
+  state.counters["bytes"] = bytes;
+}
+
+// Measures the time to deserialize a small interval in the middle of a long
+// segment, which only requires decompressing the chunks that cover it.
+void BM_DiscreteTrajectorySegmentPartialDeserialization(
+    benchmark::State& state) {
+  Instant const t0;
+  int const steps = state.range(0);
+  DiscreteTrajectory<World> trajectory;
+  auto const timeline =
+      NewCircularTrajectoryTimeline<World>(/*ω=*/1 * Radian / Second,
+                                           /*r=*/1 * Metre,
+                                           /*Δt=*/10 * Milli(Second),
+                                           /*t1=*/t0,
+                                           /*t2=*/t0 + steps * Second);
+  for (auto const& [t, degrees_of_freedom] : timeline) {
+    CHECK_OK(trajectory.Append(t, degrees_of_freedom));
+  }
+  serialization::DiscreteTrajectorySegment message;
+  trajectory.segments().front().WriteToMessage(&message, /*exact=*/{});
+
+  Instant const t_mid = t0 + 0.5 * steps * Second;
+  for (auto _ : state) {
+    auto const segment =
+        DiscreteTrajectorySegment<World>::ReadFromMessage(message,
+                                                          /*t_min=*/t_mid,
+                                                          /*t_max=*/t_mid,
+                                                          /*self=*/{});
+    benchmark::DoNotOptimize(segment.size());
+  }
+}
+
+// Same as above, but deserializing the entire segment.
+void BM_DiscreteTrajectorySegmentFullDeserialization(benchmark::State& state) {
+  Instant const t0;
+  int const steps = state.range(0);
+  DiscreteTrajectory<World> trajectory;
+  auto const timeline =
+      NewCircularTrajectoryTimeline<World>(/*ω=*/1 * Radian / Second,
+                                           /*r=*/1 * Metre,
+                                           /*Δt=*/10 * Milli(Second),
+                                           /*t1=*/t0,
+                                           /*t2=*/t0 + steps * Second);
+  for (auto const& [t, degrees_of_freedom] : timeline) {
+    CHECK_OK(trajectory.Append(t, degrees_of_freedom));
+  }
+  serialization::DiscreteTrajectorySegment message;
+  trajectory.segments().front().WriteToMessage(&message, /*exact=*/{});
+
+  for (auto _ : state) {
+    auto const segment =
+        DiscreteTrajectorySegment<World>::ReadFromMessage(message,
+                                                          /*self=*/{});
+    benchmark::DoNotOptimize(segment.size());
+  }
+}
+
 BENCHMARK(BM_DiscreteTrajectoryFront);
 BENCHMARK(BM_DiscreteTrajectoryFrontEmpty);
 BENCHMARK(BM_DiscreteTrajectoryBack);
@@ -423,6 +510,10 @@ BENCHMARK(BM_DiscreteTrajectoryFind)->Range(8, 1024);
 BENCHMARK(BM_DiscreteTrajectoryLowerBound)->Range(8, 1024);
 BENCHMARK(BM_DiscreteTrajectoryEvaluateDegreesOfFreedomExact);
 BENCHMARK(BM_DiscreteTrajectoryEvaluateDegreesOfFreedomInterpolated);
+BENCHMARK(BM_DiscreteTrajectorySegmentSerialization)->Range(8, 8 << 10);
+BENCHMARK(BM_DiscreteTrajectorySegmentPartialDeserialization)
+    ->Range(8, 8 << 10);
+BENCHMARK(BM_DiscreteTrajectorySegmentFullDeserialization)->Range(8, 8 << 10);
 
 }  // namespace physics
 }  // namespace principia
@@ -0,0 +1,95 @@
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=FourierTransform  // NOLINT(whitespace/line_length)
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "geometry/complexification.hpp"
+#include "geometry/instant.hpp"
+#include "numerics/fast_fourier_transform.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace numerics {
+
+using namespace principia::geometry::_complexification;
+using namespace principia::geometry::_instant;
+using namespace principia::numerics::_fast_fourier_transform;
+using namespace principia::quantities::_si;
+
+namespace {
+
+std::vector<double> RandomSignal(int const size) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1, 1);
+  std::vector<double> signal;
+  signal.reserve(size);
+  for (int i = 0; i < size; ++i) {
+    signal.push_back(distribution(random));
+  }
+  return signal;
+}
+
+}  // namespace
+
+template<int log2_size>
+void BM_FastFourierTransform(benchmark::State& state) {
+  using FFT = FastFourierTransform<double, Instant, 1 << log2_size>;
+  auto const signal = RandomSignal(FFT::size);
+  for (auto _ : state) {
+    // Won't fit on the stack.
+    auto const fft = std::make_unique<FFT>(signal, 1 * Second);
+    benchmark::DoNotOptimize(fft);
+  }
+}
+
+void BM_DynamicFastFourierTransform(benchmark::State& state) {
+  int const size = state.range(0);
+  auto const signal = RandomSignal(size);
+  // Compute the plan outside of the loop.
+  FourierTransformPlan::ForSize(size);
+  for (auto _ : state) {
+    DynamicFastFourierTransform<double, Instant> const fft(signal, 1 * Second);
+    benchmark::DoNotOptimize(fft);
+  }
+}
+
+// Measures the complex transform, in place.
+void BM_FourierTransformPlanInPlace(benchmark::State& state) {
+  int const size = state.range(0);
+  auto const signal = RandomSignal(2 * size);
+  std::vector<Complexification<double>> data;
+  for (int i = 0; i < size; ++i) {
+    data.emplace_back(signal[2 * i], signal[2 * i + 1]);
+  }
+  auto const plan = FourierTransformPlan::ForSize(size);
+  for (auto _ : state) {
+    plan->Transform(data.data());
+    benchmark::DoNotOptimize(data.data());
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_FastFourierTransform, 10)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FastFourierTransform, 12)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FastFourierTransform, 14)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FastFourierTransform, 16)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FastFourierTransform, 18)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_FastFourierTransform, 20)->Unit(benchmark::kMicrosecond);
+// Powers of 2 from 2¹⁰ to 2²⁰, followed by mixed-radix sizes in that range.
+BENCHMARK(BM_DynamicFastFourierTransform)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->Arg(1'000)
+    ->Arg(10'000)
+    ->Arg(100'000)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FourierTransformPlanInPlace)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->Arg(1'000'000)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace numerics
+}  // namespace principia
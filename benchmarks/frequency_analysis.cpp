@@ -0,0 +1,181 @@
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=IncrementalProjection  // NOLINT(whitespace/line_length)
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "astronomy/epoch.hpp"
+#include "astronomy/frames.hpp"
+#include "base/thread_pool.hpp"
+#include "benchmark/benchmark.h"
+#include "geometry/instant.hpp"
+#include "geometry/space.hpp"
+#include "numerics/apodization.hpp"
+#include "numerics/frequency_analysis.hpp"
+#include "numerics/piecewise_poisson_series.hpp"
+#include "numerics/poisson_series.hpp"
+#include "numerics/polynomial_evaluators.hpp"
+#include "quantities/astronomy.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+
+namespace {
+
+// The number of calls to the global |operator new| while an
+// |AllocationCounter| is alive.  The replacement below is a plain forwarding to
+// |malloc| otherwise, so that the other benchmarks in this binary are not
+// affected.
+std::atomic<bool> counting_allocations = false;
+std::atomic<std::int64_t> allocations = 0;
+
+// Counts the allocations performed by the entire process during its lifetime.
+class AllocationCounter {
+ public:
+  AllocationCounter() {
+    allocations = 0;
+    counting_allocations = true;
+  }
+
+  ~AllocationCounter() {
+    counting_allocations = false;
+  }
+
+  std::int64_t count() const {
+    return allocations;
+  }
+};
+
+}  // namespace
+
+void* operator new(std::size_t const size) {
+  if (counting_allocations.load(std::memory_order_relaxed)) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  void* const p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* const p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* const p, std::size_t) noexcept {
+  std::free(p);
+}
+
+namespace principia {
+namespace numerics {
+
+using namespace principia::astronomy::_epoch;
+using namespace principia::astronomy::_frames;
+using namespace principia::base::_thread_pool;
+using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
+using namespace principia::numerics::_frequency_analysis;
+using namespace principia::numerics::_piecewise_poisson_series;
+using namespace principia::numerics::_poisson_series;
+using namespace principia::numerics::_polynomial_evaluators;
+using namespace principia::quantities::_astronomy;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+
+namespace {
+
+constexpr int frequencies = 50;
+constexpr int pieces = 120;
+
+using Series = PoissonSeries<Displacement<ICRS>, 0, 0, HornerEvaluator>;
+using PiecewiseSeries =
+    PiecewisePoissonSeries<Displacement<ICRS>, 0, 0, HornerEvaluator>;
+
+}  // namespace
+
+// Projects a 10-year trajectory made of |frequencies| periodic terms with
+// periods between 30 days and a year onto its |frequencies| frequencies.  The
+// argument is the size of the thread pool, 0 for sequential execution.  The
+// counters report the number of frequencies actually projected (the projection
+// stops early if the residual degenerates) and the allocations per iteration.
+void BM_IncrementalProjection(benchmark::State& state) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> period_distribution(30, 365);
+  std::uniform_real_distribution<> amplitude_distribution(-1e9, 1e9);
+  auto random_displacement = [&amplitude_distribution, &random]() {
+    return Displacement<ICRS>({amplitude_distribution(random) * Metre,
+                               amplitude_distribution(random) * Metre,
+                               amplitude_distribution(random) * Metre});
+  };
+
+  Instant const t_min = J2000;
+  Instant const t_max = t_min + 10 * JulianYear;
+  Instant const t_mid = t_min + 5 * JulianYear;
+
+  std::vector<AngularFrequency> ωs;
+  Series::PolynomialsByAngularFrequency polynomials;
+  for (int i = 0; i < frequencies; ++i) {
+    ωs.push_back(2 * π * Radian / (period_distribution(random) * Day));
+    polynomials.emplace_back(
+        ωs.back(),
+        Series::Polynomials{
+            .sin = Series::PeriodicPolynomial({random_displacement()}, t_mid),
+            .cos = Series::PeriodicPolynomial({random_displacement()}, t_mid)});
+  }
+  Series const series(Series::AperiodicPolynomial({}, t_mid), polynomials);
+
+  Time const Δt = (t_max - t_min) / pieces;
+  PiecewiseSeries trajectory({t_min, t_min + Δt}, series);
+  for (int i = 1; i < pieces; ++i) {
+    trajectory.Append({t_min + i * Δt, t_min + (i + 1) * Δt}, series);
+  }
+
+  std::unique_ptr<ThreadPool<void>> pool;
+  if (state.range(0) > 0) {
+    pool = std::make_unique<ThreadPool<void>>(/*pool_size=*/state.range(0));
+  }
+  auto const apodization = _apodization::Hann<HornerEvaluator>(t_min, t_max);
+  int projected_frequencies = 0;
+  AllocationCounter const allocation_counter;
+  for (auto _ : state) {
+    int ω_index = 0;
+    auto angular_frequency_calculator =
+        [&ω_index, &ωs](auto const& residual)
+        -> std::optional<AngularFrequency> {
+      if (ω_index == ωs.size()) {
+        return std::nullopt;
+      } else {
+        return ωs[ω_index++];
+      }
+    };
+    auto const projection =
+        IncrementalProjection</*aperiodic_degree=*/1, /*periodic_degree=*/1>(
+            trajectory,
+            angular_frequency_calculator,
+            apodization,
+            t_min, t_max,
+            pool.get());
+    benchmark::DoNotOptimize(projection);
+    projected_frequencies = ω_index;
+  }
+  state.counters["allocations"] = benchmark::Counter(
+      allocation_counter.count(), benchmark::Counter::kAvgIterations);
+  state.counters["frequencies"] = projected_frequencies;
+}
+
+BENCHMARK(BM_IncrementalProjection)
+    ->Arg(0)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kSecond);
+
+}  // namespace numerics
+}  // namespace principia
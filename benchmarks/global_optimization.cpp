@@ -2,9 +2,12 @@
 
 #include "numerics/global_optimization.hpp"
 
+#include <array>
+#include <memory>
 #include <random>
 
 #include "absl/strings/str_cat.h"
+#include "base/thread_pool.hpp"
 #include "benchmark/benchmark.h"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
@@ -17,6 +20,7 @@
 namespace principia {
 namespace numerics {
 
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_space;
@@ -162,9 +166,79 @@ void BM_MLSLHartmann3(benchmark::State& state) {
                    static_cast<double>(total_minima) / state.iterations()));
 }
 
+// Emulates an objective function whose evaluation is expensive, e.g., because
+// it requires evaluating trajectories, by evaluating Hartmann3 |repetitions|
+// times.  The argument is the size of the thread pool, 0 for sequential
+// execution.
+void BM_MLSLExpensiveHartmann3(benchmark::State& state) {
+  constexpr int repetitions = 1000;
+  std::int64_t const pool_size = state.range(0);
+
+  using Optimizer =
+      MultiLevelSingleLinkage<double, Displacement<World>, /*dimensions=*/3>;
+
+  auto hartmann3 = [](Displacement<World> const& displacement) {
+    auto const& coordinates = displacement.coordinates();
+    double const x₀ = coordinates[0] / Metre;
+    double const x₁ = coordinates[1] / Metre;
+    double const x₂ = coordinates[2] / Metre;
+    double result;
+    for (int i = 0; i < repetitions; ++i) {
+      result = Hartmann3(x₀, x₁, x₂);
+      benchmark::DoNotOptimize(result);
+    }
+    return result;
+  };
+
+  auto grad_hartmann3 = [](Displacement<World> const& displacement) {
+    auto const& coordinates = displacement.coordinates();
+    double const x₀ = coordinates[0] / Metre;
+    double const x₁ = coordinates[1] / Metre;
+    double const x₂ = coordinates[2] / Metre;
+    std::array<double, 3> g;
+    for (int i = 0; i < repetitions; ++i) {
+      g = 𝛁Hartmann3(x₀, x₁, x₂);
+      benchmark::DoNotOptimize(g);
+    }
+    auto const [g₀, g₁, g₂] = g;
+    return Vector<Inverse<Length>, World>({g₀ / Metre, g₁ / Metre, g₂ / Metre});
+  };
+
+  Optimizer::Box const box = {
+      .centre = Displacement<World>({0.5 * Metre, 0.5 * Metre, 0.5 * Metre}),
+      .vertices = {
+          Displacement<World>({0.5 * Metre, 0 * Metre, 0 * Metre}),
+          Displacement<World>({0 * Metre, 0.5 * Metre, 0 * Metre}),
+          Displacement<World>({0 * Metre, 0 * Metre, 0.5 * Metre}),
+      }};
+
+  std::unique_ptr<ThreadPool<void>> pool;
+  if (pool_size > 0) {
+    pool = std::make_unique<ThreadPool<void>>(pool_size);
+  }
+
+  auto const tolerance = 1e-6 * Metre;
+  Optimizer optimizer(box, hartmann3, grad_hartmann3, pool.get());
+
+  int64_t total_minima = 0;
+  for (auto _ : state) {
+    total_minima += optimizer.FindGlobalMinima(/*points_per_round=*/50,
+                                               /*number_of_rounds=*/20,
+                                               tolerance).size();
+  }
+  state.SetLabel(
+      absl::StrCat("number of minima: ",
+                   static_cast<double>(total_minima) / state.iterations()));
+}
+
 BENCHMARK(BM_MLSLBranin)->ArgsProduct({{10, 20, 50}, {10, 20, 50}});
 BENCHMARK(BM_MLSLGoldsteinPrice)->ArgsProduct({{10, 20, 50}, {10, 20, 50}});
 BENCHMARK(BM_MLSLHartmann3)->ArgsProduct({{10, 20, 50}, {10, 20, 50}});
+BENCHMARK(BM_MLSLExpensiveHartmann3)
+    ->Arg(0)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond);
 
 }  // namespace numerics
 }  // namespace principia
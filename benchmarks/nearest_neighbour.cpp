@@ -2,10 +2,12 @@
 
 #include "numerics/nearest_neighbour.hpp"
 
+#include <memory>
 #include <random>
 #include <vector>
 
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "benchmark/benchmark.h"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
@@ -14,6 +16,7 @@ namespace principia {
 namespace numerics {
 
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
 using namespace principia::numerics::_nearest_neighbour;
@@ -44,7 +47,8 @@ PrincipalComponentPartitioningTree<V> BuildTreeUsingAdd(
 PrincipalComponentPartitioningTree<V> BuildTreeUsingConstructor(
     std::int64_t const points_in_tree,
     std::int64_t const max_values_per_cell,
-    std::vector<V>& values) {
+    std::vector<V>& values,
+    ThreadPool<void>* const thread_pool = nullptr) {
   std::mt19937_64 random(42);
   std::uniform_real_distribution<double> coordinate_distribution(-10, 10);
 
@@ -57,7 +61,8 @@ PrincipalComponentPartitioningTree<V> BuildTreeUsingConstructor(
                         coordinate_distribution(random)}));
     pointers.push_back(&values.back());
   }
-  return PrincipalComponentPartitioningTree<V>(pointers, max_values_per_cell);
+  return PrincipalComponentPartitioningTree<V>(
+      pointers, max_values_per_cell, thread_pool);
 }
 
 void BM_PCPBuildTreeUsingAdd(benchmark::State& state) {
@@ -82,6 +87,19 @@ void BM_PCPBuildTreeUsingConstructor(benchmark::State& state) {
   }
 }
 
+// The third argument is the size of the thread pool.
+void BM_PCPBuildTreeInParallel(benchmark::State& state) {
+  std::int64_t const points_in_tree = state.range(0);
+  std::int64_t const max_values_per_cell = state.range(1);
+  ThreadPool<void> pool(/*pool_size=*/state.range(2));
+  std::vector<V> values;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BuildTreeUsingConstructor(
+        points_in_tree, max_values_per_cell, values, &pool));
+  }
+}
+
 void BM_PCPFindNearestNeighbour(benchmark::State& state) {
   std::int64_t const points_in_tree = state.range(0);
   std::int64_t const max_values_per_cell = state.range(1);
@@ -99,6 +117,33 @@ void BM_PCPFindNearestNeighbour(benchmark::State& state) {
   }
 }
 
+// The third argument is the number of neighbours.  Each iteration answers 1000
+// queries.
+void BM_PCPFindNearestNeighbours(benchmark::State& state) {
+  constexpr int queries = 1000;
+  std::int64_t const points_in_tree = state.range(0);
+  std::int64_t const max_values_per_cell = state.range(1);
+  std::int64_t const k = state.range(2);
+  std::vector<V> values;
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<double> coordinate_distribution(-10, 10);
+  auto const tree =
+      BuildTreeUsingConstructor(points_in_tree, max_values_per_cell, values);
+
+  std::vector<V> query_values;
+  for (auto _ : state) {
+    state.PauseTiming();
+    query_values.clear();
+    for (int i = 0; i < queries; ++i) {
+      query_values.push_back(V({coordinate_distribution(random),
+                                coordinate_distribution(random),
+                                coordinate_distribution(random)}));
+    }
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(tree.FindNearestNeighbours(query_values, k));
+  }
+}
+
 BENCHMARK(BM_PCPBuildTreeUsingAdd)
     ->Args({1'000, 1})
     ->Args({1'000, 4})
@@ -130,7 +175,16 @@ BENCHMARK(BM_PCPBuildTreeUsingConstructor)
     ->Args({100'000, 4})
     ->Args({100'000, 16})
     ->Args({100'000, 64})
-    ->Args({100'000, 256});
+    ->Args({100'000, 256})
+    ->Args({1'000'000, 4})
+    ->Args({1'000'000, 16})
+    ->Args({1'000'000, 64});
+BENCHMARK(BM_PCPBuildTreeInParallel)
+    ->Args({100'000, 16, 4})
+    ->Args({1'000'000, 4, 4})
+    ->Args({1'000'000, 16, 4})
+    ->Args({1'000'000, 16, 8})
+    ->Args({1'000'000, 64, 4});
 BENCHMARK(BM_PCPFindNearestNeighbour)
     ->Args({1'000, 1})
     ->Args({1'000, 4})
@@ -146,7 +200,17 @@ BENCHMARK(BM_PCPFindNearestNeighbour)
     ->Args({100'000, 4})
     ->Args({100'000, 16})
     ->Args({100'000, 64})
-    ->Args({100'000, 256});
+    ->Args({100'000, 256})
+    ->Args({1'000'000, 4})
+    ->Args({1'000'000, 16})
+    ->Args({1'000'000, 64});
+BENCHMARK(BM_PCPFindNearestNeighbours)
+    ->Args({10'000, 16, 1})
+    ->Args({10'000, 16, 8})
+    ->Args({1'000'000, 4, 1})
+    ->Args({1'000'000, 16, 1})
+    ->Args({1'000'000, 16, 8})
+    ->Args({1'000'000, 64, 8});
 
 }  // namespace numerics
 }  // namespace principia
@@ -8,6 +8,7 @@
 #include "geometry/space.hpp"
 #include "numerics/polynomial.hpp"
 #include "numerics/polynomial_evaluators.hpp"
+#include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
 
@@ -20,6 +21,7 @@ using namespace principia::geometry::_r3_element;
 using namespace principia::geometry::_space;
 using namespace principia::numerics::_polynomial;
 using namespace principia::numerics::_polynomial_evaluators;
+using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
@@ -103,6 +105,48 @@ void EvaluatePolynomialInMonomialBasis(benchmark::State& state) {
   state.SetLabel(ss.str().substr(0, 0));
 }
 
+// Evaluates the value and the derivative, either with |EvaluateWithDerivative|
+// or with two separate calls, which is what |ContinuousTrajectory| does.
+template<typename Value, typename Argument, int degree,
+         template<typename, typename, int> class Evaluator>
+void EvaluatePolynomialInMonomialBasisWithDerivative(benchmark::State& state,
+                                                     bool const together) {
+  using P = PolynomialInMonomialBasis<Value, Argument, degree, Evaluator>;
+  std::mt19937_64 random(42);
+  typename P::Coefficients coefficients;
+  RandomTupleGenerator<typename P::Coefficients, 0>::Fill(coefficients, random);
+  P const p(coefficients);
+
+  auto const min = ValueGenerator<Argument>::Get(random);
+  auto const max = ValueGenerator<Argument>::Get(random);
+  auto argument = min;
+  auto const Δargument = (max - min) * 1e-9;
+  auto result = Value{};
+  auto derivative_result = Derivative<Value, Argument>{};
+
+  for (auto _ : state) {
+    for (int i = 0; i < evaluations_per_iteration; ++i) {
+      if (together) {
+        Value value;
+        Derivative<Value, Argument> derivative;
+        p.EvaluateWithDerivative(argument, value, derivative);
+        result += value;
+        derivative_result += derivative;
+      } else {
+        result += p(argument);
+        derivative_result += p.EvaluateDerivative(argument);
+      }
+      argument += Δargument;
+    }
+  }
+
+  // This weird call to |SetLabel| has no effect except that it uses |result|
+  // and therefore prevents the loop from being optimized away.
+  std::stringstream ss;
+  ss << result << derivative_result;
+  state.SetLabel(ss.str().substr(0, 0));
+}
+
 template<template<typename, typename, int> class Evaluator>
 void BM_EvaluatePolynomialInMonomialBasisDouble(benchmark::State& state) {
   int const degree = state.range(0);
@@ -215,6 +259,49 @@ void BM_EvaluatePolynomialInMonomialBasisDisplacement(benchmark::State& state) {
   }
 }
 
+// The second argument is 1 to use |EvaluateWithDerivative|, 0 to use separate
+// calls.
+template<template<typename, typename, int> class Evaluator>
+void BM_EvaluatePolynomialInMonomialBasisDisplacementWithDerivative(
+    benchmark::State& state) {
+  int const degree = state.range(0);
+  bool const together = state.range(1) != 0;
+  switch (degree) {
+    case 4:
+      EvaluatePolynomialInMonomialBasisWithDerivative<Displacement<ICRS>,
+                                                      Time,
+                                                      4,
+                                                      Evaluator>(state,
+                                                                 together);
+      break;
+    case 8:
+      EvaluatePolynomialInMonomialBasisWithDerivative<Displacement<ICRS>,
+                                                      Time,
+                                                      8,
+                                                      Evaluator>(state,
+                                                                 together);
+      break;
+    case 12:
+      EvaluatePolynomialInMonomialBasisWithDerivative<Displacement<ICRS>,
+                                                      Time,
+                                                      12,
+                                                      Evaluator>(state,
+                                                                 together);
+      break;
+    case 16:
+      EvaluatePolynomialInMonomialBasisWithDerivative<Displacement<ICRS>,
+                                                      Time,
+                                                      16,
+                                                      Evaluator>(state,
+                                                                 together);
+      break;
+    default:
+      LOG(FATAL) << "Degree " << degree << " in "
+                 << "BM_EvaluatePolynomialInMonomialBasisDisplacementWith"
+                 << "Derivative";
+  }
+}
+
 BENCHMARK_TEMPLATE1(BM_EvaluatePolynomialInMonomialBasisDouble,
                     EstrinEvaluator)
     ->Arg(4)->Arg(8)->Arg(12)->Arg(16)->Unit(benchmark::kMicrosecond);
@@ -239,6 +326,16 @@ BENCHMARK_TEMPLATE1(BM_EvaluatePolynomialInMonomialBasisVectorDouble,
 BENCHMARK_TEMPLATE1(BM_EvaluatePolynomialInMonomialBasisDisplacement,
                     HornerEvaluator)
     ->Arg(4)->Arg(8)->Arg(12)->Arg(16)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE1(
+    BM_EvaluatePolynomialInMonomialBasisDisplacementWithDerivative,
+    EstrinEvaluator)
+    ->ArgsProduct({{4, 8, 12, 16}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE1(
+    BM_EvaluatePolynomialInMonomialBasisDisplacementWithDerivative,
+    HornerEvaluator)
+    ->ArgsProduct({{4, 8, 12, 16}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
 
 }  // namespace numerics
 }  // namespace principia
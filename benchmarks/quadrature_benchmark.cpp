@@ -0,0 +1,220 @@
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=Quadrature  // NOLINT(whitespace/line_length)
+
+#include "numerics/quadrature.hpp"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "astronomy/epoch.hpp"
+#include "base/array.hpp"
+#include "base/thread_pool.hpp"
+#include "benchmark/benchmark.h"
+#include "geometry/instant.hpp"
+#include "numerics/batch_elementary_functions.hpp"
+#include "quantities/astronomy.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/named_quantities.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace numerics {
+
+using namespace principia::astronomy::_epoch;
+using namespace principia::base::_array;
+using namespace principia::base::_thread_pool;
+using namespace principia::geometry::_instant;
+using namespace principia::numerics::_batch_elementary_functions;
+using namespace principia::numerics::_quadrature;
+using namespace principia::quantities::_astronomy;
+using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_named_quantities;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+
+namespace {
+
+constexpr int frequencies = 20;
+constexpr double max_relative_error = 1e-8;
+constexpr int max_points = 1 << 14;
+constexpr int gauss_legendre_intervals = 1000;
+
+// The integrand of the inner product of a Poisson series with |frequencies|
+// periodic terms with a constant, weighted by a Hann window, over a year.
+class PoissonIntegrand {
+ public:
+  PoissonIntegrand() : t_min_(J2000), t_max_(J2000 + JulianYear) {
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<> period_distribution(10, 365);
+    std::uniform_real_distribution<> amplitude_distribution(-1, 1);
+    for (int k = 0; k < frequencies; ++k) {
+      ωs_.push_back(2 * π / (period_distribution(random) * Day / Second));
+      sin_amplitudes_.push_back(amplitude_distribution(random));
+      cos_amplitudes_.push_back(amplitude_distribution(random));
+    }
+  }
+
+  Instant const& t_min() const { return t_min_; }
+  Instant const& t_max() const { return t_max_; }
+
+  double operator()(Instant const& t) const {
+    double const τ = (t - t_min_) / Second;
+    double result = 0;
+    for (int k = 0; k < frequencies; ++k) {
+      double const ωτ = ωs_[k] * τ;
+      result += sin_amplitudes_[k] * std::sin(ωτ) +
+                cos_amplitudes_[k] * std::cos(ωτ);
+    }
+    return result * Hann(τ);
+  }
+
+  // Evaluates the series for all the |t|, using the batch elementary
+  // functions.
+  void operator()(Array<Instant const> const t,
+                  Array<double> const values) const {
+    std::vector<double> τ(t.size);
+    std::vector<double> ωτ(t.size);
+    std::vector<double> sin_ωτ(t.size);
+    std::vector<double> cos_ωτ(t.size);
+    for (std::int64_t i = 0; i < t.size; ++i) {
+      τ[i] = (t.data[i] - t_min_) / Second;
+      values.data[i] = 0;
+    }
+    for (int k = 0; k < frequencies; ++k) {
+      for (std::int64_t i = 0; i < t.size; ++i) {
+        ωτ[i] = ωs_[k] * τ[i];
+      }
+      SinCos(Mode::Accurate, ωτ, sin_ωτ, cos_ωτ);
+      for (std::int64_t i = 0; i < t.size; ++i) {
+        values.data[i] += sin_amplitudes_[k] * sin_ωτ[i] +
+                          cos_amplitudes_[k] * cos_ωτ[i];
+      }
+    }
+    for (std::int64_t i = 0; i < t.size; ++i) {
+      values.data[i] *= Hann(τ[i]);
+    }
+  }
+
+ private:
+  double Hann(double const τ) const {
+    return 1 - std::cos(2 * π * τ / ((t_max_ - t_min_) / Second));
+  }
+
+  Instant const t_min_;
+  Instant const t_max_;
+  std::vector<double> ωs_;
+  std::vector<double> sin_amplitudes_;
+  std::vector<double> cos_amplitudes_;
+};
+
+// The integrand used to compute the sidereal period and the mean elements of
+// an orbit: λ(t) (t - t₀), with the mean longitude of an eccentric orbit
+// approximated by its equation of the centre.
+class MeanLongitudeIntegrand {
+ public:
+  MeanLongitudeIntegrand() : t0_(J2000) {}
+
+  Instant const& t0() const { return t0_; }
+
+  Product<Angle, Time> operator()(Instant const& t) const {
+    double const M = n_ * ((t - t0_) / Second);
+    return (M + 2 * e_ * std::sin(M) + 1.25 * e_ * e_ * std::sin(2 * M)) *
+           Radian * (t - t0_);
+  }
+
+  void operator()(Array<Instant const> const t,
+                  Array<Product<Angle, Time>> const values) const {
+    std::vector<double> M(t.size);
+    std::vector<double> two_M(t.size);
+    std::vector<double> sin_M(t.size);
+    std::vector<double> sin_2M(t.size);
+    for (std::int64_t i = 0; i < t.size; ++i) {
+      M[i] = n_ * ((t.data[i] - t0_) / Second);
+      two_M[i] = 2 * M[i];
+    }
+    Sin(Mode::Accurate, M, sin_M);
+    Sin(Mode::Accurate, two_M, sin_2M);
+    for (std::int64_t i = 0; i < t.size; ++i) {
+      values.data[i] = (M[i] + 2 * e_ * sin_M[i] + 1.25 * e_ * e_ * sin_2M[i]) *
+                       Radian * (t.data[i] - t0_);
+    }
+  }
+
+ private:
+  Instant const t0_;
+  double const n_ = 2 * π / (90 * Minute / Second);
+  double const e_ = 0.01;
+};
+
+std::unique_ptr<ThreadPool<void>> MakePool(std::int64_t const pool_size) {
+  return pool_size == 0 ? nullptr
+                        : std::make_unique<ThreadPool<void>>(pool_size);
+}
+
+}  // namespace
+
+void BM_QuadraturePoissonAutomaticClenshawCurtis(benchmark::State& state) {
+  PoissonIntegrand const f;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(AutomaticClenshawCurtis(
+        f, f.t_min(), f.t_max(), max_relative_error, max_points));
+  }
+}
+
+// The argument is the size of the thread pool, 0 for sequential execution.
+void BM_QuadraturePoissonBatchAutomaticClenshawCurtis(
+    benchmark::State& state) {
+  PoissonIntegrand const f;
+  auto const pool = MakePool(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BatchAutomaticClenshawCurtis<double>(
+        f, f.t_min(), f.t_max(), max_relative_error, max_points, pool.get()));
+  }
+}
+
+// The mean elements are computed by integrating over each of
+// |gauss_legendre_intervals| orbits.
+void BM_QuadratureMeanLongitudeGaussLegendre(benchmark::State& state) {
+  MeanLongitudeIntegrand const f;
+  Time const period = 90 * Minute;
+  for (auto _ : state) {
+    Product<Angle, Square<Time>> result;
+    for (int i = 0; i < gauss_legendre_intervals; ++i) {
+      result += GaussLegendre<10>(
+          f, f.t0() + i * period, f.t0() + (i + 1) * period);
+    }
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+// The argument is the size of the thread pool, 0 for sequential execution.
+void BM_QuadratureMeanLongitudeBatchGaussLegendre(benchmark::State& state) {
+  MeanLongitudeIntegrand const f;
+  Time const period = 90 * Minute;
+  auto const pool = MakePool(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BatchGaussLegendre<10, Product<Angle, Time>>(
+        f,
+        f.t0(),
+        f.t0() + gauss_legendre_intervals * period,
+        gauss_legendre_intervals,
+        pool.get()));
+  }
+}
+
+BENCHMARK(BM_QuadraturePoissonAutomaticClenshawCurtis)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_QuadraturePoissonBatchAutomaticClenshawCurtis)
+    ->Arg(0)
+    ->Arg(4)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_QuadratureMeanLongitudeGaussLegendre)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_QuadratureMeanLongitudeBatchGaussLegendre)
+    ->Arg(0)
+    ->Arg(4)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace numerics
+}  // namespace principia
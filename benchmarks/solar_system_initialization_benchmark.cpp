@@ -0,0 +1,164 @@
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=SolarSystemInitialization  // NOLINT(whitespace/line_length)
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "absl/strings/str_format.h"
+#include "base/status_utilities.hpp"
+#include "base/thread_pool.hpp"
+#include "benchmark/benchmark.h"
+#include "geometry/instant.hpp"
+#include "integrators/methods.hpp"
+#include "integrators/symmetric_linear_multistep_integrator.hpp"
+#include "ksp_plugin/frames.hpp"
+#include "physics/ephemeris.hpp"
+#include "physics/solar_system.hpp"
+#include "quantities/si.hpp"
+#include "serialization/astronomy.pb.h"
+
+namespace principia {
+namespace physics {
+
+using namespace principia::base::_thread_pool;
+using namespace principia::geometry::_instant;
+using namespace principia::integrators::_methods;
+using namespace principia::integrators::_symmetric_linear_multistep_integrator;
+using namespace principia::ksp_plugin::_frames;
+using namespace principia::physics::_ephemeris;
+using namespace principia::physics::_solar_system;
+using namespace principia::quantities::_si;
+
+namespace {
+
+constexpr char epoch[] = "JD2451545.000000000";
+
+// Returns a synthetic hierarchical system with |bodies| bodies: a star, about a
+// fifth of the bodies as oblate planets on successively wider orbits, and the
+// rest as moons distributed among the planets.
+SolarSystem<Barycentric> SyntheticSolarSystem(int const bodies) {
+  CHECK_GE(bodies, 2);
+  int const planets = std::max(1, (bodies - 1) / 5);
+  int const moons = bodies - 1 - planets;
+
+  serialization::GravityModel gravity_model;
+  serialization::InitialState initial_state;
+  initial_state.set_epoch(epoch);
+  auto* const keplerian = initial_state.mutable_keplerian();
+
+  auto const add_body = [&gravity_model, keplerian](
+                            std::string const& name,
+                            std::string const& gravitational_parameter) {
+    auto* const body = gravity_model.add_body();
+    body->set_name(name);
+    body->set_gravitational_parameter(gravitational_parameter);
+    auto* const keplerian_body = keplerian->add_body();
+    keplerian_body->set_name(name);
+    return std::pair(body, keplerian_body);
+  };
+  auto const set_elements =
+      [](serialization::InitialState::Keplerian::Body& body,
+         std::string const& parent,
+         double const semimajor_axis,
+         int const index) {
+        body.set_parent(parent);
+        auto* const elements = body.mutable_elements();
+        elements->set_eccentricity(0.01 * (index % 5));
+        elements->set_semimajor_axis(
+            absl::StrFormat("%.17g m", semimajor_axis));
+        elements->set_inclination(absl::StrFormat("%d deg", index % 7));
+        elements->set_longitude_of_ascending_node(
+            absl::StrFormat("%d deg", 37 * index % 360));
+        elements->set_argument_of_periapsis(
+            absl::StrFormat("%d deg", 91 * index % 360));
+        elements->set_mean_anomaly(absl::StrFormat("%d deg", 53 * index % 360));
+      };
+
+  add_body("Star", "1.32712440018e20 m^3/s^2");
+  for (int p = 0; p < planets; ++p) {
+    std::string const name = absl::StrFormat("Planet%03d", p);
+    auto const [body, keplerian_body] = add_body(name, "1e15 m^3/s^2");
+    body->set_reference_instant(epoch);
+    body->set_mean_radius("5e6 m");
+    body->set_axis_right_ascension("-90 deg");
+    body->set_axis_declination("90 deg");
+    body->set_reference_angle("0 deg");
+    body->set_angular_frequency("1e-4 rad/s");
+    body->set_reference_radius("5e6 m");
+    body->set_j2(1e-3);
+    set_elements(*keplerian_body,
+                 /*parent=*/"Star",
+                 /*semimajor_axis=*/5e10 * std::pow(1.4, p),
+                 /*index=*/p);
+  }
+  for (int m = 0; m < moons; ++m) {
+    auto const [body, keplerian_body] =
+        add_body(absl::StrFormat("Moon%03d", m), "1e10 m^3/s^2");
+    set_elements(*keplerian_body,
+                 /*parent=*/absl::StrFormat("Planet%03d", m % planets),
+                 /*semimajor_axis=*/2e7 * std::pow(1.5, m / planets),
+                 /*index=*/m);
+  }
+  return SolarSystem<Barycentric>(gravity_model,
+                                  initial_state,
+                                  /*ignore_frame=*/true);
+}
+
+Ephemeris<Barycentric>::AccuracyParameters AccuracyParameters() {
+  return Ephemeris<Barycentric>::AccuracyParameters(
+      /*fitting_tolerance=*/1 * Metre,
+      /*geopotential_tolerance=*/0x1p-24);
+}
+
+Ephemeris<Barycentric>::FixedStepParameters FixedStepParameters() {
+  return Ephemeris<Barycentric>::FixedStepParameters(
+      SymmetricLinearMultistepIntegrator<
+          QuinlanTremaine1990Order12,
+          Ephemeris<Barycentric>::NewtonianMotionEquation>(),
+      /*step=*/10 * Minute);
+}
+
+}  // namespace
+
+// Constructs the ephemeris of a synthetic system and prolongs it by 30 days,
+// which is what happens when the plugin is initialized.
+void BM_SolarSystemInitializationSequential(benchmark::State& state) {
+  auto const solar_system = SyntheticSolarSystem(state.range(0));
+  Instant const t = solar_system.epoch() + 30 * Day;
+  for (auto _ : state) {
+    auto const ephemeris = solar_system.MakeEphemeris(AccuracyParameters(),
+                                                      FixedStepParameters());
+    CHECK_OK(ephemeris->Prolong(t));
+    benchmark::DoNotOptimize(ephemeris->t_max());
+  }
+}
+
+void BM_SolarSystemInitializationConcurrent(benchmark::State& state) {
+  auto const solar_system = SyntheticSolarSystem(state.range(0));
+  Instant const t = solar_system.epoch() + 30 * Day;
+  ThreadPool<void> thread_pool(
+      /*pool_size=*/std::thread::hardware_concurrency());
+  for (auto _ : state) {
+    auto const ephemeris = solar_system.MakeEphemeris(AccuracyParameters(),
+                                                      FixedStepParameters(),
+                                                      thread_pool);
+    CHECK_OK(ephemeris->Prolong(t, thread_pool));
+    benchmark::DoNotOptimize(ephemeris->t_max());
+  }
+}
+
+BENCHMARK(BM_SolarSystemInitializationSequential)
+    ->Arg(20)
+    ->Arg(60)
+    ->Arg(200)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SolarSystemInitializationConcurrent)
+    ->Arg(20)
+    ->Arg(60)
+    ->Arg(200)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace physics
+}  // namespace principia
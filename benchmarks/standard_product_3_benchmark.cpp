@@ -0,0 +1,127 @@
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=StandardProduct3  // NOLINT(whitespace/line_length)
+
+#include "astronomy/standard_product_3.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_format.h"
+#include "benchmark/benchmark.h"
+#include "glog/logging.h"
+#include "quantities/numbers.hpp"
+
+namespace principia {
+namespace astronomy {
+
+using namespace principia::astronomy::_standard_product_3;
+
+namespace {
+
+constexpr int satellites = 32;
+// Two days at 30 s intervals.
+constexpr int epochs = 2 * 24 * 60 * 2;
+
+// Writes, if needed, a synthetic SP3-c file with positions for |satellites|
+// GPS satellites on circular orbits at |epochs| epochs, and returns its path.
+std::filesystem::path const& SyntheticFile() {
+  static auto const* const path = [] {
+    auto* const path = new std::filesystem::path(
+        std::filesystem::temp_directory_path() /
+        "principia_standard_product_3_benchmark.sp3");
+    std::ofstream file(*path);
+    CHECK(file.good()) << *path;
+    file << absl::StrFormat(
+        "#cP2018  5  6  0  0  0.00000000 %7d d+D   IGS14 FIT SYNT\n", epochs);
+    file << "## 2000      0.00000000    30.00000000 58244 0.0000000000000\n";
+    for (int record = 0; record < 5; ++record) {
+      file << (record == 0 ? absl::StrFormat("+   %2d   ", satellites)
+                           : std::string("+        "));
+      for (int column = 0; column < 17; ++column) {
+        int const index = record * 17 + column + 1;
+        file << (index <= satellites ? absl::StrFormat("G%02d", index)
+                                     : std::string("  0"));
+      }
+      file << "\n";
+    }
+    for (int record = 0; record < 5; ++record) {
+      file << "++       ";
+      for (int column = 0; column < 17; ++column) {
+        file << "  0";
+      }
+      file << "\n";
+    }
+    file << "%c G  cc GPS ccc cccc cccc cccc cccc ccccc ccccc ccccc ccccc\n"
+         << "%c cc cc ccc ccc cccc cccc cccc cccc ccccc ccccc ccccc ccccc\n"
+         << "%f  1.2500000  1.025000000  0.00000000000  0.000000000000000\n"
+         << "%f  0.0000000  0.000000000  0.00000000000  0.000000000000000\n"
+         << "%i    0    0    0    0      0      0      0      0         0\n"
+         << "%i    0    0    0    0      0      0      0      0         0\n"
+         << "/* Synthetic orbits for benchmarking\n"
+         << "/*\n"
+         << "/*\n"
+         << "/*\n";
+    for (int i = 0; i < epochs; ++i) {
+      int const seconds = 30 * i;
+      file << absl::StrFormat("*  2018  5 %2d %2d %2d %2d.00000000\n",
+                              6 + seconds / 86400,
+                              seconds / 3600 % 24,
+                              seconds / 60 % 60,
+                              seconds % 60);
+      for (int s = 1; s <= satellites; ++s) {
+        double const θ = 2 * π * (seconds / 43'080.0 + s / 32.0);
+        double const r = 26'560;
+        file << absl::StrFormat("PG%02d%14.6f%14.6f%14.6f%14.6f\n",
+                                s,
+                                r * std::cos(θ),
+                                r * std::sin(θ) * std::cos(s),
+                                r * std::sin(θ) * std::sin(s),
+                                0.0);
+      }
+    }
+    file << "EOF\n";
+    CHECK(file.good()) << *path;
+    return path;
+  }();
+  return *path;
+}
+
+}  // namespace
+
+void BM_StandardProduct3Orbits(benchmark::State& state) {
+  auto const& path = SyntheticFile();
+  for (auto _ : state) {
+    StandardProduct3 const sp3(path, StandardProduct3::Dialect::Standard);
+    benchmark::DoNotOptimize(sp3.satellites());
+  }
+  state.SetItemsProcessed(state.iterations() * epochs);
+  state.SetBytesProcessed(state.iterations() *
+                          std::filesystem::file_size(path));
+}
+
+void BM_StandardProduct3Streaming(benchmark::State& state) {
+  auto const& path = SyntheticFile();
+  for (auto _ : state) {
+    std::int64_t points = 0;
+    StandardProduct3 const sp3(
+        path,
+        StandardProduct3::Dialect::Standard,
+        [&points](std::vector<StandardProduct3::SatelliteIdentifier> const&,
+                  StandardProduct3::Epoch const& epoch) {
+          points += epoch.points.size();
+        });
+    benchmark::DoNotOptimize(points);
+  }
+  state.SetItemsProcessed(state.iterations() * epochs);
+  state.SetBytesProcessed(state.iterations() *
+                          std::filesystem::file_size(path));
+}
+
+BENCHMARK(BM_StandardProduct3Orbits)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StandardProduct3Streaming)->Unit(benchmark::kMillisecond);
+
+}  // namespace astronomy
+}  // namespace principia
@@ -0,0 +1,101 @@
+// .\Release\x64\benchmarks.exe --benchmark_repetitions=3 --benchmark_filter=TimeScales  // NOLINT(whitespace/line_length)
+
+#include "astronomy/time_scales.hpp"
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "geometry/instant.hpp"
+#include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace astronomy {
+
+using namespace principia::astronomy::_time_scales;
+using namespace principia::geometry::_instant;
+using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+
+namespace {
+
+// A year of instants every 15 minutes, in increasing order, as in a time series
+// of ephemeris data.
+std::vector<Instant> const& SortedTTs() {
+  static auto const* const tts = [] {
+    auto* const tts = new std::vector<Instant>;
+    for (Instant t = "2020-01-01T00:00:00"_TT; t < "2021-01-01T00:00:00"_TT;
+         t += 15 * Minute) {
+      tts->push_back(t);
+    }
+    return tts;
+  }();
+  return *tts;
+}
+
+}  // namespace
+
+// The items are conversions, so the reported rate is in conversions per second.
+void BM_TimeScalesEarthRotationAngle(benchmark::State& state) {
+  auto const& tts = SortedTTs();
+  for (auto _ : state) {
+    for (Instant const& tt : tts) {
+      benchmark::DoNotOptimize(EarthRotationAngle(tt));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * tts.size());
+}
+
+void BM_TimeScalesConverterEarthRotationAngle(benchmark::State& state) {
+  auto const& tts = SortedTTs();
+  for (auto _ : state) {
+    TimeScaleConverter converter;
+    for (Instant const& tt : tts) {
+      benchmark::DoNotOptimize(converter.EarthRotationAngle(tt));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * tts.size());
+}
+
+void BM_TimeScalesBatchTTToUT1(benchmark::State& state) {
+  auto const& tts = SortedTTs();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(TTToUT1(tts));
+  }
+  state.SetItemsProcessed(state.iterations() * tts.size());
+}
+
+void BM_TimeScalesBatchUT1ToTT(benchmark::State& state) {
+  auto const ut1s = TTToUT1(SortedTTs());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(UT1ToTT(ut1s));
+  }
+  state.SetItemsProcessed(state.iterations() * ut1s.size());
+}
+
+void BM_TimeScalesBatchTTToUTC(benchmark::State& state) {
+  auto const& tts = SortedTTs();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(TTToUTC(tts));
+  }
+  state.SetItemsProcessed(state.iterations() * tts.size());
+}
+
+void BM_TimeScalesBatchUTCToTT(benchmark::State& state) {
+  auto const utcs = TTToUTC(SortedTTs());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(UTCToTT(utcs));
+  }
+  state.SetItemsProcessed(state.iterations() * utcs.size());
+}
+
+BENCHMARK(BM_TimeScalesEarthRotationAngle)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TimeScalesConverterEarthRotationAngle)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TimeScalesBatchTTToUT1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TimeScalesBatchUT1ToTT)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TimeScalesBatchTTToUTC)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TimeScalesBatchUTCToTT)->Unit(benchmark::kMillisecond);
+
+}  // namespace astronomy
+}  // namespace principia
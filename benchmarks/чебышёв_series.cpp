@@ -203,6 +203,95 @@ void BM_EvaluateDisplacement(benchmark::State& state) {
   state.SetLabel(ss.str().substr(0, 0));
 }
 
+// Evaluates the series at |state.range(1)| times per call.
+void BM_EvaluateDisplacementBatch(benchmark::State& state) {
+  int const degree = state.range(0);
+  int const batch_size = state.range(1);
+  std::mt19937_64 random(42);
+  std::vector<Displacement<ICRS>> coefficients;
+  for (int i = 0; i <= degree; ++i) {
+    coefficients.push_back(
+        Displacement<ICRS>({static_cast<double>(random()) * Metre,
+                            static_cast<double>(random()) * Metre,
+                            static_cast<double>(random()) * Metre}));
+  }
+  Instant const t0;
+  Instant const t_min = t0 + static_cast<double>(random()) * Second;
+  Instant const t_max = t_min + static_cast<double>(random()) * Second;
+  ЧебышёвSeries<Displacement<ICRS>> const series(coefficients, t_min, t_max);
+
+  Time const Δt = (t_max - t_min) * 1e-9;
+  std::vector<Instant> times;
+  for (int i = 0; i < batch_size; ++i) {
+    times.push_back(t_min + i * Δt);
+  }
+  std::vector<Displacement<ICRS>> values;
+  Displacement<ICRS> result{};
+
+  for (auto _ : state) {
+    for (int i = 0; i < evaluations_per_iteration / batch_size; ++i) {
+      series.Evaluate(times, &values);
+      result += values.back();
+      for (auto& t : times) {
+        t += batch_size * Δt;
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          (evaluations_per_iteration / batch_size) *
+                          batch_size);
+
+  // This weird call to |SetLabel| has no effect except that it uses |result|
+  // and therefore prevents the loop from being optimized away.
+  std::stringstream ss;
+  ss << result;
+  state.SetLabel(ss.str().substr(0, 0));
+}
+
+void BM_EvaluateDisplacementWithDerivative(benchmark::State& state) {
+  int const degree = state.range(0);
+  std::mt19937_64 random(42);
+  std::vector<Displacement<ICRS>> coefficients;
+  for (int i = 0; i <= degree; ++i) {
+    coefficients.push_back(
+        Displacement<ICRS>({static_cast<double>(random()) * Metre,
+                            static_cast<double>(random()) * Metre,
+                            static_cast<double>(random()) * Metre}));
+  }
+  Instant const t0;
+  Instant const t_min = t0 + static_cast<double>(random()) * Second;
+  Instant const t_max = t_min + static_cast<double>(random()) * Second;
+  ЧебышёвSeries<Displacement<ICRS>> const series(coefficients, t_min, t_max);
+
+  Instant t = t_min;
+  Time const Δt = (t_max - t_min) * 1e-9;
+  Displacement<ICRS> result{};
+  Velocity<ICRS> derivative_result{};
+
+  for (auto _ : state) {
+    for (int i = 0; i < evaluations_per_iteration; ++i) {
+      auto const [value, derivative] = series.EvaluateWithDerivative(t);
+      result += value;
+      derivative_result += derivative;
+      t += Δt;
+    }
+  }
+
+  // This weird call to |SetLabel| has no effect except that it uses |result|
+  // and therefore prevents the loop from being optimized away.
+  std::stringstream ss;
+  ss << result << derivative_result;
+  state.SetLabel(ss.str().substr(0, 0));
+}
+
+void DegreesAndBatchSizes(benchmark::internal::Benchmark* const benchmark) {
+  for (int degree = 8; degree <= 17; ++degree) {
+    for (int const batch_size : {1, 4, 64}) {
+      benchmark->ArgPair(degree, batch_size);
+    }
+  }
+}
+
 BENCHMARK(BM_EvaluateDouble)
     ->Arg(4)
     ->Arg(8)
@@ -248,6 +337,12 @@ BENCHMARK(BM_EvaluateDisplacement)
     ->Arg(18)
     ->Arg(19)
     ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_EvaluateDisplacementBatch)
+    ->Apply(DegreesAndBatchSizes)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_EvaluateDisplacementWithDerivative)
+    ->DenseRange(8, 17)
+    ->Unit(benchmark::kMicrosecond);
 
 }  // namespace numerics
 }  // namespace principia
@@ -32,6 +32,7 @@
 #include "base/pull_serializer.hpp"
 #include "base/push_deserializer.hpp"
 #include "base/serialization.hpp"
+#include "base/snapshot.hpp"
 #include "base/version.hpp"
 #include "gipfeli/gipfeli.h"
 #include "geometry/frame.hpp"
@@ -77,6 +78,7 @@ using namespace principia::base::_not_null;
 using namespace principia::base::_pull_serializer;
 using namespace principia::base::_push_deserializer;
 using namespace principia::base::_serialization;
+using namespace principia::base::_snapshot;
 using namespace principia::base::_version;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
@@ -118,6 +120,10 @@ constexpr char hexadecimal_encoder[] = "hexadecimal";
 
 constexpr int chunk_size = 64 << 10;
 constexpr int number_of_chunks = 8;
+// The number of threads used to compress or uncompress the chunks in parallel
+// with (de)serialization.  Must be less than |number_of_chunks| for the
+// pipeline to be full.
+constexpr int number_of_compression_threads = 4;
 
 not_null<Arena*> arena = []() {
   ArenaOptions options;
@@ -279,6 +285,40 @@ std::unique_ptr<google::compression::Compressor> NewCompressor(
   }
 }
 
+// In the presence of compression, the chunks are compressed and uncompressed
+// in parallel.
+PullSerializer* NewPullSerializer(std::string_view const compressor) {
+  if (compressor.empty()) {
+    return new PullSerializer(chunk_size,
+                              number_of_chunks,
+                              /*compressor=*/nullptr);
+  } else {
+    return new PullSerializer(
+        chunk_size,
+        number_of_chunks,
+        number_of_compression_threads,
+        [compressor = std::string(compressor)]() {
+          return NewCompressor(compressor);
+        });
+  }
+}
+
+PushDeserializer* NewPushDeserializer(std::string_view const compressor) {
+  if (compressor.empty()) {
+    return new PushDeserializer(chunk_size,
+                                number_of_chunks,
+                                /*compressor=*/nullptr);
+  } else {
+    return new PushDeserializer(
+        chunk_size,
+        number_of_chunks,
+        number_of_compression_threads,
+        [compressor = std::string(compressor)]() {
+          return NewCompressor(compressor);
+        });
+  }
+}
+
 Encoder<char, /*null_terminated=*/true>*
 NewEncoder(std::string_view const encoder) {
   if (encoder == hexadecimal_encoder) {
@@ -294,6 +334,12 @@ NewEncoder(std::string_view const encoder) {
   }
 }
 
+// Paths are passed as UTF-8 strings by the adapter.
+std::filesystem::path PathFromUTF8(char const* const path) {
+  return std::filesystem::path(
+      std::u8string(reinterpret_cast<char8_t const*>(path)));
+}
+
 }  // namespace
 
 void __cdecl principia__ActivatePlayer() {
@@ -463,6 +509,29 @@ void __cdecl principia__ClearWorldRotationalReferenceFrame(
   return m.Return();
 }
 
+// Applies the delta snapshot at |delta_path| to the full snapshot at
+// |base_path| and writes the resulting full snapshot at |path|.  All paths are
+// UTF-8 strings, and |path| must differ from the other two.
+void __cdecl principia__CompactPluginSnapshots(char const* const base_path,
+                                               char const* const delta_path,
+                                               char const* const path) {
+  journal::Method<journal::CompactPluginSnapshots> m(
+      {base_path, delta_path, path});
+  CHECK_NOTNULL(base_path);
+  CHECK_NOTNULL(delta_path);
+  CHECK_NOTNULL(path);
+  LOG(INFO) << "Begin compaction of snapshots " << base_path << " and "
+            << delta_path << " into " << path;
+  {
+    SnapshotReader const base(PathFromUTF8(base_path));
+    SnapshotReader const delta(PathFromUTF8(delta_path));
+    SnapshotWriter snapshot(PathFromUTF8(path));
+    Plugin::CompactSnapshots(base, delta, &snapshot);
+  }
+  LOG(INFO) << "End compaction of snapshots";
+  return m.Return();
+}
+
 double __cdecl principia__CurrentTime(Plugin const* const plugin) {
   journal::Method<journal::CurrentTime> m({plugin});
   CHECK_NOTNULL(plugin);
@@ -537,9 +606,7 @@ void __cdecl principia__DeserializePlugin(
   // Create and start a deserializer if the caller didn't provide one.
   if (*deserializer == nullptr) {
     LOG(INFO) << "Begin plugin deserialization";
-    *deserializer = new PushDeserializer(chunk_size,
-                                         number_of_chunks,
-                                         NewCompressor(compressor));
+    *deserializer = NewPushDeserializer(compressor);
     CHECK_NOTNULL(arena);
     not_null<serialization::Plugin*> const message =
         Arena::CreateMessage<serialization::Plugin>(arena);
@@ -567,6 +634,38 @@ void __cdecl principia__DeserializePlugin(
   return m.Return();
 }
 
+// Reads a plugin from the snapshot at |path|, which is a UTF-8 string.  The
+// caller takes ownership of the result, which is not null.
+Plugin const* __cdecl principia__DeserializePluginFromSnapshot(
+    char const* const path) {
+  journal::Method<journal::DeserializePluginFromSnapshot> m({path});
+  CHECK_NOTNULL(path);
+  LOG(INFO) << "Begin plugin deserialization from snapshot " << path;
+  SnapshotReader const snapshot(PathFromUTF8(path));
+  auto plugin = Plugin::ReadFromSnapshot(snapshot);
+  LOG(INFO) << "End plugin deserialization from snapshot";
+  return m.Return(plugin.release());
+}
+
+// Reads a plugin from the full snapshot at |base_path| updated by the delta
+// snapshot at |delta_path|.  Both paths are UTF-8 strings.  The caller takes
+// ownership of the result, which is not null.
+Plugin const* __cdecl principia__DeserializePluginFromSnapshots(
+    char const* const base_path,
+    char const* const delta_path) {
+  journal::Method<journal::DeserializePluginFromSnapshots> m(
+      {base_path, delta_path});
+  CHECK_NOTNULL(base_path);
+  CHECK_NOTNULL(delta_path);
+  LOG(INFO) << "Begin plugin deserialization from snapshots " << base_path
+            << " and " << delta_path;
+  SnapshotReader const base(PathFromUTF8(base_path));
+  SnapshotReader const delta(PathFromUTF8(delta_path));
+  auto plugin = Plugin::ReadFromSnapshot(base, delta);
+  LOG(INFO) << "End plugin deserialization from snapshots";
+  return m.Return(plugin.release());
+}
+
 // Calls |plugin->EndInitialization|.
 // |plugin| must not be null.  No transfer of ownership.
 void __cdecl principia__EndInitialization(Plugin* const plugin) {
@@ -636,6 +735,14 @@ bool __cdecl principia__HasEncounteredApocalypse(
   return m.Return(has_encountered_apocalypse);
 }
 
+// Whether a delta snapshot may be written for |plugin|.  |plugin| must not be
+// null.  No transfer of ownership.
+bool __cdecl principia__HasSnapshotBase(Plugin const* const plugin) {
+  journal::Method<journal::HasSnapshotBase> m({plugin});
+  CHECK_NOTNULL(plugin);
+  return m.Return(plugin->HasSnapshotBase());
+}
+
 bool __cdecl principia__HasVessel(Plugin* const plugin,
                                   char const* const vessel_guid) {
   journal::Method<journal::HasVessel> m({plugin,  vessel_guid});
@@ -1065,9 +1172,7 @@ char const* __cdecl principia__SerializePlugin(
   // Create and start a serializer if the caller didn't provide one.
   if (*serializer == nullptr) {
     LOG(INFO) << "Begin plugin serialization";
-    *serializer = new PullSerializer(chunk_size,
-                                     number_of_chunks,
-                                     NewCompressor(compressor));
+    *serializer = NewPullSerializer(compressor);
     not_null<serialization::Plugin*> const message =
         Arena::CreateMessage<serialization::Plugin>(arena);
     plugin->WriteToMessage(message);
@@ -1111,6 +1216,88 @@ char const* __cdecl principia__SerializePlugin(
   return m.Return(hexadecimal.data.release());
 }
 
+// Writes to a snapshot at |path| the changes to |plugin| since its base
+// snapshot.  |path| is a UTF-8 string.  Any existing file at |path| is
+// replaced.  |plugin| must not be null and must have a base.  No transfer of
+// ownership.
+void __cdecl principia__SerializePluginDeltaToSnapshot(
+    Plugin const* const plugin,
+    char const* const path) {
+  journal::Method<journal::SerializePluginDeltaToSnapshot> m({plugin, path});
+  CHECK_NOTNULL(plugin);
+  CHECK_NOTNULL(path);
+  LOG(INFO) << "Begin plugin delta serialization to snapshot " << path;
+  SnapshotWriter snapshot(PathFromUTF8(path));
+  plugin->WriteDeltaToSnapshot(&snapshot);
+  snapshot.Close();
+  LOG(INFO) << "End plugin delta serialization to snapshot";
+  return m.Return();
+}
+
+// Same as |principia__SerializePlugin|, but the chunks are not encoded: they
+// are copied to the caller-owned buffer |bytes|, and the result is the number
+// of bytes written, which is 0 at the end of the stream.  |bytes_size| must be
+// at least 128 KiB, which is larger than any (possibly compressed) chunk.  This
+// avoids encoding, allocating and marshaling a string for callers that can
+// handle binary data.
+int __cdecl principia__SerializePluginToBytes(
+    Plugin const* const plugin,
+    PullSerializer** const serializer,
+    char const* const compressor,
+    std::uint8_t* const bytes,
+    int const bytes_size) {
+  journal::Method<journal::SerializePluginToBytes> m({plugin,
+                                                      serializer,
+                                                      compressor,
+                                                      bytes,
+                                                      bytes_size},
+                                                     {serializer});
+  CHECK_NOTNULL(plugin);
+  CHECK_NOTNULL(serializer);
+  CHECK_NOTNULL(bytes);
+
+  // Create and start a serializer if the caller didn't provide one.
+  if (*serializer == nullptr) {
+    LOG(INFO) << "Begin plugin serialization to bytes";
+    *serializer = NewPullSerializer(compressor);
+    not_null<serialization::Plugin*> const message =
+        Arena::CreateMessage<serialization::Plugin>(arena);
+    plugin->WriteToMessage(message);
+    (*serializer)->Start(message);
+  }
+
+  // Pull a chunk.
+  Array<std::uint8_t> const chunk = (*serializer)->Pull();
+
+  // If this is the end of the serialization, delete the serializer.
+  if (chunk.size == 0) {
+    LOG(INFO) << "End plugin serialization to bytes";
+    TakeOwnership(serializer);
+    arena->Reset();
+    return m.Return(0);
+  }
+
+  CHECK_LE(chunk.size, bytes_size) << "Buffer too small";
+  std::memcpy(bytes, chunk.data, chunk.size);
+  return m.Return(chunk.size);
+}
+
+// Writes |plugin| to a snapshot at |path|, which is a UTF-8 string.  Any
+// existing file at |path| is replaced.  |plugin| must not be null.  No transfer
+// of ownership.
+void __cdecl principia__SerializePluginToSnapshot(Plugin* const plugin,
+                                                  char const* const path) {
+  journal::Method<journal::SerializePluginToSnapshot> m({plugin, path});
+  CHECK_NOTNULL(plugin);
+  CHECK_NOTNULL(path);
+  LOG(INFO) << "Begin plugin serialization to snapshot " << path;
+  SnapshotWriter snapshot(PathFromUTF8(path));
+  plugin->WriteToSnapshot(&snapshot);
+  snapshot.Close();
+  LOG(INFO) << "End plugin serialization to snapshot";
+  return m.Return();
+}
+
 // Sets the maximum number of seconds which logs may be buffered for.
 void __cdecl principia__SetBufferDuration(int const seconds) {
   journal::Method<journal::SetBufferDuration> m({seconds});
@@ -1133,6 +1320,16 @@ void __cdecl principia__SetFlag(char const* const name,
   return m.Return();
 }
 
+// Calls |plugin->SetGroupedFixedStep| with the arguments given.  |plugin| must
+// not be null.  No transfer of ownership.
+void __cdecl principia__SetGroupedFixedStep(Plugin* const plugin,
+                                            bool const enabled) {
+  journal::Method<journal::SetGroupedFixedStep> m({plugin, enabled});
+  CHECK_NOTNULL(plugin);
+  plugin->SetGroupedFixedStep(enabled);
+  return m.Return();
+}
+
 void __cdecl principia__SetMainBody(Plugin* const plugin, int const index) {
   journal::Method<journal::SetMainBody> m({plugin, index});
   CHECK_NOTNULL(plugin);
@@ -1140,6 +1337,16 @@ void __cdecl principia__SetMainBody(Plugin* const plugin, int const index) {
   return m.Return();
 }
 
+// Calls |plugin->SetPipelinedTimeStep| with the arguments given.  |plugin|
+// must not be null.  No transfer of ownership.
+void __cdecl principia__SetPipelinedTimeStep(Plugin* const plugin,
+                                             bool const enabled) {
+  journal::Method<journal::SetPipelinedTimeStep> m({plugin, enabled});
+  CHECK_NOTNULL(plugin);
+  plugin->SetPipelinedTimeStep(enabled);
+  return m.Return();
+}
+
 // Make it so that all log messages of at least |min_severity| are logged to
 // stderr (in addition to logging to the usual log file(s)).
 void __cdecl principia__SetStderrLogging(int const min_severity) {
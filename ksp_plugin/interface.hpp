@@ -93,6 +93,7 @@ bool operator==(OrbitAnalysis const& left, OrbitAnalysis const& right);
 bool operator==(OrbitRecurrence const& left, OrbitRecurrence const& right);
 bool operator==(OrbitalElements const& left, OrbitalElements const& right);
 bool operator==(QP const& left, QP const& right);
+bool operator==(QPT const& left, QPT const& right);
 bool operator==(QPRW const& left, QPRW const& right);
 bool operator==(SolarTimesOfNodes const& left, SolarTimesOfNodes const& right);
 bool operator==(WXYZ const& left, WXYZ const& right);
@@ -258,6 +258,10 @@ inline bool operator==(QP const& left, QP const& right) {
   return left.q == right.q && left.p == right.p;
 }
 
+inline bool operator==(QPT const& left, QPT const& right) {
+  return left.qp == right.qp && left.t == right.t;
+}
+
 inline bool operator==(QPRW const& left, QPRW const& right) {
   return left.qp == right.qp && left.r == right.r && left.w == right.w;
 }
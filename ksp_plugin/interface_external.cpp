@@ -2,6 +2,7 @@
 
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -35,6 +36,26 @@ Status* OK() {
   return ok;
 }
 
+// The |World| degrees of freedom used by the external interface are
+// body-centred inertial, so they are given in |body_centred_inertial| up to an
+// orthogonal map to world coordinates.  Returns that map.
+// NOTE(egg): it is correct to use the orthogonal map at the current time,
+// because |body_centred_inertial| does not rotate with respect to
+// |Barycentric|, so the orthogonal map does not depend on time.
+RigidMotion<Navigation, World> ToWorldBodyCentredInertial(
+    Plugin const& plugin,
+    NavigationFrame const& body_centred_inertial) {
+  return RigidMotion<Navigation, World>(
+      RigidTransformation<Navigation, World>(
+          Navigation::origin,
+          World::origin,
+          plugin.renderer().BarycentricToWorld(plugin.PlanetariumRotation()) *
+              body_centred_inertial.FromThisFrameAtTime(
+                  plugin.CurrentTime()).orthogonal_map()),
+      Navigation::nonrotating,
+      Navigation::unmoving);
+}
+
 }  // namespace
 
 Status* __cdecl principia__ExternalCelestialGetPosition(
@@ -146,8 +167,97 @@ Status* __cdecl principia__ExternalFlowFreefall(
     return m.Return(
         ToNewStatus(absl::InvalidArgumentError("|plugin| must not be null")));
   }
-  return m.Return(ToNewStatus(absl::UnimplementedError(
-      "|ExternalFlowFreefall| is not yet implemented")));
+  if (!plugin->HasCelestial(central_body_index)) {
+    return m.Return(ToNewStatus(
+        absl::NotFoundError(
+            absl::StrCat("No celestial with index ", central_body_index))));
+  }
+  auto const body_centred_inertial =
+      plugin->NewBodyCentredNonRotatingNavigationFrame(central_body_index);
+  auto const to_world_body_centred_inertial =
+      ToWorldBodyCentredInertial(*plugin, *body_centred_inertial);
+  auto const final_degrees_of_freedom = plugin->FlowFreefall(
+      *body_centred_inertial,
+      to_world_body_centred_inertial.Inverse()(FromQP<DegreesOfFreedom<World>>(
+          world_body_centred_initial_degrees_of_freedom)),
+      FromGameTime(*plugin, t_initial),
+      FromGameTime(*plugin, t_final));
+  if (!final_degrees_of_freedom.ok()) {
+    return m.Return(ToNewStatus(final_degrees_of_freedom.status()));
+  }
+  *world_body_centred_final_degrees_of_freedom =
+      ToQP(to_world_body_centred_inertial(*final_degrees_of_freedom));
+  return m.Return(OK());
+}
+
+Status* __cdecl principia__ExternalFlowFreefalls(
+    Plugin const* const plugin,
+    int const central_body_index,
+    QPT* const initial_states,
+    int const initial_states_size,
+    double const t_final,
+    QP* const final_degrees_of_freedom,
+    int const final_degrees_of_freedom_size) {
+  journal::Method<journal::ExternalFlowFreefalls> m(
+      {plugin,
+       central_body_index,
+       initial_states,
+       initial_states_size,
+       t_final,
+       final_degrees_of_freedom,
+       final_degrees_of_freedom_size});
+  if (plugin == nullptr) {
+    return m.Return(
+        ToNewStatus(absl::InvalidArgumentError("|plugin| must not be null")));
+  }
+  if (!plugin->HasCelestial(central_body_index)) {
+    return m.Return(ToNewStatus(
+        absl::NotFoundError(
+            absl::StrCat("No celestial with index ", central_body_index))));
+  }
+  if (final_degrees_of_freedom_size < initial_states_size) {
+    return m.Return(ToNewStatus(
+        absl::InvalidArgumentError(
+            absl::StrCat("Cannot write ", initial_states_size,
+                         " results to an array of size ",
+                         final_degrees_of_freedom_size))));
+  }
+  auto const body_centred_inertial =
+      plugin->NewBodyCentredNonRotatingNavigationFrame(central_body_index);
+  auto const to_world_body_centred_inertial =
+      ToWorldBodyCentredInertial(*plugin, *body_centred_inertial);
+  auto const from_world_body_centred_inertial =
+      to_world_body_centred_inertial.Inverse();
+
+  std::vector<DegreesOfFreedom<Navigation>> initial_degrees_of_freedom;
+  std::vector<Instant> t_initial;
+  initial_degrees_of_freedom.reserve(initial_states_size);
+  t_initial.reserve(initial_states_size);
+  for (int i = 0; i < initial_states_size; ++i) {
+    QPT const& initial_state = initial_states[i];
+    initial_degrees_of_freedom.push_back(from_world_body_centred_inertial(
+        FromQP<DegreesOfFreedom<World>>(initial_state.qp)));
+    t_initial.push_back(FromGameTime(*plugin, initial_state.t));
+  }
+  auto const results = plugin->FlowFreefalls(*body_centred_inertial,
+                                           initial_degrees_of_freedom,
+                                           t_initial,
+                                           FromGameTime(*plugin, t_final));
+
+  // All the successful results are written, but the status is that of the
+  // first failure, if any.
+  absl::Status status;
+  for (int i = 0; i < results.size(); ++i) {
+    if (results[i].ok()) {
+      final_degrees_of_freedom[i] =
+          ToQP(to_world_body_centred_inertial(*results[i]));
+    } else if (status.ok()) {
+      status = absl::Status(
+          results[i].status().code(),
+          absl::StrCat("Problem ", i, ": ", results[i].status().message()));
+    }
+  }
+  return m.Return(status.ok() ? OK() : ToNewStatus(status));
 }
 
 Status* __cdecl principia__ExternalGeopotentialGetCoefficient(
@@ -290,22 +400,8 @@ Status* __cdecl principia__ExternalGetNearestPlannedCoastDegreesOfFreedom(
         .IgnoreError();
   }
 
-  Instant const current_time = plugin->CurrentTime();
-  // The given |World| position and requested |World| degrees of freedom are
-  // body-centred inertial, so |body_centred_inertial| up to an orthogonal map
-  // to world coordinates.  Do the conversion directly.
-  // NOTE(egg): it is correct to use the orthogonal map at |current_time|,
-  // because |body_centred_inertial| does not rotate with respect to
-  // |Barycentric|, so the orthogonal map does not depend on time.
-  RigidMotion<Navigation, World> to_world_body_centred_inertial(
-      RigidTransformation<Navigation, World>(
-          Navigation::origin,
-          World::origin,
-          plugin->renderer().BarycentricToWorld(plugin->PlanetariumRotation()) *
-              body_centred_inertial->FromThisFrameAtTime(
-                  current_time).orthogonal_map()),
-      Navigation::nonrotating,
-      Navigation::unmoving);
+  auto const to_world_body_centred_inertial =
+      ToWorldBodyCentredInertial(*plugin, *body_centred_inertial);
   auto const from_world_body_centred_inertial =
       to_world_body_centred_inertial.Inverse();
   Position<Navigation> reference_position =
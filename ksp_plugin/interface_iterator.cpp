@@ -47,6 +47,35 @@ QP __cdecl principia__IteratorGetDiscreteTrajectoryQP(
       }));
 }
 
+int __cdecl principia__IteratorGetDiscreteTrajectoryQPTs(
+    Iterator* const iterator,
+    int const decimation,
+    XYZ const* const origin,
+    QPT* const points,
+    int const points_size) {
+  journal::Method<journal::IteratorGetDiscreteTrajectoryQPTs> m(
+      {iterator, decimation, origin, points, points_size});
+  CHECK_NOTNULL(iterator);
+  auto const typed_iterator = check_not_null(
+      dynamic_cast<TypedIterator<DiscreteTrajectory<World>>*>(iterator));
+  auto const plugin = typed_iterator->plugin();
+  Displacement<World> const origin_displacement =
+      origin == nullptr ? Displacement<World>()
+                        : FromXYZ<Position<World>>(*origin) - World::origin;
+  return m.Return(typed_iterator->Get<QPT>(
+      decimation,
+      [origin_displacement,
+       plugin](DiscreteTrajectory<World>::iterator const& iterator) -> QPT {
+        auto const& [time, degrees_of_freedom] = *iterator;
+        return {ToQP(DegreesOfFreedom<World>(
+                    degrees_of_freedom.position() - origin_displacement,
+                    degrees_of_freedom.velocity())),
+                ToGameTime(*plugin, time)};
+      },
+      points,
+      points_size));
+}
+
 double __cdecl principia__IteratorGetDiscreteTrajectoryTime(
     Iterator const* const iterator) {
   journal::Method<journal::IteratorGetDiscreteTrajectoryTime> m({iterator});
@@ -72,6 +101,31 @@ XYZ __cdecl principia__IteratorGetDiscreteTrajectoryXYZ(
       }));
 }
 
+int __cdecl principia__IteratorGetDiscreteTrajectoryXYZs(
+    Iterator* const iterator,
+    int const decimation,
+    XYZ const* const origin,
+    XYZ* const points,
+    int const points_size) {
+  journal::Method<journal::IteratorGetDiscreteTrajectoryXYZs> m(
+      {iterator, decimation, origin, points, points_size});
+  CHECK_NOTNULL(iterator);
+  auto const typed_iterator = check_not_null(
+      dynamic_cast<TypedIterator<DiscreteTrajectory<World>>*>(iterator));
+  Displacement<World> const origin_displacement =
+      origin == nullptr ? Displacement<World>()
+                        : FromXYZ<Position<World>>(*origin) - World::origin;
+  return m.Return(typed_iterator->Get<XYZ>(
+      decimation,
+      [origin_displacement](
+          DiscreteTrajectory<World>::iterator const& iterator) -> XYZ {
+        return ToXYZ(iterator->degrees_of_freedom.position() -
+                     origin_displacement);
+      },
+      points,
+      points_size));
+}
+
 Iterator* __cdecl principia__IteratorGetRP2LinesIterator(
     Iterator const* const iterator) {
   journal::Method<journal::IteratorGetRP2LinesIterator> m({iterator});
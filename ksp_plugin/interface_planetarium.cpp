@@ -1,7 +1,10 @@
 #include "ksp_plugin/interface.hpp"
 
 #include <algorithm>
+#include <future>
 #include <limits>
+#include <utility>
+#include <vector>
 
 #include "geometry/affine_map.hpp"
 #include "geometry/grassmann.hpp"
@@ -39,6 +42,207 @@ using namespace principia::physics::_discrete_trajectory;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
+namespace {
+
+// The values of |PlotRequest::trajectory|.
+enum PlotRequestTrajectory : int {
+  PSYCHOHISTORY = 0,
+  PREDICTION = 1,
+  FLIGHT_PLAN_SEGMENT = 2,
+  CELESTIAL_PAST_TRAJECTORY = 3,
+  CELESTIAL_FUTURE_TRAJECTORY = 4,
+};
+
+// The functions below are shared by the plotting entry points.  Each of them
+// writes at most |vertices_size| vertices at |vertices| and sets
+// |vertex_count|.  They only read the state of the plugin, so they may run
+// concurrently.  The reanimations, on the other hand, must be requested from
+// the main thread, before plotting.
+
+void RequestPsychohistoryReanimation(Plugin const& plugin,
+                                     char const* const vessel_guid,
+                                     double const max_history_length) {
+  // The psychohistory is not plotted when there is a target vessel.
+  if (!plugin.renderer().HasTargetVessel()) {
+    // Since we would want to plot starting |max_history_length| before the
+    // present, ask the reanimator to reconstruct the past.  That may take a
+    // while, during which time the history will be shorter than desired.
+    plugin.GetVessel(vessel_guid)
+        ->RequestReanimation(plugin.CurrentTime() -
+                             max_history_length * Second);
+  }
+}
+
+void RequestCelestialPastTrajectoryReanimation(
+    Plugin const& plugin,
+    double const max_history_length) {
+  // The past is not plotted when there is a target vessel.
+  if (!plugin.renderer().HasTargetVessel()) {
+    // Same as above.
+    plugin.RequestReanimation(plugin.CurrentTime() -
+                              max_history_length * Second);
+  }
+}
+
+void PlotFlightPlanSegment(Planetarium const& planetarium,
+                           Plugin const& plugin,
+                           char const* const vessel_guid,
+                           int const index,
+                           ScaledSpacePoint* const vertices,
+                           int const vertices_size,
+                           int& vertex_count) {
+  vertex_count = 0;
+  Vessel const& vessel = *plugin.GetVessel(vessel_guid);
+  CHECK(vessel.has_flight_plan()) << vessel_guid;
+  auto const segment = vessel.flight_plan().GetSegment(index);
+  // TODO(egg): this is ugly; we should centralize rendering.
+  // If this is a burn and we cannot render the beginning of the burn, we
+  // render none of it, otherwise we try to render the Frenet trihedron at the
+  // start and we fail.
+  if (index % 2 == 0 ||
+      segment->empty() ||
+      segment->front().time >= plugin.renderer().GetPlottingFrame()->t_min()) {
+    planetarium.PlotMethod3(
+        *segment, segment->begin(), segment->end(),
+        plugin.CurrentTime(),
+        /*reverse=*/false,
+        [vertices, &vertex_count](ScaledSpacePoint const& vertex) {
+          vertices[vertex_count++] = vertex;
+        },
+        vertices_size);
+  }
+}
+
+void PlotPrediction(Planetarium const& planetarium,
+                    Plugin const& plugin,
+                    char const* const vessel_guid,
+                    ScaledSpacePoint* const vertices,
+                    int const vertices_size,
+                    int& vertex_count) {
+  vertex_count = 0;
+  auto const prediction = plugin.GetVessel(vessel_guid)->prediction();
+  planetarium.PlotMethod3(
+      *prediction, prediction->begin(), prediction->end(),
+      plugin.CurrentTime(),
+      /*reverse=*/false,
+      [vertices, &vertex_count](ScaledSpacePoint const& vertex) {
+        vertices[vertex_count++] = vertex;
+      },
+      vertices_size);
+}
+
+void PlotPsychohistory(Planetarium const& planetarium,
+                       Plugin const& plugin,
+                       char const* const vessel_guid,
+                       double const max_history_length,
+                       ScaledSpacePoint* const vertices,
+                       int const vertices_size,
+                       int& vertex_count) {
+  vertex_count = 0;
+
+  // Do not plot the psychohistory when there is a target vessel as it is
+  // misleading.
+  if (plugin.renderer().HasTargetVessel()) {
+    return;
+  }
+  auto const vessel = plugin.GetVessel(vessel_guid);
+  auto const& trajectory = vessel->trajectory();
+  auto const& psychohistory = vessel->psychohistory();
+
+  Instant const desired_first_time =
+      plugin.CurrentTime() - max_history_length * Second;
+  planetarium.PlotMethod3(
+      trajectory,
+      trajectory.lower_bound(desired_first_time),
+      psychohistory->end(),
+      /*now=*/plugin.CurrentTime(),
+      /*reverse=*/true,
+      [vertices, &vertex_count](ScaledSpacePoint const& vertex) {
+        vertices[vertex_count++] = vertex;
+      },
+      vertices_size);
+}
+
+void PlotCelestialPastTrajectory(Planetarium const& planetarium,
+                                 Plugin const& plugin,
+                                 int const celestial_index,
+                                 double const max_history_length,
+                                 ScaledSpacePoint* const vertices,
+                                 int const vertices_size,
+                                 double& minimal_distance_from_camera,
+                                 int& vertex_count) {
+  vertex_count = 0;
+
+  // Do not plot the past when there is a target vessel as it is misleading.
+  if (plugin.renderer().HasTargetVessel()) {
+    minimal_distance_from_camera = std::numeric_limits<double>::infinity();
+    return;
+  }
+  auto const& celestial_trajectory =
+      plugin.GetCelestial(celestial_index).trajectory();
+  Instant const desired_first_time =
+      plugin.CurrentTime() - max_history_length * Second;
+  Instant const first_time =
+      std::max(desired_first_time, celestial_trajectory.t_min());
+  Length minimal_distance;
+  planetarium.PlotMethod3(
+      celestial_trajectory,
+      first_time,
+      /*last_time=*/plugin.CurrentTime(),
+      /*now=*/plugin.CurrentTime(),
+      /*reverse=*/true,
+      [vertices, &vertex_count](ScaledSpacePoint const& vertex) {
+        vertices[vertex_count++] = vertex;
+      },
+      vertices_size,
+      &minimal_distance);
+  minimal_distance_from_camera = minimal_distance / Metre;
+}
+
+void PlotCelestialFutureTrajectory(Planetarium const& planetarium,
+                                   Plugin const& plugin,
+                                   int const celestial_index,
+                                   char const* const vessel_guid,
+                                   ScaledSpacePoint* const vertices,
+                                   int const vertices_size,
+                                   double& minimal_distance_from_camera,
+                                   int& vertex_count) {
+  vertex_count = 0;
+
+  // Do not plot the past when there is a target vessel as it is misleading.
+  // TODO(egg): This is the future, not the past!
+  if (plugin.renderer().HasTargetVessel()) {
+    minimal_distance_from_camera = std::numeric_limits<double>::infinity();
+    return;
+  }
+  auto const& vessel = *plugin.GetVessel(vessel_guid);
+  Instant const prediction_final_time = vessel.prediction()->t_max();
+  Instant const final_time =
+      vessel.has_flight_plan()
+          ? std::max(vessel.flight_plan().actual_final_time(),
+                     prediction_final_time)
+          : prediction_final_time;
+  auto const& celestial_trajectory =
+      plugin.GetCelestial(celestial_index).trajectory();
+  // No need to request reanimation here because the current time of the
+  // plugin is necessarily covered.
+  Length minimal_distance;
+  planetarium.PlotMethod3(
+      celestial_trajectory,
+      /*first_time=*/plugin.CurrentTime(),
+      /*last_time=*/final_time,
+      /*now=*/plugin.CurrentTime(),
+      /*reverse=*/false,
+      [vertices, &vertex_count](ScaledSpacePoint const& vertex) {
+        vertices[vertex_count++] = vertex;
+      },
+      vertices_size,
+      &minimal_distance);
+  minimal_distance_from_camera = minimal_distance / Metre;
+}
+
+}  // namespace
+
 Planetarium* __cdecl principia__PlanetariumCreate(
     Plugin const* const plugin,
     XYZ const sun_world_position,
@@ -136,27 +340,13 @@ void __cdecl principia__PlanetariumPlotFlightPlanSegment(
       {vertex_count});
   CHECK_NOTNULL(plugin);
   CHECK_NOTNULL(planetarium);
-  *vertex_count = 0;
-
-  Vessel const& vessel = *plugin->GetVessel(vessel_guid);
-  CHECK(vessel.has_flight_plan()) << vessel_guid;
-  auto const segment = vessel.flight_plan().GetSegment(index);
-  // TODO(egg): this is ugly; we should centralize rendering.
-  // If this is a burn and we cannot render the beginning of the burn, we
-  // render none of it, otherwise we try to render the Frenet trihedron at the
-  // start and we fail.
-  if (index % 2 == 0 ||
-      segment->empty() ||
-      segment->front().time >= plugin->renderer().GetPlottingFrame()->t_min()) {
-    planetarium->PlotMethod3(
-        *segment, segment->begin(), segment->end(),
-        plugin->CurrentTime(),
-        /*reverse=*/false,
-        [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-          vertices[(*vertex_count)++] = vertex;
-        },
-        vertices_size);
-  }
+  PlotFlightPlanSegment(*planetarium,
+                        *plugin,
+                        vessel_guid,
+                        index,
+                        vertices,
+                        vertices_size,
+                        *vertex_count);
   return m.Return();
 }
 
@@ -174,17 +364,12 @@ void __cdecl principia__PlanetariumPlotPrediction(
       {vertex_count});
   CHECK_NOTNULL(plugin);
   CHECK_NOTNULL(planetarium);
-  *vertex_count = 0;
-
-  auto const prediction = plugin->GetVessel(vessel_guid)->prediction();
-  planetarium->PlotMethod3(
-      *prediction, prediction->begin(), prediction->end(),
-      plugin->CurrentTime(),
-      /*reverse=*/false,
-      [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-        vertices[(*vertex_count)++] = vertex;
-      },
-      vertices_size);
+  PlotPrediction(*planetarium,
+                 *plugin,
+                 vessel_guid,
+                 vertices,
+                 vertices_size,
+                 *vertex_count);
   return m.Return();
 }
 
@@ -210,37 +395,15 @@ void __cdecl principia__PlanetariumPlotPsychohistory(
       {vertex_count});
   CHECK_NOTNULL(plugin);
   CHECK_NOTNULL(planetarium);
-  *vertex_count = 0;
-
-  // Do not plot the psychohistory when there is a target vessel as it is
-  // misleading.
-  if (plugin->renderer().HasTargetVessel()) {
-    return m.Return();
-  } else {
-    auto const vessel = plugin->GetVessel(vessel_guid);
-    auto const& trajectory = vessel->trajectory();
-    auto const& psychohistory = vessel->psychohistory();
-
-    Instant const desired_first_time =
-        plugin->CurrentTime() - max_history_length * Second;
-
-    // Since we would want to plot starting from |desired_first_time|, ask the
-    // reanimator to reconstruct the past.  That may take a while, during which
-    // time the history will be shorter than desired.
-    vessel->RequestReanimation(desired_first_time);
-
-    planetarium->PlotMethod3(
-        trajectory,
-        trajectory.lower_bound(desired_first_time),
-        psychohistory->end(),
-        /*now=*/plugin->CurrentTime(),
-        /*reverse=*/true,
-        [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-          vertices[(*vertex_count)++] = vertex;
-        },
-        vertices_size);
-    return m.Return();
-  }
+  RequestPsychohistoryReanimation(*plugin, vessel_guid, max_history_length);
+  PlotPsychohistory(*planetarium,
+                    *plugin,
+                    vessel_guid,
+                    max_history_length,
+                    vertices,
+                    vertices_size,
+                    *vertex_count);
+  return m.Return();
 }
 
 // Fills the array of size |vertices_size| at |vertices| with vertices for the
@@ -266,40 +429,16 @@ void __cdecl principia__PlanetariumPlotCelestialPastTrajectory(
       {minimal_distance_from_camera, vertex_count});
   CHECK_NOTNULL(plugin);
   CHECK_NOTNULL(planetarium);
-  *vertex_count = 0;
-
-  // Do not plot the past when there is a target vessel as it is misleading.
-  if (plugin->renderer().HasTargetVessel()) {
-    *minimal_distance_from_camera = std::numeric_limits<double>::infinity();
-    return m.Return();
-  } else {
-    auto const& celestial_trajectory =
-        plugin->GetCelestial(celestial_index).trajectory();
-    Instant const desired_first_time =
-        plugin->CurrentTime() - max_history_length * Second;
-
-    // Since we would want to plot starting from |desired_first_time|, ask the
-    // reanimator to reconstruct the past.  That may take a while, during which
-    // time the history will be shorter than desired.
-    plugin->RequestReanimation(desired_first_time);
-
-    Instant const first_time =
-        std::max(desired_first_time, celestial_trajectory.t_min());
-    Length minimal_distance;
-    planetarium->PlotMethod3(
-        celestial_trajectory,
-        first_time,
-        /*last_time=*/plugin->CurrentTime(),
-        /*now=*/plugin->CurrentTime(),
-        /*reverse=*/true,
-        [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-          vertices[(*vertex_count)++] = vertex;
-        },
-        vertices_size,
-        &minimal_distance);
-    *minimal_distance_from_camera = minimal_distance / Metre;
-    return m.Return();
-  }
+  RequestCelestialPastTrajectoryReanimation(*plugin, max_history_length);
+  PlotCelestialPastTrajectory(*planetarium,
+                              *plugin,
+                              celestial_index,
+                              max_history_length,
+                              vertices,
+                              vertices_size,
+                              *minimal_distance_from_camera,
+                              *vertex_count);
+  return m.Return();
 }
 
 // Fills the array of size |vertices_size| at |vertices| with vertices for the
@@ -325,40 +464,162 @@ void __cdecl principia__PlanetariumPlotCelestialFutureTrajectory(
       {minimal_distance_from_camera, vertex_count});
   CHECK_NOTNULL(plugin);
   CHECK_NOTNULL(planetarium);
-  *vertex_count = 0;
+  PlotCelestialFutureTrajectory(*planetarium,
+                                *plugin,
+                                celestial_index,
+                                vessel_guid,
+                                vertices,
+                                vertices_size,
+                                *minimal_distance_from_camera,
+                                *vertex_count);
+  return m.Return();
+}
 
-  // Do not plot the past when there is a target vessel as it is misleading.
-  // TODO(egg): This is the future, not the past!
-  if (plugin->renderer().HasTargetVessel()) {
-    *minimal_distance_from_camera = std::numeric_limits<double>::infinity();
-    return m.Return();
-  } else {
-    auto const& vessel = *plugin->GetVessel(vessel_guid);
-    Instant const prediction_final_time = vessel.prediction()->t_max();
-    Instant const final_time =
-        vessel.has_flight_plan()
-            ? std::max(vessel.flight_plan().actual_final_time(),
-                       prediction_final_time)
-            : prediction_final_time;
-    auto const& celestial_trajectory =
-        plugin->GetCelestial(celestial_index).trajectory();
-    // No need to request reanimation here because the current time of the
-    // plugin is necessarily covered.
-    Length minimal_distance;
-    planetarium->PlotMethod3(
-        celestial_trajectory,
-        /*first_time=*/plugin->CurrentTime(),
-        /*last_time=*/final_time,
-        /*now=*/plugin->CurrentTime(),
-        /*reverse=*/false,
-        [vertices, vertex_count](ScaledSpacePoint const& vertex) {
-          vertices[(*vertex_count)++] = vertex;
-        },
-        vertices_size,
-        &minimal_distance);
-    *minimal_distance_from_camera = minimal_distance / Metre;
-    return m.Return();
+// Plots the trajectories described by the |requests| concurrently.  The
+// requests that need a reanimation have it requested first, on this thread,
+// as required by the reanimators.
+void __cdecl principia__PlanetariumPlotTrajectories(
+    Planetarium const* const planetarium,
+    Plugin const* const plugin,
+    char const* const* const vessel_guids,
+    double const max_history_length,
+    PlotRequest* const requests,
+    int const requests_size,
+    ScaledSpacePoint* const vertices,
+    int const vertices_size) {
+  journal::Method<journal::PlanetariumPlotTrajectories> m(
+      {planetarium,
+       plugin,
+       vessel_guids,
+       max_history_length,
+       requests,
+       requests_size,
+       vertices,
+       vertices_size});
+  CHECK_NOTNULL(plugin);
+  CHECK_NOTNULL(planetarium);
+  std::vector<char const*> guids;
+  for (char const* const* c = vessel_guids;
+       c != nullptr && *c != nullptr;
+       ++c) {
+    guids.push_back(*c);
+  }
+  auto const vessel_guid = [&guids](PlotRequest const& request) {
+    CHECK_LE(0, request.vessel);
+    CHECK_LT(request.vessel, guids.size());
+    return guids[request.vessel];
+  };
+
+  // The ranges of |vertices| written by the (nonempty) requests, as half-open
+  // intervals.
+  std::vector<std::pair<int, int>> vertex_ranges;
+  for (int i = 0; i < requests_size; ++i) {
+    PlotRequest& request = requests[i];
+    CHECK_LE(0, request.first_vertex);
+    CHECK_LE(0, request.max_vertices);
+    CHECK_LE(request.first_vertex + request.max_vertices, vertices_size);
+    if (request.max_vertices > 0) {
+      vertex_ranges.emplace_back(request.first_vertex,
+                                 request.first_vertex + request.max_vertices);
+    }
+    request.vertex_count = 0;
+    request.minimal_distance_from_camera =
+        std::numeric_limits<double>::infinity();
+    switch (request.trajectory) {
+      case PSYCHOHISTORY:
+        RequestPsychohistoryReanimation(
+            *plugin, vessel_guid(request), max_history_length);
+        break;
+      case CELESTIAL_PAST_TRAJECTORY:
+        RequestCelestialPastTrajectoryReanimation(*plugin, max_history_length);
+        break;
+      case PREDICTION:
+      case FLIGHT_PLAN_SEGMENT:
+      case CELESTIAL_FUTURE_TRAJECTORY:
+        break;
+      default:
+        LOG(FATAL) << "Unexpected trajectory " << request.trajectory;
+    }
   }
+
+  // The requests are plotted concurrently, so they must not write to the same
+  // vertices.
+  std::sort(vertex_ranges.begin(), vertex_ranges.end());
+  for (std::size_t i = 1; i < vertex_ranges.size(); ++i) {
+    CHECK_LE(vertex_ranges[i - 1].second, vertex_ranges[i].first)
+        << "Overlapping vertex ranges [" << vertex_ranges[i - 1].first << ", "
+        << vertex_ranges[i - 1].second << ") and [" << vertex_ranges[i].first
+        << ", " << vertex_ranges[i].second << ")";
+  }
+
+  // Each request writes to its own range of |vertices| and to its own
+  // element of |requests|, so there is no need for synchronization.
+  std::vector<std::future<void>> futures;
+  futures.reserve(requests_size);
+  for (int i = 0; i < requests_size; ++i) {
+    PlotRequest& request = requests[i];
+    char const* const guid =
+        request.trajectory == CELESTIAL_PAST_TRAJECTORY ? nullptr
+                                                        : vessel_guid(request);
+    futures.push_back(plugin->plotting_thread_pool().Add(
+        [planetarium, plugin, guid, max_history_length, &request, vertices]() {
+          ScaledSpacePoint* const request_vertices =
+              vertices + request.first_vertex;
+          switch (request.trajectory) {
+            case PSYCHOHISTORY:
+              PlotPsychohistory(*planetarium,
+                                *plugin,
+                                guid,
+                                max_history_length,
+                                request_vertices,
+                                request.max_vertices,
+                                request.vertex_count);
+              break;
+            case PREDICTION:
+              PlotPrediction(*planetarium,
+                             *plugin,
+                             guid,
+                             request_vertices,
+                             request.max_vertices,
+                             request.vertex_count);
+              break;
+            case FLIGHT_PLAN_SEGMENT:
+              PlotFlightPlanSegment(*planetarium,
+                                    *plugin,
+                                    guid,
+                                    request.index,
+                                    request_vertices,
+                                    request.max_vertices,
+                                    request.vertex_count);
+              break;
+            case CELESTIAL_PAST_TRAJECTORY:
+              PlotCelestialPastTrajectory(*planetarium,
+                                          *plugin,
+                                          request.index,
+                                          max_history_length,
+                                          request_vertices,
+                                          request.max_vertices,
+                                          request.minimal_distance_from_camera,
+                                          request.vertex_count);
+              break;
+            case CELESTIAL_FUTURE_TRAJECTORY:
+              PlotCelestialFutureTrajectory(
+                  *planetarium,
+                  *plugin,
+                  request.index,
+                  guid,
+                  request_vertices,
+                  request.max_vertices,
+                  request.minimal_distance_from_camera,
+                  request.vertex_count);
+              break;
+          }
+        }));
+  }
+  for (auto& future : futures) {
+    future.wait();
+  }
+  return m.Return();
 }
 
 }  // namespace interface
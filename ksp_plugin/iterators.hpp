@@ -64,6 +64,20 @@ class TypedIterator<DiscreteTrajectory<World>> : public Iterator {
       std::function<Interchange(
           DiscreteTrajectory<World>::iterator const&)> const& convert) const;
 
+  // Converts the points starting at the one denoted by this iterator and
+  // stores them in |output|, which has room for |output_size| elements.  Only
+  // one point out of |decimation| is converted, but the last point of the
+  // trajectory is always converted.  Stops when |output| is full or at the end
+  // of the trajectory.  This iterator is left on the next point that would
+  // have been converted, so that successive calls can fetch the trajectory in
+  // chunks.  Returns the number of elements written to |output|.
+  template<typename Interchange>
+  int Get(int decimation,
+          std::function<Interchange(
+              DiscreteTrajectory<World>::iterator const&)> const& convert,
+          Interchange* output,
+          int output_size);
+
   bool AtEnd() const override;
   void Increment() override;
   void Reset() override;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <iterator>
 #include <string>
 
 #include "ksp_plugin/iterators.hpp"
@@ -58,6 +59,34 @@ Interchange TypedIterator<DiscreteTrajectory<World>>::Get(
   return convert(iterator_);
 }
 
+template<typename Interchange>
+int TypedIterator<DiscreteTrajectory<World>>::Get(
+    int const decimation,
+    std::function<Interchange(
+        DiscreteTrajectory<World>::iterator const&)> const& convert,
+    Interchange* const output,
+    int const output_size) {
+  CHECK_LE(1, decimation);
+  CHECK_LE(0, output_size);
+  if (trajectory_.empty()) {
+    return 0;
+  }
+  auto const last = std::prev(trajectory_.end());
+  int written = 0;
+  while (written < output_size && iterator_ != trajectory_.end()) {
+    output[written] = convert(iterator_);
+    ++written;
+    if (iterator_ == last) {
+      ++iterator_;
+    } else {
+      for (int i = 0; i < decimation && iterator_ != last; ++i) {
+        ++iterator_;
+      }
+    }
+  }
+  return written;
+}
+
 inline bool TypedIterator<DiscreteTrajectory<World>>::AtEnd() const {
   return iterator_ == trajectory_.end();
 }
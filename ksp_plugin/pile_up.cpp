@@ -1,11 +1,13 @@
 #include "ksp_plugin/pile_up.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -60,6 +62,7 @@ PileUp::PileUp(
     not_null<Ephemeris<Barycentric>*> const ephemeris,
     std::function<void()> deletion_callback)
     : lock_(make_not_null_unique<absl::Mutex>()),
+      evaluations_(make_not_null_unique<std::int64_t>(0)),
       parts_(std::move(parts)),
       ephemeris_(ephemeris),
       adaptive_step_parameters_(std::move(adaptive_step_parameters)),
@@ -92,6 +95,9 @@ PileUp::PileUp(
 
 PileUp::~PileUp() {
   LOG(INFO) << "Destroying pile up at " << this;
+  if (group_ != nullptr) {
+    group_->Remove(this);
+  }
   if (deletion_callback_ != nullptr) {
     deletion_callback_();
   }
@@ -106,6 +112,11 @@ PileUp::fixed_step_parameters() const {
   return fixed_step_parameters_;
 }
 
+PileUp::AdvanceCost PileUp::last_advance_cost() const {
+  absl::MutexLock l(lock_.get());
+  return last_advance_cost_;
+}
+
 void PileUp::SetPartApparentRigidMotion(
     not_null<Part*> const part,
     RigidMotion<RigidPart, Apparent> const& rigid_motion) {
@@ -118,10 +129,14 @@ void PileUp::SetPartApparentRigidMotion(
 absl::Status PileUp::DeformAndAdvanceTime(Instant const& t) {
   absl::MutexLock l(lock_.get());
   absl::Status status;
-  if (psychohistory_->back().time < t) {
+  // If the group has flowed the history, the psychohistory may already end at
+  // |t|, but the points of the history must still be given to the parts.
+  if (psychohistory_->back().time < t || grouped_history_last_.has_value()) {
+    std::int64_t const evaluations_before = *evaluations_;
     DeformPileUpIfNeeded(t);
     status = AdvanceTime(t);
     NudgeParts();
+    last_advance_cost_.evaluations = *evaluations_ - evaluations_before;
   }
   return status;
 }
@@ -397,6 +412,7 @@ PileUp::PileUp(
     not_null<Ephemeris<Barycentric>*> const ephemeris,
     std::function<void()> deletion_callback)
     : lock_(make_not_null_unique<absl::Mutex>()),
+      evaluations_(make_not_null_unique<std::int64_t>(0)),
       parts_(std::move(parts)),
       ephemeris_(ephemeris),
       adaptive_step_parameters_(std::move(adaptive_step_parameters)),
@@ -579,18 +595,23 @@ void PileUp::DeformPileUpIfNeeded(Instant const& t) {
 
 absl::Status PileUp::AdvanceTime(Instant const& t) {
   absl::Status status;
-  Instant const history_last = history_->back().time;
+  Instant const history_last =
+      grouped_history_last_.value_or(history_->back().time);
+  grouped_history_last_.reset();
+  auto const no_intrinsic_acceleration = CountingNoIntrinsicAcceleration();
   if (intrinsic_force_ == Vector<Force, Barycentric>{}) {
     // Remove the fork.
     trajectory_.DeleteSegments(psychohistory_);
-    if (fixed_instance_ == nullptr) {
-      fixed_instance_ = ephemeris_->NewInstance(
-          {&trajectory_},
-          Ephemeris<Barycentric>::NoIntrinsicAccelerations,
-          fixed_step_parameters_);
+    if (group_ == nullptr) {
+      if (fixed_instance_ == nullptr) {
+        fixed_instance_ = ephemeris_->NewInstance(
+            {&trajectory_},
+            {no_intrinsic_acceleration},
+            fixed_step_parameters_);
+      }
+      CHECK_LT(history_->back().time, t);
+      status = ephemeris_->FlowWithFixedStep(t, *fixed_instance_);
     }
-    CHECK_LT(history_->back().time, t);
-    status = ephemeris_->FlowWithFixedStep(t, *fixed_instance_);
     psychohistory_ = trajectory_.NewSegment();
     if (history_->back().time < t) {
       // Do not clear the |fixed_instance_| here, we will use it for the next
@@ -598,7 +619,7 @@ absl::Status PileUp::AdvanceTime(Instant const& t) {
       status.Update(
           ephemeris_->FlowWithAdaptiveStep(
               &trajectory_,
-              Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+              no_intrinsic_acceleration,
               t,
               adaptive_step_parameters_,
               Ephemeris<Barycentric>::unlimited_max_ephemeris_steps));
@@ -621,7 +642,11 @@ absl::Status PileUp::AdvanceTime(Instant const& t) {
     }
 
     auto const intrinsic_acceleration =
-        [a = intrinsic_force_ / mass_](Instant const& t) { return a; };
+        [a = intrinsic_force_ / mass_,
+         evaluations = evaluations_.get()](Instant const& t) {
+          ++*evaluations;
+          return a;
+        };
     status = ephemeris_->FlowWithAdaptiveStep(
                  &trajectory_,
                  intrinsic_acceleration,
@@ -636,19 +661,41 @@ absl::Status PileUp::AdvanceTime(Instant const& t) {
   // anymore.
   auto const history_end = history_->end();
   auto const psychohistory_end = psychohistory_->end();
+  last_advance_cost_.steps = 0;
   for (auto it = trajectory_.upper_bound(history_last);
        it != history_end;
        ++it) {
     AppendToPart<&Part::AppendToHistory>(it);
+    ++last_advance_cost_.steps;
   }
   for (auto it = history_end; it != psychohistory_end; ++it) {
     AppendToPart<&Part::AppendToPsychohistory>(it);
+    ++last_advance_cost_.steps;
   }
   trajectory_.ForgetBefore(psychohistory_->front().time);
 
   return status;
 }
 
+Ephemeris<Barycentric>::IntrinsicAcceleration
+PileUp::CountingNoIntrinsicAcceleration() const {
+  return [evaluations = evaluations_.get()](Instant const& t) {
+    ++*evaluations;
+    return Vector<Acceleration, Barycentric>{};
+  };
+}
+
+void PileUp::DetachPsychohistoryForGroup() {
+  if (!grouped_history_last_.has_value()) {
+    grouped_history_last_ = history_->back().time;
+  }
+  trajectory_.DeleteSegments(psychohistory_);
+}
+
+void PileUp::AttachPsychohistoryForGroup() {
+  psychohistory_ = trajectory_.NewSegment();
+}
+
 void PileUp::NudgeParts() const {
   auto const actual_centre_of_mass = psychohistory_->back().degrees_of_freedom;
 
@@ -688,6 +735,201 @@ void PileUp::AppendToPart(DiscreteTrajectory<Barycentric>::iterator it) const {
   }
 }
 
+PileUpGroup::PileUpGroup(
+    Ephemeris<Barycentric>::FixedStepParameters fixed_step_parameters,
+    not_null<Ephemeris<Barycentric>*> const ephemeris)
+    : fixed_step_parameters_(std::move(fixed_step_parameters)),
+      ephemeris_(ephemeris) {}
+
+PileUpGroup::~PileUpGroup() {
+  Clear();
+}
+
+absl::Status PileUpGroup::AdvanceHistories(
+    std::vector<not_null<PileUp*>> const& pile_ups,
+    Instant const& t) {
+  std::set<not_null<PileUp*>> eligible;
+  for (not_null<PileUp*> const pile_up : pile_ups) {
+    absl::MutexLock l(pile_up->lock_.get());
+    if (pile_up->intrinsic_force_ == Vector<Force, Barycentric>{}) {
+      eligible.insert(pile_up);
+    }
+  }
+
+  // A member keeps its slot only if it is still eligible and hasn't flowed its
+  // history on its own since the last call.
+  std::vector<not_null<PileUp*>> leaving;
+  for (auto const& [pile_up, slot] : slots_) {
+    auto const& [cohort, index] = slot;
+    absl::MutexLock l(pile_up->lock_.get());
+    if (!eligible.contains(pile_up) ||
+        pile_up->history_->back().time !=
+            cohort->trajectories[index]->back().time) {
+      leaving.push_back(pile_up);
+    }
+  }
+  for (not_null<PileUp*> const pile_up : leaving) {
+    Remove(pile_up);
+  }
+
+  // The instance of a cohort whose slots are mostly vacant wastes evaluations
+  // of the geopotential, so its members join the new cohort.
+  for (Cohort const& cohort : cohorts_) {
+    std::size_t const occupied = std::count_if(cohort.members.begin(),
+                                       cohort.members.end(),
+                                       [](PileUp* const pile_up) {
+                                         return pile_up != nullptr;
+                                       });
+    if (2 * occupied < cohort.members.size()) {
+      for (PileUp* const pile_up : cohort.members) {
+        if (pile_up != nullptr) {
+          leaving.push_back(pile_up);
+        }
+      }
+    }
+  }
+  std::vector<not_null<PileUp*>> joining;
+  for (not_null<PileUp*> const pile_up : leaving) {
+    if (slots_.contains(pile_up)) {
+      Remove(pile_up);
+      joining.push_back(pile_up);
+    }
+  }
+  for (not_null<PileUp*> const pile_up : pile_ups) {
+    if (eligible.contains(pile_up) && !slots_.contains(pile_up) &&
+        std::find(joining.begin(), joining.end(), pile_up) == joining.end()) {
+      joining.push_back(pile_up);
+    }
+  }
+
+  for (auto const& [pile_up, _] : slots_) {
+    absl::MutexLock l(pile_up->lock_.get());
+    pile_up->DetachPsychohistoryForGroup();
+  }
+  absl::Status status;
+  if (!joining.empty()) {
+    status = AddCohort(joining);
+  }
+  for (Cohort& cohort : cohorts_) {
+    if (!status.ok()) {
+      break;
+    }
+    status = FlowCohort(cohort, t);
+  }
+  for (auto const& [pile_up, _] : slots_) {
+    absl::MutexLock l(pile_up->lock_.get());
+    pile_up->AttachPsychohistoryForGroup();
+  }
+
+  if (!status.ok()) {
+    LOG(WARNING) << "Dissolving a group of " << slots_.size()
+                 << " pile-ups: " << status;
+    Clear();
+  }
+  return status;
+}
+
+absl::Status PileUpGroup::AddCohort(
+    std::vector<not_null<PileUp*>> const& pile_ups) {
+  // Bring the histories of the pile-ups to a common time, the latest end of
+  // their histories, which is less than a step away from the others.
+  Instant t0 = InfinitePast;
+  for (not_null<PileUp*> const pile_up : pile_ups) {
+    absl::MutexLock l(pile_up->lock_.get());
+    t0 = std::max(t0, pile_up->history_->back().time);
+  }
+
+  absl::Status status;
+  Cohort& cohort = cohorts_.emplace_back();
+  std::vector<not_null<DiscreteTrajectory<Barycentric>*>> trajectories;
+  for (not_null<PileUp*> const pile_up : pile_ups) {
+    absl::MutexLock l(pile_up->lock_.get());
+    CHECK(pile_up->group_ == nullptr);
+    pile_up->group_ = this;
+    // The state of the instance of the pile-up is stale once the group has
+    // flowed its history.
+    pile_up->fixed_instance_ = nullptr;
+    pile_up->DetachPsychohistoryForGroup();
+    if (pile_up->history_->back().time < t0) {
+      status.Update(ephemeris_->FlowWithAdaptiveStep(
+          &pile_up->trajectory_,
+          pile_up->CountingNoIntrinsicAcceleration(),
+          t0,
+          pile_up->adaptive_step_parameters_,
+          Ephemeris<Barycentric>::unlimited_max_ephemeris_steps));
+    }
+    auto const& last = pile_up->history_->back();
+    auto& trajectory = cohort.trajectories.emplace_back(
+        make_not_null_unique<DiscreteTrajectory<Barycentric>>());
+    trajectory->Append(last.time, last.degrees_of_freedom).IgnoreError();
+    trajectories.push_back(trajectory.get());
+    slots_.emplace(pile_up, std::pair(&cohort, cohort.members.size()));
+    cohort.members.push_back(pile_up);
+  }
+  if (status.ok()) {
+    cohort.instance = ephemeris_->NewInstance(
+        trajectories,
+        Ephemeris<Barycentric>::NoIntrinsicAccelerations,
+        fixed_step_parameters_);
+  }
+  return status;
+}
+
+absl::Status PileUpGroup::FlowCohort(Cohort& cohort, Instant const& t) {
+  Instant const last = cohort.instance->time().value;
+  if (last >= t) {
+    return absl::OkStatus();
+  }
+  absl::Status const status =
+      ephemeris_->FlowWithFixedStep(t, *cohort.instance);
+
+  // Copy the new points to the histories of the members and drop them from the
+  // trajectories of the slots.
+  for (std::size_t i = 0; i < cohort.members.size(); ++i) {
+    PileUp* const pile_up = cohort.members[i];
+    auto& trajectory = *cohort.trajectories[i];
+    if (pile_up != nullptr) {
+      absl::MutexLock l(pile_up->lock_.get());
+      for (auto it = trajectory.upper_bound(last);
+           it != trajectory.end();
+           ++it) {
+        pile_up->trajectory_.Append(it->time, it->degrees_of_freedom)
+            .IgnoreError();
+      }
+    }
+    trajectory.ForgetBefore(trajectory.back().time);
+  }
+  return status;
+}
+
+void PileUpGroup::Remove(not_null<PileUp*> const pile_up) {
+  auto const it = slots_.find(pile_up);
+  CHECK(it != slots_.end());
+  Cohort* const cohort = it->second.first;
+  int const index = it->second.second;
+  slots_.erase(it);
+  {
+    absl::MutexLock l(pile_up->lock_.get());
+    pile_up->group_ = nullptr;
+  }
+  cohort->members[index] = nullptr;
+  if (std::all_of(cohort->members.begin(),
+                  cohort->members.end(),
+                  [](PileUp* const member) { return member == nullptr; })) {
+    cohorts_.remove_if(
+        [cohort](Cohort const& c) { return &c == cohort; });
+  }
+}
+
+void PileUpGroup::Clear() {
+  for (auto const& [pile_up, _] : slots_) {
+    absl::MutexLock l(pile_up->lock_.get());
+    pile_up->group_ = nullptr;
+  }
+  slots_.clear();
+  cohorts_.clear();
+}
+
 PileUpFuture::PileUpFuture(not_null<PileUp const*> const pile_up,
                            std::future<absl::Status> future)
     : pile_up(pile_up),
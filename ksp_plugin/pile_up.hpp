@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <list>
@@ -7,6 +8,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
@@ -33,6 +35,7 @@ namespace ksp_plugin {
 
 FORWARD_DECLARE_FROM(part, class, Part);
 
+class PileUpTest;
 class TestablePileUp;
 
 namespace _pile_up {
@@ -86,6 +89,8 @@ using PileUpPrincipalAxes = Frame<serialization::Frame::PluginTag,
                                   Handedness::Right,
                                   serialization::Frame::PILE_UP_PRINCIPAL_AXES>;
 
+class PileUpGroup;
+
 // A |PileUp| handles a connected component of the graph of |Parts| under
 // physical contact.  It advances the history and psychohistory of its component
 // |Parts|, modeling them as a massless body at their centre of mass.
@@ -102,10 +107,24 @@ class PileUp {
   // Runs the |deletion_callback| passed at construction, if not null.
   virtual ~PileUp();
 
+  // The work done by a call to |DeformAndAdvanceTime|.
+  struct AdvanceCost {
+    // The number of points appended to the trajectory of the pile-up.
+    std::int64_t steps = 0;
+    // The number of evaluations of the right-hand side of the equations of
+    // motion.
+    std::int64_t evaluations = 0;
+  };
+
   std::list<not_null<Part*>> const& parts() const;
   Ephemeris<Barycentric>::FixedStepParameters const& fixed_step_parameters()
       const;
 
+  // The cost of the last call to |DeformAndAdvanceTime| that actually advanced
+  // the pile-up, used to predict the cost of the next one.  Zero if the pile-up
+  // was never advanced.
+  AdvanceCost last_advance_cost() const;
+
   // Set the rigid motion for the given |part|.  This rigid motion is *apparent*
   // in the sense that it was reported by the game but we know better since we
   // are doing science.
@@ -174,8 +193,20 @@ class PileUp {
   // the histories of the parts and updates the degrees of freedom of the parts
   // if the pile-up is in the bubble.  After this call, the tail (of |*this|)
   // and of its parts have a (possibly ahistorical) final point exactly at |t|.
+  // If the pile-up is a member of a |PileUpGroup|, the history has already been
+  // flowed with a fixed step by the group.
   absl::Status AdvanceTime(Instant const& t);
 
+  // A vanishing intrinsic acceleration that counts the evaluations of the
+  // right-hand side in |evaluations_|.
+  Ephemeris<Barycentric>::IntrinsicAcceleration
+  CountingNoIntrinsicAcceleration() const;
+
+  // Called by |PileUpGroup| before and after it flows the history of this
+  // pile-up.
+  void DetachPsychohistoryForGroup();
+  void AttachPsychohistoryForGroup();
+
   // Adjusts the degrees of freedom of all parts in this pile up based on the
   // degrees of freedom of the pile-up computed by |AdvanceTime| and on the
   // |NonRotatingPileUp| degrees of freedom of the parts, as set by
@@ -188,6 +219,12 @@ class PileUp {
   // Wrapped in a |unique_ptr| to be moveable.
   not_null<std::unique_ptr<absl::Mutex>> lock_;
 
+  // The number of evaluations of the right-hand side since construction.
+  // Wrapped in a |unique_ptr| because it is referenced by the intrinsic
+  // accelerations passed to the integrators.
+  not_null<std::unique_ptr<std::int64_t>> evaluations_;
+  AdvanceCost last_advance_cost_;
+
   std::list<not_null<Part*>> parts_;
   not_null<Ephemeris<Barycentric>*> ephemeris_;
   Ephemeris<Barycentric>::AdaptiveStepParameters adaptive_step_parameters_;
@@ -241,12 +278,94 @@ class PileUp {
   std::optional<EulerSolver<NonRotatingPileUp, PileUpPrincipalAxes>>
       euler_solver_;
 
+  // The group that flows the history of this pile-up, if any.  Not owning.
+  PileUpGroup* group_ = nullptr;
+  // The end of the history before it was first flowed by the group since the
+  // last call to |AdvanceTime|.  The points after it have not been appended to
+  // the histories of the parts yet.
+  std::optional<Instant> grouped_history_last_;
+
   // Called in the destructor.
   std::function<void()> deletion_callback_;
 
+  friend class PileUpGroup;
   friend class ksp_plugin::TestablePileUp;
 };
 
+// A group of pile-ups whose histories are flowed with a fixed step by the
+// integrator instances of the group instead of those of the pile-ups.  The
+// pile-ups that join the group together form a cohort, whose histories are
+// flowed by a single instance with one massless body per pile-up.  The
+// positions of the massive bodies are thus evaluated once per stage for an
+// entire cohort instead of once per pile-up.  A pile-up that leaves the group
+// vacates its slot in its cohort, but the instance keeps running for the other
+// members.  Only the histories are flowed by the group, the psychohistories are
+// still flowed by |PileUp::DeformAndAdvanceTime|.  This class is not
+// thread-safe and must not be used while its members are being advanced.
+class PileUpGroup {
+ public:
+  PileUpGroup(
+      Ephemeris<Barycentric>::FixedStepParameters fixed_step_parameters,
+      not_null<Ephemeris<Barycentric>*> ephemeris);
+
+  // Removes all the members from the group.
+  ~PileUpGroup();
+
+  // Makes the |pile_ups| that are not subject to an intrinsic force the members
+  // of the group, and flows their histories as far as possible up to |t|.  The
+  // pile-ups that were already members keep their slot and their instance.
+  // Those that are no longer members, or that flowed their history on their
+  // own since the last call, vacate their slot.  The new members form a new
+  // cohort: their histories are first brought to a common time with an
+  // adaptive step, and a new instance is created for them.  A cohort whose
+  // slots are mostly vacant is restarted with its remaining members.  If the
+  // flow fails, e.g., because of a collision, the group is dissolved and its
+  // members flow their histories separately until the next call.  The
+  // |pile_ups| must have the same fixed-step parameters as the group.
+  absl::Status AdvanceHistories(std::vector<not_null<PileUp*>> const& pile_ups,
+                                Instant const& t);
+
+ private:
+  using Instance = Integrator<
+      Ephemeris<Barycentric>::NewtonianMotionEquation>::Instance;
+
+  // Pile-ups that joined the group together.  The instance flows one
+  // trajectory per slot, which only retains its last point; the points that it
+  // appends are copied to the history of the member in the slot, if any.
+  struct Cohort {
+    // Null for a vacant slot.
+    std::vector<PileUp*> members;
+    std::vector<not_null<std::unique_ptr<DiscreteTrajectory<Barycentric>>>>
+        trajectories;
+    std::unique_ptr<Instance> instance;
+  };
+
+  // Makes the |pile_ups| a new cohort of the group.  Their histories are
+  // brought to a common time.
+  absl::Status AddCohort(std::vector<not_null<PileUp*>> const& pile_ups);
+
+  // Flows the histories of the members of |cohort| as far as possible up to
+  // |t|.
+  absl::Status FlowCohort(Cohort& cohort, Instant const& t);
+
+  // Vacates the slot of |pile_up|, which must be a member of the group.
+  // Destroys the cohort if it has no members left.
+  void Remove(not_null<PileUp*> pile_up);
+
+  // Removes all the members from the group and destroys the instances.
+  void Clear();
+
+  Ephemeris<Barycentric>::FixedStepParameters const fixed_step_parameters_;
+  not_null<Ephemeris<Barycentric>*> const ephemeris_;
+  std::list<Cohort> cohorts_;
+  // The cohort and the slot of each member.  Not owning.  A pile-up vacates its
+  // slot when it is destroyed.
+  std::map<not_null<PileUp*>, std::pair<Cohort*, int>> slots_;
+
+  friend class PileUp;
+  friend class ksp_plugin::PileUpTest;
+};
+
 // A convenient data object to track a pile-up and the result of integrating it.
 struct PileUpFuture {
   PileUpFuture(not_null<PileUp const*> pile_up,
@@ -261,6 +380,7 @@ using internal::ApparentPileUp;
 using internal::NonRotatingPileUp;
 using internal::PileUp;
 using internal::PileUpFuture;
+using internal::PileUpGroup;
 using internal::PileUpPrincipalAxes;
 
 }  // namespace _pile_up
@@ -1,14 +1,18 @@
 #include "ksp_plugin/plugin.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <ios>
 #include <limits>
 #include <list>
 #include <map>
 #include <optional>
+#include <random>
+#include <ranges>
 #include <set>
 #include <string>
 #include <thread>
@@ -16,16 +20,19 @@
 #include <vector>
 
 #include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
 #include "astronomy/epoch.hpp"
 #include "astronomy/solar_system_fingerprints.hpp"
 #include "astronomy/stabilize_ksp.hpp"
 #include "astronomy/time_scales.hpp"
 #include "base/file.hpp"
 #include "base/hexadecimal.hpp"
+#include "base/jthread.hpp"
 #include "base/map_util.hpp"
 #include "base/not_null.hpp"
 #include "base/optional_logging.hpp"
 #include "base/serialization.hpp"
+#include "base/status_utilities.hpp"
 #include "base/unique_ptr_logging.hpp"
 #include "geometry/affine_map.hpp"
 #include "geometry/barycentre_calculator.hpp"
@@ -97,17 +104,192 @@ using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
+using namespace std::chrono_literals;
+
 // Keep this consistent with |prediction_steps_| in |main_window.cs|.
 constexpr std::int64_t max_steps_in_prediction = 1 << 24;
 
+// The speculative prolongation of the ephemeris doesn't go further than this
+// many steps of the ephemeris beyond the current time, so that a large time
+// step doesn't start a long and possibly useless integration.
+constexpr int max_speculative_prolongation_steps = 4;
+
+// The tags of the sections of a snapshot.  Each vessel is in a separate
+// section, followed by one section of doubles per segment of its history.  The
+// ephemeris is followed by one section of doubles per trajectory.  The header
+// describes whether the snapshot is full or a delta.
+constexpr std::uint32_t plugin_snapshot_tag = 1;
+constexpr std::uint32_t ephemeris_snapshot_tag = 2;
+constexpr std::uint32_t vessel_snapshot_tag = 3;
+constexpr std::uint32_t header_snapshot_tag = 4;
+constexpr std::uint32_t history_points_snapshot_tag = 5;
+constexpr std::uint32_t polynomials_snapshot_tag = 6;
+
+namespace {
+
+// Inserts at the beginning of |messages| the elements of |base_messages|,
+// which is left in an unspecified state.
+template<typename Message>
+void PrependFromBase(google::protobuf::RepeatedPtrField<Message>& base_messages,
+                     google::protobuf::RepeatedPtrField<Message>& messages) {
+  for (auto& message : messages) {
+    base_messages.Add()->Swap(&message);
+  }
+  messages.Swap(&base_messages);
+}
+
+// Snapshots are identified by a random number, so that a delta may not be
+// applied to the wrong base.
+std::uint64_t NewSnapshotIdentifier() {
+  std::random_device random_device;
+  return static_cast<std::uint64_t>(random_device()) << 32 | random_device();
+}
+
+// Writes |vessel_message|, completed with |vessel|, to |snapshot|, followed by
+// the points of the segments of the history of |vessel|.  For each segment,
+// |first_point_to_write| is given the index of the segment, the segment, and
+// the range of points to serialize, and returns the first point of that range
+// to actually write.
+void WriteVesselToSnapshot(
+    Vessel const& vessel,
+    PileUp::SerializationIndexForPileUp const& serialization_index_for_pile_up,
+    serialization::Plugin::VesselAndProperties& vessel_message,
+    std::function<DiscreteTrajectory<Barycentric>::iterator(
+        int index,
+        DiscreteTrajectorySegment<Barycentric> const& segment,
+        DiscreteTrajectory<Barycentric>::iterator begin,
+        DiscreteTrajectory<Barycentric>::iterator end)> const&
+        first_point_to_write,
+    SnapshotWriter& snapshot) {
+  std::vector<std::pair<DiscreteTrajectory<Barycentric>::iterator,
+                        DiscreteTrajectory<Barycentric>::iterator>>
+      history_ranges;
+  vessel.WriteToMessage(vessel_message.mutable_vessel(),
+                        serialization_index_for_pile_up,
+                        history_ranges);
+  snapshot.WriteMessage(vessel_snapshot_tag, vessel_message);
+  std::vector<double> points;
+  auto segment = vessel.trajectory().segments().begin();
+  for (int index = 0; index < history_ranges.size(); ++index) {
+    auto const& [begin, end] = history_ranges[index];
+    points.clear();
+    segment->WritePoints(
+        first_point_to_write(index, *segment, begin, end), end, &points);
+    snapshot.WriteDoubles(history_points_snapshot_tag, points);
+    ++segment;
+  }
+}
+
+// Returns the time of the last checkpoint of |ephemeris|.
+Instant LastCheckpointTime(serialization::Ephemeris const& ephemeris) {
+  CHECK_LT(0, ephemeris.checkpoint_size());
+  return Instant::ReadFromMessage(
+      ephemeris.checkpoint(ephemeris.checkpoint_size() - 1).time());
+}
+
+// Returns the time of the point at |index| in |points|, which must be in the
+// format produced by |DiscreteTrajectorySegment::WritePoints|.
+Instant HistoryPointTime(Array<double const> const& points,
+                         std::int64_t const index) {
+  constexpr std::int64_t doubles_per_point =
+      DiscreteTrajectorySegment<Barycentric>::doubles_per_point;
+  return Instant{} + points.data[index * doubles_per_point] * Second;
+}
+
+// Returns the |count| points of |points| that start at |begin_time|, which must
+// be the time of one of |points|.
+Array<double const> HistoryPointsFrom(Array<double const> const& points,
+                                      Instant const& begin_time,
+                                      std::int64_t const count) {
+  constexpr std::int64_t doubles_per_point =
+      DiscreteTrajectorySegment<Barycentric>::doubles_per_point;
+  CHECK_EQ(0, points.size % doubles_per_point);
+  std::int64_t const size = points.size / doubles_per_point;
+  auto const indices = std::views::iota(std::int64_t{0}, size);
+  auto const it = std::ranges::partition_point(
+      indices,
+      [&points, &begin_time](std::int64_t const index) {
+        return HistoryPointTime(points, index) < begin_time;
+      });
+  CHECK(it != indices.end()) << begin_time;
+  std::int64_t const begin = *it;
+  CHECK_EQ(begin_time, HistoryPointTime(points, begin));
+  CHECK_LE(begin + count, size);
+  return Array<double const>(points.data + begin * doubles_per_point,
+                             count * doubles_per_point);
+}
+
+// Writes |ephemeris_message| to |snapshot|, followed by the |polynomials| of
+// each of its trajectories.
+template<typename Doubles>
+void WriteEphemerisToSnapshot(
+    serialization::Ephemeris const& ephemeris_message,
+    std::vector<Doubles> const& polynomials,
+    SnapshotWriter& snapshot) {
+  CHECK_EQ(ephemeris_message.trajectory_size(), polynomials.size());
+  snapshot.WriteMessage(ephemeris_snapshot_tag, ephemeris_message);
+  for (auto const& trajectory_polynomials : polynomials) {
+    snapshot.WriteDoubles(polynomials_snapshot_tag, trajectory_polynomials);
+  }
+}
+
+// Reads the ephemeris and the vessels of |snapshot| into |message|, and the
+// arrays of doubles that follow them into |polynomials| and |history_points|.
+void ReadEphemerisAndVessels(
+    SnapshotReader const& snapshot,
+    serialization::Plugin& message,
+    std::vector<std::vector<Array<double const>>>& polynomials,
+    std::map<GUID, std::vector<std::vector<Array<double const>>>>&
+        history_points) {
+  int ephemeris_sections = 0;
+  for (int section = 0; section < snapshot.sections().size(); ++section) {
+    switch (snapshot.sections()[section].tag) {
+      case ephemeris_snapshot_tag:
+        ++ephemeris_sections;
+        snapshot.ReadMessage(section, message.mutable_ephemeris());
+        break;
+      case vessel_snapshot_tag:
+        snapshot.ReadMessage(section, message.add_vessel());
+        break;
+      case history_points_snapshot_tag:
+        CHECK_LT(0, message.vessel_size());
+        history_points[message.vessel(message.vessel_size() - 1).guid()]
+            .push_back({snapshot.ReadDoubles(section)});
+        break;
+      case polynomials_snapshot_tag:
+        CHECK_EQ(1, ephemeris_sections);
+        polynomials.push_back({snapshot.ReadDoubles(section)});
+        break;
+    }
+  }
+  CHECK_EQ(1, ephemeris_sections);
+}
+
+// Returns the concatenation of |arrays|.
+std::vector<double> Concatenate(
+    std::vector<Array<double const>> const& arrays) {
+  std::vector<double> result;
+  for (auto const& array : arrays) {
+    result.insert(result.end(), array.data, array.data + array.size);
+  }
+  return result;
+}
+
+}  // namespace
+
 Plugin::Plugin(std::string const& game_epoch,
                std::string const& solar_system_epoch,
                Angle const& planetarium_rotation)
-    : history_downsampling_parameters_(DefaultDownsamplingParameters()),
+    : ephemeris_prolongator_(
+          [this](Instant const& t) { return ProlongSpeculatively(t); },
+          5ms),  // 200 Hz.
+      history_downsampling_parameters_(DefaultDownsamplingParameters()),
       history_fixed_step_parameters_(DefaultHistoryParameters()),
       psychohistory_parameters_(DefaultPsychohistoryParameters()),
       vessel_thread_pool_(
           /*pool_size=*/2 * std::thread::hardware_concurrency()),
+      plotting_thread_pool_(
+          /*pool_size=*/std::thread::hardware_concurrency()),
       planetarium_rotation_(planetarium_rotation),
       game_epoch_(ParseTT(game_epoch)),
       current_time_(ParseTT(solar_system_epoch)) {
@@ -117,6 +299,11 @@ Plugin::Plugin(std::string const& game_epoch,
 }
 
 Plugin::~Plugin() {
+  // Stop the speculative prolongation first, it has no business running while
+  // the plugin is being torn down.
+  ephemeris_prolongator_.Stop();
+  // The pile-ups must not be destroyed while the group is flowing them.
+  WaitForPileUpGroup();
   // We must manually destroy the vessels, triggering the destruction of the
   // parts, which have callbacks to remove themselves from |part_id_to_vessel_|,
   // which must therefore still exist.  This also causes the parts to be
@@ -222,12 +409,16 @@ void Plugin::EndInitialization() {
                  << initial_state_.DebugString();
   }
 
-  // Construct the ephemeris.
+  // Construct the ephemeris.  The bodies and the barycentric conversions of
+  // the subsystems are computed concurrently.
+  ThreadPool<void> initialization_thread_pool(
+      /*pool_size=*/std::thread::hardware_concurrency());
   ephemeris_ =
       solar_system.MakeEphemeris(ephemeris_accuracy_parameters_.value_or(
                                      DefaultEphemerisAccuracyParameters()),
                                  ephemeris_fixed_step_parameters_.value_or(
-                                     DefaultEphemerisFixedStepParameters()));
+                                     DefaultEphemerisFixedStepParameters()),
+                                 initialization_thread_pool);
 
   // Construct the celestials using the bodies from the ephemeris.
   for (std::string const& name : solar_system.names()) {
@@ -277,6 +468,13 @@ void Plugin::EndInitialization() {
   LOG(INFO) << "Ephemeris at initialization:\nbegin\n"
             << hex.data.get() << "\nend";
 
+  // Warm up the ephemeris to the game epoch, so that the first polynomials of
+  // all the bodies are fitted concurrently instead of serially by the first
+  // |AdvanceTime|.  This must come after the above serialization, which writes
+  // the checkpoint at the initial time: deserialization needs a checkpoint at
+  // or before the current time.
+  ephemeris_->Prolong(game_epoch_, initialization_thread_pool).IgnoreError();
+
   initializing_.Flop();
 }
 
@@ -434,6 +632,7 @@ void Plugin::InsertOrKeepLoadedPart(
     DegreesOfFreedom<World> const& main_body_degrees_of_freedom,
     RigidMotion<EccentricPart, World> const& part_rigid_motion,
     Time const& Δt) {
+  WaitForPileUpGroup();
   not_null<Vessel*> const vessel = FindOrDie(vessels_, vessel_guid).get();
   CHECK(is_loaded(vessel));
 
@@ -528,6 +727,7 @@ bool Plugin::PartIsTruthful(PartId const part_id) const {
 }
 
 void Plugin::PrepareToReportCollisions() {
+  WaitForPileUpGroup();
   for (auto const& [_, vessel] : vessels_) {
     // NOTE(egg): The lifetime requirement on the second argument of
     // |MakeSingleton| (which forwards to the argument of the constructor of
@@ -564,6 +764,7 @@ void Plugin::ReportPartCollision(PartId const part1, PartId const part2) const {
 
 void Plugin::FreeVesselsAndPartsAndCollectPileUps(Time const& Δt) {
   CHECK(!initializing_);
+  WaitForPileUpGroup();
 
   // Remove the vessels that we don't want to keep.  Vessels that are not kept
   // have had no reported collisions, so their part subsets do not intersect
@@ -673,6 +874,7 @@ void Plugin::SetPartApparentRigidMotion(
       Identity<Barycentric, Apparent>()(angular_velocity_of_world_),
       Apparent::unmoving};
 
+  WaitForPileUpGroup();
   not_null<Vessel*> vessel = FindOrDie(part_id_to_vessel_, part_id);
   CHECK(is_loaded(vessel));
   not_null<Part*> const part = vessel->part(part_id);
@@ -753,31 +955,178 @@ RigidMotion<Barycentric, World> Plugin::BarycentricToWorld(
 void Plugin::AdvanceTime(Instant const& t, Angle const& planetarium_rotation) {
   CHECK(!initializing_);
   CHECK_GT(t, current_time_);
+  WaitForPileUpGroup();
 
   for (not_null<Vessel*> const vessel : loaded_vessels_) {
     vessel->ClearAllIntrinsicForcesAndTorques();
   }
 
+  Time const Δt = t - current_time_;
   current_time_ = t;
   planetarium_rotation_ = planetarium_rotation;
+  // If the pipelined time step is enabled, this is normally a no-op or a wait
+  // for the end of the speculative prolongation started by the previous call.
   ephemeris_->Prolong(current_time_).IgnoreError();
+  // Speculate that the next call will use the same time step.  This has no
+  // effect unless the pipelined time step is enabled.
+  ephemeris_prolongator_.Put(
+      current_time_ +
+      std::min(Δt,
+               max_speculative_prolongation_steps *
+                   ephemeris_->planetary_step()));
+  if (pile_up_group_ != nullptr) {
+    // The vessels that are loaded are those of the previous step.  A vessel
+    // entering the physics bubble in this step doesn't cause any trouble, its
+    // pile-up will be deformed from its grouped history.
+    std::vector<not_null<PileUp*>> unloaded_pile_ups;
+    for (PileUp* const pile_up : pile_ups_) {
+      if (pile_up == nullptr) {
+        continue;
+      }
+      bool loaded = false;
+      for (not_null<Part*> const part : pile_up->parts()) {
+        loaded |= Contains(loaded_vessels_,
+                           FindOrDie(part_id_to_vessel_, part->part_id()));
+      }
+      if (!loaded) {
+        unloaded_pile_ups.push_back(pile_up);
+      }
+    }
+    // The histories are flowed on the vessel thread pool while the game runs
+    // its physics step.  The tasks that advance the pile-ups are added later
+    // to the same pool, and wait for this one.  An error dissolves the group
+    // and is reported when the pile-ups are advanced individually.
+    pile_up_group_advance_ = vessel_thread_pool_.Add(
+        [group = pile_up_group_.get(),
+         unloaded_pile_ups = std::move(unloaded_pile_ups),
+         t = current_time_]() {
+          group->AdvanceHistories(unloaded_pile_ups, t).IgnoreError();
+          return absl::OkStatus();
+        }).share();
+  }
   UpdatePlanetariumRotation();
   loaded_vessels_.clear();
 }
 
+void Plugin::SetPipelinedTimeStep(bool const enabled) {
+  CHECK(!initializing_);
+  if (enabled) {
+    ephemeris_prolongator_.Start();
+  } else {
+    ephemeris_prolongator_.Stop();
+  }
+}
+
+void Plugin::SetGroupedFixedStep(bool const enabled) {
+  CHECK(!initializing_);
+  WaitForPileUpGroup();
+  if (!enabled) {
+    pile_up_group_ = nullptr;
+  } else if (pile_up_group_ == nullptr) {
+    pile_up_group_ = std::make_unique<PileUpGroup>(
+        history_fixed_step_parameters_, ephemeris_.get());
+  }
+}
+
+void Plugin::SetCatchUpTimeBudget(
+    std::optional<std::chrono::microseconds> const& budget) {
+  catch_up_time_budget_ = budget;
+}
+
 void Plugin::CatchUpLaggingVessels(VesselSet& collided_vessels) {
   CHECK(!initializing_);
 
-  // Start all the integrations in parallel.
-  std::vector<PileUpFuture> pile_up_futures;
+  // Start the most expensive pile-ups first, so that an expensive pile-up
+  // doesn't end up running alone after all the others have completed.  The
+  // cost of a pile-up is predicted from that of its last advance.  The costs
+  // are read once before sorting, as reading them takes the lock of the
+  // pile-up.
+  std::vector<std::pair<std::pair<std::int64_t, std::int64_t>, PileUp*>>
+      costed_pile_ups;
   for (auto* const pile_up : pile_ups_) {
+    auto const cost = pile_up->last_advance_cost();
+    costed_pile_ups.emplace_back(std::pair(cost.evaluations, cost.steps),
+                                 pile_up);
+  }
+  std::stable_sort(costed_pile_ups.begin(),
+                   costed_pile_ups.end(),
+                   [](auto const& left, auto const& right) {
+                     return left.first > right.first;
+                   });
+  std::vector<PileUp*> scheduled_pile_ups;
+  for (auto const& [_, pile_up] : costed_pile_ups) {
+    scheduled_pile_ups.push_back(pile_up);
+  }
+
+  std::optional<std::chrono::steady_clock::time_point> deadline;
+  if (catch_up_time_budget_.has_value()) {
+    deadline = std::chrono::steady_clock::now() + *catch_up_time_budget_;
+  }
+
+  // Start all the integrations in parallel.  Each task also advances time on
+  // the vessels of its pile-up, so that a pile-up doesn't have to wait for the
+  // others.
+  std::vector<PileUpFuture> pile_up_futures;
+  // Set by the tasks for the pile-ups that they defer.  Each task only writes
+  // its own element, which is read after the task completes.
+  auto const deferred = std::make_unique<bool[]>(scheduled_pile_ups.size());
+  // The vessels given to the task of each pile-up.  A vessel whose parts are in
+  // several pile-ups is only given to the first one.
+  std::vector<std::vector<not_null<Vessel*>>> scheduled_vessels(
+      scheduled_pile_ups.size());
+  VesselSet vessels_with_task;
+  for (int i = 0; i < scheduled_pile_ups.size(); ++i) {
+    PileUp* const pile_up = scheduled_pile_ups[i];
+    // The vessels of this pile-up, with an indication of whether they were
+    // previously known to have collided.  This is computed here because
+    // |collided_vessels| is modified below while the tasks are running.
+    std::vector<std::pair<not_null<Vessel*>, bool>> pile_up_vessels;
+    // A pile-up may be deferred if it is not in the physics bubble and it was
+    // not deferred by the previous call, to avoid starving it.
+    bool deferrable =
+        deadline.has_value() && !Contains(deferred_pile_ups_, pile_up);
+    for (not_null<Part*> const part : pile_up->parts()) {
+      not_null<Vessel*> const vessel =
+          FindOrDie(part_id_to_vessel_, part->part_id());
+      if (vessels_with_task.insert(vessel).second) {
+        scheduled_vessels[i].push_back(vessel);
+        pile_up_vessels.emplace_back(vessel,
+                                     Contains(collided_vessels, vessel));
+        deferrable &= !Contains(loaded_vessels_, vessel);
+      }
+    }
     pile_up_futures.emplace_back(
         pile_up,
-        vessel_thread_pool_.Add([this, pile_up]() {
-          // Note that there cannot be contention in the following method as
-          // no two pile-ups are advanced at the same time.
-          return pile_up->DeformAndAdvanceTime(current_time_);
-        }));
+        vessel_thread_pool_.Add(
+            [this,
+             pile_up,
+             pile_up_vessels = std::move(pile_up_vessels),
+             deferrable,
+             deadline,
+             &is_deferred = deferred[i],
+             group_advance = pile_up_group_advance_]() {
+              if (group_advance.valid()) {
+                group_advance.wait();
+              }
+              // The budget is exhausted, leave this pile-up for the next call.
+              if (deferrable && std::chrono::steady_clock::now() >= *deadline) {
+                is_deferred = true;
+                return absl::OkStatus();
+              }
+              // Note that there cannot be contention in the following method
+              // as no two pile-ups are advanced at the same time.
+              absl::Status const status =
+                  pile_up->DeformAndAdvanceTime(current_time_);
+              for (auto const& [vessel, collided] : pile_up_vessels) {
+                if (vessel->psychohistory()->back().time < current_time_) {
+                  if (collided || !status.ok()) {
+                    vessel->DisableDownsampling();
+                  }
+                  vessel->AdvanceTime();
+                }
+              }
+              return status;
+            }));
   }
 
   // Wait for the integrations to finish and figure out which vessels collided
@@ -786,9 +1135,27 @@ void Plugin::CatchUpLaggingVessels(VesselSet& collided_vessels) {
     WaitForVesselToCatchUp(pile_up_future, collided_vessels);
   }
 
-  // Update the vessels.
+  // Only used for comparisons, the pile-ups may be destroyed before the next
+  // call.  The vessels are only known to be advanced once their task has run
+  // without deferring its pile-up.
+  deferred_pile_ups_.clear();
+  VesselSet advanced_vessels;
+  for (int i = 0; i < scheduled_pile_ups.size(); ++i) {
+    if (deferred[i]) {
+      deferred_pile_ups_.insert(scheduled_pile_ups[i]);
+    } else {
+      advanced_vessels.insert(scheduled_vessels[i].begin(),
+                              scheduled_vessels[i].end());
+    }
+  }
+
+  // Update the vessels that were not advanced by a task: those that are not in
+  // a pile-up, if any, and those of the deferred pile-ups.  The parts of the
+  // latter have no new points, so their vessels remain behind |current_time_|
+  // until their pile-up is advanced.
   for (auto const& [_, vessel] : vessels_) {
-    if (vessel->psychohistory()->back().time < current_time_) {
+    if (!Contains(advanced_vessels, vessel.get()) &&
+        vessel->psychohistory()->back().time < current_time_) {
       if (Contains(collided_vessels, vessel.get())) {
         vessel->DisableDownsampling();
       }
@@ -810,7 +1177,13 @@ not_null<std::unique_ptr<PileUpFuture>> Plugin::CatchUpVessel(
 
   return make_not_null_unique<PileUpFuture>(
       pile_up,
-      vessel_thread_pool_.Add([this, pile_up, &vessel]() {
+      vessel_thread_pool_.Add([this,
+                               pile_up,
+                               &vessel,
+                               group_advance = pile_up_group_advance_]() {
+        if (group_advance.valid()) {
+          group_advance.wait();
+        }
         // Note that there can be contention in the following method if the
         // caller is catching-up two vessels belonging to the same pile-up in
         // parallel.
@@ -941,6 +1314,80 @@ void Plugin::UpdatePrediction(std::vector<GUID> const& vessel_guids) const {
   }
 }
 
+absl::StatusOr<DegreesOfFreedom<Navigation>> Plugin::FlowFreefall(
+    NavigationFrame const& frame,
+    DegreesOfFreedom<Navigation> const& initial_degrees_of_freedom,
+    Instant const& t_initial,
+    Instant const& t_final) const {
+  CHECK(!initializing_);
+  if (t_final < t_initial) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Cannot flow backward from ", DebugString(t_initial),
+                     " to ", DebugString(t_final)));
+  }
+  if (t_initial < ephemeris_->t_min()) {
+    return absl::OutOfRangeError(
+        absl::StrCat(DebugString(t_initial), " is before the start ",
+                     DebugString(ephemeris_->t_min()), " of the ephemeris"));
+  }
+  // The frame needs the ephemeris at |t_initial| to convert the initial
+  // degrees of freedom.  For a batch this is a no-op, |FlowFreefalls| has
+  // prolonged the ephemeris already.
+  RETURN_IF_ERROR(ephemeris_->Prolong(std::max(t_initial, t_final)));
+
+  DiscreteTrajectory<Barycentric> trajectory;
+  RETURN_IF_ERROR(trajectory.Append(
+      t_initial,
+      frame.FromThisFrameAtTime(t_initial)(initial_degrees_of_freedom)));
+  RETURN_IF_ERROR(ephemeris_->FlowWithAdaptiveStep(
+      &trajectory,
+      Ephemeris<Barycentric>::NoIntrinsicAcceleration,
+      t_final,
+      DefaultPredictionParameters(),
+      /*max_ephemeris_steps=*/std::numeric_limits<std::int64_t>::max()));
+  return frame.ToThisFrameAtTime(t_final)(
+      trajectory.back().degrees_of_freedom);
+}
+
+std::vector<absl::StatusOr<DegreesOfFreedom<Navigation>>>
+Plugin::FlowFreefalls(
+    NavigationFrame const& frame,
+    std::vector<DegreesOfFreedom<Navigation>> const& initial_degrees_of_freedom,
+    std::vector<Instant> const& t_initial,
+    Instant const& t_final) const {
+  CHECK(!initializing_);
+  CHECK_EQ(initial_degrees_of_freedom.size(), t_initial.size());
+  // Prolong the ephemeris once, on this thread, so that the integrations only
+  // evaluate the shared trajectories of the celestials and don't contend for
+  // the lock of the ephemeris.
+  Instant t_max = t_final;
+  for (Instant const& t : t_initial) {
+    t_max = std::max(t_max, t);
+  }
+  ephemeris_->Prolong(t_max).IgnoreError();
+
+  std::vector<absl::StatusOr<DegreesOfFreedom<Navigation>>> results(
+      initial_degrees_of_freedom.size());
+  std::vector<std::future<absl::Status>> futures;
+  futures.reserve(initial_degrees_of_freedom.size());
+  for (int i = 0; i < initial_degrees_of_freedom.size(); ++i) {
+    // Each task writes to its own element of |results|.
+    futures.push_back(vessel_thread_pool_.Add(
+        [this, &frame, &initial_degrees_of_freedom, &t_initial, &t_final,
+         &results, i]() {
+          results[i] = FlowFreefall(frame,
+                                    initial_degrees_of_freedom[i],
+                                    t_initial[i],
+                                    t_final);
+          return absl::OkStatus();
+        }));
+  }
+  for (auto& future : futures) {
+    future.wait();
+  }
+  return results;
+}
+
 void Plugin::CreateFlightPlan(GUID const& vessel_guid,
                               Instant const& final_time,
                               Mass const& initial_mass) const {
@@ -1352,10 +1799,234 @@ Renderer const& Plugin::renderer() const {
   return *renderer_;
 }
 
+ThreadPool<void>& Plugin::plotting_thread_pool() const {
+  return plotting_thread_pool_;
+}
+
 void Plugin::WriteToMessage(
     not_null<serialization::Plugin*> const message) const {
+  WriteToMessage(
+      message,
+      /*write_vessel=*/
+      [message](Vessel const& vessel,
+                PileUp::SerializationIndexForPileUp const&
+                    serialization_index_for_pile_up,
+                serialization::Plugin::VesselAndProperties& vessel_message) {
+        vessel.WriteToMessage(vessel_message.mutable_vessel(),
+                              serialization_index_for_pile_up);
+        message->add_vessel()->Swap(&vessel_message);
+      },
+      /*write_ephemeris=*/[message](Ephemeris<Barycentric> const& ephemeris) {
+        ephemeris.WriteToMessage(message->mutable_ephemeris());
+      });
+}
+
+void Plugin::WriteToSnapshot(not_null<SnapshotWriter*> const snapshot) {
+  LOG(INFO) << __FUNCTION__;
+  SnapshotBase base{.identifier = NewSnapshotIdentifier()};
+  serialization::Plugin message;
+  WriteToMessage(
+      &message,
+      /*write_vessel=*/
+      [snapshot, &base](
+          Vessel const& vessel,
+          PileUp::SerializationIndexForPileUp const&
+              serialization_index_for_pile_up,
+          serialization::Plugin::VesselAndProperties& vessel_message) {
+        auto& history_segments = base.history_segments[vessel.guid()];
+        WriteVesselToSnapshot(
+            vessel,
+            serialization_index_for_pile_up,
+            vessel_message,
+            /*first_point_to_write=*/
+            [&history_segments](
+                int const index,
+                DiscreteTrajectorySegment<Barycentric> const& segment,
+                DiscreteTrajectory<Barycentric>::iterator const begin,
+                DiscreteTrajectory<Barycentric>::iterator const end) {
+              if (begin != end) {
+                history_segments.emplace(
+                    &segment,
+                    SnapshotBase::HistorySegment{
+                        .index = index,
+                        .first_time = begin->time,
+                        .last_time = std::prev(end)->time});
+              }
+              return begin;
+            },
+            *snapshot);
+      },
+      /*write_ephemeris=*/
+      [snapshot, &base](Ephemeris<Barycentric> const& ephemeris) {
+        serialization::Ephemeris ephemeris_message;
+        std::vector<std::vector<double>> polynomials;
+        ephemeris.WriteToMessage(
+            &ephemeris_message, /*after=*/InfinitePast, polynomials);
+        base.ephemeris_time = LastCheckpointTime(ephemeris_message);
+        WriteEphemerisToSnapshot(ephemeris_message, polynomials, *snapshot);
+      });
+  snapshot->WriteMessage(plugin_snapshot_tag, message);
+
+  serialization::PluginSnapshot header;
+  header.set_identifier(base.identifier);
+  snapshot->WriteMessage(header_snapshot_tag, header);
+
+  // Further changes to the histories are relative to this snapshot.
+  for (auto const& [_, vessel] : vessels_) {
+    vessel->MarkTrajectoryUnchanged();
+  }
+  snapshot_base_ = std::move(base);
+}
+
+not_null<std::unique_ptr<Plugin>> Plugin::ReadFromSnapshot(
+    SnapshotReader const& snapshot) {
+  LOG(INFO) << __FUNCTION__;
+  serialization::Plugin message;
+  SnapshotArrays arrays;
+  SnapshotHistorySegments history_segments;
+  auto base =
+      ReadFullSnapshot(snapshot, &message, &arrays, &history_segments);
+  auto plugin = ReadFromMessage(message, &arrays);
+  if (base.has_value()) {
+    plugin->SetSnapshotBase(*std::move(base), history_segments);
+  }
+  return plugin;
+}
+
+bool Plugin::HasSnapshotBase() const {
+  return snapshot_base_.has_value();
+}
+
+void Plugin::WriteDeltaToSnapshot(
+    not_null<SnapshotWriter*> const snapshot) const {
+  LOG(INFO) << __FUNCTION__;
+  CHECK(HasSnapshotBase());
+  SnapshotBase const& base = *snapshot_base_;
+
+  serialization::PluginSnapshot header;
+  header.set_identifier(NewSnapshotIdentifier());
+  auto* const delta = header.mutable_delta();
+  delta->set_base_identifier(base.identifier);
+
+  serialization::Plugin message;
+  WriteToMessage(
+      &message,
+      /*write_vessel=*/
+      [snapshot, &base, delta](
+          Vessel const& vessel,
+          PileUp::SerializationIndexForPileUp const&
+              serialization_index_for_pile_up,
+          serialization::Plugin::VesselAndProperties& vessel_message) {
+        auto* const vessel_delta = delta->add_vessel();
+        vessel_delta->set_guid(vessel.guid());
+        auto const it = base.history_segments.find(vessel.guid());
+        WriteVesselToSnapshot(
+            vessel,
+            serialization_index_for_pile_up,
+            vessel_message,
+            /*first_point_to_write=*/
+            [&base, it, vessel_delta](
+                int const index,
+                DiscreteTrajectorySegment<Barycentric> const& segment,
+                DiscreteTrajectory<Barycentric>::iterator const begin,
+                DiscreteTrajectory<Barycentric>::iterator const end) {
+              auto* const segment_delta = vessel_delta->add_segment();
+              if (begin == end || it == base.history_segments.end()) {
+                return begin;
+              }
+              auto const jt = it->second.find(&segment);
+              if (jt == it->second.end()) {
+                return begin;
+              }
+              // The points of the base that are still in the segment are
+              // those before the earliest change, and they may have been
+              // forgotten at the beginning of the segment.
+              auto const& base_segment = jt->second;
+              Instant const& earliest_change = segment.earliest_change();
+              if (begin->time < base_segment.first_time ||
+                  begin->time > base_segment.last_time ||
+                  begin->time >= earliest_change) {
+                return begin;
+              }
+              auto split = earliest_change <= base_segment.last_time
+                               ? segment.lower_bound(earliest_change)
+                               : segment.upper_bound(base_segment.last_time);
+              if (split == segment.end() ||
+                  split->time > std::prev(end)->time) {
+                split = end;
+              }
+              segment_delta->set_base_segment(base_segment.index);
+              begin->time.WriteToMessage(
+                  segment_delta->mutable_base_begin_time());
+              segment_delta->set_base_points(split - begin);
+              return split;
+            },
+            *snapshot);
+      },
+      /*write_ephemeris=*/
+      [snapshot, &base](Ephemeris<Barycentric> const& ephemeris) {
+        serialization::Ephemeris ephemeris_message;
+        std::vector<std::vector<double>> polynomials;
+        ephemeris.WriteToMessage(
+            &ephemeris_message, /*after=*/base.ephemeris_time, polynomials);
+        WriteEphemerisToSnapshot(ephemeris_message, polynomials, *snapshot);
+      });
+  snapshot->WriteMessage(plugin_snapshot_tag, message);
+  snapshot->WriteMessage(header_snapshot_tag, header);
+}
+
+not_null<std::unique_ptr<Plugin>> Plugin::ReadFromSnapshot(
+    SnapshotReader const& base,
+    SnapshotReader const& delta) {
+  LOG(INFO) << __FUNCTION__;
+  serialization::Plugin message;
+  SnapshotArrays arrays;
+  SnapshotHistorySegments history_segments;
+  auto snapshot_base =
+      ReadFullSnapshot(base, &message, &arrays, &history_segments);
+  CHECK(snapshot_base.has_value()) << "The base snapshot predates deltas";
+  ReadDeltaSnapshot(delta,
+                    snapshot_base->identifier,
+                    &message,
+                    &arrays,
+                    &history_segments);
+  auto plugin = ReadFromMessage(message, &arrays);
+  // Further deltas are relative to the same base.
+  plugin->SetSnapshotBase(*std::move(snapshot_base), history_segments);
+  return plugin;
+}
+
+void Plugin::CompactSnapshots(SnapshotReader const& base,
+                              SnapshotReader const& delta,
+                              not_null<SnapshotWriter*> const snapshot) {
+  LOG(INFO) << __FUNCTION__;
+  serialization::Plugin message;
+  SnapshotArrays arrays;
+  SnapshotHistorySegments history_segments;
+  auto const snapshot_base =
+      ReadFullSnapshot(base, &message, &arrays, &history_segments);
+  CHECK(snapshot_base.has_value()) << "The base snapshot predates deltas";
+  ReadDeltaSnapshot(delta,
+                    snapshot_base->identifier,
+                    &message,
+                    &arrays,
+                    &history_segments);
+  WriteFullSnapshot(message, arrays, snapshot);
+}
+
+void Plugin::WriteToMessage(
+    not_null<serialization::Plugin*> const message,
+    std::function<void(
+        Vessel const& vessel,
+        PileUp::SerializationIndexForPileUp const&
+            serialization_index_for_pile_up,
+        serialization::Plugin::VesselAndProperties& vessel_message)> const&
+        write_vessel,
+    std::function<void(Ephemeris<Barycentric> const& ephemeris)> const&
+        write_ephemeris) const {
   LOG(INFO) << __FUNCTION__;
   CHECK(!initializing_);
+  WaitForPileUpGroup();
   if (system_fingerprint_ != 0) {
     message->set_system_fingerprint(system_fingerprint_);
   }
@@ -1390,14 +2061,13 @@ void Plugin::WriteToMessage(
   std::map<not_null<Vessel const*>, GUID const> vessel_to_guid;
   for (auto const& [guid, vessel] : vessels_) {
     vessel_to_guid.emplace(vessel.get(), guid);
-    auto* const vessel_message = message->add_vessel();
-    vessel_message->set_guid(guid);
-    vessel->WriteToMessage(vessel_message->mutable_vessel(),
-                           serialization_index_for_pile_up);
+    serialization::Plugin::VesselAndProperties vessel_message;
+    vessel_message.set_guid(guid);
     Index const parent_index = FindOrDie(celestial_to_index, vessel->parent());
-    vessel_message->set_parent_index(parent_index);
-    vessel_message->set_loaded(Contains(loaded_vessels_, vessel.get()));
-    vessel_message->set_kept(Contains(kept_vessels_, vessel.get()));
+    vessel_message.set_parent_index(parent_index);
+    vessel_message.set_loaded(Contains(loaded_vessels_, vessel.get()));
+    vessel_message.set_kept(Contains(kept_vessels_, vessel.get()));
+    write_vessel(*vessel, serialization_index_for_pile_up, vessel_message);
   }
   for (auto const& [part_id, vessel] : part_id_to_vessel_) {
     (*message->mutable_part_id_to_vessel())[part_id] = vessel_to_guid[vessel];
@@ -1409,7 +2079,7 @@ void Plugin::WriteToMessage(
     parameters.WriteToMessage(zombie_message->mutable_prediction_parameters());
   }
 
-  ephemeris_->WriteToMessage(message->mutable_ephemeris());
+  write_ephemeris(*ephemeris_);
 
   // |history_downsampling_parameters_| is not persisted.
   history_fixed_step_parameters_.WriteToMessage(
@@ -1429,8 +2099,199 @@ void Plugin::WriteToMessage(
   }
 }
 
+std::optional<Plugin::SnapshotBase> Plugin::ReadFullSnapshot(
+    SnapshotReader const& snapshot,
+    not_null<serialization::Plugin*> const message,
+    not_null<SnapshotArrays*> const arrays,
+    not_null<SnapshotHistorySegments*> const history_segments) {
+  std::optional<SnapshotBase> base;
+  auto const header_sections = snapshot.FindSections(header_snapshot_tag);
+  if (!header_sections.empty()) {
+    CHECK_EQ(1, header_sections.size());
+    serialization::PluginSnapshot header;
+    snapshot.ReadMessage(header_sections.front(), &header);
+    CHECK(!header.has_delta()) << "Not a full snapshot";
+    base = SnapshotBase{.identifier = header.identifier()};
+  }
+
+  // Reassemble the message from its sections.
+  auto const plugin_sections = snapshot.FindSections(plugin_snapshot_tag);
+  CHECK_EQ(1, plugin_sections.size());
+  snapshot.ReadMessage(plugin_sections.front(), message);
+  ReadEphemerisAndVessels(
+      snapshot, *message, arrays->polynomials, arrays->history_points);
+  if (base.has_value()) {
+    base->ephemeris_time = LastCheckpointTime(message->ephemeris());
+    history_segments->clear();
+    for (auto const& [guid, segments_points] : arrays->history_points) {
+      auto& vessel_history_segments = (*history_segments)[guid];
+      for (int index = 0; index < segments_points.size(); ++index) {
+        CHECK_EQ(1, segments_points[index].size());
+        auto const& points = segments_points[index].front();
+        std::int64_t const size =
+            points.size /
+            DiscreteTrajectorySegment<Barycentric>::doubles_per_point;
+        if (size == 0) {
+          vessel_history_segments.emplace_back();
+        } else {
+          vessel_history_segments.emplace_back(SnapshotBase::HistorySegment{
+              .index = index,
+              .first_time = HistoryPointTime(points, 0),
+              .last_time = HistoryPointTime(points, size - 1)});
+        }
+      }
+    }
+  }
+  return base;
+}
+
+void Plugin::ReadDeltaSnapshot(
+    SnapshotReader const& delta,
+    std::uint64_t const base_identifier,
+    not_null<serialization::Plugin*> const message,
+    not_null<SnapshotArrays*> const arrays,
+    not_null<SnapshotHistorySegments*> const history_segments) {
+  auto const header_sections = delta.FindSections(header_snapshot_tag);
+  CHECK_EQ(1, header_sections.size());
+  serialization::PluginSnapshot header;
+  delta.ReadMessage(header_sections.front(), &header);
+  CHECK(header.has_delta()) << "Not a delta snapshot";
+  auto const& delta_header = header.delta();
+  CHECK_EQ(base_identifier, delta_header.base_identifier())
+      << "The delta snapshot was not written relative to this base";
+
+  // The skeleton of the delta replaces that of the base.
+  serialization::Plugin base_message;
+  SnapshotArrays base_arrays;
+  message->Swap(&base_message);
+  std::swap(*arrays, base_arrays);
+  auto const plugin_sections = delta.FindSections(plugin_snapshot_tag);
+  CHECK_EQ(1, plugin_sections.size());
+  delta.ReadMessage(plugin_sections.front(), message);
+  ReadEphemerisAndVessels(
+      delta, *message, arrays->polynomials, arrays->history_points);
+
+  // The checkpoints and the polynomials of the delta were appended to those of
+  // the base.
+  auto* const ephemeris = message->mutable_ephemeris();
+  auto& base_ephemeris = *base_message.mutable_ephemeris();
+  PrependFromBase(*base_ephemeris.mutable_checkpoint(),
+                  *ephemeris->mutable_checkpoint());
+  CHECK_EQ(base_ephemeris.trajectory_size(), ephemeris->trajectory_size());
+  CHECK_EQ(base_arrays.polynomials.size(), arrays->polynomials.size());
+  for (int i = 0; i < ephemeris->trajectory_size(); ++i) {
+    PrependFromBase(
+        *base_ephemeris.mutable_trajectory(i)->mutable_checkpoint(),
+        *ephemeris->mutable_trajectory(i)->mutable_checkpoint());
+    auto& polynomials = arrays->polynomials[i];
+    polynomials.insert(polynomials.begin(),
+                       base_arrays.polynomials[i].begin(),
+                       base_arrays.polynomials[i].end());
+  }
+
+  // The points of the histories of the delta may start with points of the
+  // base.
+  history_segments->clear();
+  CHECK_EQ(delta_header.vessel_size(), message->vessel_size());
+  for (int i = 0; i < delta_header.vessel_size(); ++i) {
+    auto const& vessel_delta = delta_header.vessel(i);
+    GUID const& guid = vessel_delta.guid();
+    CHECK_EQ(guid, message->vessel(i).guid());
+    auto& history_points = arrays->history_points[guid];
+    CHECK_EQ(vessel_delta.segment_size(), history_points.size());
+    auto& vessel_history_segments = (*history_segments)[guid];
+    for (int index = 0; index < vessel_delta.segment_size(); ++index) {
+      auto const& segment_delta = vessel_delta.segment(index);
+      if (!segment_delta.has_base_segment()) {
+        vessel_history_segments.emplace_back();
+        continue;
+      }
+      auto const& base_history_points =
+          FindOrDie(base_arrays.history_points, guid);
+      CHECK_LT(segment_delta.base_segment(), base_history_points.size());
+      auto const& base_segment_points =
+          base_history_points[segment_delta.base_segment()];
+      CHECK_EQ(1, base_segment_points.size());
+      CHECK_LT(0, segment_delta.base_points());
+      auto const points = HistoryPointsFrom(
+          base_segment_points.front(),
+          Instant::ReadFromMessage(segment_delta.base_begin_time()),
+          segment_delta.base_points());
+      history_points[index].insert(history_points[index].begin(), points);
+      vessel_history_segments.emplace_back(SnapshotBase::HistorySegment{
+          .index = segment_delta.base_segment(),
+          .first_time = HistoryPointTime(points, 0),
+          .last_time =
+              HistoryPointTime(points, segment_delta.base_points() - 1)});
+    }
+  }
+}
+
+void Plugin::SetSnapshotBase(SnapshotBase base,
+                             SnapshotHistorySegments const& history_segments) {
+  base.history_segments.clear();
+  for (auto const& [guid, vessel] : vessels_) {
+    vessel->MarkTrajectoryUnchanged();
+    auto const it = history_segments.find(guid);
+    if (it == history_segments.end()) {
+      continue;
+    }
+    auto& vessel_history_segments = base.history_segments[guid];
+    auto segment = vessel->trajectory().segments().begin();
+    for (auto const& history_segment : it->second) {
+      if (segment == vessel->trajectory().segments().end()) {
+        break;
+      }
+      if (history_segment.has_value()) {
+        vessel_history_segments.emplace(&*segment, *history_segment);
+      }
+      ++segment;
+    }
+  }
+  snapshot_base_ = std::move(base);
+}
+
+void Plugin::WriteFullSnapshot(serialization::Plugin& message,
+                               SnapshotArrays const& arrays,
+                               not_null<SnapshotWriter*> const snapshot) {
+  for (auto const& vessel_message : message.vessel()) {
+    snapshot->WriteMessage(vessel_snapshot_tag, vessel_message);
+    if (auto const it = arrays.history_points.find(vessel_message.guid());
+        it != arrays.history_points.end()) {
+      CHECK_EQ(vessel_message.vessel().history().segment_size(),
+               it->second.size());
+      for (auto const& segment_points : it->second) {
+        snapshot->WriteDoubles(history_points_snapshot_tag,
+                               Concatenate(segment_points));
+      }
+    }
+  }
+  if (arrays.polynomials.empty()) {
+    snapshot->WriteMessage(ephemeris_snapshot_tag, message.ephemeris());
+  } else {
+    std::vector<std::vector<double>> polynomials;
+    for (auto const& trajectory_polynomials : arrays.polynomials) {
+      polynomials.push_back(Concatenate(trajectory_polynomials));
+    }
+    WriteEphemerisToSnapshot(message.ephemeris(), polynomials, *snapshot);
+  }
+  message.clear_vessel();
+  message.clear_ephemeris();
+  snapshot->WriteMessage(plugin_snapshot_tag, message);
+
+  serialization::PluginSnapshot header;
+  header.set_identifier(NewSnapshotIdentifier());
+  snapshot->WriteMessage(header_snapshot_tag, header);
+}
+
 not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
     serialization::Plugin const& message) {
+  return ReadFromMessage(message, /*arrays=*/nullptr);
+}
+
+not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
+    serialization::Plugin const& message,
+    SnapshotArrays const* const arrays) {
   LOG(INFO) << __FUNCTION__;
 
   auto const history_parameters =
@@ -1472,10 +2333,18 @@ not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
   // current time: an older checkpoint would require unnecessary work in
   // Prolong that could be postponed until reanimation; a newer checkpoint would
   // not cover the current time.
-  plugin->ephemeris_ =
-      Ephemeris<Barycentric>::ReadFromMessage(/*using_checkpoint_at_or_before=*/
-                                              plugin->current_time_,
-                                              message.ephemeris());
+  // Snapshots written before the arrays were introduced have no polynomials
+  // outside of |message|.
+  if (arrays == nullptr || arrays->polynomials.empty()) {
+    plugin->ephemeris_ = Ephemeris<Barycentric>::ReadFromMessage(
+        /*using_checkpoint_at_or_before=*/plugin->current_time_,
+        message.ephemeris());
+  } else {
+    plugin->ephemeris_ = Ephemeris<Barycentric>::ReadFromMessage(
+        /*using_checkpoint_at_or_before=*/plugin->current_time_,
+        message.ephemeris(),
+        arrays->polynomials);
+  }
   plugin->ephemeris_->Prolong(plugin->game_epoch_).IgnoreError();
   plugin->ephemeris_->Prolong(plugin->current_time_).IgnoreError();
   CHECK_LE(plugin->ephemeris_->t_min(), plugin->current_time_);
@@ -1488,14 +2357,30 @@ not_null<std::unique_ptr<Plugin>> Plugin::ReadFromMessage(
   for (auto const& vessel_message : message.vessel()) {
     not_null<Celestial const*> const parent =
         FindOrDie(plugin->celestials_, vessel_message.parent_index()).get();
-    not_null<std::unique_ptr<Vessel>> vessel = Vessel::ReadFromMessage(
-        vessel_message.vessel(),
-        parent,
-        plugin->ephemeris_.get(),
+    auto const deletion_callback =
         [&part_id_to_vessel = plugin->part_id_to_vessel_](
             PartId const part_id) {
           CHECK_NE(part_id_to_vessel.erase(part_id), 0) << part_id;
-        });
+        };
+    std::vector<std::vector<Array<double const>>> const* history_points =
+        nullptr;
+    if (arrays != nullptr) {
+      auto const it = arrays->history_points.find(vessel_message.guid());
+      if (it != arrays->history_points.end()) {
+        history_points = &it->second;
+      }
+    }
+    not_null<std::unique_ptr<Vessel>> vessel =
+        history_points == nullptr
+            ? Vessel::ReadFromMessage(vessel_message.vessel(),
+                                      parent,
+                                      plugin->ephemeris_.get(),
+                                      deletion_callback)
+            : Vessel::ReadFromMessage(vessel_message.vessel(),
+                                      parent,
+                                      plugin->ephemeris_.get(),
+                                      deletion_callback,
+                                      *history_points);
 
     if (vessel_message.loaded()) {
       plugin->loaded_vessels_.insert(vessel.get());
@@ -1585,11 +2470,16 @@ Plugin::Plugin(
     Ephemeris<Barycentric>::FixedStepParameters history_parameters,
     Ephemeris<Barycentric>::AdaptiveStepParameters
         psychohistory_parameters)
-    : history_downsampling_parameters_(DefaultDownsamplingParameters()),
+    : ephemeris_prolongator_(
+          [this](Instant const& t) { return ProlongSpeculatively(t); },
+          5ms),  // 200 Hz.
+      history_downsampling_parameters_(DefaultDownsamplingParameters()),
       history_fixed_step_parameters_(std::move(history_parameters)),
       psychohistory_parameters_(std::move(psychohistory_parameters)),
       vessel_thread_pool_(
-          /*pool_size=*/2 * std::thread::hardware_concurrency()) {}
+          /*pool_size=*/2 * std::thread::hardware_concurrency()),
+      plotting_thread_pool_(
+          /*pool_size=*/std::thread::hardware_concurrency()) {}
 
 void Plugin::InitializeIndices(std::string const& name,
                                Index const celestial_index,
@@ -1602,6 +2492,23 @@ void Plugin::InitializeIndices(std::string const& name,
   CHECK(inserted) << celestial_index;
 }
 
+absl::Status Plugin::ProlongSpeculatively(Instant const& t) {
+  // Prolong one step at a time so that |Stop| doesn't have to wait for the end
+  // of the entire prolongation.
+  while (ephemeris_->t_max() < t) {
+    RETURN_IF_STOPPED;
+    RETURN_IF_ERROR(ephemeris_->Prolong(
+        std::min(t, ephemeris_->t_max() + ephemeris_->planetary_step())));
+  }
+  return absl::OkStatus();
+}
+
+void Plugin::WaitForPileUpGroup() const {
+  if (pile_up_group_advance_.valid()) {
+    pile_up_group_advance_.wait();
+  }
+}
+
 void Plugin::UpdatePlanetariumRotation() {
   using PlanetariumFrame = Frame<struct PlanetariumFrameTag>;
 
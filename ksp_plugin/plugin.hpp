@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <future>
 #include <limits>
 #include <list>
@@ -12,7 +15,11 @@
 #include <vector>
 
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "base/array.hpp"
 #include "base/monostable.hpp"
+#include "base/recurring_thread.hpp"
+#include "base/snapshot.hpp"
 #include "base/thread_pool.hpp"
 #include "geometry/affine_map.hpp"
 #include "geometry/grassmann.hpp"
@@ -54,9 +61,12 @@ class TestablePlugin;
 namespace _plugin {
 namespace internal {
 
+using namespace principia::base::_array;
 using namespace principia::base::_disjoint_sets;
 using namespace principia::base::_monostable;
 using namespace principia::base::_not_null;
+using namespace principia::base::_recurring_thread;
+using namespace principia::base::_snapshot;
 using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_affine_map;
 using namespace principia::geometry::_grassmann;
@@ -292,10 +302,39 @@ class Plugin {
   // |Planetarium.InverseRotAngle| is in degrees.
   virtual void AdvanceTime(Instant const& t, Angle const& planetarium_rotation);
 
+  // Enables or disables the pipelined time step.  When it is enabled, each call
+  // to |AdvanceTime| starts prolonging the ephemeris on a background thread up
+  // to the time that the next call is expected to reach, assuming that the
+  // time step doesn't change.  The next call then finds the ephemeris already
+  // prolonged (or being prolonged) and doesn't have to integrate it on the
+  // game thread.  This function is idempotent.
+  virtual void SetPipelinedTimeStep(bool enabled);
+
+  // Enables or disables the grouped fixed step.  When it is enabled, each call
+  // to |AdvanceTime| flows the histories of all the pile-ups that were not in
+  // the physics bubble and not subject to an intrinsic force together, sharing
+  // the evaluations of the gravitational field.  The flow runs asynchronously
+  // on the vessel thread pool; the functions that modify or advance the
+  // pile-ups wait for it.  This function is idempotent.
+  virtual void SetGroupedFixedStep(bool enabled);
+
+  // Sets the time budget of |CatchUpLaggingVessels|.  Once it is exhausted,
+  // the pile ups that are not yet started and are not in the physics bubble are
+  // deferred to the next call, unless they were already deferred by the
+  // previous one.  If |budget| is null, which is the default, no pile up is
+  // ever deferred.
+  virtual void SetCatchUpTimeBudget(
+      std::optional<std::chrono::microseconds> const& budget);
+
   // Advances time to |current_time_| for all pile ups that are not already
-  // there, filling the tails of all their parts up to that instant; then
-  // advances time on all vessels that are not yet at |current_time_|.  Inserts
-  // the set of vessels that have collided with a celestial into
+  // there (except those deferred because of the time budget), filling the tails
+  // of all their parts up to that instant; then advances time on all vessels
+  // that are not yet at |current_time_|.  The vessels of a deferred pile up
+  // only get the points of their parts, so they remain behind |current_time_|
+  // until their pile up is advanced.  The pile ups are started by
+  // decreasing predicted cost, and each vessel is advanced by the task that
+  // advances its pile up, so the pile ups proceed independently of each other.
+  // Inserts the set of vessels that have collided with a celestial into
   // |collided_vessels|.
   virtual void CatchUpLaggingVessels(VesselSet& collided_vessels);
 
@@ -340,6 +379,28 @@ class Plugin {
   // Updates the prediction for the vessels with guids in |vessel_guids|.
   void UpdatePrediction(std::vector<GUID> const& vessel_guids) const;
 
+  // Returns the degrees of freedom at |t_final| of a massless body in free fall
+  // in the gravitational field of the celestials, starting from
+  // |initial_degrees_of_freedom| at |t_initial|.  The degrees of freedom are
+  // expressed in |frame|.  |t_final| must not be before |t_initial|.
+  virtual absl::StatusOr<DegreesOfFreedom<Navigation>> FlowFreefall(
+      NavigationFrame const& frame,
+      DegreesOfFreedom<Navigation> const& initial_degrees_of_freedom,
+      Instant const& t_initial,
+      Instant const& t_final) const;
+
+  // Same as above for a batch of bodies, all of them flowed until |t_final|.
+  // The ephemeris is prolonged once for the entire batch, and the bodies are
+  // then integrated concurrently.  The result at index |i| corresponds to
+  // |initial_degrees_of_freedom[i]| at |t_initial[i]|.
+  virtual std::vector<absl::StatusOr<DegreesOfFreedom<Navigation>>>
+  FlowFreefalls(
+      NavigationFrame const& frame,
+      std::vector<DegreesOfFreedom<Navigation>> const&
+          initial_degrees_of_freedom,
+      std::vector<Instant> const& t_initial,
+      Instant const& t_final) const;
+
   virtual void CreateFlightPlan(GUID const& vessel_guid,
                                 Instant const& final_time,
                                 Mass const& initial_mass) const;
@@ -451,11 +512,46 @@ class Plugin {
   virtual Renderer& renderer();
   virtual Renderer const& renderer() const;
 
+  // The thread pool used by the interface to plot trajectories concurrently.
+  ThreadPool<void>& plotting_thread_pool() const;
+
   // Must be called after initialization.
   virtual void WriteToMessage(not_null<serialization::Plugin*> message) const;
   static not_null<std::unique_ptr<Plugin>> ReadFromMessage(
       serialization::Plugin const& message);
 
+  // Same as above, but using a snapshot.  The ephemeris and each vessel are
+  // written to separate sections as soon as they are serialized, so that at
+  // most one of them is held in memory in serialized form.  The points of the
+  // histories and the polynomials of the trajectories are not serialized as
+  // protocol buffers, they are written as arrays of doubles.  Reading takes
+  // place directly from the mapped file, and the arrays are used in place.
+  virtual void WriteToSnapshot(not_null<SnapshotWriter*> snapshot);
+  static not_null<std::unique_ptr<Plugin>> ReadFromSnapshot(
+      SnapshotReader const& snapshot);
+
+  // The base of the plugin is the last full snapshot written by
+  // |WriteToSnapshot| or read by |ReadFromSnapshot|.  |WriteDeltaToSnapshot|
+  // writes to |snapshot| the changes since the base: the checkpoints and
+  // polynomials of the ephemeris that were appended since the base, and the
+  // points of the histories that are not in the base.  The changes are tracked
+  // by the histories themselves, so the base is not compared with the current
+  // state.  Deltas are relative to the base, not to the previous delta, so only
+  // the base and the last delta are needed to restore the plugin.  Must only be
+  // called if |HasSnapshotBase()|.
+  virtual bool HasSnapshotBase() const;
+  virtual void WriteDeltaToSnapshot(not_null<SnapshotWriter*> snapshot) const;
+  // Reads the plugin from the full snapshot |base| updated by |delta|, which
+  // must have been written relative to |base|.
+  static not_null<std::unique_ptr<Plugin>> ReadFromSnapshot(
+      SnapshotReader const& base,
+      SnapshotReader const& delta);
+  // Writes to |snapshot| the full snapshot obtained by applying |delta| to
+  // |base|.  This doesn't require constructing a plugin.
+  static void CompactSnapshots(SnapshotReader const& base,
+                               SnapshotReader const& delta,
+                               not_null<SnapshotWriter*> snapshot);
+
  private:
   using GUIDToOwnedVessel = std::map<GUID, not_null<std::unique_ptr<Vessel>>>;
   using IndexToOwnedCelestial =
@@ -477,6 +573,15 @@ class Plugin {
   // whenever |main_body_| or |planetarium_rotation_| changes.
   void UpdatePlanetariumRotation();
 
+  // The action of |ephemeris_prolongator_|: prolongs |ephemeris_| up to |t|,
+  // checking between steps whether the thread is stopped.
+  absl::Status ProlongSpeculatively(Instant const& t);
+
+  // Waits for the flow of the histories started by |AdvanceTime| for the
+  // |pile_up_group_|, if any.  Must be called before the pile-ups are modified,
+  // destroyed, or serialized on the calling thread.
+  void WaitForPileUpGroup() const;
+
   Velocity<World> VesselVelocity(
       Instant const& time,
       DegreesOfFreedom<Barycentric> const& degrees_of_freedom) const;
@@ -501,6 +606,87 @@ class Plugin {
   // Whether |loaded_vessels_| contains |vessel|.
   bool is_loaded(not_null<Vessel*> vessel) const;
 
+  // Implementation of serialization.  For each vessel, |write_vessel| is
+  // called with a |vessel_message| where all the fields except |vessel| are
+  // set; it must complete and store |vessel_message|.  Similarly,
+  // |write_ephemeris| must write the ephemeris.  All other parts of the plugin
+  // are written to |message|.
+  void WriteToMessage(
+      not_null<serialization::Plugin*> message,
+      std::function<void(
+          Vessel const& vessel,
+          PileUp::SerializationIndexForPileUp const&
+              serialization_index_for_pile_up,
+          serialization::Plugin::VesselAndProperties& vessel_message)> const&
+          write_vessel,
+      std::function<void(Ephemeris<Barycentric> const& ephemeris)> const&
+          write_ephemeris) const;
+
+  // The arrays of doubles read from snapshots.  They are views of the mapped
+  // files.
+  struct SnapshotArrays {
+    // Indexed by trajectory of the ephemeris, then by section.
+    std::vector<std::vector<Array<double const>>> polynomials;
+    // Indexed by segment of the history of each vessel, then by section.
+    std::map<GUID, std::vector<std::vector<Array<double const>>>>
+        history_points;
+  };
+
+  // Implementation of deserialization.  If |arrays| is null, the points of the
+  // histories and the polynomials of the trajectories are read from |message|.
+  static not_null<std::unique_ptr<Plugin>> ReadFromMessage(
+      serialization::Plugin const& message,
+      SnapshotArrays const* arrays);
+
+  // The parts of a full snapshot that may be omitted from a delta.
+  struct SnapshotBase {
+    // The points of a segment of a history that are in the base.
+    struct HistorySegment {
+      // The index of the segment in the history of the vessel in the base.
+      int index;
+      Instant first_time;
+      Instant last_time;
+    };
+    std::uint64_t identifier;
+    // The time of the last checkpoint of the ephemeris in the base.
+    Instant ephemeris_time;
+    // The segments of the histories that have points in the base.
+    std::map<GUID,
+             std::map<DiscreteTrajectorySegment<Barycentric> const*,
+                      HistorySegment>>
+        history_segments;
+  };
+  // The segments of the histories that have points in the base, indexed by
+  // vessel and then by position in the history, as read from a snapshot.
+  using SnapshotHistorySegments =
+      std::map<GUID, std::vector<std::optional<SnapshotBase::HistorySegment>>>;
+
+  // Reads the full |snapshot| into |message| and |arrays|.  Returns the
+  // description of the snapshot as a base, or null if the snapshot predates
+  // deltas.  In the former case, fills |history_segments|.
+  static std::optional<SnapshotBase> ReadFullSnapshot(
+      SnapshotReader const& snapshot,
+      not_null<serialization::Plugin*> message,
+      not_null<SnapshotArrays*> arrays,
+      not_null<SnapshotHistorySegments*> history_segments);
+  // Applies |delta| to |message| and |arrays|, which must have been read from
+  // the base with the given |base_identifier|.  Replaces |history_segments|
+  // with the segments that have points in the base after applying |delta|.
+  static void ReadDeltaSnapshot(
+      SnapshotReader const& delta,
+      std::uint64_t base_identifier,
+      not_null<serialization::Plugin*> message,
+      not_null<SnapshotArrays*> arrays,
+      not_null<SnapshotHistorySegments*> history_segments);
+  // Sets the base of this plugin, which must just have been read from a
+  // snapshot, and records that its histories are unchanged.
+  void SetSnapshotBase(SnapshotBase base,
+                       SnapshotHistorySegments const& history_segments);
+  // Writes |message| and |arrays| to |snapshot| as a full snapshot.
+  static void WriteFullSnapshot(serialization::Plugin& message,
+                                SnapshotArrays const& arrays,
+                                not_null<SnapshotWriter*> snapshot);
+
   // Initialization objects.
   Monostable initializing_;
   serialization::GravityModel gravity_model_;
@@ -526,6 +712,10 @@ class Plugin {
 
   // Not null after initialization.
   std::unique_ptr<Ephemeris<Barycentric>> ephemeris_;
+  // Prolongs |ephemeris_| speculatively when the pipelined time step is
+  // enabled.  Declared after |ephemeris_| so that it is stopped before the
+  // ephemeris is destroyed.
+  RecurringThread<Instant> ephemeris_prolongator_;
 
   // The parameters for computing the various trajectories.
   DiscreteTrajectorySegment<Barycentric>::DownsamplingParameters
@@ -533,8 +723,16 @@ class Plugin {
   Ephemeris<Barycentric>::FixedStepParameters history_fixed_step_parameters_;
   Ephemeris<Barycentric>::AdaptiveStepParameters psychohistory_parameters_;
 
-  // The thread pool for advancing vessels.
-  ThreadPool<absl::Status> vessel_thread_pool_;
+  // The thread pool for advancing vessels.  Also used by |FlowFreefalls|,
+  // hence mutable.
+  mutable ThreadPool<absl::Status> vessel_thread_pool_;
+  // The thread pool for plotting, see |plotting_thread_pool|.  Plotting only
+  // reads the state of the plugin, hence mutable.
+  mutable ThreadPool<void> plotting_thread_pool_;
+  std::optional<std::chrono::microseconds> catch_up_time_budget_;
+  // The pile-ups deferred by the last call to |CatchUpLaggingVessels|.  Not
+  // owning, only used for comparisons.
+  std::set<PileUp const*> deferred_pile_ups_;
 
   Angle planetarium_rotation_;
   std::optional<Rotation<Barycentric, AliceSun>> cached_planetarium_rotation_;
@@ -553,6 +751,14 @@ class Plugin {
   RotatingBody<Barycentric> const* main_body_ = nullptr;
   AngularVelocity<Barycentric> angular_velocity_of_world_;
 
+  // Not null iff the grouped fixed step is enabled.  The pile-ups that refer to
+  // it are destroyed by the destructor of the plugin, before this member.
+  std::unique_ptr<PileUpGroup> pile_up_group_;
+  // The flow of the histories of the members of |pile_up_group_| started by the
+  // last call to |AdvanceTime| on |vessel_thread_pool_|.  Invalid if no flow
+  // was started.
+  std::shared_future<absl::Status> pile_up_group_advance_;
+
   // Do not |erase| from this list, use |Part::reset_containing_pile_up| instead
   // and the pile-up will remove itself once no part owns it.  The elements are
   // not |not_null<>| because we temporarily need to insert null pointers.
@@ -570,6 +776,9 @@ class Plugin {
   std::map<GUID, Ephemeris<Barycentric>::AdaptiveStepParameters>
   zombie_prediction_adaptive_step_parameters_;
 
+  // Updated when a full snapshot is written or read.
+  std::optional<SnapshotBase> snapshot_base_;
+
   friend class NavballFrameField;
   friend class ksp_plugin::TestablePlugin;
 };
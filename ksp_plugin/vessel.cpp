@@ -637,6 +637,48 @@ std::string Vessel::ShortDebugString() const {
 void Vessel::WriteToMessage(not_null<serialization::Vessel*> const message,
                             PileUp::SerializationIndexForPileUp const&
                                 serialization_index_for_pile_up) const {
+  WriteToMessage(message,
+                 serialization_index_for_pile_up,
+                 /*history_ranges=*/nullptr);
+}
+
+void Vessel::WriteToMessage(
+    not_null<serialization::Vessel*> const message,
+    PileUp::SerializationIndexForPileUp const& serialization_index_for_pile_up,
+    std::vector<std::pair<DiscreteTrajectory<Barycentric>::iterator,
+                          DiscreteTrajectory<Barycentric>::iterator>>&
+        history_ranges) const {
+  WriteToMessage(message, serialization_index_for_pile_up, &history_ranges);
+}
+
+not_null<std::unique_ptr<Vessel>> Vessel::ReadFromMessage(
+    serialization::Vessel const& message,
+    not_null<Celestial const*> const parent,
+    not_null<Ephemeris<Barycentric>*> const ephemeris,
+    std::function<void(PartId)> const& deletion_callback) {
+  return ReadFromMessage(message,
+                         parent,
+                         ephemeris,
+                         deletion_callback,
+                         /*history_points=*/nullptr);
+}
+
+not_null<std::unique_ptr<Vessel>> Vessel::ReadFromMessage(
+    serialization::Vessel const& message,
+    not_null<Celestial const*> const parent,
+    not_null<Ephemeris<Barycentric>*> const ephemeris,
+    std::function<void(PartId)> const& deletion_callback,
+    std::vector<std::vector<Array<double const>>> const& history_points) {
+  return ReadFromMessage(
+      message, parent, ephemeris, deletion_callback, &history_points);
+}
+
+void Vessel::WriteToMessage(
+    not_null<serialization::Vessel*> const message,
+    PileUp::SerializationIndexForPileUp const& serialization_index_for_pile_up,
+    std::vector<std::pair<DiscreteTrajectory<Barycentric>::iterator,
+                          DiscreteTrajectory<Barycentric>::iterator>>* const
+        history_ranges) const {
   message->set_guid(guid_);
   message->set_name(name_);
   body_.WriteToMessage(message->mutable_body());
@@ -673,12 +715,21 @@ void Vessel::WriteToMessage(not_null<serialization::Vessel*> const message,
 
   // Starting with Gateaux we don't save the prediction, see #2685.  Instead we
   // just save its first point and re-read as if it was the whole prediction.
-  trajectory_.WriteToMessage(
-      message->mutable_history(),
-      /*begin=*/backstory_->end() - serialized_points,
-      /*end=*/std::next(prediction_->begin()),
-      /*tracked=*/{backstory_, psychohistory_, prediction_},
-      /*exact=*/{});
+  if (history_ranges == nullptr) {
+    trajectory_.WriteToMessage(
+        message->mutable_history(),
+        /*begin=*/backstory_->end() - serialized_points,
+        /*end=*/std::next(prediction_->begin()),
+        /*tracked=*/{backstory_, psychohistory_, prediction_},
+        /*exact=*/{});
+  } else {
+    trajectory_.WriteToMessage(
+        message->mutable_history(),
+        /*begin=*/backstory_->end() - serialized_points,
+        /*end=*/std::next(prediction_->begin()),
+        /*tracked=*/{backstory_, psychohistory_, prediction_},
+        *history_ranges);
+  }
   for (auto const& flight_plan : flight_plans_) {
     if (std::holds_alternative<serialization::FlightPlan>(flight_plan)) {
       *message->add_flight_plans() =
@@ -703,7 +754,8 @@ not_null<std::unique_ptr<Vessel>> Vessel::ReadFromMessage(
     serialization::Vessel const& message,
     not_null<Celestial const*> const parent,
     not_null<Ephemeris<Barycentric>*> const ephemeris,
-    std::function<void(PartId)> const& deletion_callback) {
+    std::function<void(PartId)> const& deletion_callback,
+    std::vector<std::vector<Array<double const>>> const* const history_points) {
   bool const is_pre_cesàro = message.has_psychohistory_is_authoritative();
   bool const is_pre_chasles = message.has_prediction();
   bool const is_pre_陈景润 = !message.history().has_downsampling() &&
@@ -791,11 +843,20 @@ not_null<std::unique_ptr<Vessel>> Vessel::ReadFromMessage(
     vessel->backstory_ = std::prev(vessel->psychohistory_);
     vessel->downsampling_parameters_ = DefaultDownsamplingParameters();
   } else {
-    vessel->trajectory_ = DiscreteTrajectory<Barycentric>::ReadFromMessage(
-        message.history(),
-        /*tracked=*/{&vessel->backstory_,
-                     &vessel->psychohistory_,
-                     &vessel->prediction_});
+    if (history_points == nullptr) {
+      vessel->trajectory_ = DiscreteTrajectory<Barycentric>::ReadFromMessage(
+          message.history(),
+          /*tracked=*/{&vessel->backstory_,
+                       &vessel->psychohistory_,
+                       &vessel->prediction_});
+    } else {
+      vessel->trajectory_ = DiscreteTrajectory<Barycentric>::ReadFromMessage(
+          message.history(),
+          /*tracked=*/{&vessel->backstory_,
+                       &vessel->psychohistory_,
+                       &vessel->prediction_},
+          *history_points);
+    }
     vessel->is_collapsible_ = message.is_collapsible();
 
     vessel->checkpointer_ =
@@ -885,6 +946,10 @@ void Vessel::FillContainingPileUpsFromMessage(
   }
 }
 
+void Vessel::MarkTrajectoryUnchanged() {
+  trajectory_.MarkUnchanged();
+}
+
 void Vessel::MakeAsynchronous() {
   synchronous_ = false;
 }
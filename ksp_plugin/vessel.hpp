@@ -6,11 +6,13 @@
 #include <queue>
 #include <set>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
+#include "base/array.hpp"
 #include "base/jthread.hpp"
 #include "base/recurring_thread.hpp"
 #include "geometry/instant.hpp"
@@ -37,6 +39,7 @@ class VesselTest;
 namespace _vessel {
 namespace internal {
 
+using namespace principia::base::_array;
 using namespace principia::base::_not_null;
 using namespace principia::base::_recurring_thread;
 using namespace principia::geometry::_grassmann;
@@ -267,16 +270,40 @@ class Vessel {
   virtual void WriteToMessage(not_null<serialization::Vessel*> message,
                               PileUp::SerializationIndexForPileUp const&
                                   serialization_index_for_pile_up) const;
+  // Same as above, but the points of the history are not written to |message|.
+  // The |i|th element of |history_ranges| is the range of points described by
+  // the |i|th segment of the history, see |DiscreteTrajectory::WriteToMessage|.
+  void WriteToMessage(
+      not_null<serialization::Vessel*> message,
+      PileUp::SerializationIndexForPileUp const&
+          serialization_index_for_pile_up,
+      std::vector<std::pair<DiscreteTrajectory<Barycentric>::iterator,
+                            DiscreteTrajectory<Barycentric>::iterator>>&
+          history_ranges) const;
   static not_null<std::unique_ptr<Vessel>> ReadFromMessage(
       serialization::Vessel const& message,
       not_null<Celestial const*> parent,
       not_null<Ephemeris<Barycentric>*> ephemeris,
       std::function<void(PartId)> const& deletion_callback);
+  // Same as above, for a |message| written without the points of its history.
+  // The points of the |i|th segment of the history are read from
+  // |history_points[i]|.
+  static not_null<std::unique_ptr<Vessel>> ReadFromMessage(
+      serialization::Vessel const& message,
+      not_null<Celestial const*> parent,
+      not_null<Ephemeris<Barycentric>*> ephemeris,
+      std::function<void(PartId)> const& deletion_callback,
+      std::vector<std::vector<Array<double const>>> const& history_points);
   void FillContainingPileUpsFromMessage(
       serialization::Vessel const& message,
       PileUp::PileUpForSerializationIndex const&
           pile_up_for_serialization_index);
 
+  // Records that the points of the trajectory are unchanged, see
+  // |DiscreteTrajectory::MarkUnchanged|.  Used when a snapshot is written or
+  // read, to be able to write the changes since that snapshot.
+  void MarkTrajectoryUnchanged();
+
   static void MakeAsynchronous();
   static void MakeSynchronous();
 
@@ -300,6 +327,25 @@ class Vessel {
       std::variant<not_null<std::unique_ptr<FlightPlan>>,
                    serialization::FlightPlan>;
 
+  // Implementation of serialization.  If |history_ranges| is null, the points
+  // of the history are written to |message|.
+  void WriteToMessage(
+      not_null<serialization::Vessel*> message,
+      PileUp::SerializationIndexForPileUp const&
+          serialization_index_for_pile_up,
+      std::vector<std::pair<DiscreteTrajectory<Barycentric>::iterator,
+                            DiscreteTrajectory<Barycentric>::iterator>>*
+          history_ranges) const;
+
+  // Implementation of deserialization.  If |history_points| is null, the points
+  // of the history are read from |message|.
+  static not_null<std::unique_ptr<Vessel>> ReadFromMessage(
+      serialization::Vessel const& message,
+      not_null<Celestial const*> parent,
+      not_null<Ephemeris<Barycentric>*> ephemeris,
+      std::function<void(PartId)> const& deletion_callback,
+      std::vector<std::vector<Array<double const>>> const* history_points);
+
   // Return functions that can be passed to a |Checkpointer| to write this
   // vessel to a checkpoint or read it back.
   Checkpointer<serialization::Vessel>::Writer
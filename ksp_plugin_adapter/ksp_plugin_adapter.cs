@@ -830,6 +830,8 @@ class PartCentredForceHolder {
         serialization_encoding_ = "base64";
       }
 
+      plugin_.SetPipelinedTimeStep(enabled: true);
+      plugin_.SetGroupedFixedStep(enabled: true);
       previous_display_mode_ = null;
       must_set_plotting_frame_ = true;
     } else {
@@ -2583,6 +2585,8 @@ out DisposableIterator
         plugin_.AdvanceTime(Planetarium.GetUniversalTime(),
                             Planetarium.InverseRotAngle);
       }
+      plugin_.SetPipelinedTimeStep(enabled: true);
+      plugin_.SetGroupedFixedStep(enabled: true);
       must_set_plotting_frame_ = true;
     } catch (Exception e) {
       Log.Fatal($"Exception while resetting plugin: {e}");
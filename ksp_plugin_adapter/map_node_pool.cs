@@ -1,5 +1,6 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.Runtime.InteropServices;
 using KSP.Localization;
 
 namespace principia {
@@ -142,19 +143,23 @@ public class SingleProvenancePool {
     }
     colour.a = 1;
 
-    for (int i = 0;
-         i < MaxNodesPerProvenance && !apsis_iterator.IteratorAtEnd();
-         ++i, apsis_iterator.IteratorIncrement()) {
-      QP apsis = apsis_iterator.IteratorGetDiscreteTrajectoryQP();
+    // Fetch all the apsides in a single call.
+    int apsides_count = apsis_iterator.IteratorGetDiscreteTrajectoryQPTs(
+        decimation  : 1,
+        origin      : null,
+        points      : ApsisBuffer.data,
+        points_size : ApsisBuffer.size);
+    for (int i = 0; i < apsides_count; ++i) {
+      QPT apsis = ApsisBuffer.apsides[i];
       MapNodeProperties node_properties = new MapNodeProperties {
           visible = true,
           object_type = provenance.type,
           colour = colour,
           reference_frame = reference_frame,
-          world_position = (Vector3d)apsis.q,
-          velocity = (Vector3d)apsis.p,
+          world_position = (Vector3d)apsis.qp.q,
+          velocity = (Vector3d)apsis.qp.p,
           source = provenance.source,
-          time = apsis_iterator.IteratorGetDiscreteTrajectoryTime(),
+          time = apsis.t,
           associated_map_object = associated_map_object,
       };
       if (provenance.type == MapObject.ObjectType.Periapsis &&
@@ -304,6 +309,17 @@ public class SingleProvenancePool {
     return new_node;
   }
 
+  private static class ApsisBuffer {
+    public static IntPtr data => handle_.AddrOfPinnedObject();
+    public static int size => apsides_.Length;
+
+    public static QPT[] apsides => apsides_;
+
+    private static readonly QPT[] apsides_ = new QPT[MaxNodesPerProvenance];
+    private static GCHandle handle_ =
+        GCHandle.Alloc(apsides_, GCHandleType.Pinned);
+  }
+
   private class MapNodeProperties {
     public bool visible;
     public MapObject.ObjectType object_type;
@@ -1,6 +1,7 @@
 #include "ksp_plugin/interface.hpp"
 
 #include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -16,6 +17,7 @@ namespace principia {
 namespace interface {
 
 using ::testing::AllOf;
+using ::testing::DoubleNear;
 using ::testing::Eq;
 using ::testing::Gt;
 using ::testing::Lt;
@@ -119,6 +121,64 @@ TEST_F(InterfaceExternalTest, GetNearestPlannedCoastDegreesOfFreedom) {
                                         Lt(1 * Centi(Metre) / Second)))));
 }
 
+TEST_F(InterfaceExternalTest, FlowFreefall) {
+  auto const to_world =
+      plugin_.renderer().BarycentricToWorld(plugin_.PlanetariumRotation());
+  Length const r = 6783 * Kilo(Metre);
+  Speed const v = Sqrt(plugin_.GetCelestial(SolarSystemFactory::Earth)
+                           .body()->gravitational_parameter() / r);
+  QP const initial_degrees_of_freedom{
+      /*q=*/ToXYZ(to_world(Displacement<Barycentric>({r, 0 * Metre, 0 * Metre}))
+                      .coordinates() /
+                  Metre),
+      /*p=*/ToXYZ(to_world(Velocity<Barycentric>(
+                               {0 * Metre / Second, v, 0 * Metre / Second}))
+                      .coordinates() /
+                  (Metre / Second))};
+  double const t_initial = ToGameTime(plugin_, plugin_.CurrentTime());
+  double const t_final = t_initial + 45 * Minute / Second;
+
+  QP single_result;
+  auto const* status = principia__ExternalFlowFreefall(
+      &plugin_,
+      SolarSystemFactory::Earth,
+      initial_degrees_of_freedom,
+      t_initial,
+      t_final,
+      &single_result);
+  EXPECT_THAT(*status, IsOk());
+  // Roughly half an orbit.
+  auto const barycentric_result =
+      to_world.Inverse()(FromQP<RelativeDegreesOfFreedom<World>>(
+          single_result));
+  EXPECT_THAT(barycentric_result.displacement().Norm(),
+              AllOf(Gt(6700 * Kilo(Metre)), Lt(6900 * Kilo(Metre))));
+  EXPECT_THAT(barycentric_result.displacement().coordinates().x,
+              Lt(-6000 * Kilo(Metre)));
+
+  // A batch where the second problem starts at |t_final| and the third one
+  // would have to flow backward.
+  std::vector<QPT> initial_states{{initial_degrees_of_freedom, t_initial},
+                                  {initial_degrees_of_freedom, t_final},
+                                  {initial_degrees_of_freedom, t_final + 1}};
+  std::vector<QP> batch_results(initial_states.size());
+  status = principia__ExternalFlowFreefalls(&plugin_,
+                                            SolarSystemFactory::Earth,
+                                            initial_states.data(),
+                                            initial_states.size(),
+                                            t_final,
+                                            batch_results.data(),
+                                            batch_results.size());
+  EXPECT_THAT(status->error,
+              Eq(static_cast<int>(absl::StatusCode::kInvalidArgument)));
+  EXPECT_THAT(batch_results[0], Eq(single_result));
+  // Only rounding errors from the change of frame.
+  EXPECT_THAT(batch_results[1].q.x,
+              DoubleNear(initial_degrees_of_freedom.q.x, 1e-3));
+  EXPECT_THAT(batch_results[1].p.y,
+              DoubleNear(initial_degrees_of_freedom.p.y, 1e-6));
+}
+
 TEST_F(InterfaceExternalTest, Geopotential) {
   XY coefficient;
   double radius;
@@ -1,6 +1,7 @@
 #include "ksp_plugin/interface.hpp"
 
 #include <string>
+#include <vector>
 
 #include "base/not_null.hpp"
 #include "geometry/identity.hpp"
@@ -374,6 +375,20 @@ TEST_F(InterfaceFlightPlanTest, FlightPlan) {
   EXPECT_EQ(XYZ({0, 2, 4}),
             principia__IteratorGetDiscreteTrajectoryXYZ(iterator));
 
+  // The first and last points, in a single call.
+  principia__IteratorReset(iterator);
+  XYZ const origin{0, 1, 2};
+  std::vector<XYZ> positions(3);
+  EXPECT_EQ(2,
+            principia__IteratorGetDiscreteTrajectoryXYZs(iterator,
+                                                         /*decimation=*/2,
+                                                         &origin,
+                                                         positions.data(),
+                                                         positions.size()));
+  EXPECT_EQ(XYZ({0, -1, -2}), positions[0]);
+  EXPECT_EQ(XYZ({0, 1, 2}), positions[1]);
+  EXPECT_TRUE(principia__IteratorAtEnd(iterator));
+
   interface_burn.thrust_in_kilonewtons = 10;
   EXPECT_CALL(*plugin_,
               NewBodyCentredNonRotatingNavigationFrame(celestial_index))
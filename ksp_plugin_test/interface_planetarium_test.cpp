@@ -1,9 +1,14 @@
 #include "ksp_plugin/interface.hpp"
 
+#include <iterator>
+#include <limits>
+#include <vector>
+
 #include "geometry/affine_map.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/orthogonal_map.hpp"
 #include "geometry/permutation.hpp"
+#include "geometry/perspective.hpp"
 #include "geometry/rotation.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -11,7 +16,14 @@
 #include "ksp_plugin_test/mock_planetarium.hpp"
 #include "ksp_plugin_test/mock_plugin.hpp"
 #include "ksp_plugin_test/mock_renderer.hpp"
+#include "ksp_plugin_test/mock_vessel.hpp"
+#include "physics/discrete_trajectory.hpp"
+#include "physics/mock_ephemeris.hpp"
+#include "physics/mock_rigid_reference_frame.hpp"
+#include "physics/rigid_motion.hpp"
 #include "quantities/quantities.hpp"
+#include "quantities/si.hpp"
+#include "testing_utilities/discrete_trajectory_factories.hpp"
 
 namespace principia {
 namespace interface {
@@ -26,13 +38,21 @@ using namespace principia::base::_not_null;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_orthogonal_map;
 using namespace principia::geometry::_permutation;
+using namespace principia::geometry::_perspective;
 using namespace principia::geometry::_rotation;
 using namespace principia::geometry::_space_transformations;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_planetarium;
 using namespace principia::ksp_plugin::_plugin;
 using namespace principia::ksp_plugin::_renderer;
+using namespace principia::ksp_plugin::_vessel;
+using namespace principia::physics::_discrete_trajectory;
+using namespace principia::physics::_ephemeris;
+using namespace principia::physics::_rigid_motion;
+using namespace principia::physics::_rigid_reference_frame;
 using namespace principia::quantities::_quantities;
+using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_discrete_trajectory_factories;
 
 class InterfacePlanetariumTest : public ::testing::Test {
  protected:
@@ -76,5 +96,147 @@ TEST_F(InterfacePlanetariumTest, ConstructionDestruction) {
   EXPECT_THAT(planetarium, IsNull());
 }
 
+TEST_F(InterfacePlanetariumTest, PlotTrajectoriesWithTargetVessel) {
+  MockRenderer renderer;
+  MockPlanetarium planetarium;
+  EXPECT_CALL(*const_plugin_, renderer()).WillRepeatedly(ReturnRef(renderer));
+  EXPECT_CALL(renderer, HasTargetVessel()).WillRepeatedly(Return(true));
+
+  // With a target vessel, none of these trajectories are plotted, and no
+  // reanimation is requested.
+  char const* const vessel_guids[] = {"guid", nullptr};
+  PlotRequest requests[] = {
+      {/*trajectory=*/0, /*vessel=*/0, /*index=*/0, /*first_vertex=*/0,
+       /*max_vertices=*/10, /*vertex_count=*/-1,
+       /*minimal_distance_from_camera=*/0},
+      {/*trajectory=*/3, /*vessel=*/0, /*index=*/1, /*first_vertex=*/10,
+       /*max_vertices=*/10, /*vertex_count=*/-1,
+       /*minimal_distance_from_camera=*/0},
+      {/*trajectory=*/4, /*vessel=*/0, /*index=*/1, /*first_vertex=*/20,
+       /*max_vertices=*/10, /*vertex_count=*/-1,
+       /*minimal_distance_from_camera=*/0}};
+  ScaledSpacePoint vertices[30];
+  principia__PlanetariumPlotTrajectories(&planetarium,
+                                         plugin_.get(),
+                                         vessel_guids,
+                                         /*max_history_length=*/3600,
+                                         requests,
+                                         std::size(requests),
+                                         vertices,
+                                         std::size(vertices));
+  for (auto const& request : requests) {
+    EXPECT_EQ(0, request.vertex_count);
+    EXPECT_EQ(std::numeric_limits<double>::infinity(),
+              request.minimal_distance_from_camera);
+  }
+}
+
+TEST_F(InterfacePlanetariumTest, PlotTrajectoriesConcurrently) {
+  MockRenderer renderer;
+  EXPECT_CALL(*const_plugin_, renderer()).WillRepeatedly(ReturnRef(renderer));
+  EXPECT_CALL(renderer, HasTargetVessel()).WillRepeatedly(Return(false));
+  EXPECT_CALL(*plugin_, CurrentTime()).WillRepeatedly(Return(t0_));
+
+  // A planetarium looking at the origin from the y axis, in a plotting frame
+  // that coincides with |Barycentric|.
+  MockEphemeris<Barycentric> ephemeris;
+  MockRigidReferenceFrame<Barycentric, Navigation> plotting_frame;
+  EXPECT_CALL(plotting_frame, t_min()).WillRepeatedly(Return(InfinitePast));
+  EXPECT_CALL(plotting_frame, t_max()).WillRepeatedly(Return(InfiniteFuture));
+  EXPECT_CALL(plotting_frame, ToThisFrameAtTime(_))
+      .WillRepeatedly(Return(RigidMotion<Barycentric, Navigation>(
+          RigidTransformation<Barycentric, Navigation>::Identity(),
+          Barycentric::nonrotating,
+          Barycentric::unmoving)));
+  Planetarium const planetarium(
+      Planetarium::Parameters(/*sphere_radius_multiplier=*/1,
+                              /*angular_resolution=*/0.4 * ArcMinute,
+                              /*field_of_view=*/90 * Degree),
+      Perspective<Navigation, Camera>(
+          RigidTransformation<Navigation, Camera>(
+              Navigation::origin + Displacement<Navigation>(
+                                       {0 * Metre, 20 * Metre, 0 * Metre}),
+              Camera::origin,
+              Permutation<Navigation, Camera>(
+                  Permutation<Navigation, Camera>::CoordinatePermutation::XZY)
+                  .Forget<OrthogonalMap>()).Forget<Similarity>(),
+          /*focal=*/5 * Metre),
+      &ephemeris,
+      &plotting_frame,
+      [](Position<Navigation> const& plotted_point) {
+        return ScaledSpacePoint::FromCoordinates(
+            ((plotted_point - Navigation::origin) / Metre).coordinates());
+      });
+
+  // Vessels on circular predictions of different periods, so that their plots
+  // differ.
+  constexpr int vessel_count = 4;
+  char const* const vessel_guids[] = {"0", "1", "2", "3", nullptr};
+  std::vector<DiscreteTrajectory<Barycentric>> predictions(vessel_count);
+  std::vector<StrictMock<MockVessel>> vessels(vessel_count);
+  for (int i = 0; i < vessel_count; ++i) {
+    AppendTrajectoryTimeline(
+        /*from=*/NewCircularTrajectoryTimeline<Barycentric>(
+            /*period=*/(1000 + 100 * i) * Second,
+            /*r=*/10 * Metre,
+            /*Δt=*/1 * Second,
+            /*t1=*/t0_,
+            /*t2=*/t0_ + 500 * Second),
+        /*to=*/predictions[i]);
+    EXPECT_CALL(vessels[i], prediction())
+        .WillRepeatedly(Return(predictions[i].segments().begin()));
+    EXPECT_CALL(*const_plugin_, GetVessel(vessel_guids[i]))
+        .WillRepeatedly(Return(&vessels[i]));
+  }
+
+  // Plot each prediction with the single-trajectory entry point.
+  constexpr int max_vertices = 1000;
+  std::vector<std::vector<ScaledSpacePoint>> expected_vertices;
+  for (int i = 0; i < vessel_count; ++i) {
+    auto& vertices = expected_vertices.emplace_back(max_vertices);
+    int vertex_count;
+    principia__PlanetariumPlotPrediction(&planetarium,
+                                         plugin_.get(),
+                                         vessel_guids[i],
+                                         vertices.data(),
+                                         max_vertices,
+                                         &vertex_count);
+    EXPECT_LT(1, vertex_count);
+    vertices.resize(vertex_count);
+  }
+
+  // Plot them all at once, in reverse order in |vertices| to check that the
+  // ranges are honoured.
+  std::vector<PlotRequest> requests;
+  for (int i = 0; i < vessel_count; ++i) {
+    requests.push_back(
+        {/*trajectory=*/1, /*vessel=*/i, /*index=*/0,
+         /*first_vertex=*/(vessel_count - 1 - i) * max_vertices,
+         /*max_vertices=*/max_vertices, /*vertex_count=*/-1,
+         /*minimal_distance_from_camera=*/0});
+  }
+  std::vector<ScaledSpacePoint> vertices(vessel_count * max_vertices);
+  principia__PlanetariumPlotTrajectories(&planetarium,
+                                         plugin_.get(),
+                                         vessel_guids,
+                                         /*max_history_length=*/3600,
+                                         requests.data(),
+                                         requests.size(),
+                                         vertices.data(),
+                                         vertices.size());
+
+  for (int i = 0; i < vessel_count; ++i) {
+    auto const& request = requests[i];
+    ASSERT_EQ(expected_vertices[i].size(), request.vertex_count);
+    for (int j = 0; j < request.vertex_count; ++j) {
+      auto const& actual = vertices[request.first_vertex + j];
+      auto const& expected = expected_vertices[i][j];
+      EXPECT_EQ(expected.x, actual.x);
+      EXPECT_EQ(expected.y, actual.y);
+      EXPECT_EQ(expected.z, actual.z);
+    }
+  }
+}
+
 }  // namespace interface
 }  // namespace principia
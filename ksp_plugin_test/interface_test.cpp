@@ -631,6 +631,30 @@ TEST_F(InterfaceTest, SerializePlugin) {
   EXPECT_THAT(serialization, IsNull());
 }
 
+TEST_F(InterfaceTest, SerializePluginToBytes) {
+  PullSerializer* serializer = nullptr;
+  auto const message = ParseFromBytes<principia::serialization::Plugin>(
+      serialized_simple_plugin_);
+  std::vector<std::uint8_t> bytes(128 << 10);
+
+  EXPECT_CALL(*plugin_, WriteToMessage(_)).WillOnce(SetArgPointee<0>(message));
+  int const size = principia__SerializePluginToBytes(plugin_.get(),
+                                                     &serializer,
+                                                     /*compressor=*/"",
+                                                     bytes.data(),
+                                                     bytes.size());
+  bytes.resize(size);
+  EXPECT_EQ(serialized_simple_plugin_, bytes);
+  std::vector<std::uint8_t> end(128 << 10);
+  EXPECT_EQ(0,
+            principia__SerializePluginToBytes(plugin_.get(),
+                                              &serializer,
+                                              /*compressor=*/"",
+                                              end.data(),
+                                              end.size()));
+  EXPECT_THAT(serializer, IsNull());
+}
+
 TEST_F(InterfaceTest, DeserializePlugin) {
   PushDeserializer* deserializer = nullptr;
   Plugin const* plugin = nullptr;
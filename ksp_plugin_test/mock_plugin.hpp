@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <optional>
 #include <string>
 #include <vector>
@@ -67,6 +68,14 @@ class MockPlugin : public Plugin {
               (Instant const& t, Angle const& planetarium_rotation),
               (override));
 
+  MOCK_METHOD(void, SetPipelinedTimeStep, (bool enabled), (override));
+  MOCK_METHOD(void, SetGroupedFixedStep, (bool enabled), (override));
+
+  MOCK_METHOD(void,
+              SetCatchUpTimeBudget,
+              (std::optional<std::chrono::microseconds> const& budget),
+              (override));
+
   MOCK_METHOD(RelativeDegreesOfFreedom<AliceSun>,
               VesselFromParent,
               (Index parent_index, GUID const& vessel_guid),
@@ -77,6 +86,23 @@ class MockPlugin : public Plugin {
               (Index celestial_index),
               (const, override));
 
+  MOCK_METHOD(absl::StatusOr<DegreesOfFreedom<Navigation>>,
+              FlowFreefall,
+              (NavigationFrame const& frame,
+               DegreesOfFreedom<Navigation> const& initial_degrees_of_freedom,
+               Instant const& t_initial,
+               Instant const& t_final),
+              (const, override));
+
+  MOCK_METHOD(std::vector<absl::StatusOr<DegreesOfFreedom<Navigation>>>,
+              FlowFreefalls,
+              (NavigationFrame const& frame,
+               std::vector<DegreesOfFreedom<Navigation>> const&
+                   initial_degrees_of_freedom,
+               std::vector<Instant> const& t_initial,
+               Instant const& t_final),
+              (const, override));
+
   MOCK_METHOD(void,
               CreateFlightPlan,
               (GUID const& vessel_guid,
@@ -157,6 +183,15 @@ class MockPlugin : public Plugin {
               WriteToMessage,
               (not_null<serialization::Plugin*> message),
               (const, override));
+  MOCK_METHOD(void,
+              WriteToSnapshot,
+              (not_null<SnapshotWriter*> snapshot),
+              (override));
+  MOCK_METHOD(bool, HasSnapshotBase, (), (const, override));
+  MOCK_METHOD(void,
+              WriteDeltaToSnapshot,
+              (not_null<SnapshotWriter*> snapshot),
+              (const, override));
 };
 
 }  // namespace internal
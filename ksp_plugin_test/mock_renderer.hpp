@@ -32,6 +32,8 @@ class MockRenderer : public Renderer {
               (),
               (const, override));
 
+  MOCK_METHOD(bool, HasTargetVessel, (), (const, override));
+
   MOCK_METHOD(DiscreteTrajectory<World>,
               RenderBarycentricTrajectoryInWorld,
               (Instant const& time,
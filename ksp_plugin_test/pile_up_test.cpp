@@ -8,6 +8,7 @@
 #include "absl/status/status.h"
 #include "ksp_plugin/integrators.hpp"
 #include "ksp_plugin/part.hpp"
+#include "geometry/instant.hpp"
 #include "geometry/r3x3_matrix.hpp"
 #include "geometry/r3_element.hpp"
 #include "geometry/rotation.hpp"
@@ -46,6 +47,7 @@ using namespace principia::astronomy::_epoch;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
+using namespace principia::geometry::_instant;
 using namespace principia::geometry::_r3_element;
 using namespace principia::geometry::_r3x3_matrix;
 using namespace principia::geometry::_rotation;
@@ -248,6 +250,62 @@ class PileUpTest : public testing::Test {
     EXPECT_THAT(pile_up.apparent_part_rigid_motion(), IsEmpty());
   }
 
+  // Returns an ephemeris in which the motion is free: it has a single tiny body
+  // very far away, because |Ephemeris| doesn't want to be empty.
+  static not_null<std::unique_ptr<Ephemeris<Barycentric>>>
+  MakeFreeMotionEphemeris() {
+    std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+    bodies.emplace_back(make_not_null_unique<MassiveBody>(1 * Kilogram));
+    std::vector<DegreesOfFreedom<Barycentric>> initial_state{
+        DegreesOfFreedom<Barycentric>{
+            Barycentric::origin +
+                Displacement<Barycentric>(
+                    {std::pow(2, 100) * Metre, 0 * Metre, 0 * Metre}),
+            Barycentric::unmoving}};
+    return make_not_null_unique<Ephemeris<Barycentric>>(
+        std::move(bodies),
+        initial_state,
+        /*initial_time=*/J2000,
+        /*accuracy_parameters=*/
+        Ephemeris<Barycentric>::AccuracyParameters{
+            /*fitting_tolerance=*/1 * Metre,
+            /*geopotential_tolerance=*/0x1p-24},
+        Ephemeris<Barycentric>::FixedStepParameters{
+            SymplecticRungeKuttaNyströmIntegrator<
+                BlanesMoan2002SRKN6B,
+                Ephemeris<Barycentric>::NewtonianMotionEquation>(),
+            1 * Second});
+  }
+
+  // The members of the cohorts of |group|, in order, with null for the vacant
+  // slots.
+  static std::vector<std::vector<PileUp*>> CohortMembers(
+      PileUpGroup const& group) {
+    std::vector<std::vector<PileUp*>> members;
+    for (auto const& cohort : group.cohorts_) {
+      members.push_back(cohort.members);
+    }
+    return members;
+  }
+
+  // The integrator instances of the cohorts of |group|, in order.
+  static std::vector<void const*> CohortInstances(PileUpGroup const& group) {
+    std::vector<void const*> instances;
+    for (auto const& cohort : group.cohorts_) {
+      instances.push_back(cohort.instance.get());
+    }
+    return instances;
+  }
+
+  // The position of the centre of mass of a part in free motion with the given
+  // degrees of freedom at |J2000|.
+  static Position<Barycentric> FreePosition(
+      DegreesOfFreedom<Barycentric> const& degrees_of_freedom,
+      Instant const& t) {
+    return degrees_of_freedom.position() +
+           degrees_of_freedom.velocity() * (t - J2000);
+  }
+
   MockFunction<void()> deletion_callback_;
 
   PartId const part_id1_ = 111;
@@ -640,6 +698,130 @@ TEST_F(PileUpTest, MidStepIntrinsicForce) {
       AlmostEquals(old_velocity + 0.5 * fixed_step * a, 1));
 }
 
+// Checks that pile-ups may join and leave a group without restarting the
+// integrator instances of the other members.
+TEST_F(PileUpTest, GroupMembership) {
+  auto const ephemeris = MakeFreeMotionEphemeris();
+  Time const step = DefaultHistoryParameters().step();
+  DegreesOfFreedom<Barycentric> const p3_dof(
+      Barycentric::origin +
+          Displacement<Barycentric>({-7 * Metre, 8 * Metre, -9 * Metre}),
+      Velocity<Barycentric>(
+          {-70 * Metre / Second, 80 * Metre / Second, -90 * Metre / Second}));
+  Part p3(/*part_id=*/333,
+          "p3",
+          mass1_,
+          EccentricPart::origin,
+          inertia_tensor1_,
+          RigidMotion<EccentricPart, Barycentric>::MakeNonRotatingMotion(
+              p3_dof),
+          /*deletion_callback=*/nullptr);
+
+  PileUpGroup group(DefaultHistoryParameters(), ephemeris.get());
+  TestablePileUp pile_up1({&p1_}, J2000,
+                          DefaultPsychohistoryParameters(),
+                          DefaultHistoryParameters(),
+                          ephemeris.get(),
+                          /*deletion_callback=*/nullptr);
+  TestablePileUp pile_up2({&p2_}, J2000,
+                          DefaultPsychohistoryParameters(),
+                          DefaultHistoryParameters(),
+                          ephemeris.get(),
+                          /*deletion_callback=*/nullptr);
+  TestablePileUp pile_up3({&p3}, J2000,
+                          DefaultPsychohistoryParameters(),
+                          DefaultHistoryParameters(),
+                          ephemeris.get(),
+                          /*deletion_callback=*/nullptr);
+
+  // Advances the |pile_ups| after the group has flowed their histories.
+  auto const advance = [&group](std::vector<not_null<PileUp*>> const& members,
+                                std::vector<TestablePileUp*> const& pile_ups,
+                                Instant const& t) {
+    EXPECT_OK(group.AdvanceHistories(members, t));
+    for (TestablePileUp* const pile_up : pile_ups) {
+      EXPECT_OK(pile_up->AdvanceTime(t));
+    }
+  };
+
+  Instant t = J2000 + 10.5 * step;
+  advance({&pile_up1}, {&pile_up1, &pile_up2, &pile_up3}, t);
+  EXPECT_THAT(CohortMembers(group), ElementsAre(ElementsAre(&pile_up1)));
+  auto const instance1 = CohortInstances(group)[0];
+
+  // A new member forms its own cohort and doesn't restart the existing one.
+  t += 10 * step;
+  advance({&pile_up1, &pile_up2, &pile_up3},
+          {&pile_up1, &pile_up2, &pile_up3},
+          t);
+  EXPECT_THAT(CohortMembers(group),
+              ElementsAre(ElementsAre(&pile_up1),
+                          ElementsAre(&pile_up2, &pile_up3)));
+  EXPECT_EQ(instance1, CohortInstances(group)[0]);
+  auto const instance23 = CohortInstances(group)[1];
+
+  // The order of the pile-ups is irrelevant.
+  t += 10 * step;
+  advance({&pile_up3, &pile_up2, &pile_up1},
+          {&pile_up1, &pile_up2, &pile_up3},
+          t);
+  EXPECT_THAT(CohortInstances(group), ElementsAre(instance1, instance23));
+
+  // A member that leaves vacates its slot, the other members keep their
+  // instance.
+  t += 10 * step;
+  advance({&pile_up1, &pile_up2}, {&pile_up1, &pile_up2, &pile_up3}, t);
+  EXPECT_THAT(CohortMembers(group),
+              ElementsAre(ElementsAre(&pile_up1),
+                          ElementsAre(&pile_up2, nullptr)));
+  EXPECT_THAT(CohortInstances(group), ElementsAre(instance1, instance23));
+
+  // A member subject to an intrinsic force leaves, and its cohort is destroyed
+  // if it has no members left.
+  p1_.apply_intrinsic_force(
+      Vector<Force, Barycentric>({1 * Newton, 0 * Newton, 0 * Newton}));
+  pile_up1.RecomputeFromParts();
+  t += 10 * step;
+  advance({&pile_up1, &pile_up2}, {&pile_up2}, t);
+  EXPECT_THAT(CohortMembers(group),
+              ElementsAre(ElementsAre(&pile_up2, nullptr)));
+  EXPECT_THAT(CohortInstances(group), ElementsAre(instance23));
+
+  // The pile-ups that stayed in the group are in free motion.  The history of
+  // |pile_up3| was flowed separately after it left.
+  EXPECT_OK(pile_up3.AdvanceTime(t));
+  for (auto const& [pile_up, dof] :
+       {std::pair{&pile_up2, p2_dof_}, std::pair{&pile_up3, p3_dof}}) {
+    EXPECT_EQ(t, pile_up->psychohistory()->back().time);
+    EXPECT_THAT(pile_up->psychohistory()->back().degrees_of_freedom,
+                Componentwise(AlmostEquals(FreePosition(dof, t), 0, 100),
+                              AlmostEquals(dof.velocity(), 0, 100)));
+  }
+
+  // A pile-up destroyed while it is a member vacates its slot.
+  {
+    Part p4(/*part_id=*/444,
+            "p4",
+            mass1_,
+            EccentricPart::origin,
+            inertia_tensor1_,
+            RigidMotion<EccentricPart, Barycentric>::MakeNonRotatingMotion(
+                p1_dof_),
+            /*deletion_callback=*/nullptr);
+    TestablePileUp pile_up4({&p4}, t,
+                            DefaultPsychohistoryParameters(),
+                            DefaultHistoryParameters(),
+                            ephemeris.get(),
+                            /*deletion_callback=*/nullptr);
+    advance({&pile_up2, &pile_up4}, {}, t + 10 * step);
+    EXPECT_THAT(CohortMembers(group),
+                ElementsAre(ElementsAre(&pile_up2, nullptr),
+                            ElementsAre(&pile_up4)));
+  }
+  EXPECT_THAT(CohortMembers(group),
+              ElementsAre(ElementsAre(&pile_up2, nullptr)));
+}
+
 TEST_F(PileUpTest, Serialization) {
   MockEphemeris<Barycentric> ephemeris;
   p1_.apply_intrinsic_force(
@@ -1,12 +1,16 @@
 #include "ksp_plugin/plugin.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <filesystem>
 #include <limits>
 #include <map>
 #include <memory>
 #include <optional>
+#include <random>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -16,6 +20,7 @@
 #include "base/macros.hpp"
 #include "base/not_null.hpp"
 #include "base/serialization.hpp"
+#include "base/snapshot.hpp"
 #include "geometry/identity.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/orthogonal_map.hpp"
@@ -29,6 +34,9 @@
 #include "integrators/symmetric_linear_multistep_integrator.hpp"
 #include "integrators/symplectic_runge_kutta_nyström_integrator.hpp"
 #include "ksp_plugin/integrators.hpp"
+#include "ksp_plugin/part.hpp"
+#include "ksp_plugin/pile_up.hpp"
+#include "ksp_plugin/vessel.hpp"
 #include "physics/continuous_trajectory.hpp"
 #include "physics/degrees_of_freedom.hpp"
 #include "physics/kepler_orbit.hpp"
@@ -75,6 +83,7 @@ using namespace principia::astronomy::_time_scales;
 using namespace principia::base::_map_util;
 using namespace principia::base::_not_null;
 using namespace principia::base::_serialization;
+using namespace principia::base::_snapshot;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_identity;
 using namespace principia::geometry::_instant;
@@ -88,7 +97,10 @@ using namespace principia::integrators::_ordinary_differential_equations;
 using namespace principia::integrators::_symmetric_linear_multistep_integrator;
 using namespace principia::ksp_plugin::_frames;
 using namespace principia::ksp_plugin::_identification;
+using namespace principia::ksp_plugin::_part;
+using namespace principia::ksp_plugin::_pile_up;
 using namespace principia::ksp_plugin::_plugin;
+using namespace principia::ksp_plugin::_vessel;
 using namespace principia::physics::_continuous_trajectory;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_ephemeris;
@@ -444,6 +456,86 @@ TEST_F(PluginTest, Serialization) {
   second_message.mutable_vessel(0)->mutable_vessel()
       ->mutable_history()->mutable_segment(0)->clear_zfp();
   EXPECT_THAT(message, EqualsProto(second_message));
+
+  // Same thing through a snapshot.
+  std::filesystem::path const directory =
+      std::filesystem::temp_directory_path() /
+      ("principia_plugin_test_" + std::to_string(std::random_device()()));
+  std::filesystem::create_directories(directory);
+  std::filesystem::path const snapshot_path = directory / "plugin.snapshot";
+  {
+    SnapshotWriter snapshot(snapshot_path);
+    plugin->WriteToSnapshot(&snapshot);
+  }
+  {
+    SnapshotReader const snapshot(snapshot_path);
+    // One section for the header, one for the skeleton, one for the ephemeris,
+    // one for the vessel, plus one per segment of the history and one per
+    // trajectory of the ephemeris.
+    EXPECT_EQ(4 + second_message.vessel(0).vessel().history().segment_size() +
+                  second_message.ephemeris().trajectory_size(),
+              snapshot.sections().size());
+    plugin = Plugin::ReadFromSnapshot(snapshot);
+  }
+  serialization::Plugin third_message;
+  plugin->WriteToMessage(&third_message);
+  third_message.mutable_vessel(0)->mutable_vessel()
+      ->mutable_history()->mutable_segment(0)->clear_zfp();
+  EXPECT_THAT(third_message, EqualsProto(second_message));
+
+  // A delta relative to the snapshot that was just read, and its compaction.
+  std::filesystem::path const delta_path = directory / "delta.snapshot";
+  std::filesystem::path const compacted_path =
+      directory / "compacted.snapshot";
+  EXPECT_TRUE(plugin->HasSnapshotBase());
+  plugin->InsertOrKeepVessel(satellite,
+                             "v" + satellite,
+                             SolarSystemFactory::Earth,
+                             /*loaded=*/false,
+                             inserted);
+  plugin->AdvanceTime(HistoryTime(time, 8), Angle());
+  plugin->CatchUpLaggingVessels(collided_vessels);
+  serialization::Plugin fourth_message;
+  plugin->WriteToMessage(&fourth_message);
+  {
+    SnapshotWriter delta(delta_path);
+    plugin->WriteDeltaToSnapshot(&delta);
+  }
+  {
+    // The points of the history that are in the base are not written again.
+    SnapshotReader const delta(delta_path);
+    serialization::PluginSnapshot header;
+    // The header is written last.
+    delta.ReadMessage(delta.sections().size() - 1, &header);
+    ASSERT_EQ(1, header.delta().vessel_size());
+    EXPECT_EQ(0, header.delta().vessel(0).segment(0).base_segment());
+    EXPECT_LT(0, header.delta().vessel(0).segment(0).base_points());
+    EXPECT_LT(std::filesystem::file_size(delta_path),
+              std::filesystem::file_size(snapshot_path));
+  }
+  {
+    SnapshotReader const base(snapshot_path);
+    SnapshotReader const delta(delta_path);
+    plugin = Plugin::ReadFromSnapshot(base, delta);
+    EXPECT_TRUE(plugin->HasSnapshotBase());
+    SnapshotWriter compacted(compacted_path);
+    Plugin::CompactSnapshots(base, delta, &compacted);
+  }
+  serialization::Plugin fifth_message;
+  plugin->WriteToMessage(&fifth_message);
+  {
+    SnapshotReader const compacted(compacted_path);
+    plugin = Plugin::ReadFromSnapshot(compacted);
+  }
+  serialization::Plugin sixth_message;
+  plugin->WriteToMessage(&sixth_message);
+  std::filesystem::remove_all(directory);
+  for (auto* const m : {&fourth_message, &fifth_message, &sixth_message}) {
+    m->mutable_vessel(0)->mutable_vessel()
+        ->mutable_history()->mutable_segment(0)->clear_zfp();
+  }
+  EXPECT_THAT(fifth_message, EqualsProto(fourth_message));
+  EXPECT_THAT(sixth_message, EqualsProto(fourth_message));
 }
 
 TEST_F(PluginTest, Initialization) {
@@ -915,6 +1007,199 @@ TEST_F(PluginTest, NavballTargetVessel) {
   plugin.NavballFrameField(World::origin)->FromThisFrame(World::origin);
 }
 
+TEST_F(PluginTest, PipelinedTimeStep) {
+  GUID const guid = "Pipelined Vessel";
+  PartId const part_id = 666;
+
+  Plugin plugin(initial_time_,
+                initial_time_,
+                0 * Radian);
+  plugin.InsertCelestialAbsoluteCartesian(
+      SolarSystemFactory::Earth,
+      /*parent_index=*/std::nullopt,
+      solar_system_->gravity_model_message(
+          SolarSystemFactory::name(SolarSystemFactory::Earth)),
+      solar_system_->cartesian_initial_state_message(
+          SolarSystemFactory::name(SolarSystemFactory::Earth)));
+  plugin.EndInitialization();
+  plugin.SetPipelinedTimeStep(true);
+
+  bool inserted;
+  plugin.InsertOrKeepVessel(guid,
+                            "v" + guid,
+                            SolarSystemFactory::Earth,
+                            /*loaded=*/false,
+                            inserted);
+  plugin.InsertUnloadedPart(
+      part_id,
+      "part",
+      guid,
+      RelativeDegreesOfFreedom<AliceSun>(satellite_initial_displacement_,
+                                         satellite_initial_velocity_));
+  plugin.PrepareToReportCollisions();
+  plugin.FreeVesselsAndPartsAndCollectPileUps(20 * Milli(Second));
+
+  // Each step speculatively prolongs the ephemeris for the next one.
+  for (int i = 0; i < 10; ++i) {
+    plugin.AdvanceTime(plugin.CurrentTime() + 1 * Hour, 0 * Radian);
+    VesselSet collided_vessels;
+    plugin.CatchUpLaggingVessels(collided_vessels);
+    EXPECT_TRUE(collided_vessels.empty());
+    EXPECT_EQ(plugin.CurrentTime(),
+              plugin.GetVessel(guid)->psychohistory()->back().time);
+  }
+  plugin.SetPipelinedTimeStep(false);
+}
+
+// Checks that the speculative prolongation is limited to a few steps of the
+// ephemeris, and that it can be stopped while it is running.
+TEST_F(PluginTest, PipelinedTimeStepLookAhead) {
+  plugin_->InsertCelestialAbsoluteCartesian(
+      SolarSystemFactory::Earth,
+      /*parent_index=*/std::nullopt,
+      solar_system_->gravity_model_message(
+          SolarSystemFactory::name(SolarSystemFactory::Earth)),
+      solar_system_->cartesian_initial_state_message(
+          SolarSystemFactory::name(SolarSystemFactory::Earth)));
+  plugin_->EndInitialization();
+
+  // The ephemeris never makes progress, so the speculative prolongation only
+  // ends when the thread is stopped.
+  Instant const t = ParseTT(initial_time_) + 100 * Day;
+  Time const step = 10 * Minute;
+  auto& ephemeris = plugin_->mock_ephemeris();
+  ON_CALL(ephemeris, planetary_step()).WillByDefault(Return(step));
+  ON_CALL(ephemeris, t_max()).WillByDefault(Return(t));
+  EXPECT_CALL(ephemeris, Prolong(AllOf(Gt(t), Le(t + step))))
+      .Times(AnyNumber())
+      .WillRepeatedly(Return(absl::OkStatus()));
+  EXPECT_CALL(ephemeris, Prolong(t)).WillOnce(Return(absl::OkStatus()));
+
+  plugin_->SetPipelinedTimeStep(true);
+  plugin_->AdvanceTime(t, 0 * Radian);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  plugin_->SetPipelinedTimeStep(false);
+}
+
+TEST_F(PluginTest, CatchUpTimeBudget) {
+  GUID const guid = "Deferred Vessel";
+  PartId const part_id = 666;
+
+  Plugin plugin(initial_time_,
+                initial_time_,
+                0 * Radian);
+  plugin.InsertCelestialAbsoluteCartesian(
+      SolarSystemFactory::Earth,
+      /*parent_index=*/std::nullopt,
+      solar_system_->gravity_model_message(
+          SolarSystemFactory::name(SolarSystemFactory::Earth)),
+      solar_system_->cartesian_initial_state_message(
+          SolarSystemFactory::name(SolarSystemFactory::Earth)));
+  plugin.EndInitialization();
+  // With a zero budget, the unloaded pile-up is deferred by every other call.
+  plugin.SetCatchUpTimeBudget(std::chrono::microseconds(0));
+
+  bool inserted;
+  plugin.InsertOrKeepVessel(guid,
+                            "v" + guid,
+                            SolarSystemFactory::Earth,
+                            /*loaded=*/false,
+                            inserted);
+  plugin.InsertUnloadedPart(
+      part_id,
+      "part",
+      guid,
+      RelativeDegreesOfFreedom<AliceSun>(satellite_initial_displacement_,
+                                         satellite_initial_velocity_));
+  plugin.PrepareToReportCollisions();
+  plugin.FreeVesselsAndPartsAndCollectPileUps(20 * Milli(Second));
+
+  not_null<Vessel*> const vessel = plugin.GetVessel(guid);
+  PileUp const* pile_up = nullptr;
+  vessel->ForSomePart([&pile_up](Part& part) {
+    pile_up = part.containing_pile_up();
+  });
+  ASSERT_NE(nullptr, pile_up);
+  EXPECT_EQ(0, pile_up->last_advance_cost().steps);
+  EXPECT_EQ(0, pile_up->last_advance_cost().evaluations);
+
+  VesselSet collided_vessels;
+  plugin.AdvanceTime(plugin.CurrentTime() + 1 * Hour, 0 * Radian);
+  plugin.CatchUpLaggingVessels(collided_vessels);
+  EXPECT_LT(vessel->psychohistory()->back().time, plugin.CurrentTime());
+  EXPECT_EQ(0, pile_up->last_advance_cost().steps);
+
+  plugin.AdvanceTime(plugin.CurrentTime() + 1 * Hour, 0 * Radian);
+  plugin.CatchUpLaggingVessels(collided_vessels);
+  EXPECT_EQ(plugin.CurrentTime(), vessel->psychohistory()->back().time);
+  EXPECT_LT(0, pile_up->last_advance_cost().steps);
+  EXPECT_LE(pile_up->last_advance_cost().steps,
+            pile_up->last_advance_cost().evaluations);
+  EXPECT_TRUE(collided_vessels.empty());
+}
+
+TEST_F(PluginTest, GroupedFixedStep) {
+  // Two vessels on opposite sides of the same circular orbit, each in its own
+  // pile-up.
+  std::vector<GUID> const guids = {"Debris 1", "Debris 2"};
+  std::vector<PartId> const part_ids = {666, 777};
+  std::vector<double> const signs = {1, -1};
+
+  auto const advance = [this, &guids, &part_ids, &signs](bool const grouped) {
+    std::vector<Position<Barycentric>> positions;
+    Plugin plugin(initial_time_,
+                  initial_time_,
+                  0 * Radian);
+    plugin.InsertCelestialAbsoluteCartesian(
+        SolarSystemFactory::Earth,
+        /*parent_index=*/std::nullopt,
+        solar_system_->gravity_model_message(
+            SolarSystemFactory::name(SolarSystemFactory::Earth)),
+        solar_system_->cartesian_initial_state_message(
+            SolarSystemFactory::name(SolarSystemFactory::Earth)));
+    plugin.EndInitialization();
+    plugin.SetGroupedFixedStep(grouped);
+
+    for (int i = 0; i < guids.size(); ++i) {
+      bool inserted;
+      plugin.InsertOrKeepVessel(guids[i],
+                                "v" + guids[i],
+                                SolarSystemFactory::Earth,
+                                /*loaded=*/false,
+                                inserted);
+      plugin.InsertUnloadedPart(
+          part_ids[i],
+          "part",
+          guids[i],
+          RelativeDegreesOfFreedom<AliceSun>(
+              signs[i] * satellite_initial_displacement_,
+              signs[i] * satellite_initial_velocity_));
+    }
+    plugin.PrepareToReportCollisions();
+    plugin.FreeVesselsAndPartsAndCollectPileUps(20 * Milli(Second));
+
+    for (int i = 0; i < 60; ++i) {
+      plugin.AdvanceTime(plugin.CurrentTime() + 1 * Minute, 0 * Radian);
+      VesselSet collided_vessels;
+      plugin.CatchUpLaggingVessels(collided_vessels);
+      EXPECT_TRUE(collided_vessels.empty());
+    }
+    for (auto const& guid : guids) {
+      auto const& last = plugin.GetVessel(guid)->psychohistory()->back();
+      EXPECT_EQ(plugin.CurrentTime(), last.time);
+      positions.push_back(last.degrees_of_freedom.position());
+    }
+    return positions;
+  };
+
+  auto const separate_positions = advance(/*grouped=*/false);
+  auto const grouped_positions = advance(/*grouped=*/true);
+  for (int i = 0; i < guids.size(); ++i) {
+    EXPECT_THAT((grouped_positions[i] - separate_positions[i]).Norm(),
+                Lt(1 * Milli(Metre)));
+  }
+}
+
 TEST_F(PluginTest, Frenet) {
   // Create a plugin with planetarium rotation 0.
   Plugin plugin(initial_time_,
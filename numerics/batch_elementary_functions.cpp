@@ -0,0 +1,576 @@
+#include "numerics/batch_elementary_functions.hpp"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "glog/logging.h"
+
+namespace principia {
+namespace numerics {
+namespace _batch_elementary_functions {
+namespace internal {
+
+namespace {
+
+constexpr int lanes = 4;
+
+// Adding this constant to a double of magnitude less than 2⁵¹ rounds it to an
+// integer, which ends up in the low bits of the representation of the sum.
+constexpr double magic = 0x1.8p52;
+constexpr std::int64_t magic_bits = 0x4338'0000'0000'0000;
+
+// π/2 split in three parts, and π and π/2 split in two parts.
+constexpr double π_over_2_1 = 0x1.921fb54442d18p0;
+constexpr double π_over_2_2 = 0x1.1a62633145c07p-54;
+constexpr double π_over_2_3 = -0x1.f1976b7ed8fbcp-110;
+constexpr double π_hi = 3.141592653589793;
+constexpr double π_lo = 1.2246467991473532e-16;
+constexpr double two_over_π = 0.6366197723675814;
+
+constexpr double ln_2_hi = 0.6931471805599453;
+constexpr double ln_2_lo = 2.3190468138462996e-17;
+constexpr double one_over_ln_2 = 1.4426950408889634;
+
+// ArcTan(i/8) for i in [0, 8], split in two parts.
+constexpr double arctan_hi[] = {0.0,
+                                0.12435499454676144,
+                                0.24497866312686414,
+                                0.35877067027057225,
+                                0.4636476090008061,
+                                0.5585993153435624,
+                                0.6435011087932844,
+                                0.7188299996216245,
+                                0.7853981633974483};
+constexpr double arctan_lo[] = {0.0,
+                                -3.1253241424539383e-18,
+                                1.0698755618734451e-17,
+                                -2.4623815582638635e-17,
+                                2.2698777452961687e-17,
+                                -5.4556305485916264e-18,
+                                1.5834785051444286e-17,
+                                -2.1478388444456983e-17,
+                                3.061616997868383e-17};
+
+// The polynomials below are Taylor expansions, truncated so that the
+// truncation error is well below the rounding errors in |Mode::Accurate|.
+// The denominators are exactly representable, so the coefficients are
+// correctly rounded.
+
+// Sin(r) = r + r³ S(r²) on [-π/4, π/4].
+constexpr std::array<double, 8> accurate_sin = {
+    -1.0 / 6.0,
+    1.0 / 120.0,
+    -1.0 / 5040.0,
+    1.0 / 362880.0,
+    -1.0 / 39916800.0,
+    1.0 / 6227020800.0,
+    -1.0 / 1307674368000.0,
+    1.0 / 355687428096000.0};
+constexpr std::array<double, 5> fast_sin = {
+    -1.0 / 6.0,
+    1.0 / 120.0,
+    -1.0 / 5040.0,
+    1.0 / 362880.0,
+    -1.0 / 39916800.0};
+
+// Cos(r) = 1 - r²/2 + r⁴ C(r²) on [-π/4, π/4].
+constexpr std::array<double, 8> accurate_cos = {
+    1.0 / 24.0,
+    -1.0 / 720.0,
+    1.0 / 40320.0,
+    -1.0 / 3628800.0,
+    1.0 / 479001600.0,
+    -1.0 / 87178291200.0,
+    1.0 / 20922789888000.0,
+    -1.0 / 6402373705728000.0};
+constexpr std::array<double, 5> fast_cos = {
+    1.0 / 24.0,
+    -1.0 / 720.0,
+    1.0 / 40320.0,
+    -1.0 / 3628800.0,
+    1.0 / 479001600.0};
+
+// ArcTan(r) = r + r³ A(r²) on [-1/16, 1/16].
+constexpr std::array<double, 6> accurate_arctan = {
+    -1.0 / 3.0, 1.0 / 5.0, -1.0 / 7.0, 1.0 / 9.0, -1.0 / 11.0, 1.0 / 13.0};
+constexpr std::array<double, 3> fast_arctan = {
+    -1.0 / 3.0, 1.0 / 5.0, -1.0 / 7.0};
+
+// Exp(r) on [-Log(2)/2, Log(2)/2].
+constexpr std::array<double, 14> accurate_exp = {1.0,
+                                                 1.0,
+                                                 1.0 / 2.0,
+                                                 1.0 / 6.0,
+                                                 1.0 / 24.0,
+                                                 1.0 / 120.0,
+                                                 1.0 / 720.0,
+                                                 1.0 / 5040.0,
+                                                 1.0 / 40320.0,
+                                                 1.0 / 362880.0,
+                                                 1.0 / 3628800.0,
+                                                 1.0 / 39916800.0,
+                                                 1.0 / 479001600.0,
+                                                 1.0 / 6227020800.0};
+constexpr std::array<double, 9> fast_exp = {1.0,
+                                            1.0,
+                                            1.0 / 2.0,
+                                            1.0 / 6.0,
+                                            1.0 / 24.0,
+                                            1.0 / 120.0,
+                                            1.0 / 720.0,
+                                            1.0 / 5040.0,
+                                            1.0 / 40320.0};
+
+// 2 ArcTanh(s) = 2 s + 2 s³ L(s²) on [-3 + 2√2, 3 - 2√2].
+constexpr std::array<double, 9> accurate_log = {1.0 / 3.0,
+                                                1.0 / 5.0,
+                                                1.0 / 7.0,
+                                                1.0 / 9.0,
+                                                1.0 / 11.0,
+                                                1.0 / 13.0,
+                                                1.0 / 15.0,
+                                                1.0 / 17.0,
+                                                1.0 / 19.0};
+constexpr std::array<double, 4> fast_log = {
+    1.0 / 3.0, 1.0 / 5.0, 1.0 / 7.0, 1.0 / 9.0};
+
+template<Mode mode, std::size_t accurate_size, std::size_t fast_size>
+constexpr auto const& Select(std::array<double, accurate_size> const& accurate,
+                             std::array<double, fast_size> const& fast) {
+  if constexpr (mode == Mode::Accurate) {
+    return accurate;
+  } else {
+    return fast;
+  }
+}
+
+template<std::size_t size>
+PRINCIPIA_TARGET("avx2,fma")
+inline __m256d Horner(std::array<double, size> const& coefficients,
+                      __m256d const x) {
+  __m256d result = _mm256_set1_pd(coefficients[size - 1]);
+  for (int i = size - 2; i >= 0; --i) {
+    result = _mm256_fmadd_pd(result, x, _mm256_set1_pd(coefficients[i]));
+  }
+  return result;
+}
+
+// Rounds |x| to the nearest integer, which is returned as a double and in the
+// low bits of |bits|.  |x| must be less than 2⁵¹ in magnitude.
+PRINCIPIA_TARGET("avx2,fma")
+inline __m256d Round(__m256d const x, __m256i& bits) {
+  __m256d const shifted = _mm256_add_pd(x, _mm256_set1_pd(magic));
+  bits = _mm256_sub_epi64(_mm256_castpd_si256(shifted),
+                          _mm256_set1_epi64x(magic_bits));
+  return _mm256_sub_pd(shifted, _mm256_set1_pd(magic));
+}
+
+PRINCIPIA_TARGET("avx2,fma")
+inline __m256d Abs(__m256d const x) {
+  return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+}
+
+// Each kernel below has a |Vector| function that processes |lanes| elements
+// and returns a bit mask of the lanes that are outside of its domain, and a
+// |Scalar| function that processes one element with the standard library.
+
+template<Mode mode>
+PRINCIPIA_TARGET("avx2,fma")
+inline int SinCosVector(__m256d const x, __m256d& sin, __m256d& cos) {
+  // The computation is done on |x|, and the sign of sin is restored at the
+  // end, which yields Sin(-0) = -0.
+  __m256d const abs_x = Abs(x);
+  int const outside = _mm256_movemask_pd(
+      _mm256_cmp_pd(abs_x, _mm256_set1_pd(0x1p20), _CMP_NLE_UQ));
+  // Argument reduction: |x| = k π/2 + r with |r| ≤ π/4.  The first step is
+  // exact in the domain.
+  __m256i k_bits;
+  __m256d const k = Round(_mm256_mul_pd(abs_x, _mm256_set1_pd(two_over_π)),
+                          k_bits);
+  __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(π_over_2_1), abs_x);
+  r = _mm256_fnmadd_pd(k, _mm256_set1_pd(π_over_2_2), r);
+  r = _mm256_fnmadd_pd(k, _mm256_set1_pd(π_over_2_3), r);
+
+  __m256d const r² = _mm256_mul_pd(r, r);
+  __m256d const s = _mm256_fmadd_pd(
+      _mm256_mul_pd(r, r²),
+      Horner(Select<mode>(accurate_sin, fast_sin), r²),
+      r);
+  __m256d const c = _mm256_fmadd_pd(
+      _mm256_mul_pd(r², r²),
+      Horner(Select<mode>(accurate_cos, fast_cos), r²),
+      _mm256_fnmadd_pd(_mm256_set1_pd(0.5), r², _mm256_set1_pd(1.0)));
+
+  // The quadrant is given by the two low bits of k: in quadrants 1 and 3, sin
+  // and cos are swapped; the sign of sin is that of bit 1 of k, the sign of cos
+  // that of bit 1 of k + 1.
+  __m256i const one = _mm256_set1_epi64x(1);
+  __m256d const swap = _mm256_castsi256_pd(
+      _mm256_cmpeq_epi64(_mm256_and_si256(k_bits, one), one));
+  __m256d const sin_sign = _mm256_castsi256_pd(_mm256_slli_epi64(
+      _mm256_and_si256(k_bits, _mm256_set1_epi64x(2)), 62));
+  __m256d const cos_sign = _mm256_castsi256_pd(_mm256_slli_epi64(
+      _mm256_and_si256(_mm256_add_epi64(k_bits, one), _mm256_set1_epi64x(2)),
+      62));
+  sin = _mm256_xor_pd(_mm256_blendv_pd(s, c, swap),
+                      _mm256_xor_pd(sin_sign,
+                                    _mm256_and_pd(x, _mm256_set1_pd(-0.0))));
+  cos = _mm256_xor_pd(_mm256_blendv_pd(c, s, swap), cos_sign);
+  return outside;
+}
+
+struct SinKernel {
+  static constexpr int inputs = 1;
+  static constexpr int outputs = 1;
+
+  template<Mode mode>
+  PRINCIPIA_TARGET("avx2,fma")
+  static int Vector(__m256d const (&x)[inputs], __m256d (&y)[outputs]) {
+    __m256d cos;
+    return SinCosVector<mode>(x[0], y[0], cos);
+  }
+
+  static void Scalar(double const (&x)[inputs], double (&y)[outputs]) {
+    y[0] = std::sin(x[0]);
+  }
+};
+
+struct CosKernel {
+  static constexpr int inputs = 1;
+  static constexpr int outputs = 1;
+
+  template<Mode mode>
+  PRINCIPIA_TARGET("avx2,fma")
+  static int Vector(__m256d const (&x)[inputs], __m256d (&y)[outputs]) {
+    __m256d sin;
+    return SinCosVector<mode>(x[0], sin, y[0]);
+  }
+
+  static void Scalar(double const (&x)[inputs], double (&y)[outputs]) {
+    y[0] = std::cos(x[0]);
+  }
+};
+
+struct SinCosKernel {
+  static constexpr int inputs = 1;
+  static constexpr int outputs = 2;
+
+  template<Mode mode>
+  PRINCIPIA_TARGET("avx2,fma")
+  static int Vector(__m256d const (&x)[inputs], __m256d (&y)[outputs]) {
+    return SinCosVector<mode>(x[0], y[0], y[1]);
+  }
+
+  static void Scalar(double const (&x)[inputs], double (&y)[outputs]) {
+    y[0] = std::sin(x[0]);
+    y[1] = std::cos(x[0]);
+  }
+};
+
+struct ArcTanKernel {
+  static constexpr int inputs = 2;
+  static constexpr int outputs = 1;
+
+  template<Mode mode>
+  PRINCIPIA_TARGET("avx2,fma")
+  static int Vector(__m256d const (&x)[inputs], __m256d (&y)[outputs]) {
+    __m256d const max = _mm256_set1_pd(std::numeric_limits<double>::max());
+    __m256d const abs_y = Abs(x[0]);
+    __m256d const abs_x = Abs(x[1]);
+    __m256d const numerator = _mm256_min_pd(abs_x, abs_y);
+    __m256d const denominator = _mm256_max_pd(abs_x, abs_y);
+    __m256d const outside_mask = _mm256_or_pd(
+        _mm256_or_pd(_mm256_cmp_pd(abs_x, max, _CMP_NLE_UQ),
+                     _mm256_cmp_pd(abs_y, max, _CMP_NLE_UQ)),
+        _mm256_cmp_pd(denominator, _mm256_setzero_pd(), _CMP_EQ_OQ));
+
+    // Reduction to |r| ≤ 1/16 using ArcTan(t) = ArcTan(c) + ArcTan(r) with
+    // c = i/8 and r = (t - c) / (1 + t c).  The subtraction is exact.
+    __m256d const t = _mm256_div_pd(numerator, denominator);
+    __m256i i;
+    __m256d const c = _mm256_mul_pd(
+        Round(_mm256_mul_pd(t, _mm256_set1_pd(8.0)), i),
+        _mm256_set1_pd(0.125));
+    __m256d const r =
+        _mm256_div_pd(_mm256_sub_pd(t, c),
+                      _mm256_fmadd_pd(t, c, _mm256_set1_pd(1.0)));
+    __m256d const r² = _mm256_mul_pd(r, r);
+    __m256d const arctan_r = _mm256_fmadd_pd(
+        _mm256_mul_pd(r, r²),
+        Horner(Select<mode>(accurate_arctan, fast_arctan), r²),
+        r);
+
+    // The result is carried as hi + lo until the end.  The index is garbage
+    // for the lanes outside of the domain, so it must be cleared before the
+    // gathers.
+    i = _mm256_andnot_si256(_mm256_castpd_si256(outside_mask), i);
+    __m256d hi = _mm256_i64gather_pd(arctan_hi, i, sizeof(double));
+    __m256d lo = _mm256_add_pd(
+        _mm256_i64gather_pd(arctan_lo, i, sizeof(double)), arctan_r);
+
+    // If |y| > |x|, the result is π/2 - ArcTan(|x|/|y|).
+    __m256d const swap = _mm256_cmp_pd(abs_y, abs_x, _CMP_GT_OQ);
+    hi = _mm256_blendv_pd(
+        hi, _mm256_sub_pd(_mm256_set1_pd(π_over_2_1), hi), swap);
+    lo = _mm256_blendv_pd(
+        lo, _mm256_sub_pd(_mm256_set1_pd(π_over_2_2), lo), swap);
+    // If x < 0, the result is π - the above.
+    __m256d const negative_x = x[1];
+    hi = _mm256_blendv_pd(hi, _mm256_sub_pd(_mm256_set1_pd(π_hi), hi),
+                          negative_x);
+    lo = _mm256_blendv_pd(lo, _mm256_sub_pd(_mm256_set1_pd(π_lo), lo),
+                          negative_x);
+    // The result has the sign of y.
+    y[0] = _mm256_or_pd(_mm256_add_pd(hi, lo),
+                        _mm256_and_pd(x[0], _mm256_set1_pd(-0.0)));
+    return _mm256_movemask_pd(outside_mask);
+  }
+
+  static void Scalar(double const (&x)[inputs], double (&y)[outputs]) {
+    y[0] = std::atan2(x[0], x[1]);
+  }
+};
+
+struct ExpKernel {
+  static constexpr int inputs = 1;
+  static constexpr int outputs = 1;
+
+  template<Mode mode>
+  PRINCIPIA_TARGET("avx2,fma")
+  static int Vector(__m256d const (&x)[inputs], __m256d (&y)[outputs]) {
+    int const outside =
+        _mm256_movemask_pd(_mm256_cmp_pd(Abs(x[0]),
+                                         _mm256_set1_pd(708.0),
+                                         _CMP_NLE_UQ));
+    // Argument reduction: x = k Log(2) + r with |r| ≤ Log(2)/2.  The first
+    // step is exact in the domain.
+    __m256i k_bits;
+    __m256d const k =
+        Round(_mm256_mul_pd(x[0], _mm256_set1_pd(one_over_ln_2)), k_bits);
+    __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(ln_2_hi), x[0]);
+    r = _mm256_fnmadd_pd(k, _mm256_set1_pd(ln_2_lo), r);
+    // 2ᵏ, which is a normal number in the domain.
+    __m256d const two_to_the_k = _mm256_castsi256_pd(_mm256_slli_epi64(
+        _mm256_add_epi64(k_bits, _mm256_set1_epi64x(1023)), 52));
+    y[0] = _mm256_mul_pd(Horner(Select<mode>(accurate_exp, fast_exp), r),
+                         two_to_the_k);
+    return outside;
+  }
+
+  static void Scalar(double const (&x)[inputs], double (&y)[outputs]) {
+    y[0] = std::exp(x[0]);
+  }
+};
+
+struct LogKernel {
+  static constexpr int inputs = 1;
+  static constexpr int outputs = 1;
+
+  template<Mode mode>
+  PRINCIPIA_TARGET("avx2,fma")
+  static int Vector(__m256d const (&x)[inputs], __m256d (&y)[outputs]) {
+    int const outside = _mm256_movemask_pd(_mm256_or_pd(
+        _mm256_cmp_pd(x[0],
+                      _mm256_set1_pd(std::numeric_limits<double>::min()),
+                      _CMP_NGE_UQ),
+        _mm256_cmp_pd(x[0],
+                      _mm256_set1_pd(std::numeric_limits<double>::max()),
+                      _CMP_NLE_UQ)));
+    // Decomposition x = 2ᵉ m with m in [√2/2, √2].
+    __m256i const bits = _mm256_castpd_si256(x[0]);
+    __m256d m = _mm256_castsi256_pd(_mm256_or_si256(
+        _mm256_and_si256(bits, _mm256_set1_epi64x(0x000F'FFFF'FFFF'FFFF)),
+        _mm256_set1_epi64x(0x3FF0'0000'0000'0000)));
+    __m256d e = _mm256_sub_pd(
+        _mm256_castsi256_pd(_mm256_add_epi64(
+            _mm256_sub_epi64(_mm256_srli_epi64(bits, 52),
+                             _mm256_set1_epi64x(1023)),
+            _mm256_set1_epi64x(magic_bits))),
+        _mm256_set1_pd(magic));
+    // The threshold is √2.
+    __m256d const halve =
+        _mm256_cmp_pd(m, _mm256_set1_pd(0x1.6a09e667f3bcdp0), _CMP_GT_OQ);
+    m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), halve);
+    e = _mm256_add_pd(e, _mm256_and_pd(halve, _mm256_set1_pd(1.0)));
+
+    // Log(m) = 2 ArcTanh(s) with s = (m - 1) / (m + 1).  The subtraction is
+    // exact.
+    __m256d const f = _mm256_sub_pd(m, _mm256_set1_pd(1.0));
+    __m256d const s =
+        _mm256_div_pd(f, _mm256_add_pd(f, _mm256_set1_pd(2.0)));
+    __m256d const two_s = _mm256_add_pd(s, s);
+    __m256d const s² = _mm256_mul_pd(s, s);
+    __m256d const log_m = _mm256_fmadd_pd(
+        _mm256_mul_pd(two_s, s²),
+        Horner(Select<mode>(accurate_log, fast_log), s²),
+        two_s);
+    y[0] = _mm256_fmadd_pd(
+        e,
+        _mm256_set1_pd(ln_2_hi),
+        _mm256_fmadd_pd(e, _mm256_set1_pd(ln_2_lo), log_m));
+    return outside;
+  }
+
+  static void Scalar(double const (&x)[inputs], double (&y)[outputs]) {
+    y[0] = std::log(x[0]);
+  }
+};
+
+// Processes |count| ≤ |lanes| elements starting at |index|.  If |count| is less
+// than |lanes|, the last element is repeated to fill the registers.
+template<typename Kernel, Mode mode>
+PRINCIPIA_TARGET("avx2,fma")
+inline void ProcessGroup(
+    std::array<double const*, Kernel::inputs> const& inputs,
+    std::array<double*, Kernel::outputs> const& outputs,
+    std::int64_t const index,
+    int const count) {
+  __m256d x[Kernel::inputs];
+  __m256d y[Kernel::outputs];
+  for (int j = 0; j < Kernel::inputs; ++j) {
+    if (count == lanes) {
+      x[j] = _mm256_loadu_pd(&inputs[j][index]);
+    } else {
+      double padded[lanes];
+      for (int l = 0; l < lanes; ++l) {
+        padded[l] = inputs[j][index + std::min(l, count - 1)];
+      }
+      x[j] = _mm256_loadu_pd(padded);
+    }
+  }
+  int const outside = Kernel::template Vector<mode>(x, y);
+
+  double values[Kernel::outputs][lanes];
+  for (int j = 0; j < Kernel::outputs; ++j) {
+    _mm256_storeu_pd(values[j], y[j]);
+  }
+  if (outside != 0) {
+    // The inputs may have been overwritten if they are also outputs, so we use
+    // the copies in the registers.
+    double arguments[Kernel::inputs][lanes];
+    for (int j = 0; j < Kernel::inputs; ++j) {
+      _mm256_storeu_pd(arguments[j], x[j]);
+    }
+    for (int l = 0; l < count; ++l) {
+      if (outside & (1 << l)) {
+        double scalar_x[Kernel::inputs];
+        double scalar_y[Kernel::outputs];
+        for (int j = 0; j < Kernel::inputs; ++j) {
+          scalar_x[j] = arguments[j][l];
+        }
+        Kernel::Scalar(scalar_x, scalar_y);
+        for (int j = 0; j < Kernel::outputs; ++j) {
+          values[j][l] = scalar_y[j];
+        }
+      }
+    }
+  }
+  for (int j = 0; j < Kernel::outputs; ++j) {
+    std::copy(values[j], values[j] + count, &outputs[j][index]);
+  }
+}
+
+template<typename Kernel, Mode mode>
+PRINCIPIA_TARGET("avx2,fma")
+void ApplyVectorized(std::array<double const*, Kernel::inputs> const& inputs,
+                     std::array<double*, Kernel::outputs> const& outputs,
+                     std::int64_t const size) {
+  std::int64_t i = 0;
+  for (; i + lanes <= size; i += lanes) {
+    ProcessGroup<Kernel, mode>(inputs, outputs, i, lanes);
+  }
+  if (i < size) {
+    ProcessGroup<Kernel, mode>(inputs, outputs, i, size - i);
+  }
+}
+
+template<typename Kernel>
+void Apply(Mode const mode,
+           std::array<Array<double const>, Kernel::inputs> const& inputs,
+           std::array<Array<double>, Kernel::outputs> const& outputs) {
+  std::int64_t const size = inputs[0].size;
+  std::array<double const*, Kernel::inputs> input_data;
+  std::array<double*, Kernel::outputs> output_data;
+  for (int j = 0; j < Kernel::inputs; ++j) {
+    CHECK_EQ(size, inputs[j].size);
+    input_data[j] = inputs[j].data;
+  }
+  for (int j = 0; j < Kernel::outputs; ++j) {
+    CHECK_EQ(size, outputs[j].size);
+    output_data[j] = outputs[j].data;
+  }
+
+  if (UseVectorizedElementaryFunctions) {
+    switch (mode) {
+      case Mode::Accurate:
+        ApplyVectorized<Kernel, Mode::Accurate>(input_data, output_data, size);
+        return;
+      case Mode::Fast:
+        ApplyVectorized<Kernel, Mode::Fast>(input_data, output_data, size);
+        return;
+    }
+    LOG(FATAL) << "Unexpected mode " << static_cast<int>(mode);
+  } else {
+    for (std::int64_t i = 0; i < size; ++i) {
+      double x[Kernel::inputs];
+      double y[Kernel::outputs];
+      for (int j = 0; j < Kernel::inputs; ++j) {
+        x[j] = input_data[j][i];
+      }
+      Kernel::Scalar(x, y);
+      for (int j = 0; j < Kernel::outputs; ++j) {
+        output_data[j][i] = y[j];
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void Sin(Mode const mode,
+         Array<double const> const x,
+         Array<double> const sin) {
+  Apply<SinKernel>(mode, {x}, {sin});
+}
+
+void Cos(Mode const mode,
+         Array<double const> const x,
+         Array<double> const cos) {
+  Apply<CosKernel>(mode, {x}, {cos});
+}
+
+void SinCos(Mode const mode,
+            Array<double const> const x,
+            Array<double> const sin,
+            Array<double> const cos) {
+  Apply<SinCosKernel>(mode, {x}, {sin, cos});
+}
+
+void ArcTan(Mode const mode,
+            Array<double const> const y,
+            Array<double const> const x,
+            Array<double> const arctan) {
+  Apply<ArcTanKernel>(mode, {y, x}, {arctan});
+}
+
+void Exp(Mode const mode,
+         Array<double const> const x,
+         Array<double> const exp) {
+  Apply<ExpKernel>(mode, {x}, {exp});
+}
+
+void Log(Mode const mode,
+         Array<double const> const x,
+         Array<double> const log) {
+  Apply<LogKernel>(mode, {x}, {log});
+}
+
+}  // namespace internal
+}  // namespace _batch_elementary_functions
+}  // namespace numerics
+}  // namespace principia
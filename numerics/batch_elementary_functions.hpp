@@ -0,0 +1,81 @@
+#pragma once
+
+#include "base/array.hpp"
+#include "base/cpuid.hpp"
+#include "base/macros.hpp"
+
+namespace principia {
+namespace numerics {
+namespace _batch_elementary_functions {
+namespace internal {
+
+using namespace principia::base::_array;
+using namespace principia::base::_cpuid;
+
+// Elementary functions evaluated on arrays of doubles.  Each function writes
+// one result per element of its input(s); the outputs must have the same size
+// as the inputs.  An output may be the same array as an input, but it must not
+// otherwise overlap it.
+//
+// When |UseVectorizedElementaryFunctions| is true, the elements are processed
+// by groups of 4 with AVX2 and FMA.  Each vectorized implementation has a
+// domain, given below; elements outside of it (including infinities and NaNs)
+// are computed by the standard library, so that the results are correct for
+// all arguments.  The same happens for all elements if the processor doesn't
+// support the vectorized implementations.
+//
+// The error bounds below are for the vectorized implementations in their
+// domain, and are measured with respect to the standard library functions.
+// They are in ULPs of the result for |Mode::Accurate|, and are absolute errors
+// (relative for |Exp|) for |Mode::Fast|.
+
+enum class Mode {
+  // Errors of at most 2 ULPs.
+  Accurate,
+  // Shorter polynomials, between 10% and 100% faster depending on the function.
+  Fast,
+};
+
+#if PRINCIPIA_USE_FMA_IF_AVAILABLE
+inline bool const UseVectorizedElementaryFunctions =
+    HasCPUFeatures(CPUFeatureFlags::AVX | CPUFeatureFlags::FMA) &&
+    HasCPUFeatures(CPUExtendedFeatureFlags::AVX2);
+#else
+inline bool const UseVectorizedElementaryFunctions = false;
+#endif
+
+// Domain: |x| ≤ 2²⁰.  Accurate: 2 ULPs for sin, 1 ULP for cos.  Fast: 1e-11.
+void Sin(Mode mode, Array<double const> x, Array<double> sin);
+void Cos(Mode mode, Array<double const> x, Array<double> cos);
+void SinCos(Mode mode,
+            Array<double const> x,
+            Array<double> sin,
+            Array<double> cos);
+
+// The arguments are in the order of |std::atan2|.  Domain: finite |x| and |y|,
+// not both zero.  Accurate: 2 ULPs.  Fast: 2e-12.
+void ArcTan(Mode mode,
+            Array<double const> y,
+            Array<double const> x,
+            Array<double> arctan);
+
+// Domain: |x| ≤ 708.  Accurate: 1 ULP.  Fast: relative error 3e-10.
+void Exp(Mode mode, Array<double const> x, Array<double> exp);
+
+// Domain: normal, finite, positive |x|.  Accurate: 2 ULPs.  Fast: 1e-9.
+void Log(Mode mode, Array<double const> x, Array<double> log);
+
+}  // namespace internal
+
+using internal::ArcTan;
+using internal::Cos;
+using internal::Exp;
+using internal::Log;
+using internal::Mode;
+using internal::Sin;
+using internal::SinCos;
+using internal::UseVectorizedElementaryFunctions;
+
+}  // namespace _batch_elementary_functions
+}  // namespace numerics
+}  // namespace principia
@@ -0,0 +1,211 @@
+#include "numerics/batch_elementary_functions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "numerics/ulp_distance.hpp"
+
+namespace principia {
+namespace numerics {
+
+using namespace principia::numerics::_batch_elementary_functions;
+using namespace principia::numerics::_ulp_distance;
+
+class BatchElementaryFunctionsTest : public ::testing::Test {
+ protected:
+  static constexpr int size_ = 100'003;
+
+  // Returns uniformly distributed values in [min, max].
+  static std::vector<double> Uniform(double const min, double const max) {
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<> distribution(min, max);
+    std::vector<double> result(size_);
+    for (auto& x : result) {
+      x = distribution(random);
+    }
+    return result;
+  }
+
+  // Returns values whose logarithm is uniformly distributed in
+  // [log_min, log_max], with random signs if |signed_values| is true.
+  static std::vector<double> LogUniform(double const log_min,
+                                        double const log_max,
+                                        bool const signed_values) {
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<> distribution(log_min, log_max);
+    std::bernoulli_distribution sign;
+    std::vector<double> result(size_);
+    for (auto& x : result) {
+      x = std::exp(distribution(random));
+      if (signed_values && sign(random)) {
+        x = -x;
+      }
+    }
+    return result;
+  }
+
+  static std::int64_t MaxULPDistance(std::vector<double> const& expected,
+                                     std::vector<double> const& actual) {
+    std::int64_t result = 0;
+    for (int i = 0; i < expected.size(); ++i) {
+      result = std::max(result, ULPDistance(expected[i], actual[i]));
+    }
+    return result;
+  }
+
+  static double MaxAbsoluteError(std::vector<double> const& expected,
+                                 std::vector<double> const& actual) {
+    double result = 0;
+    for (int i = 0; i < expected.size(); ++i) {
+      result = std::max(result, std::abs(expected[i] - actual[i]));
+    }
+    return result;
+  }
+
+  static double MaxRelativeError(std::vector<double> const& expected,
+                                 std::vector<double> const& actual) {
+    double result = 0;
+    for (int i = 0; i < expected.size(); ++i) {
+      result = std::max(result,
+                        std::abs((expected[i] - actual[i]) / expected[i]));
+    }
+    return result;
+  }
+
+  static std::vector<double> Map(std::function<double(double)> const& f,
+                                 std::vector<double> const& x) {
+    std::vector<double> result;
+    for (double const x_i : x) {
+      result.push_back(f(x_i));
+    }
+    return result;
+  }
+};
+
+TEST_F(BatchElementaryFunctionsTest, SinCos) {
+  for (auto const& x :
+       {Uniform(-10, 10), LogUniform(-30, std::log(0x1p20), true)}) {
+    std::vector<double> const expected_sin =
+        Map(static_cast<double (*)(double)>(&std::sin), x);
+    std::vector<double> const expected_cos =
+        Map(static_cast<double (*)(double)>(&std::cos), x);
+    std::vector<double> sin(x.size());
+    std::vector<double> cos(x.size());
+
+    Sin(Mode::Accurate, x, sin);
+    EXPECT_LE(MaxULPDistance(expected_sin, sin), 2);
+    Cos(Mode::Accurate, x, cos);
+    EXPECT_LE(MaxULPDistance(expected_cos, cos), 1);
+    std::fill(sin.begin(), sin.end(), 0);
+    std::fill(cos.begin(), cos.end(), 0);
+    SinCos(Mode::Accurate, x, sin, cos);
+    EXPECT_LE(MaxULPDistance(expected_sin, sin), 2);
+    EXPECT_LE(MaxULPDistance(expected_cos, cos), 1);
+
+    Sin(Mode::Fast, x, sin);
+    EXPECT_LE(MaxAbsoluteError(expected_sin, sin), 1e-11);
+    Cos(Mode::Fast, x, cos);
+    EXPECT_LE(MaxAbsoluteError(expected_cos, cos), 1e-11);
+  }
+}
+
+TEST_F(BatchElementaryFunctionsTest, ArcTan) {
+  std::vector<double> const y = LogUniform(-20, 20, true);
+  std::vector<double> x = LogUniform(-20, 20, true);
+  std::reverse(x.begin(), x.end());
+  std::vector<double> expected;
+  for (int i = 0; i < x.size(); ++i) {
+    expected.push_back(std::atan2(y[i], x[i]));
+  }
+  std::vector<double> arctan(x.size());
+
+  ArcTan(Mode::Accurate, y, x, arctan);
+  EXPECT_LE(MaxULPDistance(expected, arctan), 2);
+  ArcTan(Mode::Fast, y, x, arctan);
+  EXPECT_LE(MaxAbsoluteError(expected, arctan), 2e-12);
+}
+
+TEST_F(BatchElementaryFunctionsTest, Exp) {
+  std::vector<double> const x = Uniform(-708, 708);
+  std::vector<double> const expected =
+      Map(static_cast<double (*)(double)>(&std::exp), x);
+  std::vector<double> exp(x.size());
+
+  Exp(Mode::Accurate, x, exp);
+  EXPECT_LE(MaxULPDistance(expected, exp), 1);
+  Exp(Mode::Fast, x, exp);
+  EXPECT_LE(MaxRelativeError(expected, exp), 3e-10);
+}
+
+TEST_F(BatchElementaryFunctionsTest, Log) {
+  for (auto const& x : {Uniform(0.5, 2), LogUniform(-700, 700, false)}) {
+    std::vector<double> const expected =
+        Map(static_cast<double (*)(double)>(&std::log), x);
+    std::vector<double> log(x.size());
+
+    Log(Mode::Accurate, x, log);
+    EXPECT_LE(MaxULPDistance(expected, log), 2);
+    Log(Mode::Fast, x, log);
+    EXPECT_LE(MaxAbsoluteError(expected, log), 1e-9);
+  }
+}
+
+// Arguments outside of the domains of the vectorized implementations give the
+// results of the standard library, the others are within 2 ULPs.
+TEST_F(BatchElementaryFunctionsTest, OutsideDomain) {
+  double const infinity = std::numeric_limits<double>::infinity();
+  double const nan = std::numeric_limits<double>::quiet_NaN();
+  double const denormal = std::numeric_limits<double>::denorm_min();
+  std::vector<double> const x = {
+      0.0, -0.0, 1e300, -1e7, infinity, -infinity, nan, denormal, -1.0, 709.5};
+  std::vector<double> const y = {
+      0.0, 0.0, -0.0, 1.0, infinity, 3.0, 1.0, -infinity, nan, -0.0};
+  std::vector<double> result(x.size());
+  auto const expect_close = [](double const expected, double const actual) {
+    if (std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(actual));
+    } else {
+      EXPECT_LE(ULPDistance(expected, actual), 2);
+      EXPECT_EQ(std::signbit(expected), std::signbit(actual));
+    }
+  };
+  Sin(Mode::Accurate, x, result);
+  for (int i = 0; i < x.size(); ++i) {
+    expect_close(std::sin(x[i]), result[i]);
+  }
+  Exp(Mode::Accurate, x, result);
+  for (int i = 0; i < x.size(); ++i) {
+    expect_close(std::exp(x[i]), result[i]);
+  }
+  Log(Mode::Accurate, x, result);
+  for (int i = 0; i < x.size(); ++i) {
+    expect_close(std::log(x[i]), result[i]);
+  }
+  ArcTan(Mode::Accurate, y, x, result);
+  for (int i = 0; i < x.size(); ++i) {
+    expect_close(std::atan2(y[i], x[i]), result[i]);
+  }
+}
+
+// Results don't depend on the position of an element in the array, and the
+// output may be the input.
+TEST_F(BatchElementaryFunctionsTest, SizesAndAliasing) {
+  std::vector<double> const x = Uniform(-1, 1);
+  std::vector<double> expected(x.size());
+  Exp(Mode::Accurate, x, expected);
+  for (int size = 0; size <= 9; ++size) {
+    std::vector<double> in_place(x.begin(), x.begin() + size);
+    Exp(Mode::Accurate, in_place, in_place);
+    EXPECT_EQ(std::vector<double>(expected.begin(), expected.begin() + size),
+              in_place);
+  }
+}
+
+}  // namespace numerics
+}  // namespace principia
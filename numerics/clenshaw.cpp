@@ -0,0 +1,190 @@
+#include "numerics/clenshaw.hpp"
+
+#include <immintrin.h>
+
+#include <algorithm>
+
+namespace principia {
+namespace numerics {
+namespace _clenshaw {
+namespace internal {
+
+namespace {
+
+constexpr int lanes = 4;
+
+// The x, y, z components of |lanes| values of the recurrence.  The helpers
+// below pass them by value so that they stay in registers once inlined.
+struct Components {
+  __m256d x;
+  __m256d y;
+  __m256d z;
+};
+
+PRINCIPIA_TARGET("avx2,fma")
+inline Components Broadcast(R3Element<double> const& c) {
+  return {_mm256_set1_pd(c.x), _mm256_set1_pd(c.y), _mm256_set1_pd(c.z)};
+}
+
+// Returns a t b_k+1 + c_k - b_k+2, with a = 2 t in the recurrence and a = t for
+// the final value.
+PRINCIPIA_TARGET("avx2,fma")
+inline Components Step(__m256d const a,
+                       Components const& c_k,
+                       Components const& b_kplus1,
+                       Components const& b_kplus2) {
+  return {_mm256_fmadd_pd(a, b_kplus1.x, _mm256_sub_pd(c_k.x, b_kplus2.x)),
+          _mm256_fmadd_pd(a, b_kplus1.y, _mm256_sub_pd(c_k.y, b_kplus2.y)),
+          _mm256_fmadd_pd(a, b_kplus1.z, _mm256_sub_pd(c_k.z, b_kplus2.z))};
+}
+
+PRINCIPIA_TARGET("avx2,fma")
+inline void Store(Components const& components,
+                  R3Element<double>* const values) {
+  double x[lanes];
+  double y[lanes];
+  double z[lanes];
+  _mm256_storeu_pd(x, components.x);
+  _mm256_storeu_pd(y, components.y);
+  _mm256_storeu_pd(z, components.z);
+  for (int l = 0; l < lanes; ++l) {
+    values[l] = R3Element<double>(x[l], y[l], z[l]);
+  }
+}
+
+// Loads the components of |c| in the first three lanes.  The fourth lane would
+// hold the padding of |R3Element|, which is uninitialized and could contain
+// denormals or NaNs that slow down the arithmetic, so it is cleared.
+PRINCIPIA_TARGET("avx2,fma")
+inline __m256d Load(R3Element<double> const& c) {
+  return _mm256_blend_pd(_mm256_setzero_pd(), _mm256_loadu_pd(&c.x), 0b0111);
+}
+
+// Evaluates the series at |lanes| arguments.
+PRINCIPIA_TARGET("avx2,fma")
+void EvaluateOneGroup(R3Element<double> const* const coefficients,
+                      int const degree,
+                      double const* const scaled_t,
+                      R3Element<double>* const values) {
+  __m256d const t = _mm256_loadu_pd(scaled_t);
+  __m256d const two_t = _mm256_add_pd(t, t);
+  __m256d const zero = _mm256_setzero_pd();
+  Components b_kplus1{zero, zero, zero};
+  Components b_kplus2{zero, zero, zero};
+  for (int k = degree; k >= 1; --k) {
+    Components const b_k =
+        Step(two_t, Broadcast(coefficients[k]), b_kplus1, b_kplus2);
+    b_kplus2 = b_kplus1;
+    b_kplus1 = b_k;
+  }
+  Store(Step(t, Broadcast(coefficients[0]), b_kplus1, b_kplus2), values);
+}
+
+// Evaluates the series at |2 * lanes| arguments.  The two groups are
+// independent, which gives the processor more work to overlap with the latency
+// of the fused operations.
+PRINCIPIA_TARGET("avx2,fma")
+void EvaluateTwoGroups(R3Element<double> const* const coefficients,
+                       int const degree,
+                       double const* const scaled_t,
+                       R3Element<double>* const values) {
+  __m256d const t1 = _mm256_loadu_pd(scaled_t);
+  __m256d const t2 = _mm256_loadu_pd(scaled_t + lanes);
+  __m256d const two_t1 = _mm256_add_pd(t1, t1);
+  __m256d const two_t2 = _mm256_add_pd(t2, t2);
+  __m256d const zero = _mm256_setzero_pd();
+  Components b1_kplus1{zero, zero, zero};
+  Components b1_kplus2{zero, zero, zero};
+  Components b2_kplus1{zero, zero, zero};
+  Components b2_kplus2{zero, zero, zero};
+  for (int k = degree; k >= 1; --k) {
+    Components const c_k = Broadcast(coefficients[k]);
+    Components const b1_k = Step(two_t1, c_k, b1_kplus1, b1_kplus2);
+    Components const b2_k = Step(two_t2, c_k, b2_kplus1, b2_kplus2);
+    b1_kplus2 = b1_kplus1;
+    b1_kplus1 = b1_k;
+    b2_kplus2 = b2_kplus1;
+    b2_kplus1 = b2_k;
+  }
+  Components const c_0 = Broadcast(coefficients[0]);
+  Store(Step(t1, c_0, b1_kplus1, b1_kplus2), values);
+  Store(Step(t2, c_0, b2_kplus1, b2_kplus2), values + lanes);
+}
+
+}  // namespace
+
+void EvaluateClenshaw(R3Element<double> const* const coefficients,
+                      int const degree,
+                      double const* const scaled_t,
+                      std::int64_t const count,
+                      R3Element<double>* const values) {
+  std::int64_t i = 0;
+  static_assert(clenshaw_group_size == 2 * lanes);
+  for (; i + clenshaw_group_size <= count; i += clenshaw_group_size) {
+    EvaluateTwoGroups(coefficients, degree, &scaled_t[i], &values[i]);
+  }
+  // Pad the remaining arguments by repeating the last one.
+  while (i < count) {
+    std::int64_t const n = std::min<std::int64_t>(lanes, count - i);
+    double padded_scaled_t[lanes];
+    R3Element<double> padded_values[lanes];
+    for (int l = 0; l < lanes; ++l) {
+      padded_scaled_t[l] = scaled_t[i + std::min<std::int64_t>(l, n - 1)];
+    }
+    EvaluateOneGroup(coefficients, degree, padded_scaled_t, padded_values);
+    std::copy(padded_values, padded_values + n, &values[i]);
+    i += n;
+  }
+}
+
+PRINCIPIA_TARGET("avx2,fma")
+void EvaluateClenshawWithDerivative(R3Element<double> const* const coefficients,
+                                    int const degree,
+                                    double const scaled_t,
+                                    R3Element<double>& value,
+                                    R3Element<double>& derivative) {
+  // The fourth lane is unused.
+  __m256d const t = _mm256_set1_pd(scaled_t);
+  __m256d const two_t = _mm256_add_pd(t, t);
+  __m256d b_kplus1 = _mm256_setzero_pd();
+  __m256d b_kplus2 = _mm256_setzero_pd();
+  __m256d d_kplus1 = _mm256_setzero_pd();
+  __m256d d_kplus2 = _mm256_setzero_pd();
+  // The coefficients of the derivative are (k + 1) c_k+1.  Starting with
+  // c_degree+1 = 0 yields d_degree = 0, which lets us run both recurrences in
+  // the same loop.
+  __m256d c_kplus1 = _mm256_setzero_pd();
+  for (int k = degree; k >= 1; --k) {
+    __m256d const c_k = Load(coefficients[k]);
+    // b_k = c_k + 2 t b_k+1 - b_k+2.
+    __m256d const b_k =
+        _mm256_fmadd_pd(two_t, b_kplus1, _mm256_sub_pd(c_k, b_kplus2));
+    // d_k = (k + 1) c_k+1 + 2 t d_k+1 - d_k+2.
+    __m256d const d_k = _mm256_fmadd_pd(
+        two_t,
+        d_kplus1,
+        _mm256_fmsub_pd(_mm256_set1_pd(k + 1), c_kplus1, d_kplus2));
+    b_kplus2 = b_kplus1;
+    b_kplus1 = b_k;
+    d_kplus2 = d_kplus1;
+    d_kplus1 = d_k;
+    c_kplus1 = c_k;
+  }
+  __m256d const c_0 = Load(coefficients[0]);
+  double result[lanes];
+  // c_0 + t b_1 - b_2.
+  _mm256_storeu_pd(
+      result, _mm256_fmadd_pd(t, b_kplus1, _mm256_sub_pd(c_0, b_kplus2)));
+  value = R3Element<double>(result[0], result[1], result[2]);
+  // c_1 + 2 t d_1 - d_2, where c_1 is now in |c_kplus1| (or 0 if the degree is
+  // 0).
+  _mm256_storeu_pd(
+      result,
+      _mm256_fmadd_pd(two_t, d_kplus1, _mm256_sub_pd(c_kplus1, d_kplus2)));
+  derivative = R3Element<double>(result[0], result[1], result[2]);
+}
+
+}  // namespace internal
+}  // namespace _clenshaw
+}  // namespace numerics
+}  // namespace principia
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+
+#include "base/cpuid.hpp"
+#include "base/macros.hpp"
+#include "geometry/r3_element.hpp"
+
+namespace principia {
+namespace numerics {
+namespace _clenshaw {
+namespace internal {
+
+using namespace principia::base::_cpuid;
+using namespace principia::geometry::_r3_element;
+
+// Vectorized implementations of the Clenshaw algorithm for Чебышёв series with
+// values in R³.  The |degree + 1| coefficients are consecutive
+// |R3Element<double>|s, i.e., interleaved x/y/z doubles (followed by padding),
+// so that a coefficient may be loaded in a single 256-bit register.  The
+// arguments are scaled to [-1, 1].
+//
+// These functions use AVX2 and FMA, which they enable locally, so they don't
+// suffer from the VEX-encoding problem of |CanEmitFMAInstructions|.  They may
+// only be called if |UseVectorizedClenshaw| is true.  Because of the fused
+// operations, their results may differ in the last bits from those of the
+// scalar algorithm.
+
+#if PRINCIPIA_USE_FMA_IF_AVAILABLE
+inline bool const UseVectorizedClenshaw =
+    HasCPUFeatures(CPUFeatureFlags::AVX | CPUFeatureFlags::FMA) &&
+    HasCPUFeatures(CPUExtendedFeatureFlags::AVX2);
+#else
+inline bool const UseVectorizedClenshaw = false;
+#endif
+
+// The number of arguments that |EvaluateClenshaw| processes together, 4 per
+// register.
+constexpr std::int64_t clenshaw_group_size = 8;
+// For fewer arguments than this, the scalar algorithm is faster because the
+// vectorized one would be mostly padding.
+constexpr std::int64_t clenshaw_minimum_count = 4;
+
+// Evaluates the series at the |count| arguments |scaled_t| and stores the
+// results in |values|.  The arguments are processed by groups of
+// |clenshaw_group_size|, with a padded group of 4 for the remainder.
+void EvaluateClenshaw(R3Element<double> const* coefficients,
+                      int degree,
+                      double const* scaled_t,
+                      std::int64_t count,
+                      R3Element<double>* values);
+
+// Evaluates the series and its derivative with respect to |scaled_t|.  The two
+// recurrences run side by side, each with one register holding the three
+// components.
+void EvaluateClenshawWithDerivative(R3Element<double> const* coefficients,
+                                    int degree,
+                                    double scaled_t,
+                                    R3Element<double>& value,
+                                    R3Element<double>& derivative);
+
+}  // namespace internal
+
+using internal::clenshaw_group_size;
+using internal::clenshaw_minimum_count;
+using internal::EvaluateClenshaw;
+using internal::EvaluateClenshawWithDerivative;
+using internal::UseVectorizedClenshaw;
+
+}  // namespace _clenshaw
+}  // namespace numerics
+}  // namespace principia
@@ -0,0 +1,136 @@
+#include "numerics/fast_fourier_transform.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "glog/logging.h"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/numbers.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace numerics {
+namespace _fast_fourier_transform {
+namespace internal {
+
+using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_si;
+
+namespace {
+
+// Returns e⁻²ⁱᵏᶿ with θ = π / n.
+Complexification<double> UnitRoot(int const k, int const n) {
+  Angle const θ = 2 * π * Radian * static_cast<double>(k) / n;
+  return {Cos(θ), -Sin(θ)};
+}
+
+}  // namespace
+
+not_null<FourierTransformPlan const*> FourierTransformPlan::ForSize(
+    int const size) {
+  CHECK_GT(size, 0);
+  ABSL_CONST_INIT static absl::Mutex lock(absl::kConstInit);
+  static auto* const plans =
+      new std::map<int, std::unique_ptr<FourierTransformPlan const>>();
+  {
+    absl::ReaderMutexLock l(&lock);
+    auto const it = plans->find(size);
+    if (it != plans->end()) {
+      return check_not_null(it->second.get());
+    }
+  }
+  // Construct the plan outside of the lock, as it may need the plan for half
+  // the size.  If another thread constructed the same plan in the meantime,
+  // ours is dropped.
+  std::unique_ptr<FourierTransformPlan const> plan(
+      new FourierTransformPlan(size));
+  absl::MutexLock l(&lock);
+  auto const [it, _] = plans->emplace(size, std::move(plan));
+  return check_not_null(it->second.get());
+}
+
+FourierTransformPlan::FourierTransformPlan(int const size) : size_(size) {
+  // Factor the size, using radix 4 as much as possible for powers of 2.
+  std::vector<int> radices;
+  int n = size_;
+  while (n % 4 == 0) {
+    radices.push_back(4);
+    n /= 4;
+  }
+  if (n % 2 == 0) {
+    radices.push_back(2);
+    n /= 2;
+  }
+  for (int p = 3; n > 1; p += 2) {
+    while (n % p == 0) {
+      radices.push_back(p);
+      n /= p;
+    }
+  }
+
+  // Precompute the twiddle factors of each stage.
+  int m = 1;
+  for (int const r : radices) {
+    Stage stage{.radix = r,
+                .m = m,
+                .twiddles_begin = static_cast<int>(twiddles_.size()),
+                .roots_begin = -1};
+    for (int j = 0; j < m; ++j) {
+      for (int q = 1; q < r; ++q) {
+        twiddles_.push_back(UnitRoot(q * j, r * m));
+      }
+    }
+    if (r > 5) {
+      max_generic_radix_ = std::max(max_generic_radix_, r);
+      stage.roots_begin = twiddles_.size();
+      for (int k = 0; k < r; ++k) {
+        twiddles_.push_back(UnitRoot(k, r));
+      }
+    }
+    stages_.push_back(stage);
+    m *= r;
+  }
+
+  // The decimation in time expects the input in digit-reversed order: the last
+  // stage combines transforms of the elements having the same index modulo its
+  // radix, and so on.
+  digit_reversal_.resize(size_);
+  for (int i = 0; i < size_; ++i) {
+    int position = 0;
+    int rest = i;
+    for (auto it = stages_.rbegin(); it != stages_.rend(); ++it) {
+      position += (rest % it->radix) * it->m;
+      rest /= it->radix;
+    }
+    digit_reversal_[i] = position;
+  }
+
+  // Decompose the permutation into cycles, and the cycles into transpositions.
+  std::vector<bool> visited(size_, false);
+  for (int i = 0; i < size_; ++i) {
+    if (visited[i]) {
+      continue;
+    }
+    visited[i] = true;
+    for (int j = digit_reversal_[i]; j != i; j = digit_reversal_[j]) {
+      transpositions_.emplace_back(i, j);
+      visited[j] = true;
+    }
+  }
+
+  if (size_ % 2 == 0) {
+    half_plan_ = ForSize(size_ / 2);
+    real_twiddles_.reserve(size_ / 2);
+    for (int k = 0; k < size_ / 2; ++k) {
+      real_twiddles_.push_back(UnitRoot(k, size_));
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace _fast_fourier_transform
+}  // namespace numerics
+}  // namespace principia
@@ -4,9 +4,11 @@
 #include <complex>
 #include <map>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "base/bits.hpp"
+#include "base/not_null.hpp"
 #include "geometry/complexification.hpp"
 #include "geometry/hilbert.hpp"
 #include "geometry/interval.hpp"
@@ -21,6 +23,7 @@ namespace _fast_fourier_transform {
 namespace internal {
 
 using namespace principia::base::_bits;
+using namespace principia::base::_not_null;
 using namespace principia::geometry::_complexification;
 using namespace principia::geometry::_hilbert;
 using namespace principia::geometry::_interval;
@@ -88,9 +91,132 @@ class FastFourierTransform {
   friend class numerics::FastFourierTransformTest;
 };
 
+// A precomputed plan for discrete Fourier transforms (with the same convention
+// as above) of a size known at runtime, which may be any positive integer.  The
+// transform is computed by a mixed-radix algorithm and is fastest when the size
+// only has the prime factors 2, 3 and 5; a prime factor p > 5 costs O(p)
+// operations per element.  Plans are immutable and are cached by size, so they
+// may be shared by all transforms of the same size.
+class FourierTransformPlan {
+ public:
+  // Returns the plan for the given |size|, computing it if necessary.  This
+  // function is thread-safe.  The plans are never destroyed.
+  static not_null<FourierTransformPlan const*> ForSize(int size);
+
+  int size() const;
+
+  // Replaces the |size()| elements starting at |data| with their discrete
+  // Fourier transform.  This only allocates if the size has a prime factor
+  // p > 5, in which case it allocates a single scratch buffer of the largest
+  // such p elements.
+  template<typename Value>
+  void Transform(Complexification<Value>* data) const;
+
+  // Computes the discrete Fourier transform of the |size()| (real) elements
+  // starting at |begin| and stores it in the |size()| elements starting at
+  // |transform|.  If the size is even, this only does a complex transform of
+  // half the size.
+  template<typename Iterator, typename Value>
+  void RealTransform(Iterator begin, Complexification<Value>* transform) const;
+
+ private:
+  // A stage of the decimation in time combines |radix| transforms of size
+  // |m| into transforms of size |radix * m|.
+  struct Stage {
+    int radix;
+    int m;
+    // Index in |twiddles_| of the m (radix - 1) twiddle factors of this stage,
+    // ordered by butterfly.
+    int twiddles_begin;
+    // Index in |twiddles_| of the |radix|-th roots of unity, only used for the
+    // radices that don't have a specialized butterfly.
+    int roots_begin;
+  };
+
+  explicit FourierTransformPlan(int size);
+
+  // Applies the stages to |data|, which must be in digit-reversed order.
+  template<typename Value>
+  void Butterflies(Complexification<Value>* data) const;
+
+  // |scratch| must have at least |stage.radix| elements if the radix doesn't
+  // have a specialized butterfly; it is not used otherwise.
+  template<typename Value>
+  void Butterfly(Stage const& stage,
+                 Complexification<Value>* scratch,
+                 Complexification<Value>* data) const;
+
+  int const size_;
+  std::vector<Stage> stages_;
+  std::vector<Complexification<double>> twiddles_;
+  // The largest radix that doesn't have a specialized butterfly, or 0 if
+  // there is none.  This is the size of the scratch buffer of |Butterflies|.
+  int max_generic_radix_ = 0;
+
+  // The index at which the element i of the input must be put before the
+  // stages are applied.
+  std::vector<int> digit_reversal_;
+  // The digit reversal as a sequence of transpositions, for in-place use.
+  std::vector<std::pair<int, int>> transpositions_;
+
+  // For even sizes, the plan for half the size and the factors e⁻²ⁱᵏᶿ used by
+  // the real transform, with θ = π / size and k < size / 2.
+  FourierTransformPlan const* half_plan_ = nullptr;
+  std::vector<Complexification<double>> real_twiddles_;
+};
+
+// Same as |FastFourierTransform|, but for a number of samples known at runtime
+// and with no constraint on that number.
+template<typename Value, typename Argument>
+class DynamicFastFourierTransform {
+ public:
+  using AngularFrequency = Derivative<Angle, Argument>;
+
+  // The container must not be empty.  For the purpose of expressing the
+  // frequencies, the values are assumed to be sampled at intervals of Δt.
+
+  template<typename Container,
+           typename = std::enable_if_t<
+               std::is_convertible_v<typename Container::value_type, Value>>>
+  DynamicFastFourierTransform(Container const& container,
+                              Difference<Argument> const& Δt);
+
+  template<typename Iterator,
+           typename = std::enable_if_t<std::is_convertible_v<
+               typename std::iterator_traits<Iterator>::value_type,
+               Value>>>
+  DynamicFastFourierTransform(Iterator begin, Iterator end,
+                              Difference<Argument> const& Δt);
+
+  int size() const;
+
+  std::map<AngularFrequency, typename Hilbert<Value>::Norm²Type>
+  PowerSpectrum() const;
+
+  // Returns the interval that contains the largest peak of power in the
+  // specifed range.
+  Interval<AngularFrequency> Mode(AngularFrequency const& min_ω,
+                                  AngularFrequency const& max_ω) const;
+
+  // Given s ∈ [0, size - 1] ∩ ℕ, returns the coefficient Uₛ.
+  Complexification<Value> const& operator[](int s) const;
+
+  // Given s ∈ [0, size - 1] ∩ ℕ, returns the frequency corresponding to Uₛ.
+  AngularFrequency frequency(int s) const;
+
+ private:
+  not_null<FourierTransformPlan const*> const plan_;
+  Difference<Argument> const Δt_;
+  AngularFrequency const Δω_;
+
+  std::vector<Complexification<Value>> transform_;
+};
+
 }  // namespace internal
 
+using internal::DynamicFastFourierTransform;
 using internal::FastFourierTransform;
+using internal::FourierTransformPlan;
 
 }  // namespace _fast_fourier_transform
 }  // namespace numerics
@@ -2,8 +2,11 @@
 
 #include "numerics/fast_fourier_transform.hpp"
 
+#include <algorithm>
 #include <map>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "base/bits.hpp"
 #include "quantities/elementary_functions.hpp"
@@ -211,6 +214,282 @@ FastFourierTransform<Value, Argument, size_>::frequency(int const s) const {
   return s * Δω_;
 }
 
+// Multiplication by -i, used by the butterflies.
+template<typename Value>
+Complexification<Value> MultiplyByMinusI(Complexification<Value> const& z) {
+  return {z.imaginary_part(), -z.real_part()};
+}
+
+inline int FourierTransformPlan::size() const {
+  return size_;
+}
+
+template<typename Value>
+void FourierTransformPlan::Transform(
+    Complexification<Value>* const data) const {
+  for (auto const& [i, j] : transpositions_) {
+    std::swap(data[i], data[j]);
+  }
+  Butterflies(data);
+}
+
+template<typename Iterator, typename Value>
+void FourierTransformPlan::RealTransform(
+    Iterator const begin,
+    Complexification<Value>* const transform) const {
+  if (half_plan_ == nullptr) {
+    // Odd size, promote to complex.
+    auto it = begin;
+    for (int i = 0; i < size_; ++i, ++it) {
+      transform[digit_reversal_[i]] = Complexification<Value>(*it);
+    }
+    Butterflies(transform);
+    return;
+  }
+
+  // Pack the even elements in the real parts and the odd elements in the
+  // imaginary parts, and transform the result as a complex sequence of half
+  // the size.
+  int const h = half_plan_->size_;
+  auto it = begin;
+  for (int i = 0; i < h; ++i) {
+    Value const& even = *it;
+    ++it;
+    Value const& odd = *it;
+    ++it;
+    transform[half_plan_->digit_reversal_[i]] =
+        Complexification<Value>(even, odd);
+  }
+  half_plan_->Butterflies(transform);
+
+  // Untangle the transforms E of the even elements and O of the odd elements
+  // using Eₖ = (Zₖ + Z*ₕ₋ₖ) / 2 and Oₖ = -i (Zₖ - Z*ₕ₋ₖ) / 2, where Z is the
+  // transform computed above.  The result is Uₖ = Eₖ + e⁻²ⁱᵏᶿ Oₖ and
+  // Uₖ₊ₕ = Eₖ - e⁻²ⁱᵏᶿ Oₖ; the second half is also obtained from the symmetry
+  // of the transform of real values.
+  {
+    Complexification<Value> const& z₀ = transform[0];
+    Value const re = z₀.real_part();
+    Value const im = z₀.imaginary_part();
+    transform[0] = Complexification<Value>(re + im);
+    transform[h] = Complexification<Value>(re - im);
+  }
+  for (int k = 1; 2 * k <= h; ++k) {
+    int const j = h - k;
+    Complexification<Value> const zₖ = transform[k];
+    Complexification<Value> const zⱼ = transform[j];
+    Complexification<Value> const eₖ = 0.5 * (zₖ + zⱼ.Conjugate());
+    Complexification<Value> const oₖ =
+        MultiplyByMinusI(0.5 * (zₖ - zⱼ.Conjugate()));
+    Complexification<Value> const uₖ = eₖ + real_twiddles_[k] * oₖ;
+    Complexification<Value> const uⱼ =
+        eₖ.Conjugate() + real_twiddles_[j] * oₖ.Conjugate();
+    transform[k] = uₖ;
+    transform[j] = uⱼ;
+    transform[size_ - k] = uₖ.Conjugate();
+    transform[size_ - j] = uⱼ.Conjugate();
+  }
+}
+
+template<typename Value>
+void FourierTransformPlan::Butterflies(
+    Complexification<Value>* const data) const {
+  // Empty, and therefore not allocated, if all the radices have a specialized
+  // butterfly.
+  std::vector<Complexification<Value>> scratch(max_generic_radix_);
+  for (auto const& stage : stages_) {
+    Butterfly(stage, scratch.data(), data);
+  }
+}
+
+template<typename Value>
+void FourierTransformPlan::Butterfly(
+    Stage const& stage,
+    Complexification<Value>* const scratch,
+    Complexification<Value>* const data) const {
+  using Complex = Complexification<Value>;
+  int const r = stage.radix;
+  int const m = stage.m;
+  Complexification<double> const* const twiddles =
+      &twiddles_[stage.twiddles_begin];
+  for (int block = 0; block < size_; block += r * m) {
+    Complex* const x = &data[block];
+    switch (r) {
+      case 2:
+        for (int j = 0; j < m; ++j) {
+          Complex const x₀ = x[j];
+          Complex const x₁ = x[j + m] * twiddles[j];
+          x[j] = x₀ + x₁;
+          x[j + m] = x₀ - x₁;
+        }
+        break;
+      case 3: {
+        // sin(2π/3).
+        constexpr double s = 0.86602540378443864676;
+        for (int j = 0; j < m; ++j) {
+          Complexification<double> const* const w = &twiddles[2 * j];
+          Complex const x₀ = x[j];
+          Complex const x₁ = x[j + m] * w[0];
+          Complex const x₂ = x[j + 2 * m] * w[1];
+          Complex const t = x₁ + x₂;
+          Complex const u = x₀ - 0.5 * t;
+          Complex const v = MultiplyByMinusI(s * (x₁ - x₂));
+          x[j] = x₀ + t;
+          x[j + m] = u + v;
+          x[j + 2 * m] = u - v;
+        }
+        break;
+      }
+      case 4:
+        for (int j = 0; j < m; ++j) {
+          Complexification<double> const* const w = &twiddles[3 * j];
+          Complex const x₀ = x[j];
+          Complex const x₁ = x[j + m] * w[0];
+          Complex const x₂ = x[j + 2 * m] * w[1];
+          Complex const x₃ = x[j + 3 * m] * w[2];
+          Complex const t₀ = x₀ + x₂;
+          Complex const t₁ = x₀ - x₂;
+          Complex const t₂ = x₁ + x₃;
+          Complex const t₃ = MultiplyByMinusI(x₁ - x₃);
+          x[j] = t₀ + t₂;
+          x[j + m] = t₁ + t₃;
+          x[j + 2 * m] = t₀ - t₂;
+          x[j + 3 * m] = t₁ - t₃;
+        }
+        break;
+      case 5: {
+        // cos(2π/5), cos(4π/5), sin(2π/5), sin(4π/5).
+        constexpr double c₁ = 0.30901699437494742410;
+        constexpr double c₂ = -0.80901699437494742410;
+        constexpr double s₁ = 0.95105651629515357212;
+        constexpr double s₂ = 0.58778525229247312917;
+        for (int j = 0; j < m; ++j) {
+          Complexification<double> const* const w = &twiddles[4 * j];
+          Complex const x₀ = x[j];
+          Complex const x₁ = x[j + m] * w[0];
+          Complex const x₂ = x[j + 2 * m] * w[1];
+          Complex const x₃ = x[j + 3 * m] * w[2];
+          Complex const x₄ = x[j + 4 * m] * w[3];
+          Complex const t₁ = x₁ + x₄;
+          Complex const t₂ = x₂ + x₃;
+          Complex const d₁ = x₁ - x₄;
+          Complex const d₂ = x₂ - x₃;
+          Complex const a₁ = x₀ + c₁ * t₁ + c₂ * t₂;
+          Complex const a₂ = x₀ + c₂ * t₁ + c₁ * t₂;
+          Complex const b₁ = MultiplyByMinusI(s₁ * d₁ + s₂ * d₂);
+          Complex const b₂ = MultiplyByMinusI(s₂ * d₁ - s₁ * d₂);
+          x[j] = x₀ + t₁ + t₂;
+          x[j + m] = a₁ + b₁;
+          x[j + 2 * m] = a₂ + b₂;
+          x[j + 3 * m] = a₂ - b₂;
+          x[j + 4 * m] = a₁ - b₁;
+        }
+        break;
+      }
+      default: {
+        // A direct transform of size r, for the other prime factors.
+        Complexification<double> const* const roots =
+            &twiddles_[stage.roots_begin];
+        Complex* const y = scratch;
+        for (int j = 0; j < m; ++j) {
+          Complexification<double> const* const w = &twiddles[(r - 1) * j];
+          y[0] = x[j];
+          for (int q = 1; q < r; ++q) {
+            y[q] = x[j + q * m] * w[q - 1];
+          }
+          for (int p = 0; p < r; ++p) {
+            Complex sum = y[0];
+            for (int q = 1; q < r; ++q) {
+              sum += y[q] * roots[(p * q) % r];
+            }
+            x[j + p * m] = sum;
+          }
+        }
+      }
+    }
+  }
+}
+
+template<typename Value, typename Argument>
+template<typename Container, typename>
+DynamicFastFourierTransform<Value, Argument>::DynamicFastFourierTransform(
+    Container const& container,
+    Difference<Argument> const& Δt)
+    : DynamicFastFourierTransform(container.cbegin(), container.cend(), Δt) {}
+
+template<typename Value, typename Argument>
+template<typename Iterator, typename>
+DynamicFastFourierTransform<Value, Argument>::DynamicFastFourierTransform(
+    Iterator const begin,
+    Iterator const end,
+    Difference<Argument> const& Δt)
+    : plan_(FourierTransformPlan::ForSize(std::distance(begin, end))),
+      Δt_(Δt),
+      Δω_(2 * π * Radian / (plan_->size() * Δt_)),
+      transform_(plan_->size()) {
+  plan_->RealTransform(begin, transform_.data());
+}
+
+template<typename Value, typename Argument>
+int DynamicFastFourierTransform<Value, Argument>::size() const {
+  return plan_->size();
+}
+
+template<typename Value, typename Argument>
+auto DynamicFastFourierTransform<Value, Argument>::PowerSpectrum() const
+    -> std::map<AngularFrequency, typename Hilbert<Value>::Norm²Type> {
+  std::map<AngularFrequency, typename Hilbert<Value>::Norm²Type>
+      spectrum;
+  int k = 0;
+  for (auto const& coefficient : transform_) {
+    spectrum.emplace_hint(spectrum.end(), k * Δω_, coefficient.Norm²());
+    ++k;
+  }
+  return spectrum;
+}
+
+template<typename Value, typename Argument>
+auto DynamicFastFourierTransform<Value, Argument>::Mode(
+    AngularFrequency const& min_ω,
+    AngularFrequency const& max_ω) const -> Interval<AngularFrequency> {
+  CHECK_LE(min_ω, max_ω);
+  std::optional<int> max;
+  typename Hilbert<Value>::Norm²Type max_power;
+
+  // Only look at the first size / 2 + 1 elements because the spectrum is
+  // symmetrical.  There is no need to construct the |PowerSpectrum|.
+  for (int s = 0; s < size() / 2 + 1; ++s) {
+    AngularFrequency const ω = frequency(s);
+    if (min_ω <= ω && ω <= max_ω) {
+      auto const power = transform_[s].Norm²();
+      if (!max.has_value() || power > max_power) {
+        max = s;
+        max_power = power;
+      }
+    }
+  }
+  CHECK(max.has_value()) << min_ω << " " << max_ω;
+
+  Interval<AngularFrequency> result;
+  result.Include(std::max(max.value() - 1, 0) * Δω_);
+  result.Include((max.value() + 1) * Δω_);
+  return result;
+}
+
+template<typename Value, typename Argument>
+Complexification<Value> const&
+DynamicFastFourierTransform<Value, Argument>::operator[](int const s) const {
+  return transform_[s];
+}
+
+template<typename Value, typename Argument>
+auto DynamicFastFourierTransform<Value, Argument>::frequency(int const s) const
+    -> AngularFrequency {
+  DCHECK_GE(s, 0);
+  DCHECK_LT(s, size());
+  return s * Δω_;
+}
+
 }  // namespace internal
 }  // namespace _fast_fourier_transform
 }  // namespace numerics
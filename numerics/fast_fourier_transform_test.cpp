@@ -1,6 +1,7 @@
 #include "numerics/fast_fourier_transform.hpp"
 
 #include <algorithm>
+#include <complex>
 #include <random>
 #include <vector>
 
@@ -19,6 +20,7 @@ namespace numerics {
 
 using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
+using ::testing::Eq;
 using ::testing::Lt;
 using ::testing::Pair;
 using namespace principia::geometry::_complexification;
@@ -46,6 +48,40 @@ class FastFourierTransformTest : public ::testing::Test {
       FastFourierTransform<Scalar, Instant, size_> const& fft) {
     return fft.transform_;
   }
+
+  // A direct computation of the discrete Fourier transform, in long double.
+  static std::vector<std::complex<long double>> DiscreteFourierTransform(
+      std::vector<std::complex<long double>> const& u) {
+    int const n = u.size();
+    std::vector<std::complex<long double>> result(n);
+    for (int s = 0; s < n; ++s) {
+      for (int r = 0; r < n; ++r) {
+        long double const θ = -2 * π * ((static_cast<long long>(r) * s) % n) /
+                              static_cast<long double>(n);
+        result[s] += u[r] * std::complex<long double>(std::cos(θ),
+                                                      std::sin(θ));
+      }
+    }
+    return result;
+  }
+
+  // The largest error on the coefficients, relative to the largest
+  // coefficient.
+  static double RelativeError(
+      std::vector<std::complex<long double>> const& expected,
+      std::vector<Complex> const& actual) {
+    long double max_error = 0;
+    long double max_norm = 0;
+    for (int s = 0; s < expected.size(); ++s) {
+      max_error = std::max(
+          max_error,
+          std::abs(expected[s] -
+                   std::complex<long double>(actual[s].real_part(),
+                                             actual[s].imaginary_part())));
+      max_norm = std::max(max_norm, std::abs(expected[s]));
+    }
+    return max_error / max_norm;
+  }
 };
 
 TEST_F(FastFourierTransformTest, Square) {
@@ -229,5 +265,110 @@ TEST_F(FastFourierTransformTest, Inverse) {
   EXPECT_THAT(nv.frequency(1) - nv.frequency(0), AlmostEquals(Δt, 0));
 }
 
+TEST_F(FastFourierTransformTest, DynamicSin) {
+  // Same as the |Sin| test.
+  std::vector<double> const sin{+0,
+                                +0.44991188055599964373,
+                                +0.80360826369441117592,
+                                +0.98544972998846018066,
+                                +0.95654873748436662401,
+                                +0.72308588173832461680,
+                                +0.33498815015590491954,
+                                -0.12474816864589884767,
+                                -0.55780658091328209620,
+                                -0.87157577241358806002,
+                                -0.99895491709792831520,
+                                -0.91270346343588987220,
+                                -0.63126663787232131146,
+                                -0.21483085764466499644,
+                                +0.24754738092257664739,
+                                +0.65698659871878909040};
+  FastFourierTransform<double, Instant, 16> const expected(sin, 1 * Second);
+  DynamicFastFourierTransform<double, Instant> const transform(sin,
+                                                               1 * Second);
+  EXPECT_EQ(16, transform.size());
+  for (int s = 0; s < transform.size(); ++s) {
+    // Some of the coefficients are small and affected by cancellations, so we
+    // compare the absolute errors.
+    EXPECT_NEAR(expected[s].real_part(), transform[s].real_part(), 2e-15) << s;
+    EXPECT_NEAR(expected[s].imaginary_part(),
+                transform[s].imaginary_part(),
+                2e-15) << s;
+    EXPECT_EQ(expected.frequency(s), transform.frequency(s));
+  }
+}
+
+TEST_F(FastFourierTransformTest, MixedRadix) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> distribution(-1, 1);
+  for (int const size : {1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 14, 15, 25, 30, 45,
+                         49, 60, 77, 100, 128, 243, 360, 625, 1000, 1024}) {
+    std::vector<double> real_values;
+    std::vector<Complex> complex_values;
+    std::vector<std::complex<long double>> long_real_values;
+    std::vector<std::complex<long double>> long_complex_values;
+    for (int i = 0; i < size; ++i) {
+      double const re = distribution(random);
+      double const im = distribution(random);
+      real_values.push_back(re);
+      complex_values.emplace_back(re, im);
+      long_real_values.emplace_back(re);
+      long_complex_values.emplace_back(re, im);
+    }
+
+    // Real input.
+    DynamicFastFourierTransform<double, Instant> const transform(real_values,
+                                                                 1 * Second);
+    std::vector<Complex> coefficients;
+    for (int s = 0; s < size; ++s) {
+      coefficients.push_back(transform[s]);
+    }
+    EXPECT_THAT(
+        RelativeError(DiscreteFourierTransform(long_real_values), coefficients),
+        Lt(1e-14)) << size;
+
+    // Complex input, in place.
+    auto const plan = FourierTransformPlan::ForSize(size);
+    EXPECT_THAT(plan, Eq(FourierTransformPlan::ForSize(size)));
+    plan->Transform(complex_values.data());
+    EXPECT_THAT(RelativeError(DiscreteFourierTransform(long_complex_values),
+                              complex_values),
+                Lt(1e-14)) << size;
+  }
+}
+
+TEST_F(FastFourierTransformTest, DynamicMode) {
+  // Not a power of 2.
+  int const size = 3 * 5 * 5 * 7 * 128;
+  AngularFrequency const ω = 666 * π / size * Radian / Second;
+  Time const Δt = 1 * Second;
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> noise(-0.5, 0.5);
+  std::vector<Displacement<World>> signal;
+  for (int n = 0; n < size; ++n) {
+    signal.push_back(
+        Displacement<World>({(Sin(n * ω * Δt) + noise(random)) * Metre,
+                             Cos(n * ω * Δt) * Metre,
+                             Sin(2 * n * ω * Δt) * Metre}));
+  }
+
+  DynamicFastFourierTransform<Displacement<World>, Instant> const transform(
+      signal, Δt);
+  {
+    auto const mode =
+        transform.Mode(AngularFrequency{}, Infinity<AngularFrequency>);
+    EXPECT_THAT(mode.midpoint(), AlmostEquals(ω, 0, 4));
+    EXPECT_THAT(mode.measure(),
+                AlmostEquals(4 * π / size * Radian / Second, 0, 64));
+  }
+  {
+    auto const mode = transform.Mode(0.99 * ω, 1.01 * ω);
+    EXPECT_THAT(mode.midpoint(), AlmostEquals(ω, 0, 4));
+    EXPECT_THAT(mode.measure(),
+                AlmostEquals(4 * π / size * Radian / Second, 0, 64));
+  }
+  EXPECT_EQ(size, transform.PowerSpectrum().size());
+}
+
 }  // namespace numerics
 }  // namespace principia
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <type_traits>
 
+#include "base/thread_pool.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/interval.hpp"
 #include "numerics/poisson_series.hpp"
@@ -13,6 +14,7 @@ namespace numerics {
 namespace _frequency_analysis {
 namespace internal {
 
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_instant;
 using namespace principia::geometry::_interval;
 using namespace principia::numerics::_poisson_series;
@@ -34,7 +36,11 @@ AngularFrequency PreciseMode(
                   Evaluator> const& weight);
 
 // In the projection functions the |Function| must have an |InnerProduct| with
-// |PoissonSeries| or |PiecewisePoissonSeries|.
+// |PoissonSeries| or |PiecewisePoissonSeries|.  If |thread_pool| is not null,
+// the inner products of the residual with the basis elements for a frequency
+// are computed in parallel on that pool; the result doesn't depend on the
+// number of threads.  Parallel execution requires that the inner products of
+// the |Function| be safe to call concurrently.
 
 // Computes the Кудрявцев projection of |function| on a basis with angular
 // frequency ω and maximum degrees |aperiodic_ldegree| and |periodic_ldegree|.
@@ -52,7 +58,8 @@ Projection(Function const& function,
                          aperiodic_wdegree, periodic_wdegree,
                          Evaluator> const& weight,
            Instant const& t_min,
-           Instant const& t_max);
+           Instant const& t_max,
+           ThreadPool<void>* thread_pool = nullptr);
 
 // AngularFrequencyCalculator is a templated functor that implements the
 // extraction of the most relevant frequency out of a (mostly periodic)
@@ -86,7 +93,8 @@ IncrementalProjection(Function const& function,
                                     aperiodic_wdegree, periodic_wdegree,
                                     Evaluator> const& weight,
                       Instant const& t_min,
-                      Instant const& t_max);
+                      Instant const& t_max,
+                      ThreadPool<void>* thread_pool = nullptr);
 
 }  // namespace internal
 
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <future>
 #include <vector>
 
 #include "absl/status/status.h"
@@ -156,7 +157,8 @@ absl::Status NormalGramSchmidtStep(
 // inner products for the range [0, m_begin[.  The range of |q| to process (and
 // the range of |z| to update is at indices [m_begin, m_end[.  This function
 // doesn't return |qₘ₊₁| because it's not needed for the solution.  It also
-// doesn't return |ρ|.
+// doesn't return |ρ|.  If |thread_pool| is not null, the inner products are
+// computed in parallel.
 template<typename Function, typename BasisSeries, typename Norm,
          int aperiodic_wdegree, int periodic_wdegree,
          template<typename, typename, int> class Evaluator>
@@ -169,18 +171,40 @@ absl::Status AugmentedGramSchmidtStep(
     std::vector<BasisSeries> const& q,
     int const m_begin,
     int const m_end,
-    UnboundedVector<Norm>& z) {
+    UnboundedVector<Norm>& z,
+    ThreadPool<void>* const thread_pool) {
   // It would be conceptually possible to use [Bjö94], Algorithm 6.1 here and
   // do reorthonormalization.  Unfortunately, it runs afoul of an issue where
   // the inner product of a piecewise Poisson series with a polynomial doesn't
   // converge (because it depends on a heuristics that uses the maximum
   // frequency).  Instead of trying to make it work, we use MGS.
 
-  // This code follows [Hig02], Algorithm 19.12.  See also [Bjö94], Algorithm
-  // 2.2, for the column version of MGS which is what we are using here.
-  for (int k = m_begin; k < m_end; ++k) {
-    z[k] = InnerProduct(q[k], b, weight, t_min, t_max);
-    b -= z[k] * q[k];
+  if (thread_pool == nullptr) {
+    // This code follows [Hig02], Algorithm 19.12.  See also [Bjö94], Algorithm
+    // 2.2, for the column version of MGS which is what we are using here.
+    for (int k = m_begin; k < m_end; ++k) {
+      z[k] = InnerProduct(q[k], b, weight, t_min, t_max);
+      b -= z[k] * q[k];
+    }
+  } else {
+    // MGS is inherently sequential.  Within the range [m_begin, m_end[ the
+    // |q[k]| are orthonormal (up to rounding) so we use CGS on that block: the
+    // inner products are all taken with the same |b| and may be computed in
+    // parallel.  The updates are then applied in index order, so the result is
+    // independent of the scheduling of the threads.
+    std::vector<std::future<void>> futures;
+    for (int k = m_begin; k < m_end; ++k) {
+      futures.push_back(thread_pool->Add([&b, &q, &t_max, &t_min, &weight, &z,
+                                          k]() {
+        z[k] = InnerProduct(q[k], b, weight, t_min, t_max);
+      }));
+    }
+    for (auto const& future : futures) {
+      future.wait();
+    }
+    for (int k = m_begin; k < m_end; ++k) {
+      b -= z[k] * q[k];
+    }
   }
 
   // We do not compute the norm of |b| here (named |ρ| in [Hig02] section 20.3)
@@ -226,7 +250,8 @@ Projection(Function const& function,
                          aperiodic_wdegree, periodic_wdegree,
                          Evaluator> const& weight,
            Instant const& t_min,
-           Instant const& t_max) {
+           Instant const& t_max,
+           ThreadPool<void>* const thread_pool) {
   std::optional<AngularFrequency> optional_ω = ω;
 
   // A calculator that returns optional_ω once and then stops.
@@ -240,7 +265,8 @@ Projection(Function const& function,
       function,
       angular_frequency_calculator,
       weight,
-      t_min, t_max);
+      t_min, t_max,
+      thread_pool);
 }
 
 template<int aperiodic_degree, int periodic_degree,
@@ -257,7 +283,8 @@ IncrementalProjection(Function const& function,
                                     aperiodic_wdegree, periodic_wdegree,
                                     Evaluator> const& weight,
                       Instant const& t_min,
-                      Instant const& t_max) {
+                      Instant const& t_max,
+                      ThreadPool<void>* const thread_pool) {
   using Value = std::invoke_result_t<Function, Instant>;
   using Norm = typename Hilbert<Value>::NormType;
   using Normalized = typename Hilbert<Value>::NormalizedType;
@@ -329,7 +356,8 @@ IncrementalProjection(Function const& function,
                                                  weight, t_min, t_max,
                                                  q,
                                                  m_begin, /*m_end=*/basis_size,
-                                                 z);
+                                                 z,
+                                                 thread_pool);
     if (!status.ok()) {
       return F;
     }
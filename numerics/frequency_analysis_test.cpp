@@ -5,6 +5,7 @@
 #include <random>
 #include <vector>
 
+#include "base/thread_pool.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
@@ -33,6 +34,7 @@ using ::testing::AllOf;
 using ::testing::Ge;
 using ::testing::Gt;
 using ::testing::Lt;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
@@ -532,6 +534,70 @@ TEST_F(FrequencyAnalysisTest, PoissonSeriesIncrementalProjectionSecular) {
   }
 }
 
+TEST_F(FrequencyAnalysisTest, ParallelIncrementalProjection) {
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<> frequency_distribution(2000.0, 3000.0);
+  std::uniform_real_distribution<> amplitude_distribution(-10.0, 10.0);
+
+  std::vector<AngularFrequency> ωs;
+  for (int i = 0; i < 3; ++i) {
+    ωs.push_back(frequency_distribution(random) * Radian / Second);
+  }
+
+  Instant const t_min = t0_;
+  Instant const t_mid =
+      t0_ + 100 * Radian / *std::max_element(ωs.cbegin(), ωs.cend());
+  Instant const t_max =
+      t0_ + 200 * Radian / *std::max_element(ωs.cbegin(), ωs.cend());
+
+  Series4 series(Series4::AperiodicPolynomial({}, t_mid), {});
+  for (int i = 0; i < 3; ++i) {
+    auto const sin = random_polynomial4_(t_mid, random, amplitude_distribution);
+    auto const cos = random_polynomial4_(t_mid, random, amplitude_distribution);
+    series += Series4(Series4::AperiodicPolynomial({}, t_mid),
+                      {{ωs[i], Series4::Polynomials{sin, cos}}});
+  }
+  using PiecewiseSeries4 =
+      PiecewisePoissonSeries<Length, 4, 4, HornerEvaluator>;
+  auto const piecewise_series =
+      Slice<PiecewiseSeries4>(series, /*pieces=*/10, t_min, t_max);
+
+  // A perfect calculator for the frequencies of the series.
+  int ω_index;
+  auto angular_frequency_calculator =
+      [&ω_index, &ωs](auto const& residual) -> std::optional<AngularFrequency> {
+    if (ω_index == ωs.size()) {
+      return std::nullopt;
+    } else {
+      return ωs[ω_index++];
+    }
+  };
+
+  auto const apodization = _apodization::Hann<HornerEvaluator>(t_min, t_max);
+  ω_index = 0;
+  auto const sequential_projection4 =
+      IncrementalProjection<4, 4>(piecewise_series,
+                                  angular_frequency_calculator,
+                                  apodization,
+                                  t_min, t_max);
+  ThreadPool<void> pool(/*pool_size=*/4);
+  ω_index = 0;
+  auto const parallel_projection4 =
+      IncrementalProjection<4, 4>(piecewise_series,
+                                  angular_frequency_calculator,
+                                  apodization,
+                                  t_min, t_max,
+                                  &pool);
+  for (int i = 0; i <= 100; ++i) {
+    Instant const t = t_min + i * (t_max - t_min) / 100;
+    EXPECT_THAT(parallel_projection4(t),
+                RelativeErrorFrom(sequential_projection4(t),
+                                  AllOf(Ge(0), Lt(1e-10))));
+    EXPECT_THAT(parallel_projection4(t),
+                RelativeErrorFrom(series(t), AllOf(Ge(0), Lt(1e-9))));
+  }
+}
+
 #endif
 
 }  // namespace frequency_analysis
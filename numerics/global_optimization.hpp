@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/hilbert.hpp"
 #include "numerics/nearest_neighbour.hpp"
 #include "quantities/named_quantities.hpp"
@@ -17,6 +18,7 @@ namespace _global_optimization {
 namespace internal {
 
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_hilbert;
 using namespace principia::numerics::_nearest_neighbour;
 using namespace principia::quantities::_named_quantities;
@@ -58,10 +60,15 @@ class MultiLevelSingleLinkage {
     Measure measure() const;
   };
 
+  // If |thread_pool| is not null, the evaluations of |f| at the sample points
+  // of a round and the local searches started in a round are executed
+  // concurrently on it; in that case |f| and |grad_f| must be thread-safe.  The
+  // results don't depend on the presence or size of the pool.
   MultiLevelSingleLinkage(
       Box const& box,
       Field<Scalar, Argument> f,
-      Field<Gradient<Scalar, Argument>, Argument> grad_f);
+      Field<Gradient<Scalar, Argument>, Argument> grad_f,
+      ThreadPool<void>* thread_pool = nullptr);
 
   // If |number_of_rounds| is given, the algorithm does |number_of_rounds|
   // iterations, each time adding |points_per_round| to the sample.
@@ -110,6 +117,11 @@ class MultiLevelSingleLinkage {
   // Returns a vector of size |values_per_round|.  The points are in |box_|.
   Arguments RandomArguments(std::int64_t values_per_round);
 
+  // Calls |function| for each index in [0, size[, on |thread_pool_| if there
+  // is one, and waits for all the calls to complete.
+  void ForEachIndex(std::int64_t size,
+                    std::function<void(std::int64_t)> const& function) const;
+
   // Returns the square of the radius rₖ from [RT87a], eqn. 35, specialized for
   // |dimensions|.
   Norm²Type CriticalRadius²(double σ, std::int64_t kN);
@@ -119,6 +131,7 @@ class MultiLevelSingleLinkage {
   typename Box::Measure const box_measure_;
   Field<Scalar, Argument> const f_;
   Field<Gradient<Scalar, Argument>, Argument> const grad_f_;
+  ThreadPool<void>* const thread_pool_;
 
   std::mt19937_64 random_;
   std::uniform_real_distribution<> distribution_;
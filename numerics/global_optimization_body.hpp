@@ -3,11 +3,13 @@
 #include "numerics/global_optimization.hpp"
 
 #include <algorithm>
+#include <future>
 #include <map>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "base/macros.hpp"
 #include "geometry/barycentre_calculator.hpp"
 #include "numerics/gradient_descent.hpp"
@@ -58,12 +60,14 @@ template<typename Scalar, typename Argument, int dimensions>
 MultiLevelSingleLinkage<Scalar, Argument, dimensions>::MultiLevelSingleLinkage(
     Box const& box,
     Field<Scalar, Argument> f,
-    Field<Gradient<Scalar, Argument>, Argument> grad_f)
+    Field<Gradient<Scalar, Argument>, Argument> grad_f,
+    ThreadPool<void>* const thread_pool)
     : box_(box),
       box_diametre_(box_.diametre()),
       box_measure_(box_.measure()),
       f_(std::move(f)),
       grad_f_(std::move(grad_f)),
+      thread_pool_(thread_pool),
       random_(42),
       distribution_(-1.0, 1.0) {
   for (auto const& vertex : box_.vertices) {
@@ -126,11 +130,15 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMinima(
       /*values=*/{},
       pcp_tree_max_values_per_cell);
 
-  // The PCP tree used for detecting proximity of the sample points .  It gets
-  // updated as new points are generated.
-  PrincipalComponentPartitioningTree<Argument> point_neighbourhoods(
-      /*values=*/{},
-      pcp_tree_max_values_per_cell);
+  // The PCP tree used for detecting proximity of the sample points.  It is
+  // built from the points of the first round, and updated as new points are
+  // generated in subsequent rounds.
+  std::optional<PrincipalComponentPartitioningTree<Argument>>
+      point_neighbourhoods;
+
+  // The values of |f| at the sample points.  Each sample point is evaluated
+  // exactly once, when it is generated.
+  absl::flat_hash_map<Argument const*, Scalar> point_values;
 
   int number_of_local_searches = 0;
 
@@ -197,52 +205,54 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMinima(
     // rₖ depends on γ.
     // Anyway, reducing the sample would be annoying with our data structures,
     // so let's not go there, 'tis a silly place.
+    // The points are generated sequentially so that they only depend on the
+    // seed, but the (expensive) evaluations of |f| are concurrent.
     Arguments pointsₖ = RandomArguments(N);
-    for (auto& pointₖ : pointsₖ) {
-      points.push_back(std::move(pointₖ));
+    std::vector<Scalar> f_pointsₖ(pointsₖ.size());
+    ForEachIndex(pointsₖ.size(),
+                 [&f, &f_pointsₖ, &pointsₖ](std::int64_t const i) {
+                   f_pointsₖ[i] = f(*pointsₖ[i]);
+                 });
+    std::vector<not_null<Argument const*>> new_points;
+    for (std::int64_t i = 0; i < pointsₖ.size(); ++i) {
+      points.push_back(std::move(pointsₖ[i]));
       Argument const* const pointₖ_pointer = points.back().get();
-      point_neighbourhoods.Add(pointₖ_pointer);
+      new_points.push_back(pointₖ_pointer);
+      point_values.emplace(pointₖ_pointer, f_pointsₖ[i]);
       schedule.emplace_hint(
           schedule.end(), Infinity<Norm²Type>, pointₖ_pointer);
     }
+    if (point_neighbourhoods.has_value()) {
+      for (auto const new_point : new_points) {
+        point_neighbourhoods->Add(new_point);
+      }
+    } else {
+      point_neighbourhoods.emplace(new_points, pcp_tree_max_values_per_cell);
+    }
 
     // Compute the radius below which we won't do a local search in this
     // iteration.
     Norm²Type const rₖ² = CriticalRadius²(/*σ=*/4, kN);
 
     // Process the points whose nearest neighbour is "sufficiently far" (or
-    // unknown).
+    // unknown).  The decision to start a local search from a point doesn't
+    // depend on the results of the other local searches, so we first collect
+    // the starting points, in the order of |schedule|.
+    std::vector<Argument const*> local_search_starts;
     for (auto it = schedule.upper_bound(rₖ²); it != schedule.end();) {
       Argument const& xᵢ = *it->second;
-      auto* const xⱼ = point_neighbourhoods.FindNearestNeighbour(
-          xᵢ, [f_xᵢ = f(xᵢ), rₖ², f, xᵢ](Argument const* const xⱼ) {
-            return (xᵢ - *xⱼ).Norm²() <= rₖ² && f(*xⱼ) < f_xᵢ;
+      auto* const xⱼ = point_neighbourhoods->FindNearestNeighbour(
+          xᵢ,
+          [f_xᵢ = point_values.at(&xᵢ), rₖ², &point_values, &xᵢ](
+              Argument const* const xⱼ) {
+            return (xᵢ - *xⱼ).Norm²() <= rₖ² && point_values.at(xⱼ) < f_xᵢ;
           });
 
       if (xⱼ == nullptr) {
         // We must do a local search as xᵢ couldn't be added to an existing
-        // cluster.  Note that the radius of the search has to be the diametre
-        // of the box: it's possible that xᵢ would be near one vertex of the box
-        // and the stationary point near the opposite vertex.
-        ++number_of_local_searches;
-        auto const stationary_point =
-            BroydenFletcherGoldfarbShanno(xᵢ,
-                                          f,
-                                          grad_f,
-                                          local_search_tolerance,
-                                          box_diametre_);
-
-        // If the new stationary point is sufficiently far from the ones we
-        // already know, record it.
-        if (stationary_point.has_value() &&
-            IsNewStationaryPoint(stationary_point.value(),
-                                 stationary_point_neighbourhoods,
-                                 local_search_tolerance)) {
-          stationary_points.push_back(
-              std::make_unique<Argument>(stationary_point.value()));
-          stationary_point_neighbourhoods.Add(stationary_points.back().get());
-        }
-        // A local search has been started from xᵢ, so no point in considering
+        // cluster.
+        local_search_starts.push_back(&xᵢ);
+        // A local search will be started from xᵢ, so no point in considering
         // it again.
         it = schedule.erase(it);
       } else {
@@ -256,6 +266,42 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::FindGlobalMinima(
         schedule.emplace(distance²_to_xⱼ, &xᵢ);
       }
     }
+
+    // Run the local searches of this round.  Note that the radius of the
+    // search has to be the diametre of the box: it's possible that xᵢ would be
+    // near one vertex of the box and the stationary point near the opposite
+    // vertex.
+    number_of_local_searches += local_search_starts.size();
+    std::vector<std::optional<Argument>> local_search_results(
+        local_search_starts.size());
+    ForEachIndex(local_search_starts.size(),
+                 [this,
+                  &f,
+                  &grad_f,
+                  &local_search_results,
+                  &local_search_starts,
+                  local_search_tolerance](std::int64_t const i) {
+                   local_search_results[i] =
+                       BroydenFletcherGoldfarbShanno(*local_search_starts[i],
+                                                     f,
+                                                     grad_f,
+                                                     local_search_tolerance,
+                                                     box_diametre_);
+                 });
+
+    // If a new stationary point is sufficiently far from the ones we already
+    // know, record it.  This is done in the order of the starting points, so
+    // that the result doesn't depend on the scheduling of the local searches.
+    for (auto const& stationary_point : local_search_results) {
+      if (stationary_point.has_value() &&
+          IsNewStationaryPoint(stationary_point.value(),
+                               stationary_point_neighbourhoods,
+                               local_search_tolerance)) {
+        stationary_points.push_back(
+            std::make_unique<Argument>(stationary_point.value()));
+        stationary_point_neighbourhoods.Add(stationary_points.back().get());
+      }
+    }
   }
 
   DLOG(ERROR) << "Number of local searches: " << number_of_local_searches;
@@ -301,6 +347,26 @@ MultiLevelSingleLinkage<Scalar, Argument, dimensions>::RandomArguments(
   return arguments;
 }
 
+template<typename Scalar, typename Argument, int dimensions>
+void MultiLevelSingleLinkage<Scalar, Argument, dimensions>::ForEachIndex(
+    std::int64_t const size,
+    std::function<void(std::int64_t)> const& function) const {
+  if (thread_pool_ == nullptr) {
+    for (std::int64_t i = 0; i < size; ++i) {
+      function(i);
+    }
+  } else {
+    std::vector<std::future<void>> futures;
+    futures.reserve(size);
+    for (std::int64_t i = 0; i < size; ++i) {
+      futures.push_back(thread_pool_->Add([&function, i]() { function(i); }));
+    }
+    for (auto const& future : futures) {
+      future.wait();
+    }
+  }
+}
+
 template<typename Scalar, typename Argument, int dimensions>
 typename MultiLevelSingleLinkage<Scalar, Argument, dimensions>::Norm²Type
 MultiLevelSingleLinkage<Scalar, Argument, dimensions>::CriticalRadius²(
@@ -1,5 +1,8 @@
 #include "numerics/global_optimization.hpp"
 
+#include <atomic>
+
+#include "base/thread_pool.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/space.hpp"
@@ -21,6 +24,7 @@ namespace numerics {
 using ::testing::ElementsAre;
 using ::testing::IsEmpty;
 using ::testing::_;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_space;
@@ -84,7 +88,7 @@ TEST_F(GlobalOptimizationTest, Branin) {
                                                    /*number_of_rounds=*/10,
                                                    tolerance);
 
-    EXPECT_EQ(1264, function_invocations);
+    EXPECT_EQ(407, function_invocations);
     EXPECT_EQ(316, gradient_invocations);
 
     EXPECT_THAT(
@@ -111,7 +115,7 @@ TEST_F(GlobalOptimizationTest, Branin) {
                                    /*number_of_rounds=*/std::nullopt,
                                    tolerance);
 
-    EXPECT_EQ(1019, function_invocations);
+    EXPECT_EQ(232, function_invocations);
     EXPECT_EQ(136, gradient_invocations);
 
     EXPECT_THAT(
@@ -173,7 +177,7 @@ TEST_F(GlobalOptimizationTest, GoldsteinPrice) {
                                                    /*number_of_rounds=*/10,
                                                    tolerance);
 
-    EXPECT_EQ(2129, function_invocations);
+    EXPECT_EQ(474, function_invocations);
     EXPECT_EQ(278, gradient_invocations);
     EXPECT_THAT(
         minima,
@@ -199,7 +203,7 @@ TEST_F(GlobalOptimizationTest, GoldsteinPrice) {
                                    /*number_of_rounds=*/std::nullopt,
                                    tolerance);
 
-    EXPECT_EQ(5730, function_invocations);
+    EXPECT_EQ(678, function_invocations);
     EXPECT_EQ(178, gradient_invocations);
     EXPECT_THAT(
         minima,
@@ -266,7 +270,7 @@ TEST_F(GlobalOptimizationTest, Hartmann3) {
                                                    /*number_of_rounds=*/10,
                                                    tolerance);
 
-    EXPECT_EQ(1364, function_invocations);
+    EXPECT_EQ(558, function_invocations);
     EXPECT_EQ(463, gradient_invocations);
     EXPECT_THAT(
         minima,
@@ -295,7 +299,7 @@ TEST_F(GlobalOptimizationTest, Hartmann3) {
                                    /*number_of_rounds=*/std::nullopt,
                                    tolerance);
 
-    EXPECT_EQ(199, function_invocations);
+    EXPECT_EQ(139, function_invocations);
     EXPECT_EQ(124, gradient_invocations);
     EXPECT_THAT(
         minima,
@@ -313,6 +317,66 @@ TEST_F(GlobalOptimizationTest, Hartmann3) {
   }
 }
 
+// Checks that the concurrent evaluation yields the same minima and the same
+// number of evaluations as the sequential one.
+TEST_F(GlobalOptimizationTest, Parallel) {
+  using Optimizer =
+      MultiLevelSingleLinkage<double, Displacement<World>, /*dimensions=*/3>;
+  std::atomic_int function_invocations = 0;
+  std::atomic_int gradient_invocations = 0;
+
+  auto hartmann3 =
+      [&function_invocations](Displacement<World> const& displacement) {
+    ++function_invocations;
+    auto const& coordinates = displacement.coordinates();
+    double const x₀ = coordinates[0] / Metre;
+    double const x₁ = coordinates[1] / Metre;
+    double const x₂ = coordinates[2] / Metre;
+    return Hartmann3(x₀, x₁, x₂);
+  };
+
+  auto grad_hartmann3 = [&gradient_invocations](
+                            Displacement<World> const& displacement) {
+    ++gradient_invocations;
+    auto const& coordinates = displacement.coordinates();
+    double const x₀ = coordinates[0] / Metre;
+    double const x₁ = coordinates[1] / Metre;
+    double const x₂ = coordinates[2] / Metre;
+    auto const [g₀, g₁, g₂] = 𝛁Hartmann3(x₀, x₁, x₂);
+    return Vector<Inverse<Length>, World>({g₀ / Metre, g₁ / Metre, g₂ / Metre});
+  };
+
+  Optimizer::Box const box = {
+      .centre = Displacement<World>({0.5 * Metre, 0.5 * Metre, 0.5 * Metre}),
+      .vertices = {
+          Displacement<World>({0.5 * Metre, 0 * Metre, 0 * Metre}),
+          Displacement<World>({0 * Metre, 0.5 * Metre, 0 * Metre}),
+          Displacement<World>({0 * Metre, 0 * Metre, 0.5 * Metre}),
+      }};
+
+  auto const tolerance = 1e-6 * Metre;
+  Optimizer sequential_optimizer(box, hartmann3, grad_hartmann3);
+  auto const sequential_minima =
+      sequential_optimizer.FindGlobalMinima(/*points_per_round=*/10,
+                                            /*number_of_rounds=*/10,
+                                            tolerance);
+  int const sequential_function_invocations = function_invocations;
+  int const sequential_gradient_invocations = gradient_invocations;
+
+  function_invocations = 0;
+  gradient_invocations = 0;
+  ThreadPool<void> pool(/*pool_size=*/4);
+  Optimizer parallel_optimizer(box, hartmann3, grad_hartmann3, &pool);
+  auto const parallel_minima =
+      parallel_optimizer.FindGlobalMinima(/*points_per_round=*/10,
+                                          /*number_of_rounds=*/10,
+                                          tolerance);
+
+  EXPECT_EQ(sequential_function_invocations, function_invocations);
+  EXPECT_EQ(sequential_gradient_invocations, gradient_invocations);
+  EXPECT_EQ(sequential_minima, parallel_minima);
+}
+
 // A function that looks like the opposite of the gravitational potential.
 TEST_F(GlobalOptimizationTest, Potential) {
   using Optimizer = MultiLevelSingleLinkage<Inverse<Length>,
@@ -349,7 +413,7 @@ TEST_F(GlobalOptimizationTest, Potential) {
                                                    /*number_of_rounds=*/10,
                                                    tolerance);
 
-    EXPECT_EQ(1452, function_invocations);
+    EXPECT_EQ(586, function_invocations);
     EXPECT_EQ(503, gradient_invocations);
     EXPECT_THAT(minima, IsEmpty());
   }
@@ -361,7 +425,7 @@ TEST_F(GlobalOptimizationTest, Potential) {
                                    /*number_of_rounds=*/std::nullopt,
                                    tolerance);
 
-    EXPECT_EQ(127, function_invocations);
+    EXPECT_EQ(98, function_invocations);
     EXPECT_EQ(91, gradient_invocations);
     EXPECT_THAT(minima, IsEmpty());
   }
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/hilbert.hpp"
@@ -18,6 +19,7 @@ namespace _nearest_neighbour {
 namespace internal {
 
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_hilbert;
@@ -33,16 +35,25 @@ class PrincipalComponentPartitioningTree {
  public:
   using Value = Value_;
 
+  // A type-erased filter.  The functions below accept any callable with this
+  // signature; passing a lambda directly avoids the type erasure.
   using Filter = std::function<bool(Value const*)>;
 
+  // The default filter, which accepts all values.
+  struct NoFilter {
+    constexpr bool operator()(Value const*) const { return true; }
+  };
+
   // We stop subdividing a cell when it contains |max_values_per_cell| or fewer
   // values.  This API takes (non-owning) pointers so that the client can relate
   // the values given here to the ones it gets from |FindNearestNeighbour|.  The
   // vector |values| may be empty, in which case the object is not usable until
-  // the first value has been |Add|ed.
+  // the first value has been |Add|ed.  If |thread_pool| is not null, the
+  // subtrees are built concurrently on it; the resulting tree is the same.
   PrincipalComponentPartitioningTree(
       std::vector<not_null<Value const*>> const& values,
-      std::int64_t max_values_per_cell);
+      std::int64_t max_values_per_cell,
+      ThreadPool<void>* thread_pool = nullptr);
 
   // Adds a new value to the tree, restructuring it as needed.
   void Add(not_null<Value const*> value);
@@ -50,8 +61,20 @@ class PrincipalComponentPartitioningTree {
   // Finds the nearest neighbour of the given |value|.  Returns nullptr if the
   // tree is empty.  Only the values for which |filter| returns true are
   // considered.
+  template<typename Predicate = NoFilter>
   Value const* FindNearestNeighbour(Value const& value,
-                                    Filter const& filter = nullptr) const;
+                                    Predicate const& filter = {}) const;
+
+  // For each element of |values|, finds its |k| nearest neighbours, sorted by
+  // increasing distance.  Fewer than |k| neighbours are returned if the tree
+  // doesn't have enough values for which |filter| returns true.  All the
+  // queries are answered in a single traversal of the tree, so that each leaf
+  // is visited once for all the queries that need it.
+  template<typename Predicate = NoFilter>
+  std::vector<std::vector<Value const*>> FindNearestNeighbours(
+      std::vector<Value> const& values,
+      std::int64_t k,
+      Predicate const& filter = {}) const;
 
  private:
   // A frame used to compute the principal components.
@@ -84,22 +107,23 @@ class PrincipalComponentPartitioningTree {
       std::declval<DisplacementPrincipalComponentsSystem>().rotation.Inverse()(
           std::declval<Axis>()));
 
-  // The declarations of the tree structure.
-  struct Internal;
+  // The declarations of the tree structure.  The nodes are stored in |nodes_|,
+  // mostly in preorder, and refer to their children by their index in that
+  // vector.
+  using NodeIndex = std::int32_t;
 
   using Leaf = std::vector<std::int32_t>;  // Indices in |displacements_|.
 
-  using Node = std::variant<Internal, Leaf>;
-
-  using Children = std::pair<not_null<std::unique_ptr<Node>>,
-                             not_null<std::unique_ptr<Node>>>;
-
   struct Internal {
     Axis principal_axis;
     Displacement anchor;
-    Children children;
+    NodeIndex first_child;
+    NodeIndex second_child;
   };
 
+  using Node = std::variant<Internal, Leaf>;
+  using Nodes = std::vector<Node>;
+
   // The construction of the tree uses this type, which contains an index in the
   // |displacements_| array and storage for the projection of the corresponding
   // |Displacement| on the current principal axis.  We use 32-bit integers
@@ -111,16 +135,47 @@ class PrincipalComponentPartitioningTree {
   };
   using Indices = std::vector<Index>;
 
+  // A subtree whose construction has been deferred to be executed on a thread
+  // pool.  Its nodes are built in |nodes| and its root goes at |position| in
+  // |nodes_|.
+  struct DeferredSubtree {
+    typename Indices::iterator begin;
+    typename Indices::iterator end;
+    std::int64_t size;
+    NodeIndex position;
+    Nodes nodes;
+  };
+
+  // The state of a query of |FindNearestNeighbours|: the displacement of the
+  // queried value, and a max-heap of the (squared distances, indices) of the
+  // nearest neighbours found so far.
+  struct Query {
+    Displacement displacement;
+    std::vector<std::pair<Norm², std::int32_t>> nearest;
+  };
+  using QueryIndices = std::vector<std::int32_t>;
+
   // Called when the first point is added to the tree to initialize the
-  // |centroid_| and the |root_|.
-  void Initialize();
+  // |centroid_| and the |nodes_|.
+  void Initialize(ThreadPool<void>* thread_pool);
 
   // Constructs a tree for the displacements given by the index range
-  // [begin, end[.  |size| must be equal to |std::distance(begin, end)|, but is
-  // passed by the caller for efficiency.
-  not_null<std::unique_ptr<Node>> BuildTree(typename Indices::iterator begin,
-                                            typename Indices::iterator end,
-                                            std::int64_t size) const;
+  // [begin, end[, appending its nodes to |nodes| in preorder, and returns the
+  // index of its root.  |size| must be equal to |std::distance(begin, end)|,
+  // but is passed by the caller for efficiency.  If |deferred| is not null,
+  // the internal nodes at depth |parallel_depth| are not built but recorded in
+  // |deferred|, with a placeholder in |nodes|.
+  NodeIndex BuildTree(typename Indices::iterator begin,
+                      typename Indices::iterator end,
+                      std::int64_t size,
+                      Nodes& nodes,
+                      std::int64_t parallel_depth = 0,
+                      std::vector<DeferredSubtree>* deferred = nullptr) const;
+
+  // Moves the nodes of |subtree| (built by |BuildTree| with its root at index
+  // 0) to |nodes_|, putting the root at |position| and the other nodes at the
+  // end.
+  void Splice(Nodes&& subtree, NodeIndex position);
 
   // Returns the symmetric bilinear form that represents the "inertia" of the
   // displacements given by the index range [begin, end[.
@@ -128,22 +183,24 @@ class PrincipalComponentPartitioningTree {
       typename Indices::iterator begin,
       typename Indices::iterator end) const;
 
-  // Adds the value at the given |index| by first finding the location in the
-  // subtree rooted at |node| where it would be located, and then adding it to
-  // the leaf (if there is room) or splitting the leaf (if not).
-  void Add(std::int32_t index, Node& node);
+  // Inserts the value at the given |index| by first finding the leaf where it
+  // would be located, and then adding it to that leaf (if there is room) or
+  // splitting the leaf (if not).
+  void Insert(std::int32_t index);
 
-  // Specializations for internal nodes and leaves, respectively.
-  void Add(std::int32_t index, Internal const& internal);
-  void Add(std::int32_t index, Leaf& leaf, Node& node);
+  // Returns true if |filter| accepts the value at |index|.  A null |Filter| is
+  // accepted for compatibility.
+  template<typename Predicate>
+  bool Accepts(Predicate const& filter, std::int32_t index) const;
 
   // Finds the point closest to |displacement| in the |node| and its children,
   // and returns its index and its (squared) distance.  If |displacement| is
   // close to the separator plane of |parent|, sets |must_check_other_side| to
   // true.  That pointer may be null if the client doesn't want to check this
   // condition.  |parent| should be null for the root of the tree.
+  template<typename Predicate>
   void Find(Displacement const& displacement,
-            Filter const& filter,
+            Predicate const& filter,
             Internal const* parent,
             Node const& node,
             Norm²& min_distance²,
@@ -151,21 +208,36 @@ class PrincipalComponentPartitioningTree {
             bool* must_check_other_side) const;
 
   // Specializations for internal nodes and leaves, respectively.
+  template<typename Predicate>
   void Find(Displacement const& displacement,
-            Filter const& filter,
+            Predicate const& filter,
             Internal const* parent,
             Internal const& internal,
             Norm²& min_distance²,
             std::int32_t& min_index,
             bool* must_check_other_side) const;
+  template<typename Predicate>
   void Find(Displacement const& displacement,
-            Filter const& filter,
+            Predicate const& filter,
             Internal const* parent,
             Leaf const& leaf,
             Norm²& min_distance²,
             std::int32_t& min_index,
             bool* must_check_other_side) const;
 
+  // Updates the |queries| designated by the range [begin, end[ with the |k|
+  // nearest neighbours found in the |node| and its children.  Each query
+  // visits first the side of a separator plane where it is located, and then
+  // the other side if its |k|th nearest neighbour so far is farther than the
+  // plane.  The range is reordered.
+  template<typename Predicate>
+  void FindK(typename QueryIndices::iterator begin,
+             typename QueryIndices::iterator end,
+             std::int64_t k,
+             Predicate const& filter,
+             NodeIndex node,
+             std::vector<Query>& queries) const;
+
   // Construction parameters.
   std::vector<not_null<Value const*>> values_;
   std::int64_t const max_values_per_cell_;
@@ -178,7 +250,8 @@ class PrincipalComponentPartitioningTree {
   // |values_|.
   std::vector<Displacement> displacements_;
 
-  std::unique_ptr<Node> root_;
+  // The root is at index 0.
+  Nodes nodes_;
 };
 
 }  // namespace internal
@@ -3,9 +3,12 @@
 #include "numerics/nearest_neighbour.hpp"
 
 #include <algorithm>
+#include <future>
+#include <iterator>
 #include <limits>
 #include <vector>
 #include <type_traits>
+#include <utility>
 
 #include "geometry/barycentre_calculator.hpp"
 #include "geometry/grassmann.hpp"
@@ -27,15 +30,20 @@ using namespace principia::quantities::_quantities;
 
 constexpr std::int32_t no_min_index = -1;
 
+// The number of deferred subtrees per thread when building in parallel.  More
+// than one to balance the load, as the subtrees may have different depths.
+constexpr std::int64_t deferred_subtrees_per_thread = 4;
+
 template<typename Value_>
 PrincipalComponentPartitioningTree<Value_>::PrincipalComponentPartitioningTree(
     std::vector<not_null<Value const*>> const& values,
-    std::int64_t const max_values_per_cell)
+    std::int64_t const max_values_per_cell,
+    ThreadPool<void>* const thread_pool)
     : values_(values),
       max_values_per_cell_(max_values_per_cell) {
   CHECK_LE(values_.size(), std::numeric_limits<std::int32_t>::max());
   if (!values_.empty()) {
-    Initialize();
+    Initialize(thread_pool);
   }
 }
 
@@ -44,7 +52,7 @@ void PrincipalComponentPartitioningTree<Value_>::Add(
     not_null<Value const*> const value) {
   values_.push_back(value);
   if (values_.size() == 1) {
-    Initialize();
+    Initialize(/*thread_pool=*/nullptr);
   } else {
     // There is no good way to rebalance a PCP tree (or a kd tree for that
     // matter).  Bkd trees provide some kind of solution, but their lookup is
@@ -53,14 +61,15 @@ void PrincipalComponentPartitioningTree<Value_>::Add(
     auto const displacement = *value - centroid_;
     std::int32_t const index = displacements_.size();
     displacements_.push_back(displacement);
-    Add(index, *root_);
+    Insert(index);
   }
 }
 
 template<typename Value_>
+template<typename Predicate>
 Value_ const* PrincipalComponentPartitioningTree<Value_>::FindNearestNeighbour(
     Value const& value,
-    Filter const& filter) const {
+    Predicate const& filter) const {
   if (displacements_.empty()) {
     return nullptr;
   }
@@ -69,7 +78,7 @@ Value_ const* PrincipalComponentPartitioningTree<Value_>::FindNearestNeighbour(
   Find(value - centroid_,
        filter,
        /*parent=*/nullptr,
-       *root_,
+       nodes_.front(),
        min_distance², min_index,
        /*must_check_other_side=*/nullptr);
 
@@ -81,7 +90,49 @@ Value_ const* PrincipalComponentPartitioningTree<Value_>::FindNearestNeighbour(
 }
 
 template<typename Value_>
-void PrincipalComponentPartitioningTree<Value_>::Initialize() {
+template<typename Predicate>
+std::vector<std::vector<Value_ const*>>
+PrincipalComponentPartitioningTree<Value_>::FindNearestNeighbours(
+    std::vector<Value> const& values,
+    std::int64_t const k,
+    Predicate const& filter) const {
+  CHECK_LT(0, k);
+  CHECK_LE(values.size(), std::numeric_limits<std::int32_t>::max());
+  std::vector<std::vector<Value const*>> result(values.size());
+  if (displacements_.empty()) {
+    return result;
+  }
+
+  std::vector<Query> queries;
+  queries.reserve(values.size());
+  QueryIndices query_indices;
+  query_indices.reserve(values.size());
+  for (std::int32_t i = 0; i < values.size(); ++i) {
+    queries.push_back({.displacement = values[i] - centroid_, .nearest = {}});
+    queries.back().nearest.reserve(k);
+    query_indices.push_back(i);
+  }
+
+  FindK(query_indices.begin(), query_indices.end(),
+        k,
+        filter,
+        /*node=*/0,
+        queries);
+
+  for (std::int32_t i = 0; i < queries.size(); ++i) {
+    auto& nearest = queries[i].nearest;
+    std::sort_heap(nearest.begin(), nearest.end());
+    result[i].reserve(nearest.size());
+    for (auto const& [_, index] : nearest) {
+      result[i].push_back(values_[index]);
+    }
+  }
+  return result;
+}
+
+template<typename Value_>
+void PrincipalComponentPartitioningTree<Value_>::Initialize(
+    ThreadPool<void>* const thread_pool) {
   // Compute the centroid of the values.
   std::vector<Value> values_for_barycentre;
   values_for_barycentre.reserve(values_.size());
@@ -105,17 +156,56 @@ void PrincipalComponentPartitioningTree<Value_>::Initialize() {
     indices.push_back({.index = i, .projection = Norm{}});
   }
 
-  // Finally, build the tree.
-  root_ = BuildTree(indices.begin(), indices.end(), indices.size());
+  // Finally, build the tree.  Each node is allocated in |nodes_|, which is
+  // sized for a balanced tree.
+  nodes_.clear();
+  nodes_.reserve(
+      2 * (displacements_.size() + max_values_per_cell_ - 1) /
+      max_values_per_cell_);
+  if (thread_pool == nullptr) {
+    BuildTree(indices.begin(), indices.end(), indices.size(), nodes_);
+  } else {
+    // Build the top of the tree sequentially, stopping at a depth that gives
+    // a few subtrees per thread, and build these subtrees concurrently.  Each
+    // subtree touches a disjoint range of |indices|.
+    std::int64_t parallel_depth = 0;
+    while ((std::int64_t{1} << parallel_depth) <
+           deferred_subtrees_per_thread * thread_pool->size()) {
+      ++parallel_depth;
+    }
+    std::vector<DeferredSubtree> deferred;
+    BuildTree(indices.begin(), indices.end(), indices.size(),
+              nodes_,
+              parallel_depth,
+              &deferred);
+    std::vector<std::future<void>> futures;
+    for (auto& subtree : deferred) {
+      futures.push_back(thread_pool->Add([this, &subtree]() {
+        BuildTree(subtree.begin, subtree.end, subtree.size, subtree.nodes);
+      }));
+    }
+    for (auto const& future : futures) {
+      future.wait();
+    }
+    // Splice in a deterministic order so that the tree doesn't depend on the
+    // scheduling.
+    for (auto& subtree : deferred) {
+      Splice(std::move(subtree.nodes), subtree.position);
+    }
+  }
 }
 
 template<typename Value_>
-not_null<std::unique_ptr<
-typename PrincipalComponentPartitioningTree<Value_>::Node>>
+typename PrincipalComponentPartitioningTree<Value_>::NodeIndex
 PrincipalComponentPartitioningTree<Value_>::BuildTree(
     typename Indices::iterator const begin,
     typename Indices::iterator const end,
-    std::int64_t const size) const {
+    std::int64_t const size,
+    Nodes& nodes,
+    std::int64_t const parallel_depth,
+    std::vector<DeferredSubtree>* const deferred) const {
+  CHECK_LT(nodes.size(), std::numeric_limits<NodeIndex>::max());
+  NodeIndex const position = nodes.size();
   if (size <= max_values_per_cell_) {
     // We are done subdividing, return a leaf.
     Leaf leaf;
@@ -123,7 +213,22 @@ PrincipalComponentPartitioningTree<Value_>::BuildTree(
     for (auto it = begin; it != end; ++it) {
       leaf.push_back(it->index);
     }
-    return make_not_null_unique<Node>(leaf);
+    nodes.emplace_back(std::move(leaf));
+    return position;
+  }
+
+  // Reserve the slot of this node so that the tree is in preorder.  Note that
+  // |nodes| may be reallocated by the recursive calls, so we must not retain
+  // references to its elements.
+  nodes.emplace_back();
+
+  if (deferred != nullptr && parallel_depth == 0) {
+    deferred->push_back({.begin = begin,
+                         .end = end,
+                         .size = size,
+                         .position = position,
+                         .nodes = {}});
+    return position;
   }
 
   // Compute the "inertia" of the selected displacements and diagonalize it.
@@ -163,13 +268,40 @@ PrincipalComponentPartitioningTree<Value_>::BuildTree(
       {displacements_[mid_lower->index], displacements_[mid_upper->index]},
       {1, 1});
 
-  auto first_child = BuildTree(begin, mid_upper, size / 2);
-  auto second_child = BuildTree(mid_upper, end, size - size / 2);
+  NodeIndex const first_child = BuildTree(begin, mid_upper, size / 2,
+                                          nodes,
+                                          parallel_depth - 1,
+                                          deferred);
+  NodeIndex const second_child = BuildTree(mid_upper, end, size - size / 2,
+                                           nodes,
+                                           parallel_depth - 1,
+                                           deferred);
+
+  nodes[position] = Internal{.principal_axis = principal_axis,
+                             .anchor = anchor,
+                             .first_child = first_child,
+                             .second_child = second_child};
+  return position;
+}
 
-  return make_not_null_unique<Node>(
-      Internal{.principal_axis = principal_axis,
-               .anchor = anchor,
-               .children = {std::move(first_child), std::move(second_child)}});
+template<typename Value_>
+void PrincipalComponentPartitioningTree<Value_>::Splice(
+    Nodes&& subtree,
+    NodeIndex const position) {
+  CHECK(!subtree.empty());
+  CHECK_LE(nodes_.size() + subtree.size(),
+           std::numeric_limits<NodeIndex>::max());
+  // The node at index i > 0 in |subtree| goes at index |offset + i|.
+  NodeIndex const offset = nodes_.size() - 1;
+  for (auto& node : subtree) {
+    if (auto* const internal = std::get_if<Internal>(&node)) {
+      internal->first_child += offset;
+      internal->second_child += offset;
+    }
+  }
+  nodes_[position] = std::move(subtree.front());
+  std::move(std::next(subtree.begin()), subtree.end(),
+            std::back_inserter(nodes_));
 }
 
 template<typename Value_>
@@ -186,53 +318,59 @@ PrincipalComponentPartitioningTree<Value_>::ComputePrincipalComponentForm(
 }
 
 template<typename Value_>
-void PrincipalComponentPartitioningTree<Value_>::Add(std::int32_t const index,
-                                                     Node& node) {
-  if (std::holds_alternative<Internal>(node)) {
-    Add(index, std::get<Internal>(node));
-  } else if (std::holds_alternative<Leaf>(node)) {
-    Add(index, std::get<Leaf>(node), node);
-  } else {
-    LOG(FATAL) << "Unexpected node";
-  }
-}
-
-template<typename Value_>
-void PrincipalComponentPartitioningTree<Value_>::Add(std::int32_t const index,
-                                                     Internal const& internal) {
-  Norm const projection = InnerProduct(internal.principal_axis,
-                                       displacements_[index] - internal.anchor);
-  if (projection < Norm{}) {
-    Add(index, *internal.children.first);
-  } else {
-    Add(index, *internal.children.second);
+void PrincipalComponentPartitioningTree<Value_>::Insert(
+    std::int32_t const index) {
+  // Find the leaf where the value belongs.
+  NodeIndex position = 0;
+  while (auto const* const internal =
+             std::get_if<Internal>(&nodes_[position])) {
+    Norm const projection = InnerProduct(
+        internal->principal_axis, displacements_[index] - internal->anchor);
+    if (projection < Norm{}) {
+      position = internal->first_child;
+    } else {
+      position = internal->second_child;
+    }
   }
-}
 
-template<typename Value_>
-void PrincipalComponentPartitioningTree<Value_>::Add(std::int32_t const index,
-                                                     Leaf& leaf,
-                                                     Node& node) {
+  auto& leaf = std::get<Leaf>(nodes_[position]);
   leaf.push_back(index);
   if (leaf.size() > max_values_per_cell_) {
     // The leaf is full, we need to split it by building a (sub)tree based on
-    // it.
+    // it, which replaces the leaf.
     Indices indices;
     indices.reserve(leaf.size());
     for (const std::int32_t index : leaf) {
       indices.push_back({.index = index, .projection = Norm{}});
     }
-    auto const subtree =
-        BuildTree(indices.begin(), indices.end(), indices.size());
-    CHECK(std::holds_alternative<Internal>(*subtree));
-    node = std::move(*subtree);
+    Nodes subtree;
+    BuildTree(indices.begin(), indices.end(), indices.size(), subtree);
+    CHECK(std::holds_alternative<Internal>(subtree.front()));
+    Splice(std::move(subtree), position);
+  }
+}
+
+template<typename Value_>
+template<typename Predicate>
+bool PrincipalComponentPartitioningTree<Value_>::Accepts(
+    Predicate const& filter,
+    std::int32_t const index) const {
+  if constexpr (std::is_same_v<Predicate, NoFilter>) {
+    return true;
+  } else if constexpr (std::is_null_pointer_v<Predicate>) {
+    return true;
+  } else if constexpr (std::is_same_v<Predicate, Filter>) {
+    return filter == nullptr || filter(values_[index]);
+  } else {
+    return filter(values_[index]);
   }
 }
 
 template<typename Value_>
+template<typename Predicate>
 void PrincipalComponentPartitioningTree<Value_>::Find(
     Displacement const& displacement,
-    Filter const& filter,
+    Predicate const& filter,
     Internal const* const parent,
     Node const& node,
     Norm²& min_distance²,
@@ -258,9 +396,10 @@ void PrincipalComponentPartitioningTree<Value_>::Find(
 }
 
 template<typename Value_>
+template<typename Predicate>
 void PrincipalComponentPartitioningTree<Value_>::Find(
     Displacement const& displacement,
-    Filter const& filter,
+    Predicate const& filter,
     Internal const* parent,
     Internal const& internal,
     Norm²& min_distance²,
@@ -274,9 +413,9 @@ void PrincipalComponentPartitioningTree<Value_>::Find(
   // side, if |displacement| is too close to that plane.
   Node const* preferred_side;
   if (projection < Norm{}) {
-    preferred_side = internal.children.first.get();
+    preferred_side = &nodes_[internal.first_child];
   } else {
-    preferred_side = internal.children.second.get();
+    preferred_side = &nodes_[internal.second_child];
   }
 
   std::int32_t preferred_min_index;
@@ -292,9 +431,9 @@ void PrincipalComponentPartitioningTree<Value_>::Find(
   if (preferred_must_check_other_side) {
     Node const* other_side;
     if (projection < Norm{}) {
-      other_side = internal.children.second.get();
+      other_side = &nodes_[internal.second_child];
     } else {
-      other_side = internal.children.first.get();
+      other_side = &nodes_[internal.first_child];
     }
 
     // We omit |must_check_other_side| because there is no point in checking the
@@ -332,9 +471,10 @@ void PrincipalComponentPartitioningTree<Value_>::Find(
 }
 
 template<typename Value_>
+template<typename Predicate>
 void PrincipalComponentPartitioningTree<Value_>::Find(
     Displacement const& displacement,
-    Filter const& filter,
+    Predicate const& filter,
     Internal const* const parent,
     Leaf const& leaf,
     Norm²& min_distance²,
@@ -349,8 +489,7 @@ void PrincipalComponentPartitioningTree<Value_>::Find(
     auto const distance² = (displacements_[index] - displacement).Norm²();
     // Skip the values that are filtered out.  Note that *all* the values may be
     // filtered out.
-    if (distance² < min_distance² &&
-        (filter == nullptr || filter(values_[index]))) {
+    if (distance² < min_distance² && Accepts(filter, index)) {
       min_distance² = distance²;
       min_index = index;
     }
@@ -365,6 +504,74 @@ void PrincipalComponentPartitioningTree<Value_>::Find(
   }
 }
 
+template<typename Value_>
+template<typename Predicate>
+void PrincipalComponentPartitioningTree<Value_>::FindK(
+    typename QueryIndices::iterator const begin,
+    typename QueryIndices::iterator const end,
+    std::int64_t const k,
+    Predicate const& filter,
+    NodeIndex const node,
+    std::vector<Query>& queries) const {
+  if (begin == end) {
+    return;
+  }
+
+  // The squared distance beyond which a value cannot be one of the |k|
+  // nearest neighbours of |query|.
+  auto const bound² = [k](Query const& query) {
+    return query.nearest.size() < k ? Infinity<Norm²>
+                                    : query.nearest.front().first;
+  };
+
+  if (auto const* const leaf = std::get_if<Leaf>(&nodes_[node])) {
+    // The leaf is traversed once for all the queries.
+    for (auto it = begin; it != end; ++it) {
+      auto& query = queries[*it];
+      auto& nearest = query.nearest;
+      for (auto const index : *leaf) {
+        auto const distance² =
+            (displacements_[index] - query.displacement).Norm²();
+        if (distance² < bound²(query) && Accepts(filter, index)) {
+          if (nearest.size() == k) {
+            std::pop_heap(nearest.begin(), nearest.end());
+            nearest.pop_back();
+          }
+          nearest.emplace_back(distance², index);
+          std::push_heap(nearest.begin(), nearest.end());
+        }
+      }
+    }
+    return;
+  }
+
+  auto const& internal = std::get<Internal>(nodes_[node]);
+  auto const projection = [&internal](Query const& query) {
+    return InnerProduct(internal.principal_axis,
+                        query.displacement - internal.anchor);
+  };
+
+  // Split the queries according to the side of the separator plane where they
+  // are located, and search that side first.
+  auto const mid = std::partition(
+      begin, end, [&projection, &queries](std::int32_t const i) {
+        return projection(queries[i]) < Norm{};
+      });
+  FindK(begin, mid, k, filter, internal.first_child, queries);
+  FindK(mid, end, k, filter, internal.second_child, queries);
+
+  // Search the other side for the queries whose current bound extends beyond
+  // the separator plane.
+  auto const must_check_other_side = [&bound², &projection, &queries](
+                                         std::int32_t const i) {
+    return Pow<2>(projection(queries[i])) < bound²(queries[i]);
+  };
+  auto const first_end = std::partition(mid, end, must_check_other_side);
+  FindK(mid, first_end, k, filter, internal.first_child, queries);
+  auto const second_end = std::partition(begin, mid, must_check_other_side);
+  FindK(begin, second_end, k, filter, internal.second_child, queries);
+}
+
 }  // namespace internal
 }  // namespace _nearest_neighbour
 }  // namespace numerics
@@ -1,9 +1,11 @@
 #include "numerics/nearest_neighbour.hpp"
 
+#include <algorithm>
 #include <random>
 #include <vector>
 
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/grassmann.hpp"
 #include "gmock/gmock.h"
@@ -13,9 +15,11 @@
 namespace principia {
 namespace numerics {
 
+using ::testing::ElementsAreArray;
 using ::testing::Eq;
 using ::testing::Pointee;
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_grassmann;
 using namespace principia::numerics::_nearest_neighbour;
@@ -44,6 +48,29 @@ class PrincipalComponentPartitioningTreeTest : public ::testing::Test {
     return nearest;
   }
 
+  // Computes the |k| nearest points using the brute force algorithm.
+  std::vector<V const*> BruteForceNearestNeighbours(
+      V const& query_value,
+      std::vector<V> const& values,
+      std::int64_t const k,
+      PrincipalComponentPartitioningTree<V>::Filter const& filter = nullptr) {
+    std::vector<V const*> nearest;
+    for (auto const& value : values) {
+      if (filter == nullptr || filter(&value)) {
+        nearest.push_back(&value);
+      }
+    }
+    std::sort(nearest.begin(), nearest.end(),
+              [&query_value](V const* const left, V const* const right) {
+                return (*left - query_value).Norm²() <
+                       (*right - query_value).Norm²();
+              });
+    if (nearest.size() > k) {
+      nearest.resize(k);
+    }
+    return nearest;
+  }
+
   // Fills the vectors with |number_of_values| randomly generated values.
   void MakeValues(
       int const number_of_values,
@@ -151,6 +178,50 @@ TEST_F(PrincipalComponentPartitioningTreeTest, RandomConstructor) {
   }
 }
 
+// Same as the previous test, but the trees are built on a thread pool, and more
+// points are added afterwards.
+TEST_F(PrincipalComponentPartitioningTreeTest, RandomParallelConstructor) {
+  static constexpr int points_in_tree = 10'000;
+  static constexpr int points_to_add = 100;
+  static constexpr int points_to_test = 100;
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<double> coordinate_distribution(-10, 10);
+
+  std::vector<V> tree_points;
+  std::vector<not_null<V const*>> tree_pointers;
+  MakeValues(points_in_tree + points_to_add,
+             tree_points,
+             tree_pointers,
+             random,
+             coordinate_distribution);
+  std::vector<not_null<V const*>> const initial_pointers(
+      tree_pointers.begin(), tree_pointers.begin() + points_in_tree);
+  ThreadPool<void> pool(/*pool_size=*/4);
+  PrincipalComponentPartitioningTree<V> tree1(initial_pointers,
+                                              /*max_values_per_cell=*/1,
+                                              &pool);
+  PrincipalComponentPartitioningTree<V> tree3(initial_pointers,
+                                              /*max_values_per_cell=*/3,
+                                              &pool);
+  for (int i = points_in_tree; i < tree_pointers.size(); ++i) {
+    tree1.Add(tree_pointers[i]);
+    tree3.Add(tree_pointers[i]);
+  }
+
+  for (int i = 0; i < points_to_test; ++i) {
+    auto const query_point = V({coordinate_distribution(random),
+                                coordinate_distribution(random),
+                                coordinate_distribution(random)});
+
+    auto* const nearest = BruteForceNearestNeighbour(query_point, tree_points);
+    auto* const nearest1 = tree1.FindNearestNeighbour(query_point);
+    auto* const nearest3 = tree3.FindNearestNeighbour(query_point);
+
+    EXPECT_THAT(nearest1, Eq(nearest)) << *nearest1 << " " << *nearest;
+    EXPECT_THAT(nearest3, Eq(nearest)) << *nearest3 << " " << *nearest;
+  }
+}
+
 // Same as the previous test, but the trees are initially empty and points are
 // added using |Add|.
 TEST_F(PrincipalComponentPartitioningTreeTest, RandomAdd) {
@@ -235,5 +306,64 @@ TEST_F(PrincipalComponentPartitioningTreeTest, RandomFilter) {
   EXPECT_TRUE(filtering_was_effective) << "Filtering did nothing";
 }
 
+// Batched k nearest neighbours, with and without a filter, validated against
+// the brute force algorithm.
+TEST_F(PrincipalComponentPartitioningTreeTest, RandomNearestNeighbours) {
+  static constexpr int points_in_tree = 1000;
+  static constexpr int points_to_test = 100;
+  static constexpr int k = 7;
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<double> coordinate_distribution(-10, 10);
+
+  std::vector<V> tree_points;
+  std::vector<not_null<V const*>> tree_pointers;
+  MakeValues(points_in_tree,
+             tree_points,
+             tree_pointers,
+             random,
+             coordinate_distribution);
+  PrincipalComponentPartitioningTree<V> tree1(tree_pointers,
+                                              /*max_values_per_cell=*/1);
+  PrincipalComponentPartitioningTree<V> tree8(tree_pointers,
+                                              /*max_values_per_cell=*/8);
+
+  std::vector<V> query_points;
+  for (int i = 0; i < points_to_test; ++i) {
+    query_points.push_back(V({coordinate_distribution(random),
+                              coordinate_distribution(random),
+                              coordinate_distribution(random)}));
+  }
+
+  auto const filter = [](V const* const point) {
+    return point->Norm²() < 100;
+  };
+
+  auto const nearest1 = tree1.FindNearestNeighbours(query_points, k);
+  auto const nearest8 = tree8.FindNearestNeighbours(query_points, k);
+  auto const filtered_nearest1 =
+      tree1.FindNearestNeighbours(query_points, k, filter);
+  auto const filtered_nearest8 =
+      tree8.FindNearestNeighbours(query_points, k, filter);
+  for (int i = 0; i < points_to_test; ++i) {
+    auto const nearest =
+        BruteForceNearestNeighbours(query_points[i], tree_points, k);
+    EXPECT_THAT(nearest1[i], ElementsAreArray(nearest));
+    EXPECT_THAT(nearest8[i], ElementsAreArray(nearest));
+
+    auto const filtered_nearest =
+        BruteForceNearestNeighbours(query_points[i], tree_points, k, filter);
+    EXPECT_THAT(filtered_nearest1[i], ElementsAreArray(filtered_nearest));
+    EXPECT_THAT(filtered_nearest8[i], ElementsAreArray(filtered_nearest));
+  }
+
+  // Fewer values than requested.
+  PrincipalComponentPartitioningTree<V> small_tree(
+      {tree_pointers[0], tree_pointers[1]}, /*max_values_per_cell=*/1);
+  auto const small_nearest = small_tree.FindNearestNeighbours(query_points, k);
+  for (int i = 0; i < points_to_test; ++i) {
+    EXPECT_EQ(2, small_nearest[i].size());
+  }
+}
+
 }  // namespace numerics
 }  // namespace principia
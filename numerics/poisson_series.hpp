@@ -160,6 +160,15 @@ class PoissonSeries {
   };
   SplitPoissonSeries Split(AngularFrequency const& ω_cutoff) const;
 
+  // Adds |right| to this series (or subtracts it if |subtract| is true) without
+  // constructing a new series.  The periodic vector is only reallocated if it
+  // needs to grow to accommodate new frequencies.
+  template<int aperiodic_rdegree, int periodic_rdegree>
+  void AddInPlace(PoissonSeries<Value,
+                                aperiodic_rdegree, periodic_rdegree,
+                                Evaluator> const& right,
+                  bool subtract);
+
   Instant origin_;  // Common to all polynomials.
   AperiodicPolynomial aperiodic_;
   // The frequencies in this vector are positive, distinct and in increasing
@@ -201,6 +210,14 @@ class PoissonSeries {
   auto friend Multiply(PoissonSeries<L, al, pl, E> const& left,
                        PoissonSeries<R, ar, pr, E> const& right,
                        P const& product);
+  template<typename L, typename R, int al, int pl, int ar, int pr,
+           template<typename, typename, int> class E,
+           typename P>
+  auto friend MultiplyAndIntegrate(PoissonSeries<L, al, pl, E> const& left,
+                                   PoissonSeries<R, ar, pr, E> const& right,
+                                   P const& product,
+                                   Instant const& t1,
+                                   Instant const& t2);
   template<typename V, int ad, int pd,
            template<typename, typename, int> class E>
   friend std::ostream& operator<<(std::ostream& out,
@@ -204,6 +204,150 @@ auto Multiply(PoissonSeries<LValue,
                 std::move(periodic));
 }
 
+// The sines and cosines of ω (t₁ - t₀) and ω (t₂ - t₀) for some angular
+// frequency ω and some origin t₀.
+struct Phases {
+  double sin_ωt1 = 0;
+  double cos_ωt1 = 1;
+  double sin_ωt2 = 0;
+  double cos_ωt2 = 1;
+};
+
+inline Phases MakePhases(AngularFrequency const& ω,
+                         Instant const& t0,
+                         Instant const& t1,
+                         Instant const& t2) {
+  return {.sin_ωt1 = Sin(ω * (t1 - t0)),
+          .cos_ωt1 = Cos(ω * (t1 - t0)),
+          .sin_ωt2 = Sin(ω * (t2 - t0)),
+          .cos_ωt2 = Cos(ω * (t2 - t0))};
+}
+
+// Returns the phases for ω₁ + ω₂ given the phases for ω₁ and ω₂.
+inline Phases PhasesOfSum(Phases const& phases1, Phases const& phases2) {
+  return {.sin_ωt1 = phases1.sin_ωt1 * phases2.cos_ωt1 +
+                     phases1.cos_ωt1 * phases2.sin_ωt1,
+          .cos_ωt1 = phases1.cos_ωt1 * phases2.cos_ωt1 -
+                     phases1.sin_ωt1 * phases2.sin_ωt1,
+          .sin_ωt2 = phases1.sin_ωt2 * phases2.cos_ωt2 +
+                     phases1.cos_ωt2 * phases2.sin_ωt2,
+          .cos_ωt2 = phases1.cos_ωt2 * phases2.cos_ωt2 -
+                     phases1.sin_ωt2 * phases2.sin_ωt2};
+}
+
+// Returns the phases for ω₁ - ω₂ given the phases for ω₁ and ω₂.
+inline Phases PhasesOfDifference(Phases const& phases1, Phases const& phases2) {
+  return {.sin_ωt1 = phases1.sin_ωt1 * phases2.cos_ωt1 -
+                     phases1.cos_ωt1 * phases2.sin_ωt1,
+          .cos_ωt1 = phases1.cos_ωt1 * phases2.cos_ωt1 +
+                     phases1.sin_ωt1 * phases2.sin_ωt1,
+          .sin_ωt2 = phases1.sin_ωt2 * phases2.cos_ωt2 -
+                     phases1.cos_ωt2 * phases2.sin_ωt2,
+          .cos_ωt2 = phases1.cos_ωt2 * phases2.cos_ωt2 +
+                     phases1.sin_ωt2 * phases2.sin_ωt2};
+}
+
+// This function computes ∫ₜ₁ᵗ² product(left, right)(t) dt, where the functor
+// Product is as for |Multiply|.  It generates the same terms as |Multiply| but
+// integrates them on the fly instead of constructing, sorting and grouping
+// them.  The trigonometric functions are only evaluated for the frequencies of
+// the arguments, the ones for the frequencies of the terms are obtained by
+// angle addition.  This is only advantageous if few terms of the product have
+// the same frequency, e.g., if |right| is a weight with a handful of terms.
+template<typename LValue, typename RValue,
+         int aperiodic_ldegree, int periodic_ldegree,
+         int aperiodic_rdegree, int periodic_rdegree,
+         template<typename, typename, int> class Evaluator,
+         typename Product>
+auto MultiplyAndIntegrate(PoissonSeries<LValue,
+                                        aperiodic_ldegree, periodic_ldegree,
+                                        Evaluator> const& left,
+                          PoissonSeries<RValue,
+                                        aperiodic_rdegree, periodic_rdegree,
+                                        Evaluator> const& right,
+                          Product const& product,
+                          Instant const& t1,
+                          Instant const& t2) {
+  using Result = decltype(Multiply(left, right, product));
+  using PeriodicPolynomial = typename Result::PeriodicPolynomial;
+
+  Instant const& t0 = left.origin_;
+  CHECK_EQ(t0, right.origin_);
+
+  std::vector<Phases> right_phases;
+  right_phases.reserve(right.periodic_.size());
+  for (auto const& [ωr, _] : right.periodic_) {
+    right_phases.push_back(MakePhases(ωr, t0, t1, t2));
+  }
+
+  auto result = typename Result::AperiodicPolynomial(
+                    product(left.aperiodic_, right.aperiodic_))
+                    .Integrate(t1, t2);
+
+  // Integrates a periodic term of the product.
+  auto integrate = [&result, &t1, &t2](AngularFrequency const& ω,
+                                       Phases const& phases,
+                                       PeriodicPolynomial const& sin,
+                                       PeriodicPolynomial const& cos) {
+    if (ω == AngularFrequency{}) {
+      result += cos.Integrate(t1, t2);
+    } else {
+      result += AngularFrequencyIntegrate(ω,
+                                          sin, cos,
+                                          t1, t2,
+                                          phases.sin_ωt1, phases.cos_ωt1,
+                                          phases.sin_ωt2, phases.cos_ωt2);
+    }
+  };
+
+  // The terms involving a zero aperiodic polynomial are skipped, they are
+  // common after splitting a series in its slow and fast parts.
+  bool const left_aperiodic_is_zero = left.aperiodic_.is_zero();
+  bool const right_aperiodic_is_zero = right.aperiodic_.is_zero();
+  for (auto const& [ωl, polynomials_left] : left.periodic_) {
+    Phases const left_phases = MakePhases(ωl, t0, t1, t2);
+    if (!right_aperiodic_is_zero) {
+      integrate(ωl,
+                left_phases,
+                PeriodicPolynomial(
+                    product(polynomials_left.sin, right.aperiodic_)),
+                PeriodicPolynomial(
+                    product(polynomials_left.cos, right.aperiodic_)));
+    }
+    for (int j = 0; j < right.periodic_.size(); ++j) {
+      auto const& [ωr, polynomials_right] = right.periodic_[j];
+      auto const cos_cos = PeriodicPolynomial(
+          product(polynomials_left.cos, polynomials_right.cos));
+      auto const cos_sin = PeriodicPolynomial(
+          product(polynomials_left.cos, polynomials_right.sin));
+      auto const sin_cos = PeriodicPolynomial(
+          product(polynomials_left.sin, polynomials_right.cos));
+      auto const sin_sin = PeriodicPolynomial(
+          product(polynomials_left.sin, polynomials_right.sin));
+      integrate(ωl - ωr,
+                PhasesOfDifference(left_phases, right_phases[j]),
+                (-cos_sin + sin_cos) / 2,
+                (sin_sin + cos_cos) / 2);
+      integrate(ωl + ωr,
+                PhasesOfSum(left_phases, right_phases[j]),
+                (cos_sin + sin_cos) / 2,
+                (-sin_sin + cos_cos) / 2);
+    }
+  }
+  if (!left_aperiodic_is_zero) {
+    for (int j = 0; j < right.periodic_.size(); ++j) {
+      auto const& [ωr, polynomials_right] = right.periodic_[j];
+      integrate(ωr,
+                right_phases[j],
+                PeriodicPolynomial(
+                    product(left.aperiodic_, polynomials_right.sin)),
+                PeriodicPolynomial(
+                    product(left.aperiodic_, polynomials_right.cos)));
+    }
+  }
+  return result;
+}
+
 template<typename Value,
          int aperiodic_degree_, int periodic_degree_,
          template<typename, typename, int> class Evaluator>
@@ -384,10 +528,14 @@ Norm(PoissonSeries<double,
       /*max_relative_error=*/clenshaw_curtis_relative_error,
       /*max_points=*/max_points);
 
-  auto const fast_integrand =
-      PointwiseInnerProduct(split.fast, split.fast + 2 * split.slow) *
-      weight;
-  auto const fast_quadrature = fast_integrand.Integrate(t_min, t_max);
+  auto const multiply = [](auto const& left, auto const& right) {
+    return left * right;
+  };
+  auto const fast_quadrature = MultiplyAndIntegrate(
+      PointwiseInnerProduct(split.fast, split.fast + 2 * split.slow),
+      weight,
+      multiply,
+      t_min, t_max);
 
   return Sqrt((slow_quadrature + fast_quadrature) / (t_max - t_min));
 }
@@ -401,9 +549,7 @@ PoissonSeries<Value, aperiodic_degree_, periodic_degree_, Evaluator>::
 operator+=(PoissonSeries<Value,
                          aperiodic_rdegree, periodic_rdegree,
                          Evaluator> const& right) {
-  static_assert(aperiodic_rdegree <= aperiodic_degree_);
-  static_assert(periodic_rdegree <= periodic_degree_);
-  *this = *this + right;
+  AddInPlace(right, /*subtract=*/false);
   return *this;
 }
 
@@ -416,9 +562,7 @@ PoissonSeries<Value, aperiodic_degree_, periodic_degree_, Evaluator>::
 operator-=(PoissonSeries<Value,
                          aperiodic_rdegree, periodic_rdegree,
                          Evaluator> const& right) {
-  static_assert(aperiodic_rdegree <= aperiodic_degree_);
-  static_assert(periodic_rdegree <= periodic_degree_);
-  *this = *this - right;
+  AddInPlace(right, /*subtract=*/true);
   return *this;
 }
 
@@ -581,6 +725,92 @@ Split(AngularFrequency const& ω_cutoff) const {
   }
 }
 
+template<typename Value,
+         int aperiodic_degree_, int periodic_degree_,
+         template<typename, typename, int> class Evaluator>
+template<int aperiodic_rdegree, int periodic_rdegree>
+void PoissonSeries<Value, aperiodic_degree_, periodic_degree_, Evaluator>::
+AddInPlace(PoissonSeries<Value,
+                         aperiodic_rdegree, periodic_rdegree,
+                         Evaluator> const& right,
+           bool const subtract) {
+  static_assert(aperiodic_rdegree <= aperiodic_degree_);
+  static_assert(periodic_rdegree <= periodic_degree_);
+  // Returns polynomials of our degree for the term of |right| with the given
+  // polynomials.
+  auto const signed_polynomials =
+      [subtract](auto const& polynomials) -> Polynomials {
+    if (subtract) {
+      return {.sin = PeriodicPolynomial(-polynomials.sin),
+              .cos = PeriodicPolynomial(-polynomials.cos)};
+    } else {
+      return {.sin = PeriodicPolynomial(polynomials.sin),
+              .cos = PeriodicPolynomial(polynomials.cos)};
+    }
+  };
+
+  if (subtract) {
+    aperiodic_ -= AperiodicPolynomial(right.aperiodic_);
+  } else {
+    aperiodic_ += AperiodicPolynomial(right.aperiodic_);
+  }
+
+  // First pass: update the frequencies that are common to both series, and
+  // count the ones that only exist in |right|.
+  int missing_frequencies = 0;
+  auto it = periodic_.begin();
+  for (auto const& [ω, polynomials] : right.periodic_) {
+    while (it != periodic_.end() && it->first < ω) {
+      ++it;
+    }
+    if (it != periodic_.end() && it->first == ω) {
+      if (subtract) {
+        it->second.sin -= PeriodicPolynomial(polynomials.sin);
+        it->second.cos -= PeriodicPolynomial(polynomials.cos);
+      } else {
+        it->second.sin += PeriodicPolynomial(polynomials.sin);
+        it->second.cos += PeriodicPolynomial(polynomials.cos);
+      }
+      ++it;
+    } else {
+      ++missing_frequencies;
+    }
+  }
+  if (missing_frequencies == 0) {
+    return;
+  }
+
+  // Second pass: make room at the end of the vector and merge the missing
+  // frequencies from the back, so that each term is moved at most once.  The
+  // elements inserted here are placeholders that get overwritten.
+  int left_index = periodic_.size() - 1;
+  int right_index = right.periodic_.size() - 1;
+  periodic_.insert(
+      periodic_.end(),
+      missing_frequencies,
+      {right.periodic_.back().first,
+       signed_polynomials(right.periodic_.back().second)});
+  // The loop stops when all the missing frequencies have been inserted, at
+  // which point the beginning of the vector is in its final state.
+  for (int destination_index = periodic_.size() - 1;
+       destination_index > left_index;
+       --destination_index) {
+    auto const& [ωr, polynomials_right] = right.periodic_[right_index];
+    if (left_index >= 0 && periodic_[left_index].first >= ωr) {
+      if (periodic_[left_index].first == ωr) {
+        // Already updated by the first pass.
+        --right_index;
+      }
+      periodic_[destination_index] = std::move(periodic_[left_index]);
+      --left_index;
+    } else {
+      periodic_[destination_index] = {ωr,
+                                      signed_polynomials(polynomials_right)};
+      --right_index;
+    }
+  }
+}
+
 template<typename Value,
          int aperiodic_rdegree, int periodic_rdegree,
          template<typename, typename, int> class Evaluator>
@@ -969,12 +1199,16 @@ typename Hilbert<LValue, RValue>::InnerProductType InnerProduct(
       /*max_relative_error=*/clenshaw_curtis_relative_error,
       /*max_points=*/max_points);
 
-  auto const fast_integrand =
-      (PointwiseInnerProduct(left_split.fast, right_split.slow) +
-       PointwiseInnerProduct(left_split.slow, right_split.fast) +
-       PointwiseInnerProduct(left_split.fast, right_split.fast)) *
-      weight;
-  auto const fast_quadrature = fast_integrand.Integrate(t_min, t_max);
+  auto const multiply = [](auto const& left, auto const& right) {
+    return left * right;
+  };
+  auto const fast_quadrature = MultiplyAndIntegrate(
+      PointwiseInnerProduct(left_split.fast, right_split.slow) +
+          PointwiseInnerProduct(left_split.slow, right_split.fast) +
+          PointwiseInnerProduct(left_split.fast, right_split.fast),
+      weight,
+      multiply,
+      t_min, t_max);
 
   return (slow_quadrature + fast_quadrature) / (t_max - t_min);
 }
@@ -163,6 +163,44 @@ TEST_F(PoissonSeriesTest, VectorSpace) {
   }
 }
 
+TEST_F(PoissonSeriesTest, InPlaceVectorSpace) {
+  // A series of a lower degree with a frequency that is neither in |pa_| nor in
+  // |pb_| and lies between theirs.
+  Degree0 const pc(
+      Degree0::AperiodicPolynomial({5}, t0_),
+      Degree0::PolynomialsByAngularFrequency{
+          {1.5 * Radian / Second,
+           Degree0::Polynomials{
+               .sin = Degree0::PeriodicPolynomial({6}, t0_),
+               .cos = Degree0::PeriodicPolynomial({7}, t0_)}}});
+  {
+    // Frequency 3 is missing from |pa_| and gets appended.
+    auto sum = *pa_;
+    sum += *pb_;
+    EXPECT_THAT(sum(t0_ + 1 * Second),
+                AlmostEquals((*pa_ + *pb_)(t0_ + 1 * Second), 0));
+  }
+  {
+    // Frequency 2 is missing from |pb_| and gets inserted.
+    auto difference = *pb_;
+    difference -= *pa_;
+    EXPECT_THAT(difference(t0_ + 1 * Second),
+                AlmostEquals((*pb_ - *pa_)(t0_ + 1 * Second), 0));
+  }
+  {
+    auto sum = *pa_;
+    sum += pc;
+    sum += pc;
+    EXPECT_THAT(sum(t0_ + 1 * Second),
+                AlmostEquals((*pa_ + pc + pc)(t0_ + 1 * Second), 0));
+  }
+  {
+    auto difference = *pa_;
+    difference -= difference;
+    EXPECT_EQ(0, difference(t0_ + 1 * Second));
+  }
+}
+
 TEST_F(PoissonSeriesTest, Algebra) {
   auto const product = *pa_ * *pb_;
   EXPECT_THAT(product(t0_ + 1 * Second),
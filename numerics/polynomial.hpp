@@ -83,6 +83,12 @@ class Polynomial {
   virtual Value operator()(Argument const& argument) const = 0;
   virtual Derivative<Value, Argument> EvaluateDerivative(
       Argument const& argument) const = 0;
+  // Equivalent to calling |operator()| and |EvaluateDerivative|, but may share
+  // some of the computations.
+  virtual void EvaluateWithDerivative(
+      Argument const& argument,
+      Value& value,
+      Derivative<Value, Argument>& derivative) const = 0;
 
   // Only useful for benchmarking, analyzing performance or for downcasting.  Do
   // not use in other circumstances.
@@ -133,10 +139,15 @@ class PolynomialInMonomialBasis : public Polynomial<Value_, Argument_> {
   Value operator()(Argument const& argument) const override;
   Derivative<Value, Argument> EvaluateDerivative(
       Argument const& argument) const override;
+  void EvaluateWithDerivative(
+      Argument const& argument,
+      Value& value,
+      Derivative<Value, Argument>& derivative) const override;
 
   constexpr int degree() const override;
   bool is_zero() const override;
 
+  Coefficients const& coefficients() const;
   Argument const& origin() const;
 
   // Returns a copy of this polynomial adjusted to the given origin.
@@ -431,6 +431,18 @@ EvaluateDerivative(Argument const& argument) const {
       coefficients_, argument - origin_);
 }
 
+template<typename Value_, typename Argument_, int degree_,
+         template<typename, typename, int> typename Evaluator>
+void PolynomialInMonomialBasis<Value_, Argument_, degree_, Evaluator>::
+EvaluateWithDerivative(
+    Argument const& argument,
+    Value& value,
+    quantities::_named_quantities::Derivative<Value, Argument>& derivative)
+    const {
+  Evaluator<Value, Difference<Argument>, degree_>::EvaluateWithDerivative(
+      coefficients_, argument - origin_, value, derivative);
+}
+
 template<typename Value_, typename Argument_, int degree_,
          template<typename, typename, int> typename Evaluator>
 constexpr int
@@ -446,6 +458,15 @@ is_zero() const {
   return coefficients_ == Coefficients{};
 }
 
+template<typename Value_, typename Argument_, int degree_,
+         template<typename, typename, int> typename Evaluator>
+typename PolynomialInMonomialBasis<Value_, Argument_, degree_, Evaluator>::
+    Coefficients const&
+PolynomialInMonomialBasis<Value_, Argument_, degree_, Evaluator>::
+coefficients() const {
+  return coefficients_;
+}
+
 template<typename Value_, typename Argument_, int degree_,
          template<typename, typename, int> typename Evaluator>
 Argument_ const&
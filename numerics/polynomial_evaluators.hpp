@@ -52,6 +52,13 @@ struct EstrinEvaluator {
   FORCE_INLINE(static) Derivative<Value, Argument>
   EvaluateDerivative(Coefficients const& coefficients,
                      Argument const& argument);
+  // Same as |Evaluate| and |EvaluateDerivative|, with identical results, but
+  // the squares of the argument are only computed once.
+  FORCE_INLINE(static) void EvaluateWithDerivative(
+      Coefficients const& coefficients,
+      Argument const& argument,
+      Value& value,
+      Derivative<Value, Argument>& derivative);
 };
 
 template<typename Value, typename Argument, int degree, bool allow_fma>
@@ -69,6 +76,13 @@ struct HornerEvaluator {
   FORCE_INLINE(static) Derivative<Value, Argument>
   EvaluateDerivative(Coefficients const& coefficients,
                      Argument const& argument);
+  // Same as |Evaluate| and |EvaluateDerivative|, with identical results, but
+  // the two independent recurrences are interleaved.
+  FORCE_INLINE(static) void EvaluateWithDerivative(
+      Coefficients const& coefficients,
+      Argument const& argument,
+      Value& value,
+      Derivative<Value, Argument>& derivative);
 };
 
 }  // namespace internal
@@ -297,6 +297,68 @@ EstrinEvaluator<Value, Argument, degree, allow_fma>::EvaluateDerivative(
   }
 }
 
+template<typename Value, typename Argument, int degree, bool allow_fma>
+FORCE_INLINE(inline) void
+EstrinEvaluator<Value, Argument, degree, allow_fma>::EvaluateWithDerivative(
+    Coefficients const& coefficients,
+    Argument const& argument,
+    Value& value,
+    Derivative<Value, Argument>& derivative) {
+  // The squares only depend on the overall |degree|, so the evaluators for the
+  // value and for the derivative use the same ones.
+  if (allow_fma && UseHardwareFMA) {
+    using InternalEvaluator = InternalEstrinEvaluator<Value,
+                                                      Argument,
+                                                      degree,
+                                                      /*fma=*/true,
+                                                      /*low=*/0,
+                                                      /*subdegree=*/degree>;
+    auto const argument_squares =
+        InternalEvaluator::ArgumentSquaresGenerator::Evaluate(argument);
+    value = InternalEvaluator::Evaluate(coefficients,
+                                        argument,
+                                        argument_squares);
+    if constexpr (degree == 0) {
+      derivative = Derivative<Value, Argument>{};
+    } else {
+      using InternalDerivativeEvaluator =
+          InternalEstrinEvaluator<Value,
+                                  Argument,
+                                  degree,
+                                  /*fma=*/true,
+                                  /*low=*/1,
+                                  /*subdegree=*/degree - 1>;
+      derivative = InternalDerivativeEvaluator::EvaluateDerivative(
+          coefficients, argument, argument_squares);
+    }
+  } else {
+    using InternalEvaluator = InternalEstrinEvaluator<Value,
+                                                      Argument,
+                                                      degree,
+                                                      /*fma=*/false,
+                                                      /*low=*/0,
+                                                      /*subdegree=*/degree>;
+    auto const argument_squares =
+        InternalEvaluator::ArgumentSquaresGenerator::Evaluate(argument);
+    value = InternalEvaluator::Evaluate(coefficients,
+                                        argument,
+                                        argument_squares);
+    if constexpr (degree == 0) {
+      derivative = Derivative<Value, Argument>{};
+    } else {
+      using InternalDerivativeEvaluator =
+          InternalEstrinEvaluator<Value,
+                                  Argument,
+                                  degree,
+                                  /*fma=*/false,
+                                  /*low=*/1,
+                                  /*subdegree=*/degree - 1>;
+      derivative = InternalDerivativeEvaluator::EvaluateDerivative(
+          coefficients, argument, argument_squares);
+    }
+  }
+}
+
 // Internal helper for Horner evaluation.  |degree| is the degree of the overall
 // polynomial, |low| defines the subpolynomial that we currently evaluate, i.e.,
 // the one with a constant term coefficient |std::get<low>(coefficients)|.
@@ -416,6 +478,19 @@ HornerEvaluator<Value, Argument, degree, allow_fma>::EvaluateDerivative(
   }
 }
 
+template<typename Value, typename Argument, int degree, bool allow_fma>
+FORCE_INLINE(inline) void
+HornerEvaluator<Value, Argument, degree, allow_fma>::EvaluateWithDerivative(
+    Coefficients const& coefficients,
+    Argument const& argument,
+    Value& value,
+    Derivative<Value, Argument>& derivative) {
+  // Everything is inlined, so the compiler is free to interleave the two
+  // recurrences, which hides the latency of each of them.
+  value = Evaluate(coefficients, argument);
+  derivative = EvaluateDerivative(coefficients, argument);
+}
+
 }  // namespace internal
 }  // namespace _polynomial_evaluators
 }  // namespace numerics
@@ -35,6 +35,17 @@ class PolynomialEvaluatorTest : public ::testing::Test {
       EXPECT_EQ(E::EvaluateDerivative(binomial_coefficients, argument),
                 degree * std::pow(argument + 1, degree - 1))
           << argument << " " << degree;
+      double value;
+      double derivative;
+      E::EvaluateWithDerivative(binomial_coefficients,
+                                argument,
+                                value,
+                                derivative);
+      EXPECT_EQ(value, E::Evaluate(binomial_coefficients, argument))
+          << argument << " " << degree;
+      EXPECT_EQ(derivative,
+                E::EvaluateDerivative(binomial_coefficients, argument))
+          << argument << " " << degree;
     }
   }
 };
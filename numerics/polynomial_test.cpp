@@ -10,6 +10,7 @@
 #include "gtest/gtest.h"
 #include "numerics/polynomial_evaluators.hpp"
 #include "quantities/constants.hpp"
+#include "quantities/elementary_functions.hpp"
 #include "quantities/named_quantities.hpp"
 #include "quantities/quantities.hpp"
 #include "quantities/si.hpp"
@@ -34,6 +35,7 @@ using namespace principia::geometry::_space;
 using namespace principia::numerics::_polynomial;
 using namespace principia::numerics::_polynomial_evaluators;
 using namespace principia::quantities::_constants;
+using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
@@ -156,6 +158,41 @@ TEST_F(PolynomialTest, Evaluate2P) {
 #endif
 }
 
+TEST_F(PolynomialTest, EvaluateWithDerivative) {
+  Instant const t0 = Instant() + 0.3 * Second;
+  P2P const p({World::origin + std::get<0>(coefficients_),
+               std::get<1>(coefficients_),
+               std::get<2>(coefficients_)},
+              t0);
+  Position<World> d;
+  Velocity<World> v;
+  p.EvaluateWithDerivative(t0 + 0.5 * Second, d, v);
+  EXPECT_EQ(p(t0 + 0.5 * Second), d);
+  EXPECT_EQ(p.EvaluateDerivative(t0 + 0.5 * Second), v);
+
+  // The evaluation through the base class gives the same results.
+  Polynomial<Position<World>, Instant> const& polynomial = p;
+  polynomial.EvaluateWithDerivative(t0 + 0.5 * Second, d, v);
+  EXPECT_EQ(p(t0 + 0.5 * Second), d);
+  EXPECT_EQ(p.EvaluateDerivative(t0 + 0.5 * Second), v);
+
+  using P17E = PolynomialInMonomialBasis<Displacement<World>, Time, 17,
+                                         EstrinEvaluator>;
+  P17E::Coefficients coefficients;
+  std::get<3>(coefficients) =
+      Displacement<World>({1 * Metre, -2 * Metre, 3 * Metre}) /
+      Pow<3>(Second);
+  std::get<17>(coefficients) =
+      Displacement<World>({-1 * Metre, 2 * Metre, 0.5 * Metre}) /
+      Pow<17>(Second);
+  P17E const p17(coefficients);
+  Displacement<World> d17;
+  Velocity<World> v17;
+  p17.EvaluateWithDerivative(1.1 * Second, d17, v17);
+  EXPECT_EQ(p17(1.1 * Second), d17);
+  EXPECT_EQ(p17.EvaluateDerivative(1.1 * Second), v17);
+}
+
 // Check that a polynomial of high order may be declared.
 TEST_F(PolynomialTest, Evaluate17) {
   P17::Coefficients const coefficients;
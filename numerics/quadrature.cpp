@@ -0,0 +1,91 @@
+#include "numerics/quadrature.hpp"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "base/bits.hpp"
+#include "geometry/complexification.hpp"
+#include "glog/logging.h"
+#include "numerics/fast_fourier_transform.hpp"
+#include "quantities/elementary_functions.hpp"
+#include "quantities/numbers.hpp"
+#include "quantities/si.hpp"
+
+namespace principia {
+namespace numerics {
+namespace _quadrature {
+namespace internal {
+
+using namespace principia::base::_bits;
+using namespace principia::geometry::_complexification;
+using namespace principia::numerics::_fast_fourier_transform;
+using namespace principia::quantities::_elementary_functions;
+using namespace principia::quantities::_si;
+
+namespace {
+
+std::unique_ptr<ClenshawCurtisRule const> MakeClenshawCurtisRule(
+    int const points) {
+  int const N = points - 1;
+  auto rule = std::make_unique<ClenshawCurtisRule>();
+  rule->nodes.reserve(points);
+  for (int s = 0; s <= N; ++s) {
+    rule->nodes.push_back(Cos(π * Radian * s / N));
+  }
+
+  // With the notation of |ClenshawCurtisImplementation|, the quadrature is
+  //   (1/N) Σʺ 1/(1 - n²) aₙ  for n even,
+  // where aₙ is the discrete Fourier transform of the values f(cos πs/N)
+  // extended to 2N points by symmetry.  Exchanging the sums, the weight of
+  // f(cos πs/N) is (gₛ/N) Σʺ 1/(1 - n²) cos πns/N, where gₛ is 1 at the ends
+  // and 2 elsewhere.  That sum is the discrete Fourier transform of the
+  // moments 1/(1 - n²) extended in the same way.
+  auto const plan = FourierTransformPlan::ForSize(2 * N);
+  std::vector<Complexification<double>> moments(2 * N);
+  for (int n = 0; n <= N; n += 2) {
+    moments[n] = 1.0 / (1 - n * n);
+    if (n > 0 && n < N) {
+      moments[2 * N - n] = moments[n];
+    }
+  }
+  plan->Transform(moments.data());
+
+  rule->weights.reserve(points);
+  for (int s = 0; s <= N; ++s) {
+    int const gₛ = s == 0 || s == N ? 1 : 2;
+    rule->weights.push_back(gₛ * moments[s].real_part() / N);
+  }
+  return rule;
+}
+
+}  // namespace
+
+not_null<ClenshawCurtisRule const*> ClenshawCurtisRuleForPoints(
+    int const points) {
+  CHECK_LE(2, points);
+  CHECK_EQ(points - 1, 1 << FloorLog2(points - 1))
+      << "Bad number of points " << points;
+  ABSL_CONST_INIT static absl::Mutex lock(absl::kConstInit);
+  static auto* const rules =
+      new std::map<int, std::unique_ptr<ClenshawCurtisRule const>>();
+  {
+    absl::ReaderMutexLock l(&lock);
+    auto const it = rules->find(points);
+    if (it != rules->end()) {
+      return check_not_null(it->second.get());
+    }
+  }
+  // Construct the rule outside of the lock.  If another thread constructed the
+  // same rule in the meantime, ours is dropped.
+  auto rule = MakeClenshawCurtisRule(points);
+  absl::MutexLock l(&lock);
+  auto const [it, _] = rules->emplace(points, std::move(rule));
+  return check_not_null(it->second.get());
+}
+
+}  // namespace internal
+}  // namespace _quadrature
+}  // namespace numerics
+}  // namespace principia
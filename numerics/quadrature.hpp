@@ -2,7 +2,11 @@
 
 #include <optional>
 #include <type_traits>
+#include <vector>
 
+#include "base/array.hpp"
+#include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "quantities/named_quantities.hpp"
 
 namespace principia {
@@ -10,6 +14,9 @@ namespace numerics {
 namespace _quadrature {
 namespace internal {
 
+using namespace principia::base::_array;
+using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
 
@@ -56,9 +63,59 @@ Primitive<std::invoke_result_t<Function, Argument>, Argument> Midpoint(
     Argument const& upper_bound,
     int intervals);
 
+// The nodes and weights of the Clenshaw-Curtis quadrature on N + 1 points: the
+// integral of f over [-1, 1] is approximated by Σ weights[s] f(nodes[s]) for
+// s ∈ [0, N], where nodes[s] = cos πs/N.
+struct ClenshawCurtisRule {
+  std::vector<double> nodes;
+  std::vector<double> weights;
+};
+
+// Returns the rule for the given number of points, which must be of the form
+// 2ᵖ + 1, computing it if necessary.  This function is thread-safe.  The rules
+// are never destroyed.
+not_null<ClenshawCurtisRule const*> ClenshawCurtisRuleForPoints(int points);
+
+// The following functions evaluate the integrand in batches: |f| is called as
+// |f(arguments, values)| with an |Array<Argument const>| and an |Array<Value>|
+// of the same size, and must set each element of |values| to the value of the
+// integrand at the corresponding element of |arguments|.  This lets the callee
+// amortize its overhead and vectorize.  If |thread_pool| is not null, large
+// batches are split and evaluated concurrently on it, so |f| must be
+// thread-safe; the result doesn't depend on the pool.
+
+// Gauss-Legendre quadrature with |points| points on each of |intervals|
+// subintervals of equal width.
+template<int points, typename Value, typename Argument, typename BatchFunction>
+Primitive<Value, Argument> BatchGaussLegendre(
+    BatchFunction const& f,
+    Argument const& lower_bound,
+    Argument const& upper_bound,
+    int intervals = 1,
+    ThreadPool<void>* thread_pool = nullptr);
+
+// Same as |AutomaticClenshawCurtis|, but each refinement only evaluates the
+// integrand at the new nodes, in a single batch, and uses the cached rule for
+// its number of points instead of a Fourier transform.
+template<typename Value,
+         int initial_points = 3,
+         typename Argument,
+         typename BatchFunction>
+Primitive<Value, Argument> BatchAutomaticClenshawCurtis(
+    BatchFunction const& f,
+    Argument const& lower_bound,
+    Argument const& upper_bound,
+    std::optional<double> max_relative_error,
+    std::optional<int> max_points,
+    ThreadPool<void>* thread_pool = nullptr);
+
 }  // namespace internal
 
 using internal::AutomaticClenshawCurtis;
+using internal::BatchAutomaticClenshawCurtis;
+using internal::BatchGaussLegendre;
+using internal::ClenshawCurtisRule;
+using internal::ClenshawCurtisRuleForPoints;
 using internal::GaussLegendre;
 using internal::MaxPointsHeuristicsForAutomaticClenshawCurtis;
 using internal::Midpoint;
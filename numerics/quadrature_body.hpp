@@ -3,6 +3,7 @@
 #include "numerics/quadrature.hpp"
 
 #include <algorithm>
+#include <future>
 #include <memory>
 #include <vector>
 
@@ -28,6 +29,10 @@ using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
+// The minimum number of evaluations of the integrand per thread when a batch is
+// split across a thread pool.  Smaller batches are not worth the overhead.
+constexpr std::int64_t min_evaluations_per_thread = 256;
+
 template<int points, typename Argument, typename Function>
 Primitive<std::invoke_result_t<Function, Argument>, Argument> Gauss(
     Function const& f,
@@ -53,6 +58,41 @@ void FillClenshawCurtisCache(
     std::vector<std::invoke_result_t<Function, Argument>>&
         f_cos_N⁻¹π_bit_reversed);
 
+// Evaluates |f| on |arguments|, storing the results in |values|, which must
+// have the same size.  The evaluation is split in contiguous chunks executed
+// on |thread_pool| if it is not null and there are enough |arguments|.
+template<typename Value, typename Argument, typename BatchFunction>
+void EvaluateBatch(BatchFunction const& f,
+                   std::vector<Argument> const& arguments,
+                   std::vector<Value>& values,
+                   ThreadPool<void>* const thread_pool) {
+  std::int64_t const size = arguments.size();
+  DCHECK_EQ(size, values.size());
+  std::int64_t const chunks =
+      thread_pool == nullptr
+          ? 1
+          : std::clamp(size / min_evaluations_per_thread,
+                       std::int64_t{1},
+                       thread_pool->size());
+  if (chunks == 1) {
+    f(Array<Argument const>(arguments), Array<Value>(values));
+    return;
+  }
+  std::vector<std::future<void>> futures;
+  futures.reserve(chunks);
+  for (std::int64_t i = 0; i < chunks; ++i) {
+    std::int64_t const begin = size * i / chunks;
+    std::int64_t const end = size * (i + 1) / chunks;
+    futures.push_back(thread_pool->Add([&arguments, begin, end, &f, &values]() {
+      f(Array<Argument const>(arguments.data() + begin, end - begin),
+        Array<Value>(values.data() + begin, end - begin));
+    }));
+  }
+  for (auto const& future : futures) {
+    future.wait();
+  }
+}
+
 template<int points, typename Argument, typename Function>
 Primitive<std::invoke_result_t<Function, Argument>, Argument>
 AutomaticClenshawCurtisImplementation(
@@ -297,6 +337,123 @@ Primitive<std::invoke_result_t<Function, Argument>, Argument> ClenshawCurtis(
       f, lower_bound, upper_bound, f_cos_N⁻¹π_bit_reversed);
 }
 
+template<int points, typename Value, typename Argument, typename BatchFunction>
+Primitive<Value, Argument> BatchGaussLegendre(
+    BatchFunction const& f,
+    Argument const& lower_bound,
+    Argument const& upper_bound,
+    int const intervals,
+    ThreadPool<void>* const thread_pool) {
+  static_assert(points < LegendreRoots.rows(),
+                "No table for Gauss-Legendre with the chosen number of points");
+  CHECK_LT(0, intervals);
+  double const* const nodes = LegendreRoots.row<points>();
+  double const* const weights = GaussLegendreWeights.row<points>();
+  Difference<Argument> const half_width =
+      (upper_bound - lower_bound) / (2 * intervals);
+
+  std::vector<Argument> arguments;
+  arguments.reserve(points * intervals);
+  for (int j = 0; j < intervals; ++j) {
+    Argument const interval_lower_bound =
+        lower_bound + (upper_bound - lower_bound) * j / intervals;
+    for (int i = 0; i < points; ++i) {
+      arguments.push_back(interval_lower_bound + half_width * (nodes[i] + 1));
+    }
+  }
+  std::vector<Value> values(arguments.size());
+  EvaluateBatch(f, arguments, values, thread_pool);
+
+  Value result{};
+  for (int j = 0; j < intervals; ++j) {
+    for (int i = 0; i < points; ++i) {
+      result += weights[i] * values[j * points + i];
+    }
+  }
+  return result * half_width;
+}
+
+template<typename Value,
+         int initial_points,
+         typename Argument,
+         typename BatchFunction>
+Primitive<Value, Argument> BatchAutomaticClenshawCurtis(
+    BatchFunction const& f,
+    Argument const& lower_bound,
+    Argument const& upper_bound,
+    std::optional<double> const max_relative_error,
+    std::optional<int> const max_points,
+    ThreadPool<void>* const thread_pool) {
+  using Result = Primitive<Value, Argument>;
+  static_assert(initial_points >= 2);
+  static_assert(initial_points - 1 == 1 << FloorLog2(initial_points - 1));
+
+  Difference<Argument> const half_width = (upper_bound - lower_bound) / 2;
+  auto const weighted_sum = [&half_width](ClenshawCurtisRule const& rule,
+                                          std::vector<Value> const& values) {
+    Value Σ{};
+    for (int s = 0; s < values.size(); ++s) {
+      Σ += rule.weights[s] * values[s];
+    }
+    return Σ * half_width;
+  };
+
+  // The values of the integrand at the nodes of the current rule, in the order
+  // of the nodes.
+  int points = initial_points;
+  auto rule = ClenshawCurtisRuleForPoints(points);
+  std::vector<Argument> arguments;
+  arguments.reserve(points);
+  for (double const node : rule->nodes) {
+    arguments.push_back(lower_bound + half_width * (1 + node));
+  }
+  std::vector<Value> values(points);
+  EvaluateBatch(f, arguments, values, thread_pool);
+  Result estimate = weighted_sum(*rule, values);
+
+  std::vector<Value> new_values;
+  for (;;) {
+    if (points > 1 << 24) {
+      LOG(FATAL) << "Too many refinements while integrating from "
+                 << lower_bound << " to " << upper_bound;
+    }
+
+    // Doubling N keeps the current nodes at the even indices, so we only need
+    // to evaluate the integrand at the odd indices.
+    int const new_points = 2 * points - 1;
+    rule = ClenshawCurtisRuleForPoints(new_points);
+    arguments.clear();
+    for (int s = 1; s < new_points; s += 2) {
+      arguments.push_back(lower_bound + half_width * (1 + rule->nodes[s]));
+    }
+    new_values.resize(arguments.size());
+    EvaluateBatch(f, arguments, new_values, thread_pool);
+
+    // Interleave the old and the new values.
+    values.resize(new_points);
+    for (int s = points - 1; s >= 0; --s) {
+      values[2 * s] = values[s];
+    }
+    for (int s = 1; s < new_points; s += 2) {
+      values[s] = new_values[s / 2];
+    }
+    points = new_points;
+
+    Result const new_estimate = weighted_sum(*rule, values);
+
+    // This is the naïve estimate mentioned in [Gen72b], p. 339.
+    auto const absolute_error_estimate =
+        Hilbert<Result>::Norm(new_estimate - estimate);
+    estimate = new_estimate;
+    if ((max_relative_error.has_value() &&
+         absolute_error_estimate <=
+             max_relative_error.value() * Hilbert<Result>::Norm(estimate)) ||
+        (max_points.has_value() && points >= max_points.value())) {
+      return estimate;
+    }
+  }
+}
+
 inline std::optional<int> MaxPointsHeuristicsForAutomaticClenshawCurtis(
     AngularFrequency const& max_ω,
     Time const& Δt,
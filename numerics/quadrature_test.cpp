@@ -1,7 +1,12 @@
 #include "numerics/quadrature.hpp"
 
+#include <atomic>
+#include <cmath>
 #include <limits>
+#include <vector>
 
+#include "base/array.hpp"
+#include "base/thread_pool.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "quantities/elementary_functions.hpp"
@@ -15,6 +20,8 @@ namespace quadrature {
 
 using ::testing::AnyOf;
 using ::testing::Eq;
+using namespace principia::base::_array;
+using namespace principia::base::_thread_pool;
 using namespace principia::numerics::_quadrature;
 using namespace principia::quantities::_elementary_functions;
 using namespace principia::quantities::_quantities;
@@ -130,6 +137,119 @@ TEST_F(QuadratureTest, Sin10) {
               AnyOf(Eq(32769), Eq(65537), Eq(262145), Eq(524289), Eq(1048577)));
 }
 
+TEST_F(QuadratureTest, ClenshawCurtisRule) {
+  // The rule integrates exactly the polynomials of degree up to N.
+  for (int const points : {2, 3, 5, 9, 17, 65, 1025}) {
+    auto const& rule = *ClenshawCurtisRuleForPoints(points);
+    int const N = points - 1;
+    for (int k = 0; k <= N; k += 2) {
+      double ʃxᵏ = 0;
+      for (int s = 0; s < points; ++s) {
+        ʃxᵏ += rule.weights[s] * std::pow(rule.nodes[s], k);
+      }
+      EXPECT_THAT(ʃxᵏ, AlmostEquals(2.0 / (k + 1), 0, 1000))
+          << points << " " << k;
+    }
+  }
+  // The rules are cached.
+  EXPECT_EQ(ClenshawCurtisRuleForPoints(17), ClenshawCurtisRuleForPoints(17));
+}
+
+TEST_F(QuadratureTest, BatchGaussLegendre) {
+  int evaluations = 0;
+  auto const f = [](Angle const x) { return Sin(x); };
+  auto const batch_f = [&evaluations](Array<Angle const> const x,
+                                      Array<double> const sin_x) {
+    ++evaluations;
+    for (std::int64_t i = 0; i < x.size; ++i) {
+      sin_x.data[i] = Sin(x.data[i]);
+    }
+  };
+  EXPECT_EQ((GaussLegendre<10>(f, -2.0 * Radian, 5.0 * Radian)),
+            (BatchGaussLegendre<10, double>(
+                batch_f, -2.0 * Radian, 5.0 * Radian)));
+  EXPECT_EQ(1, evaluations);
+
+  auto const ʃf = (Cos(2.0 * Radian) - Cos(5.0 * Radian)) * Radian;
+  EXPECT_THAT((BatchGaussLegendre<10, double>(batch_f,
+                                               -2.0 * Radian,
+                                               5.0 * Radian,
+                                               /*intervals=*/7)),
+              AlmostEquals(ʃf, 0, 10));
+}
+
+TEST_F(QuadratureTest, BatchAutomaticClenshawCurtis) {
+  std::atomic_int evaluations = 0;
+  auto const f = [](Angle const x) { return Sin(10 * x); };
+  auto const batch_f = [&evaluations](Array<Angle const> const x,
+                                      Array<double> const sin_10x) {
+    evaluations += x.size;
+    for (std::int64_t i = 0; i < x.size; ++i) {
+      sin_10x.data[i] = Sin(10 * x.data[i]);
+    }
+  };
+  auto const ʃf = (Cos(20 * Radian) - Cos(50 * Radian)) / 10 * Radian;
+
+  auto const sequential = BatchAutomaticClenshawCurtis<double>(
+      batch_f,
+      -2.0 * Radian,
+      5.0 * Radian,
+      /*max_relative_error=*/1e-14,
+      /*max_points=*/std::nullopt);
+  EXPECT_THAT(sequential, AlmostEquals(ʃf, 263));
+  EXPECT_THAT(AutomaticClenshawCurtis(f,
+                                      -2.0 * Radian,
+                                      5.0 * Radian,
+                                      /*max_relative_error=*/1e-14,
+                                      /*max_points=*/std::nullopt),
+              AlmostEquals(sequential, 14));
+  EXPECT_EQ(129, evaluations);
+
+  // The result doesn't depend on the thread pool.
+  evaluations = 0;
+  ThreadPool<void> pool(/*pool_size=*/4);
+  EXPECT_EQ(sequential,
+            BatchAutomaticClenshawCurtis<double>(
+                batch_f,
+                -2.0 * Radian,
+                5.0 * Radian,
+                /*max_relative_error=*/1e-14,
+                /*max_points=*/std::nullopt,
+                &pool));
+  EXPECT_EQ(129, evaluations);
+
+  // Same number of evaluations as the non-batch version.  Note that the weights
+  // are not computed in the same way, so with a tolerance close to ε the
+  // rounding errors may cause a different number of refinements.
+  int non_batch_evaluations = 0;
+  auto const g = [&non_batch_evaluations](Angle const x) {
+    ++non_batch_evaluations;
+    return Sin(x);
+  };
+  auto const batch_g = [&evaluations](Array<Angle const> const x,
+                                      Array<double> const sin_x) {
+    evaluations += x.size;
+    for (std::int64_t i = 0; i < x.size; ++i) {
+      sin_x.data[i] = Sin(x.data[i]);
+    }
+  };
+  evaluations = 0;
+  auto const ʃg = (Cos(2.0 * Radian) - Cos(5.0 * Radian)) * Radian;
+  EXPECT_THAT(BatchAutomaticClenshawCurtis<double>(
+                  batch_g,
+                  -2.0 * Radian,
+                  5.0 * Radian,
+                  /*max_relative_error=*/1e-12,
+                  /*max_points=*/std::nullopt),
+              AlmostEquals(ʃg, 0, 4));
+  AutomaticClenshawCurtis(g,
+                          -2.0 * Radian,
+                          5.0 * Radian,
+                          /*max_relative_error=*/1e-12,
+                          /*max_points=*/std::nullopt);
+  EXPECT_EQ(non_batch_evaluations, evaluations);
+}
+
 }  // namespace quadrature
 }  // namespace numerics
 }  // namespace principia
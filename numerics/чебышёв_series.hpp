@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstdint>
+#include <utility>
 #include <vector>
 
+#include "base/not_null.hpp"
 #include "geometry/instant.hpp"
 #include "quantities/quantities.hpp"
 #include "serialization/numerics.pb.h"
@@ -31,6 +34,14 @@ class EvaluationHelper final {
   EvaluationHelper& operator=(EvaluationHelper&& other) = default;
 
   Vector EvaluateImplementation(double scaled_t) const;
+  // Evaluates at the |count| arguments |scaled_t| and stores the results in
+  // |values|.
+  void EvaluateImplementation(double const* scaled_t,
+                              std::int64_t count,
+                              Vector* values) const;
+  // Returns the value and the derivative with respect to |scaled_t|.
+  std::pair<Vector, Vector> EvaluateWithDerivativeImplementation(
+      double scaled_t) const;
 
   Vector coefficients(int index) const;
   int degree() const;
@@ -68,11 +79,26 @@ class ЧебышёвSeries final {
   Vector Evaluate(Instant const& t) const;
   Variation<Vector> EvaluateDerivative(Instant const& t) const;
 
+  // Same as above, but for all the |times|; the results are stored in
+  // |values|, which is resized.  For values in R³, the times are processed
+  // several at once using AVX2 and FMA if available, in which case the results
+  // may differ in the last bits from those of the single-time |Evaluate|.
+  void Evaluate(std::vector<Instant> const& times,
+                not_null<std::vector<Vector>*> values) const;
+
+  // Returns the value and the derivative at |t|, computed together.  The same
+  // remark as above applies to values in R³.
+  std::pair<Vector, Variation<Vector>> EvaluateWithDerivative(
+      Instant const& t) const;
+
   void WriteToMessage(not_null<serialization::ЧебышёвSeries*> message) const;
   static ЧебышёвSeries ReadFromMessage(
       serialization::ЧебышёвSeries const& message);
 
  private:
+  // Maps [t_min, t_max] to [-1, 1].
+  double ScaledTime(Instant const& t) const;
+
   Instant t_min_;
   Instant t_max_;
   Inverse<Time> one_over_duration_;
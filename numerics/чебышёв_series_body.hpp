@@ -1,11 +1,14 @@
 #include "numerics/чебышёв_series.hpp"
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "geometry/grassmann.hpp"
 #include "geometry/r3_element.hpp"
 #include "geometry/serialization.hpp"
 #include "glog/logging.h"
+#include "numerics/clenshaw.hpp"
 #include "numerics/fixed_arrays.hpp"
 #include "numerics/newhall.mathematica.h"
 
@@ -17,8 +20,48 @@ namespace internal {
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_r3_element;
 using namespace principia::geometry::_serialization;
+using namespace principia::numerics::_clenshaw;
 using namespace principia::quantities::_si;
 
+// The number of arguments that the batch evaluations process in one go, which
+// lets them use buffers on the stack.
+constexpr std::int64_t evaluation_chunk_size = 64;
+
+// Returns the value and the derivative with respect to |scaled_t| of the series
+// with the given |coefficients|, running the Clenshaw recurrences for Tₖ and
+// (for the derivative) Uₖ side by side.
+template<typename Vector>
+std::pair<Vector, Vector> ClenshawWithDerivative(
+    std::vector<Vector> const& coefficients,
+    int const degree,
+    double const scaled_t) {
+  double const two_scaled_t = scaled_t + scaled_t;
+  Vector b_kplus1{};
+  Vector b_kplus2{};
+  Vector d_kplus1{};
+  Vector d_kplus2{};
+  for (int k = degree; k >= 1; --k) {
+    // b_k = c_k + 2 t b_k+1 - b_k+2.
+    Vector const b_k = coefficients[k] + two_scaled_t * b_kplus1 - b_kplus2;
+    b_kplus2 = b_kplus1;
+    b_kplus1 = b_k;
+    if (k < degree) {
+      // d_k = (k + 1) c_k+1 + 2 t d_k+1 - d_k+2.
+      Vector const d_k = coefficients[k + 1] * (k + 1) +
+                         two_scaled_t * d_kplus1 - d_kplus2;
+      d_kplus2 = d_kplus1;
+      d_kplus1 = d_k;
+    }
+  }
+  // c_0 + t b_1 - b_2.
+  Vector const value = coefficients[0] + scaled_t * b_kplus1 - b_kplus2;
+  if (degree == 0) {
+    return {value, Vector{}};
+  }
+  // c_1 + 2 t d_1 - d_2.
+  return {value, coefficients[1] + two_scaled_t * d_kplus1 - d_kplus2};
+}
+
 // The compiler does a much better job on an |R3Element<double>| than on a
 // |Vector<Quantity>| so we specialize this case.
 template<typename Scalar, typename Frame, int rank>
@@ -32,11 +75,18 @@ class EvaluationHelper<Multivector<Scalar, Frame, rank>> final {
 
   Multivector<Scalar, Frame, rank> EvaluateImplementation(
       double scaled_t) const;
+  void EvaluateImplementation(double const* scaled_t,
+                              std::int64_t count,
+                              Multivector<Scalar, Frame, rank>* values) const;
+  std::pair<Multivector<Scalar, Frame, rank>, Multivector<Scalar, Frame, rank>>
+  EvaluateWithDerivativeImplementation(double scaled_t) const;
 
   Multivector<Scalar, Frame, rank> coefficients(int index) const;
   int degree() const;
 
  private:
+  // Each |R3Element| holds interleaved x, y, z doubles, and is padded to 32
+  // bytes, which is the layout expected by the vectorized Clenshaw.
   std::vector<R3Element<double>> coefficients_;
   int degree_;
 };
@@ -80,6 +130,23 @@ Vector EvaluationHelper<Vector>::EvaluateImplementation(
   }
 }
 
+template<typename Vector>
+void EvaluationHelper<Vector>::EvaluateImplementation(
+    double const* const scaled_t,
+    std::int64_t const count,
+    Vector* const values) const {
+  for (std::int64_t i = 0; i < count; ++i) {
+    values[i] = EvaluateImplementation(scaled_t[i]);
+  }
+}
+
+template<typename Vector>
+std::pair<Vector, Vector>
+EvaluationHelper<Vector>::EvaluateWithDerivativeImplementation(
+    double const scaled_t) const {
+  return ClenshawWithDerivative(coefficients_, degree_, scaled_t);
+}
+
 template<typename Vector>
 Vector EvaluationHelper<Vector>::coefficients(int const index) const {
   return coefficients_[index];
@@ -143,6 +210,46 @@ EvaluationHelper<Multivector<Scalar, Frame, rank>>::EvaluateImplementation(
     }
 }
 
+template<typename Scalar, typename Frame, int rank>
+void EvaluationHelper<Multivector<Scalar, Frame, rank>>::EvaluateImplementation(
+    double const* const scaled_t,
+    std::int64_t const count,
+    Multivector<Scalar, Frame, rank>* const values) const {
+  if (!UseVectorizedClenshaw || count < clenshaw_minimum_count) {
+    for (std::int64_t i = 0; i < count; ++i) {
+      values[i] = EvaluateImplementation(scaled_t[i]);
+    }
+    return;
+  }
+  // A small buffer is cheaper to construct than one for an entire chunk.
+  R3Element<double> results[clenshaw_group_size];
+  for (std::int64_t i = 0; i < count; i += clenshaw_group_size) {
+    std::int64_t const n = std::min(clenshaw_group_size, count - i);
+    EvaluateClenshaw(coefficients_.data(), degree_, &scaled_t[i], n, results);
+    for (std::int64_t j = 0; j < n; ++j) {
+      values[i + j] =
+          Multivector<double, Frame, rank>(results[j]) * si::Unit<Scalar>;
+    }
+  }
+}
+
+template<typename Scalar, typename Frame, int rank>
+std::pair<Multivector<Scalar, Frame, rank>, Multivector<Scalar, Frame, rank>>
+EvaluationHelper<Multivector<Scalar, Frame, rank>>::
+EvaluateWithDerivativeImplementation(double const scaled_t) const {
+  R3Element<double> value;
+  R3Element<double> derivative;
+  if (UseVectorizedClenshaw) {
+    EvaluateClenshawWithDerivative(
+        coefficients_.data(), degree_, scaled_t, value, derivative);
+  } else {
+    std::tie(value, derivative) =
+        ClenshawWithDerivative(coefficients_, degree_, scaled_t);
+  }
+  return {Multivector<double, Frame, rank>(value) * si::Unit<Scalar>,
+          Multivector<double, Frame, rank>(derivative) * si::Unit<Scalar>};
+}
+
 template<typename Scalar, typename Frame, int rank>
 Multivector<Scalar, Frame, rank>
 EvaluationHelper<Multivector<Scalar, Frame, rank>>::coefficients(
@@ -208,31 +315,14 @@ int ЧебышёвSeries<Vector>::degree() const {
 
 template<typename Vector>
 Vector ЧебышёвSeries<Vector>::Evaluate(Instant const& t) const {
-  // This formula ensures continuity at the edges by producing -1 or +1 within
-  // 2 ulps for |t_min_| and |t_max_|.
-  double const scaled_t = ((t - t_max_) + (t - t_min_)) * one_over_duration_;
-  // We have to allow |scaled_t| to go slightly out of [-1, 1] because of
-  // computation errors.  But if it goes too far, something is broken.
-  // TODO(phl): This should use DCHECK but these macros don't work because the
-  // Principia projects don't define NDEBUG.
-#ifdef _DEBUG
-  CHECK_LE(scaled_t, 1.1);
-  CHECK_GE(scaled_t, -1.1);
-#endif
-
-  return helper_.EvaluateImplementation(scaled_t);
+  return helper_.EvaluateImplementation(ScaledTime(t));
 }
 
 template<typename Vector>
 Variation<Vector> ЧебышёвSeries<Vector>::EvaluateDerivative(
     Instant const& t) const {
-  // See comments above.
-  double const scaled_t = ((t - t_max_) + (t - t_min_)) * one_over_duration_;
+  double const scaled_t = ScaledTime(t);
   double const two_scaled_t = scaled_t + scaled_t;
-#ifdef _DEBUG
-  CHECK_LE(scaled_t, 1.1);
-  CHECK_GE(scaled_t, -1.1);
-#endif
 
   Vector b_kplus2_vector{};
   Vector b_kplus1_vector{};
@@ -250,6 +340,30 @@ Variation<Vector> ЧебышёвSeries<Vector>::EvaluateDerivative(
              (one_over_duration_ + one_over_duration_);
 }
 
+template<typename Vector>
+void ЧебышёвSeries<Vector>::Evaluate(
+    std::vector<Instant> const& times,
+    not_null<std::vector<Vector>*> const values) const {
+  std::int64_t const size = times.size();
+  values->resize(size);
+  double scaled_t[evaluation_chunk_size];
+  for (std::int64_t i = 0; i < size; i += evaluation_chunk_size) {
+    std::int64_t const n = std::min(evaluation_chunk_size, size - i);
+    for (std::int64_t j = 0; j < n; ++j) {
+      scaled_t[j] = ScaledTime(times[i + j]);
+    }
+    helper_.EvaluateImplementation(scaled_t, n, &(*values)[i]);
+  }
+}
+
+template<typename Vector>
+auto ЧебышёвSeries<Vector>::EvaluateWithDerivative(Instant const& t) const
+    -> std::pair<Vector, Variation<Vector>> {
+  auto const [value, scaled_derivative] =
+      helper_.EvaluateWithDerivativeImplementation(ScaledTime(t));
+  return {value, scaled_derivative * (one_over_duration_ + one_over_duration_)};
+}
+
 template<typename Vector>
 void ЧебышёвSeries<Vector>::WriteToMessage(
     not_null<serialization::ЧебышёвSeries*> const message) const {
@@ -282,6 +396,22 @@ template<typename Vector>
                        Instant::ReadFromMessage(message.t_max()));
 }
 
+template<typename Vector>
+double ЧебышёвSeries<Vector>::ScaledTime(Instant const& t) const {
+  // This formula ensures continuity at the edges by producing -1 or +1 within
+  // 2 ulps for |t_min_| and |t_max_|.
+  double const scaled_t = ((t - t_max_) + (t - t_min_)) * one_over_duration_;
+  // We have to allow |scaled_t| to go slightly out of [-1, 1] because of
+  // computation errors.  But if it goes too far, something is broken.
+  // TODO(phl): This should use DCHECK but these macros don't work because the
+  // Principia projects don't define NDEBUG.
+#ifdef _DEBUG
+  CHECK_LE(scaled_t, 1.1);
+  CHECK_GE(scaled_t, -1.1);
+#endif
+  return scaled_t;
+}
+
 }  // namespace internal
 }  // namespace _чебышёв_series
 }  // namespace numerics
@@ -1,23 +1,31 @@
 #include "numerics/чебышёв_series.hpp"
 
+#include <cstdint>
+#include <vector>
+
 #include "astronomy/frames.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
+#include "geometry/space.hpp"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include "quantities/named_quantities.hpp"
 #include "quantities/si.hpp"
+#include "testing_utilities/numerics_matchers.hpp"
 
 namespace principia {
 namespace numerics {
 
+using ::testing::Lt;
 using namespace principia::astronomy::_frames;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
+using namespace principia::geometry::_space;
 using namespace principia::numerics::_чебышёв_series;
 using namespace principia::quantities::_named_quantities;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_numerics_matchers;
 
 class ЧебышёвSeriesTest : public ::testing::Test {
  protected:
@@ -131,6 +139,77 @@ TEST_F(ЧебышёвSeriesTest, X6Vector) {
             x6.Evaluate(t0_ + 3 * Second));
 }
 
+TEST_F(ЧебышёвSeriesTest, BatchEvaluation) {
+  using V = Displacement<ICRS>;
+  std::vector<V> coefficients;
+  for (int k = 0; k <= 13; ++k) {
+    coefficients.push_back(
+        V({1.0 / (k + 1) * Metre, -3.0 / (k + 2) * Metre, k * Metre}));
+  }
+  ЧебышёвSeries<V> const series(coefficients, t_min_, t_max_);
+  ЧебышёвSeries<double> const scalar_series({7, 8, -1, 3}, t_min_, t_max_);
+
+  // A size that exercises the full groups, the padded remainder and more than
+  // one chunk.
+  std::vector<Instant> times;
+  for (int i = 0; i <= 100; ++i) {
+    times.push_back(t_min_ + i * (t_max_ - t_min_) / 100);
+  }
+  std::vector<V> values;
+  series.Evaluate(times, &values);
+  std::vector<double> scalar_values;
+  scalar_series.Evaluate(times, &scalar_values);
+  ASSERT_EQ(times.size(), values.size());
+  ASSERT_EQ(times.size(), scalar_values.size());
+  for (std::int64_t i = 0; i < times.size(); ++i) {
+    // The vectorized algorithm uses fused operations, so it may differ from
+    // the scalar one in the last bits.
+    EXPECT_THAT(values[i],
+                AbsoluteErrorFrom(series.Evaluate(times[i]),
+                                  Lt(1e-13 * Metre)))
+        << i;
+    EXPECT_EQ(scalar_series.Evaluate(times[i]), scalar_values[i]) << i;
+  }
+
+  series.Evaluate({}, &values);
+  EXPECT_TRUE(values.empty());
+}
+
+TEST_F(ЧебышёвSeriesTest, EvaluateWithDerivative) {
+  using V = Displacement<ICRS>;
+  for (int degree = 0; degree <= 13; ++degree) {
+    std::vector<V> coefficients;
+    for (int k = 0; k <= degree; ++k) {
+      coefficients.push_back(
+          V({1.0 / (k + 1) * Metre, -3.0 / (k + 2) * Metre, k * Metre}));
+    }
+    ЧебышёвSeries<V> const series(coefficients, t_min_, t_max_);
+    for (int i = 0; i <= 10; ++i) {
+      Instant const t = t_min_ + i * (t_max_ - t_min_) / 10;
+      auto const [value, derivative] = series.EvaluateWithDerivative(t);
+      EXPECT_THAT(value,
+                  AbsoluteErrorFrom(series.Evaluate(t), Lt(1e-13 * Metre)))
+          << degree << " " << i;
+      if (degree == 0) {
+        EXPECT_EQ(Velocity<ICRS>(), derivative);
+      } else {
+        EXPECT_THAT(derivative,
+                    AbsoluteErrorFrom(series.EvaluateDerivative(t),
+                                      Lt(1e-12 * Metre / Second)))
+            << degree << " " << i;
+      }
+    }
+  }
+
+  ЧебышёвSeries<double> const x5(
+      {0.0, 10.0 / 16.0, 0, 5.0 / 16.0, 0, 1.0 / 16.0}, t_min_, t_max_);
+  for (Instant const t : {t_min_, t0_ + 1 * Second, t0_ + 2 * Second}) {
+    auto const [value, derivative] = x5.EvaluateWithDerivative(t);
+    EXPECT_EQ(x5.Evaluate(t), value);
+    EXPECT_EQ(x5.EvaluateDerivative(t), derivative);
+  }
+}
+
 TEST_F(ЧебышёвSeriesDeathTest, SerializationError) {
   ЧебышёвSeries<Speed> v({1 * Metre / Second,
                           -2 * Metre / Second,
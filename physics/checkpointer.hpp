@@ -117,6 +117,12 @@ class Checkpointer {
   void WriteToMessage(not_null<google::protobuf::RepeatedPtrField<
                           typename Message::Checkpoint>*> message) const
       EXCLUDES(lock_);
+  // Same as above, but only the checkpoints strictly after |after| are
+  // written.  Since checkpoints are never modified, this is sufficient to write
+  // the changes since an earlier serialization.
+  void WriteToMessage(not_null<google::protobuf::RepeatedPtrField<
+                          typename Message::Checkpoint>*> message,
+                      Instant const& after) const EXCLUDES(lock_);
   static not_null<std::unique_ptr<Checkpointer>> ReadFromMessage(
       Writer writer,
       Reader reader,
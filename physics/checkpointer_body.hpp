@@ -200,8 +200,19 @@ template<typename Message>
 void Checkpointer<Message>::WriteToMessage(
     not_null<google::protobuf::RepeatedPtrField<typename Message::Checkpoint>*>
         message) const {
+  WriteToMessage(message, /*after=*/InfinitePast);
+}
+
+template<typename Message>
+void Checkpointer<Message>::WriteToMessage(
+    not_null<google::protobuf::RepeatedPtrField<typename Message::Checkpoint>*>
+        message,
+    Instant const& after) const {
   absl::ReaderMutexLock l(&lock_);
-  for (const auto [time, checkpoint] : checkpoints_) {
+  for (auto it = checkpoints_.upper_bound(after);
+       it != checkpoints_.end();
+       ++it) {
+    auto const& [time, checkpoint] = *it;
     typename Message::Checkpoint* const message_checkpoint = message->Add();
     *message_checkpoint = checkpoint;
     time.WriteToMessage(message_checkpoint->mutable_time());
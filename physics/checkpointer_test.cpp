@@ -236,5 +236,27 @@ TEST_F(CheckpointerTest, Serialization) {
   EXPECT_EQ(Instant() + 10 * Second, checkpointer->oldest_checkpoint());
 }
 
+TEST_F(CheckpointerTest, SerializationAfter) {
+  Instant t = Instant() + 10 * Second;
+  EXPECT_CALL(writer_, Call(_)).Times(3);
+  checkpointer_.WriteToCheckpoint(t);
+  t += 13 * Second;
+  checkpointer_.WriteToCheckpoint(t);
+  t += 5 * Second;
+  checkpointer_.WriteToCheckpoint(t);
+
+  Message m1;
+  checkpointer_.WriteToMessage(&m1.checkpoint,
+                               /*after=*/Instant() + 10 * Second);
+  EXPECT_EQ(2, m1.checkpoint.size());
+  EXPECT_EQ(23, m1.checkpoint[0].time().scalar().magnitude());
+  EXPECT_EQ(28, m1.checkpoint[1].time().scalar().magnitude());
+
+  Message m2;
+  checkpointer_.WriteToMessage(&m2.checkpoint,
+                               /*after=*/Instant() + 28 * Second);
+  EXPECT_THAT(m2.checkpoint, IsEmpty());
+}
+
 }  // namespace physics
 }  // namespace principia
@@ -7,6 +7,7 @@
 
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
+#include "base/array.hpp"
 #include "base/not_null.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/space.hpp"
@@ -28,6 +29,7 @@ class TestableContinuousTrajectory;
 namespace _continuous_trajectory {
 namespace internal {
 
+using namespace principia::base::_array;
 using namespace principia::base::_not_null;
 using namespace principia::base::_traits;
 using namespace principia::geometry::_instant;
@@ -129,6 +131,26 @@ class ContinuousTrajectory : public Trajectory<Frame> {
       Instant const& desired_t_min,
       serialization::ContinuousTrajectory const& message);
 
+  // Same as above, but the polynomials are not written to |message|.  Instead
+  // they are appended to |polynomials|, each as its |t_max| in seconds since
+  // |Instant{}|, its degree, its origin in seconds since |Instant{}|, and the
+  // coordinates of its coefficients in SI units.  Only the checkpoints and the
+  // polynomials that are strictly after |after| are written: this is used to
+  // write the changes since an earlier serialization, the other ones being
+  // unchanged.
+  void WriteToMessage(not_null<serialization::ContinuousTrajectory*> message,
+                      Instant const& after,
+                      std::vector<double>& polynomials) const EXCLUDES(lock_);
+  // Same as above, for a |message| written without its polynomials.  They are
+  // read from the concatenation of |polynomials|, each array holding entire
+  // polynomials.  The arrays are not retained.
+  template<typename F = Frame,
+           typename = std::enable_if_t<is_serializable_v<F>>>
+  static not_null<std::unique_ptr<ContinuousTrajectory>> ReadFromMessage(
+      Instant const& desired_t_min,
+      serialization::ContinuousTrajectory const& message,
+      std::vector<Array<double const>> const& polynomials);
+
   // These members call the corresponding functions of the internal
   // checkpointer.
   void WriteToCheckpoint(Instant const& t) const;
@@ -180,6 +202,30 @@ class ContinuousTrajectory : public Trajectory<Frame> {
   };
   using InstantPolynomialPairs = std::vector<InstantPolynomialPair>;
 
+  // Implementation of serialization.  If |polynomials| is null, the
+  // polynomials are written to |message|.
+  void WriteToMessage(not_null<serialization::ContinuousTrajectory*> message,
+                      Instant const& after,
+                      std::vector<double>* polynomials) const EXCLUDES(lock_);
+  // Implementation of deserialization.  If |polynomials| is null, the
+  // polynomials are read from |message|.
+  static not_null<std::unique_ptr<ContinuousTrajectory>> ReadFromMessage(
+      Instant const& desired_t_min,
+      serialization::ContinuousTrajectory const& message,
+      std::vector<Array<double const>> const* polynomials);
+
+  // Appends the origin and the coefficients of |polynomial|, which must have
+  // the given |degree|, to |polynomials|.
+  template<int degree>
+  static void WritePolynomialCoefficients(
+      Polynomial<Position<Frame>, Instant> const& polynomial,
+      std::vector<double>& polynomials);
+  // Reads a polynomial of the given |degree| from its origin and coefficients,
+  // starting at |doubles|.
+  template<int degree>
+  static not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
+  ReadPolynomialCoefficients(double const* doubles);
+
   // Really a static method, but may be overridden for testing.
   virtual not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
   NewhallApproximationInMonomialBasis(
@@ -9,6 +9,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/for_all_of.hpp"
 #include "base/status_utilities.hpp"
 #include "geometry/interval.hpp"
 #include "glog/stl_logging.h"
@@ -22,6 +23,7 @@ namespace physics {
 namespace _continuous_trajectory {
 namespace internal {
 
+using namespace principia::base::_for_all_of;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_interval;
 using namespace principia::numerics::_newhall;
@@ -328,12 +330,58 @@ ContinuousTrajectory<Frame>::ToPiecewisePoissonSeries(
 #undef PRINCIPIA_CAST_TO_POLYNOMIAL_IN_MONOMIAL_BASIS
 #endif
 
+#define PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(value)                   \
+  case value:                                                           \
+    WritePolynomialCoefficients<value>(*polynomial, *polynomials);      \
+    break
+
+#define PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(value)                    \
+  case value:                                                           \
+    continuous_trajectory->polynomials_.emplace_back(                   \
+        t_max, ReadPolynomialCoefficients<value>(coefficients));        \
+    break
+
 template<typename Frame>
 void ContinuousTrajectory<Frame>::WriteToMessage(
       not_null<serialization::ContinuousTrajectory*> const message) const {
+  WriteToMessage(message, /*after=*/InfinitePast, /*polynomials=*/nullptr);
+}
+
+template<typename Frame>
+template<typename, typename>
+not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>
+ContinuousTrajectory<Frame>::ReadFromMessage(
+    Instant const& desired_t_min,
+    serialization::ContinuousTrajectory const& message) {
+  return ReadFromMessage(desired_t_min, message, /*polynomials=*/nullptr);
+}
+
+template<typename Frame>
+void ContinuousTrajectory<Frame>::WriteToMessage(
+    not_null<serialization::ContinuousTrajectory*> const message,
+    Instant const& after,
+    std::vector<double>& polynomials) const {
+  WriteToMessage(message, after, &polynomials);
+}
+
+template<typename Frame>
+template<typename, typename>
+not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>
+ContinuousTrajectory<Frame>::ReadFromMessage(
+    Instant const& desired_t_min,
+    serialization::ContinuousTrajectory const& message,
+    std::vector<Array<double const>> const& polynomials) {
+  return ReadFromMessage(desired_t_min, message, &polynomials);
+}
+
+template<typename Frame>
+void ContinuousTrajectory<Frame>::WriteToMessage(
+    not_null<serialization::ContinuousTrajectory*> const message,
+    Instant const& after,
+    std::vector<double>* const polynomials) const {
   absl::ReaderMutexLock l(&lock_);
   CHECK_LT(checkpointer_->oldest_checkpoint(), InfiniteFuture);
-  checkpointer_->WriteToMessage(message->mutable_checkpoint());
+  checkpointer_->WriteToMessage(message->mutable_checkpoint(), after);
   step_.WriteToMessage(message->mutable_step());
   tolerance_.WriteToMessage(message->mutable_tolerance());
 
@@ -345,10 +393,38 @@ void ContinuousTrajectory<Frame>::WriteToMessage(
   for (auto const& pair : polynomials_) {
     Instant const& t_max = pair.t_max;
     auto const& polynomial = pair.polynomial;
-    if (t_max <= checkpointer_->oldest_checkpoint()) {
-      auto* const pair = message->add_instant_polynomial_pair();
-      t_max.WriteToMessage(pair->mutable_t_max());
-      polynomial->WriteToMessage(pair->mutable_polynomial());
+    if (t_max <= after) {
+      continue;
+    } else if (t_max <= checkpointer_->oldest_checkpoint()) {
+      if (polynomials == nullptr) {
+        auto* const pair = message->add_instant_polynomial_pair();
+        t_max.WriteToMessage(pair->mutable_t_max());
+        polynomial->WriteToMessage(pair->mutable_polynomial());
+      } else {
+        polynomials->push_back((t_max - Instant{}) / Second);
+        polynomials->push_back(polynomial->degree());
+        switch (polynomial->degree()) {
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(1);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(2);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(3);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(4);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(5);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(6);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(7);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(8);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(9);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(10);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(11);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(12);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(13);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(14);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(15);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(16);
+          PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE(17);
+          default:
+            LOG(FATAL) << "Unexpected degree " << polynomial->degree();
+        }
+      }
     } else {
       break;
     }
@@ -359,11 +435,11 @@ void ContinuousTrajectory<Frame>::WriteToMessage(
 }
 
 template<typename Frame>
-template<typename, typename>
 not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>
 ContinuousTrajectory<Frame>::ReadFromMessage(
     Instant const& desired_t_min,
-    serialization::ContinuousTrajectory const& message) {
+    serialization::ContinuousTrajectory const& message,
+    std::vector<Array<double const>> const* const polynomials) {
   bool const is_pre_cohen = message.series_size() > 0;
   bool const is_pre_fatou = !message.has_checkpoint_time();
   bool const is_pre_grassmann = message.has_adjusted_tolerance() &&
@@ -410,6 +486,38 @@ ContinuousTrajectory<Frame>::ReadFromMessage(
               series.t_min(), series.t_max(),
               error_estimate));
     }
+  } else if (polynomials != nullptr) {
+    CHECK_EQ(0, message.instant_polynomial_pair_size());
+    for (auto const& array : *polynomials) {
+      for (std::int64_t i = 0; i < array.size;) {
+        Instant const t_max = Instant{} + array.data[i] * Second;
+        int const degree = array.data[i + 1];
+        double const* const coefficients = &array.data[i + 2];
+        i += 2 + 1 + 3 * (degree + 1);
+        CHECK_LE(i, array.size);
+        switch (degree) {
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(1);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(2);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(3);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(4);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(5);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(6);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(7);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(8);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(9);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(10);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(11);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(12);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(13);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(14);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(15);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(16);
+          PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE(17);
+          default:
+            LOG(FATAL) << "Unexpected degree " << degree;
+        }
+      }
+    }
   } else {
     for (auto const& pair : message.instant_polynomial_pair()) {
       if (is_pre_gröbner) {
@@ -486,6 +594,9 @@ ContinuousTrajectory<Frame>::ReadFromMessage(
   return continuous_trajectory;
 }
 
+#undef PRINCIPIA_POLYNOMIAL_DEGREE_READ_CASE
+#undef PRINCIPIA_POLYNOMIAL_DEGREE_WRITE_CASE
+
 template<typename Frame>
 void ContinuousTrajectory<Frame>::WriteToCheckpoint(Instant const& t) const {
   checkpointer_->WriteToCheckpoint(t);
@@ -627,8 +738,10 @@ ContinuousTrajectory<Frame>::EvaluateDegreesOfFreedomLocked(
   auto const it = FindPolynomialForInstantLocked(time);
   CHECK(it != polynomials_.end());
   auto const& polynomial = *it->polynomial;
-  return DegreesOfFreedom<Frame>(polynomial(time),
-                                 polynomial.EvaluateDerivative(time));
+  Position<Frame> position;
+  Velocity<Frame> velocity;
+  polynomial.EvaluateWithDerivative(time, position, velocity);
+  return DegreesOfFreedom<Frame>(position, velocity);
 }
 
 template<typename Frame>
@@ -647,6 +760,60 @@ ContinuousTrajectory<Frame>::InstantPolynomialPair::InstantPolynomialPair(
     : t_max(t_max),
       polynomial(std::move(polynomial)) {}
 
+template<typename Frame>
+template<int degree>
+void ContinuousTrajectory<Frame>::WritePolynomialCoefficients(
+    Polynomial<Position<Frame>, Instant> const& polynomial,
+    std::vector<double>& polynomials) {
+  auto const& polynomial_of_degree = dynamic_cast<
+      PolynomialInMonomialBasis<Position<Frame>, Instant,
+                                degree, EstrinEvaluator> const&>(polynomial);
+  polynomials.push_back((polynomial_of_degree.origin() - Instant{}) / Second);
+  for_all_of(polynomial_of_degree.coefficients())
+      .loop([&polynomials](auto const& coefficient) {
+        using Coefficient = std::remove_cvref_t<decltype(coefficient)>;
+        auto const coordinates = [&coefficient]() {
+          if constexpr (std::is_same_v<Coefficient, Position<Frame>>) {
+            return (coefficient - Frame::origin).coordinates();
+          } else {
+            return coefficient.coordinates();
+          }
+        }();
+        using Scalar = std::remove_cvref_t<decltype(coordinates.x)>;
+        polynomials.insert(polynomials.end(),
+                           {coordinates.x / si::Unit<Scalar>,
+                            coordinates.y / si::Unit<Scalar>,
+                            coordinates.z / si::Unit<Scalar>});
+      });
+}
+
+template<typename Frame>
+template<int degree>
+not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
+ContinuousTrajectory<Frame>::ReadPolynomialCoefficients(
+    double const* doubles) {
+  using PolynomialOfDegree = PolynomialInMonomialBasis<Position<Frame>, Instant,
+                                                       degree, EstrinEvaluator>;
+  Instant const origin = Instant{} + *doubles++ * Second;
+  typename PolynomialOfDegree::Coefficients coefficients;
+  for_all_of(coefficients).loop([&doubles](auto& coefficient) {
+    using Coefficient = std::remove_cvref_t<decltype(coefficient)>;
+    if constexpr (std::is_same_v<Coefficient, Position<Frame>>) {
+      coefficient = Frame::origin + Displacement<Frame>({doubles[0] * Metre,
+                                                         doubles[1] * Metre,
+                                                         doubles[2] * Metre});
+    } else {
+      using Scalar =
+          std::remove_cvref_t<decltype(coefficient.coordinates().x)>;
+      coefficient = Coefficient({doubles[0] * si::Unit<Scalar>,
+                                 doubles[1] * si::Unit<Scalar>,
+                                 doubles[2] * si::Unit<Scalar>});
+    }
+    doubles += 3;
+  });
+  return make_not_null_unique<PolynomialOfDegree>(coefficients, origin);
+}
+
 template<typename Frame>
 not_null<std::unique_ptr<Polynomial<Position<Frame>, Instant>>>
 ContinuousTrajectory<Frame>::NewhallApproximationInMonomialBasis(
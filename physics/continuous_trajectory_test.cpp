@@ -6,6 +6,7 @@
 #include <limits>
 #include <vector>
 
+#include "base/array.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/space.hpp"
@@ -29,9 +30,11 @@
 namespace principia {
 namespace physics {
 
+using ::testing::IsEmpty;
 using ::testing::Sequence;
 using ::testing::SetArgReferee;
 using ::testing::_;
+using namespace principia::base::_array;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_instant;
@@ -778,6 +781,87 @@ TEST_F(ContinuousTrajectoryTest, Serialization) {
   EXPECT_THAT(message, EqualsProto(second_message));
 }
 
+TEST_F(ContinuousTrajectoryTest, SerializationWithArrays) {
+  int const number_of_steps = 20;
+  int const number_of_substeps = 50;
+  Time const step = 0.01 * Second;
+  Length const tolerance = 0.1 * Metre;
+
+  auto position_function =
+      [this](Instant const t) {
+        return World::origin +
+            Displacement<World>({(t - t0_) * 3 * Metre / Second,
+                                 (t - t0_) * 5 * Metre / Second,
+                                 (t - t0_) * (-2) * Metre / Second});
+      };
+  auto velocity_function =
+      [](Instant const t) {
+        return Velocity<World>({3 * Metre / Second,
+                                5 * Metre / Second,
+                                -2 * Metre / Second});
+      };
+
+  auto const trajectory = std::make_unique<ContinuousTrajectory<World>>(
+                              step, tolerance);
+  FillTrajectory(number_of_steps,
+                 step,
+                 position_function,
+                 velocity_function,
+                 t0_,
+                 *trajectory);
+  trajectory->WriteToCheckpoint(trajectory->t_max());
+
+  serialization::ContinuousTrajectory message;
+  std::vector<double> polynomials;
+  trajectory->WriteToMessage(&message, /*after=*/InfinitePast, polynomials);
+  EXPECT_EQ(0, message.instant_polynomial_pair_size());
+  EXPECT_EQ(1, message.checkpoint_size());
+  // Two polynomials of degree 3.
+  EXPECT_EQ(2 * (3 + 3 * 4), polynomials.size());
+
+  // Only the polynomials and checkpoints after |after| are written.
+  Instant const first_t_max = Instant{} + polynomials[0] * Second;
+  serialization::ContinuousTrajectory delta_message;
+  std::vector<double> delta_polynomials;
+  trajectory->WriteToMessage(
+      &delta_message, /*after=*/first_t_max, delta_polynomials);
+  EXPECT_EQ(1, delta_message.checkpoint_size());
+  EXPECT_EQ(std::vector<double>(polynomials.begin() + polynomials.size() / 2,
+                                polynomials.end()),
+            delta_polynomials);
+  serialization::ContinuousTrajectory empty_delta_message;
+  std::vector<double> empty_delta_polynomials;
+  trajectory->WriteToMessage(&empty_delta_message,
+                             /*after=*/trajectory->t_max(),
+                             empty_delta_polynomials);
+  EXPECT_EQ(0, empty_delta_message.checkpoint_size());
+  EXPECT_THAT(empty_delta_polynomials, IsEmpty());
+
+  // Split the polynomials across two arrays, as a snapshot delta would.
+  std::vector<Array<double const>> const arrays{
+      Array<double const>(polynomials.data(), polynomials.size() / 2),
+      Array<double const>(delta_polynomials.data(), delta_polynomials.size())};
+  auto const trajectory_read = ContinuousTrajectory<World>::ReadFromMessage(
+      /*desired_t_min=*/InfiniteFuture,
+      message,
+      arrays);
+  EXPECT_EQ(trajectory->t_min(), trajectory_read->t_min());
+  EXPECT_EQ(trajectory->t_max(), trajectory_read->t_max());
+  for (Instant time = trajectory->t_min();
+        time <= trajectory->t_max();
+        time += step / number_of_substeps) {
+    EXPECT_EQ(trajectory->EvaluateDegreesOfFreedom(time),
+              trajectory_read->EvaluateDegreesOfFreedom(time));
+  }
+
+  // The array form carries the same polynomials as the message form.
+  serialization::ContinuousTrajectory full_message;
+  trajectory->WriteToMessage(&full_message);
+  serialization::ContinuousTrajectory second_full_message;
+  trajectory_read->WriteToMessage(&second_full_message);
+  EXPECT_THAT(full_message, EqualsProto(second_full_message));
+}
+
 TEST_F(ContinuousTrajectoryTest, PreCohenCompatibility) {
   int const number_of_steps = 110;
   Time const step = 0.01 * Second;
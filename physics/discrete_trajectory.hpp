@@ -3,10 +3,12 @@
 #include <iterator>
 #include <list>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "absl/container/btree_map.h"
 #include "absl/status/status.h"
+#include "base/array.hpp"
 #include "base/macros.hpp"
 #include "base/not_null.hpp"
 #include "base/tags.hpp"
@@ -31,6 +33,7 @@ FORWARD_DECLARE_FROM(discrete_trajectory_segment,
 namespace _discrete_trajectory {
 namespace internal {
 
+using namespace principia::base::_array;
 using namespace principia::base::_not_null;
 using namespace principia::base::_tags;
 using namespace principia::base::_traits;
@@ -123,6 +126,10 @@ class DiscreteTrajectory : public Trajectory<Frame> {
   //    result is that of the latest segment (the one with the largest times).
   void Merge(DiscreteTrajectory<Frame> trajectory);
 
+  // Records that the points of all the segments are unchanged, see
+  // |DiscreteTrajectorySegment::earliest_change|.
+  void MarkUnchanged();
+
   Instant t_min() const override;
   Instant t_max() const override;
 
@@ -146,6 +153,17 @@ class DiscreteTrajectory : public Trajectory<Frame> {
       iterator end,
       std::vector<SegmentIterator> const& tracked,
       std::vector<iterator> const& exact) const;
+  // Same as above, but the points are not written to |message|.  Instead, the
+  // points described by the |i|th segment of |message| are given by the |i|th
+  // element of |segment_ranges|, which is a range of the |i|th segment of this
+  // trajectory.  The caller is expected to store these points separately, using
+  // |DiscreteTrajectorySegment::WritePoints|.
+  void WriteToMessage(
+      not_null<serialization::DiscreteTrajectory*> message,
+      iterator begin,
+      iterator end,
+      std::vector<SegmentIterator> const& tracked,
+      std::vector<std::pair<iterator, iterator>>& segment_ranges) const;
 
   // |tracked| must have a size appropriate for the |message| being deserialized
   // and the orders of the |tracked| iterators must be consistent during
@@ -156,6 +174,15 @@ class DiscreteTrajectory : public Trajectory<Frame> {
   static DiscreteTrajectory ReadFromMessage(
       serialization::DiscreteTrajectory const& message,
       std::vector<SegmentIterator*> const& tracked);
+  // Same as above, for a |message| written without its points.  The points of
+  // the |i|th segment of |message| are read from |points[i]|, see
+  // |DiscreteTrajectorySegment::ReadFromMessage|.
+  template<typename F = Frame,
+           typename = std::enable_if_t<is_serializable_v<F>>>
+  static DiscreteTrajectory ReadFromMessage(
+      serialization::DiscreteTrajectory const& message,
+      std::vector<SegmentIterator*> const& tracked,
+      std::vector<std::vector<Array<double const>>> const& points);
 
  private:
   using DownsamplingParameters =
@@ -185,6 +212,24 @@ class DiscreteTrajectory : public Trajectory<Frame> {
   // Updates the segments self-pointers and the time-to-segment mapping after
   // segments have been spliced from |from| to |to|.  The iterator indicates the
   // segments to fix-up.
+  // Implementation of serialization.  If |segment_ranges| is null, the points
+  // are written to |message|, otherwise they are not and the range of each
+  // segment is appended to |*segment_ranges|.
+  void WriteToMessage(
+      not_null<serialization::DiscreteTrajectory*> message,
+      iterator begin,
+      iterator end,
+      std::vector<SegmentIterator> const& tracked,
+      std::vector<iterator> const& exact,
+      std::vector<std::pair<iterator, iterator>>* segment_ranges) const;
+
+  // Implementation of deserialization.  If |points| is null, the points are
+  // read from |message|.
+  static DiscreteTrajectory ReadFromMessage(
+      serialization::DiscreteTrajectory const& message,
+      std::vector<SegmentIterator*> const& tracked,
+      std::vector<std::vector<Array<double const>>> const* points);
+
   static void AdjustAfterSplicing(
       DiscreteTrajectory& from,
       DiscreteTrajectory& to,
@@ -457,6 +457,13 @@ void DiscreteTrajectory<Frame>::Merge(DiscreteTrajectory<Frame> trajectory) {
   CHECK_OK(ConsistencyStatus());
 }
 
+template<typename Frame>
+void DiscreteTrajectory<Frame>::MarkUnchanged() {
+  for (auto& segment : *segments_) {
+    segment.MarkUnchanged();
+  }
+}
+
 template<typename Frame>
 Instant DiscreteTrajectory<Frame>::t_min() const {
   if (empty()) {
@@ -510,6 +517,51 @@ void DiscreteTrajectory<Frame>::WriteToMessage(
     iterator const end,
     std::vector<SegmentIterator> const& tracked,
     std::vector<iterator> const& exact) const {
+  WriteToMessage(message,
+                 begin,
+                 end,
+                 tracked,
+                 exact,
+                 /*segment_ranges=*/nullptr);
+}
+
+template<typename Frame>
+void DiscreteTrajectory<Frame>::WriteToMessage(
+    not_null<serialization::DiscreteTrajectory*> message,
+    iterator const begin,
+    iterator const end,
+    std::vector<SegmentIterator> const& tracked,
+    std::vector<std::pair<iterator, iterator>>& segment_ranges) const {
+  WriteToMessage(message, begin, end, tracked, /*exact=*/{}, &segment_ranges);
+}
+
+template<typename Frame>
+template<typename F, typename>
+DiscreteTrajectory<Frame>
+DiscreteTrajectory<Frame>::ReadFromMessage(
+    serialization::DiscreteTrajectory const& message,
+    std::vector<SegmentIterator*> const& tracked) {
+  return ReadFromMessage(message, tracked, /*points=*/nullptr);
+}
+
+template<typename Frame>
+template<typename F, typename>
+DiscreteTrajectory<Frame>
+DiscreteTrajectory<Frame>::ReadFromMessage(
+    serialization::DiscreteTrajectory const& message,
+    std::vector<SegmentIterator*> const& tracked,
+    std::vector<std::vector<Array<double const>>> const& points) {
+  return ReadFromMessage(message, tracked, &points);
+}
+
+template<typename Frame>
+void DiscreteTrajectory<Frame>::WriteToMessage(
+    not_null<serialization::DiscreteTrajectory*> message,
+    iterator const begin,
+    iterator const end,
+    std::vector<SegmentIterator> const& tracked,
+    std::vector<iterator> const& exact,
+    std::vector<std::pair<iterator, iterator>>* const segment_ranges) const {
   // Construct a map to efficiently find if a segment must be tracked.  The
   // keys are pointers to segments in |tracked|, the values are the
   // corresponding indices.  Note that multiple tracked segments may turn out to
@@ -569,8 +621,13 @@ void DiscreteTrajectory<Frame>::WriteToMessage(
 
     // Note that we execute this call for the segments that precede the
     // intersection in order to write the correct structure of (empty) segments.
-    sit->WriteToMessage(
-        message->add_segment(), begin_time_it, end_time_it, exact);
+    if (segment_ranges == nullptr) {
+      sit->WriteToMessage(
+          message->add_segment(), begin_time_it, end_time_it, exact);
+    } else {
+      sit->WriteToMessage(message->add_segment(), begin_time_it, end_time_it);
+      segment_ranges->emplace_back(begin_time_it, end_time_it);
+    }
 
     const auto [position_begin, position_end] =
         segment_to_position.equal_range(&*sit);
@@ -617,15 +674,16 @@ void DiscreteTrajectory<Frame>::WriteToMessage(
 }
 
 template<typename Frame>
-template<typename F, typename>
 DiscreteTrajectory<Frame>
 DiscreteTrajectory<Frame>::ReadFromMessage(
     serialization::DiscreteTrajectory const& message,
-    std::vector<SegmentIterator*> const& tracked) {
+    std::vector<SegmentIterator*> const& tracked,
+    std::vector<std::vector<Array<double const>>> const* const points) {
   DiscreteTrajectory trajectory(uninitialized);
 
   bool const is_pre_hamilton = message.segment_size() == 0;
   if (is_pre_hamilton) {
+    CHECK(points == nullptr);
     LOG_IF(WARNING, is_pre_hamilton)
         << "Reading pre-Hamilton DiscreteTrajectory";
     ReadFromPreHamiltonMessage(
@@ -638,12 +696,21 @@ DiscreteTrajectory<Frame>::ReadFromMessage(
   // restore the tracked segments.
   std::vector<SegmentIterator> segment_iterators;
   segment_iterators.reserve(message.segment_size());
-  for (auto const& serialized_segment : message.segment()) {
+  if (points != nullptr) {
+    CHECK_EQ(message.segment_size(), points->size());
+  }
+  for (int i = 0; i < message.segment_size(); ++i) {
+    auto const& serialized_segment = message.segment(i);
     trajectory.segments_->emplace_back();
     auto const sit = --trajectory.segments_->end();
     auto const self = SegmentIterator(trajectory.segments_.get(), sit);
-    *sit = DiscreteTrajectorySegment<Frame>::ReadFromMessage(serialized_segment,
-                                                             self);
+    if (points == nullptr) {
+      *sit = DiscreteTrajectorySegment<Frame>::ReadFromMessage(
+          serialized_segment, self);
+    } else {
+      *sit = DiscreteTrajectorySegment<Frame>::ReadFromMessage(
+          serialized_segment, (*points)[i], self);
+    }
     segment_iterators.push_back(self);
   }
 
@@ -3,10 +3,12 @@
 #include <cstdint>
 #include <iterator>
 #include <optional>
+#include <string_view>
 #include <vector>
 
 #include "absl/container/btree_map.h"
 #include "absl/status/status.h"
+#include "base/array.hpp"
 #include "base/not_null.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/space.hpp"
@@ -39,6 +41,7 @@ class DiscreteTrajectorySegmentTest;
 namespace _discrete_trajectory_segment {
 namespace internal {
 
+using namespace principia::base::_array;
 using namespace principia::base::_not_null;
 using namespace principia::base::_traits;
 using namespace principia::geometry::_instant;
@@ -66,6 +69,9 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
   using DownsamplingParameters =
       _discrete_trajectory_types::DownsamplingParameters;
 
+  // The number of doubles used by |WritePoints| to represent a point.
+  static constexpr std::int64_t doubles_per_point = 7;
+
   // TODO(phl): Decide which constructors should be public.
   DiscreteTrajectorySegment() = default;
   explicit DiscreteTrajectorySegment(
@@ -127,6 +133,16 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
   // not to depend on the actual structure of the timeline.
   bool was_downsampled() const;
 
+  // The points of this segment that existed at the last call to
+  // |MarkUnchanged| and whose time is strictly before |earliest_change()| are
+  // still present and unchanged, except for those that were forgotten at the
+  // beginning of the segment.  Appending points at the end of the segment
+  // doesn't change |earliest_change()|, but inserting or removing points
+  // elsewhere, including by downsampling, does.  Returns -∞ if
+  // |MarkUnchanged| was never called, and +∞ if no point was changed since the
+  // last call.  Used to write the changes since an earlier serialization.
+  Instant earliest_change() const;
+
   // The points denoted by |exact| are written and re-read exactly and are not
   // affected by any errors introduced by zfp compression.  The endpoints of a
   // segment are always exact.
@@ -140,12 +156,48 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
       iterator begin,
       iterator end,
       std::vector<iterator> const& exact) const;
+  // Same as above, but the points are not written to |message|, only the
+  // downsampling state is.  The caller is expected to store the points defined
+  // by [begin, end[ separately, using |WritePoints|.
+  void WriteToMessage(
+      not_null<serialization::DiscreteTrajectorySegment*> message,
+      iterator begin,
+      iterator end) const;
+
+  // Appends the points defined by [begin, end[ to |points|, exactly, using
+  // |doubles_per_point| doubles per point: the time in seconds since
+  // |Instant{}|, the position in metres and the velocity in metres per second.
+  void WritePoints(iterator begin,
+                   iterator end,
+                   not_null<std::vector<double>*> points) const;
 
   template<typename F = Frame,
            typename = std::enable_if_t<is_serializable_v<F>>>
   static DiscreteTrajectorySegment ReadFromMessage(
       serialization::DiscreteTrajectorySegment const& message,
       DiscreteTrajectorySegmentIterator<Frame> self);
+  // Same as above, for a |message| written without its points.  The points are
+  // read from the concatenation of |points|, which must be in the format
+  // produced by |WritePoints|.  The arrays are not retained.
+  template<typename F = Frame,
+           typename = std::enable_if_t<is_serializable_v<F>>>
+  static DiscreteTrajectorySegment ReadFromMessage(
+      serialization::DiscreteTrajectorySegment const& message,
+      std::vector<Array<double const>> const& points,
+      DiscreteTrajectorySegmentIterator<Frame> self);
+  // Same as above, but only the chunks of the timeline that are needed to
+  // evaluate the segment over [t_min, t_max] are decompressed.  The result
+  // contains all the points of the serialized segment in that interval, plus
+  // the points of the chunks that contain them.  It is suitable for lookups
+  // and evaluation over [t_min, t_max] but it may have fewer dense points than
+  // the original segment, and should not be appended to.
+  template<typename F = Frame,
+           typename = std::enable_if_t<is_serializable_v<F>>>
+  static DiscreteTrajectorySegment ReadFromMessage(
+      serialization::DiscreteTrajectorySegment const& message,
+      Instant const& t_min,
+      Instant const& t_max,
+      DiscreteTrajectorySegmentIterator<Frame> self);
 
  private:
   // Versions of find, lower_bound, and upper_bound that use optionals to
@@ -179,6 +231,13 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
   // result is that of the latest segment (with the largest times).
   void Merge(DiscreteTrajectorySegment<Frame> segment);
 
+  // Records that none of the points of this segment has changed, see
+  // |earliest_change|.
+  void MarkUnchanged();
+
+  // Records that the points at or after |t| may have changed.
+  void RecordChange(Instant const& t);
+
   // Computes |number_of_dense_points_| based on the start of the dense
   // timeline.  Used for compatibility deserialization.
   void SetStartOfDenseTimeline(Instant const& t);
@@ -199,9 +258,25 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
 
   typename Timeline::const_iterator timeline_begin() const;
   typename Timeline::const_iterator timeline_end() const;
+  // Returns the iterator in |timeline_| that corresponds to |it|.
+  typename Timeline::const_iterator timeline_iterator(iterator it) const;
   bool timeline_empty() const;
   std::int64_t timeline_size() const;
 
+  // Decompresses a chunk of |size| points from the beginning of |zfp_chunk| and
+  // appends them to this segment.  The points that have an entry in |exact| are
+  // restored exactly.
+  void ReadZfpChunkFromMessage(std::int64_t size,
+                               std::string_view zfp_chunk,
+                               Timeline const& exact);
+
+  // Writes the downsampling state of the segment to |message|.
+  // |timeline_size| and |number_of_points_to_skip_at_end| are as below.
+  void WriteDownsamplingToMessage(
+      not_null<serialization::DiscreteTrajectorySegment*> message,
+      std::int64_t timeline_size,
+      std::int64_t number_of_points_to_skip_at_end) const;
+
   // Implementation of serialization.  The caller is expected to pass consistent
   // parameters.  |timeline_begin| and |timeline_end| define the range to write.
   // |timeline_size| is the distance from |timeline_begin| to |timeline_end|.
@@ -223,6 +298,8 @@ class DiscreteTrajectorySegment : public Trajectory<Frame> {
 
   bool was_downsampled_ = false;
 
+  Instant earliest_change_ = InfinitePast;
+
   DiscreteTrajectorySegmentIterator<Frame> self_;
   Timeline timeline_;
 
@@ -6,6 +6,7 @@
 #include <iterator>
 #include <list>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "absl/container/btree_set.h"
@@ -25,6 +26,12 @@ using namespace principia::numerics::_fit_hermite_spline;
 using namespace principia::quantities::_quantities;
 using namespace principia::quantities::_si;
 
+// The number of points of the timeline that are compressed together.  Larger
+// values improve compression, smaller values reduce the amount of data that
+// must be decompressed to access an arbitrary point.  This is a multiple of the
+// size of the zfp blocks to avoid padding.
+constexpr std::int64_t points_per_zfp_chunk = 1024;
+
 template<typename Frame>
 DiscreteTrajectorySegment<Frame>::DiscreteTrajectorySegment(
     DiscreteTrajectorySegmentIterator<Frame> const self)
@@ -93,6 +100,9 @@ std::int64_t DiscreteTrajectorySegment<Frame>::size() const {
 
 template<typename Frame>
 void DiscreteTrajectorySegment<Frame>::clear() {
+  if (!timeline_.empty()) {
+    RecordChange(timeline_.cbegin()->time);
+  }
   downsampling_parameters_.reset();
   number_of_dense_points_ = 0;
   was_downsampled_ = false;
@@ -189,6 +199,11 @@ bool DiscreteTrajectorySegment<Frame>::was_downsampled() const {
   return was_downsampled_;
 }
 
+template<typename Frame>
+Instant DiscreteTrajectorySegment<Frame>::earliest_change() const {
+  return earliest_change_;
+}
+
 template<typename Frame>
 void DiscreteTrajectorySegment<Frame>::WriteToMessage(
     not_null<serialization::DiscreteTrajectorySegment*> message,
@@ -207,12 +222,8 @@ void DiscreteTrajectorySegment<Frame>::WriteToMessage(
     iterator const begin,
     iterator const end,
     std::vector<iterator> const& exact) const {
-  typename Timeline::const_iterator const timeline_begin =
-      begin == this->end() ? timeline_.cend()
-                           : iterator::iterator(begin.point_);
-  typename Timeline::const_iterator const timeline_end =
-      end == this->end() ? timeline_.cend()
-                         : iterator::iterator(end.point_);
+  auto const timeline_begin = timeline_iterator(begin);
+  auto const timeline_end = timeline_iterator(end);
   bool const covers_entire_segment =
       timeline_begin == timeline_.cbegin() && timeline_end == timeline_.cend();
   std::int64_t const timeline_size =
@@ -228,11 +239,66 @@ void DiscreteTrajectorySegment<Frame>::WriteToMessage(
                  exact);
 }
 
+template<typename Frame>
+void DiscreteTrajectorySegment<Frame>::WriteToMessage(
+    not_null<serialization::DiscreteTrajectorySegment*> message,
+    iterator const begin,
+    iterator const end) const {
+  auto const timeline_begin = timeline_iterator(begin);
+  auto const timeline_end = timeline_iterator(end);
+  bool const covers_entire_segment =
+      timeline_begin == timeline_.cbegin() && timeline_end == timeline_.cend();
+  if (covers_entire_segment) {
+    WriteDownsamplingToMessage(message,
+                               timeline_.size(),
+                               /*number_of_points_to_skip_at_end=*/0);
+  } else {
+    WriteDownsamplingToMessage(message,
+                               std::distance(timeline_begin, timeline_end),
+                               std::distance(timeline_end, timeline_.cend()));
+  }
+}
+
+template<typename Frame>
+void DiscreteTrajectorySegment<Frame>::WritePoints(
+    iterator const begin,
+    iterator const end,
+    not_null<std::vector<double>*> const points) const {
+  auto const timeline_end = timeline_iterator(end);
+  for (auto it = timeline_iterator(begin); it != timeline_end; ++it) {
+    auto const& [t, degrees_of_freedom] = *it;
+    auto const q = degrees_of_freedom.position() - Frame::origin;
+    auto const v = degrees_of_freedom.velocity();
+    points->insert(points->end(),
+                   {(t - Instant{}) / Second,
+                    q.coordinates().x / Metre,
+                    q.coordinates().y / Metre,
+                    q.coordinates().z / Metre,
+                    v.coordinates().x / (Metre / Second),
+                    v.coordinates().y / (Metre / Second),
+                    v.coordinates().z / (Metre / Second)});
+  }
+}
+
+template<typename Frame>
+template<typename F, typename>
+DiscreteTrajectorySegment<Frame>
+DiscreteTrajectorySegment<Frame>::ReadFromMessage(
+    serialization::DiscreteTrajectorySegment const& message,
+    DiscreteTrajectorySegmentIterator<Frame> const self) {
+  return ReadFromMessage(message,
+                         /*t_min=*/InfinitePast,
+                         /*t_max=*/InfiniteFuture,
+                         self);
+}
+
 template<typename Frame>
 template<typename F, typename>
 DiscreteTrajectorySegment<Frame>
 DiscreteTrajectorySegment<Frame>::ReadFromMessage(
     serialization::DiscreteTrajectorySegment const& message,
+    Instant const& t_min,
+    Instant const& t_max,
     DiscreteTrajectorySegmentIterator<Frame> const self) {
   // Note that while is_pre_hardy means that the save is pre-Hardy,
   // !is_pre_hardy does not mean it is Hardy or later; a pre-Hardy segment with
@@ -259,43 +325,39 @@ DiscreteTrajectorySegment<Frame>::ReadFromMessage(
 
   // Decompress the timeline before restoring the downsampling parameters to
   // avoid re-downsampling.
-  ZfpCompressor decompressor;
   ZfpCompressor::ReadVersion(message);
 
-  int const timeline_size = message.zfp().timeline_size();
-  std::vector<double> t(timeline_size);
-  std::vector<double> qx(timeline_size);
-  std::vector<double> qy(timeline_size);
-  std::vector<double> qz(timeline_size);
-  std::vector<double> px(timeline_size);
-  std::vector<double> py(timeline_size);
-  std::vector<double> pz(timeline_size);
-  std::string_view zfp_timeline(message.zfp().timeline().data(),
-                                message.zfp().timeline().size());
-
-  decompressor.ReadFromMessageMultidimensional<2>(t, zfp_timeline);
-  decompressor.ReadFromMessageMultidimensional<2>(qx, zfp_timeline);
-  decompressor.ReadFromMessageMultidimensional<2>(qy, zfp_timeline);
-  decompressor.ReadFromMessageMultidimensional<2>(qz, zfp_timeline);
-  decompressor.ReadFromMessageMultidimensional<2>(px, zfp_timeline);
-  decompressor.ReadFromMessageMultidimensional<2>(py, zfp_timeline);
-  decompressor.ReadFromMessageMultidimensional<2>(pz, zfp_timeline);
-
-  for (int i = 0; i < timeline_size; ++i) {
-    Position<Frame> const q =
-        Frame::origin +
-        Displacement<Frame>({qx[i] * Metre, qy[i] * Metre, qz[i] * Metre});
-    Velocity<Frame> const p({px[i] * (Metre / Second),
-                             py[i] * (Metre / Second),
-                             pz[i] * (Metre / Second)});
-
-    // See if this is a point whose degrees of freedom must be restored
-    // exactly.
-    Instant const time = Instant() + t[i] * Second;
-    if (auto it = exact.find(time); it == exact.cend()) {
-      segment.Append(time, DegreesOfFreedom<Frame>(q, p)).IgnoreError();
-    } else {
-      segment.Append(time, it->degrees_of_freedom).IgnoreError();
+  auto const& zfp = message.zfp();
+  std::string_view const zfp_timeline(zfp.timeline().data(),
+                                      zfp.timeline().size());
+  bool const is_pre_ibn_yunus = zfp.chunk_size() == 0;
+  // Whether the last point of the timeline was restored.
+  bool end_restored = true;
+  if (is_pre_ibn_yunus) {
+    // The timeline is a single stream that cannot be partially decompressed.
+    segment.ReadZfpChunkFromMessage(zfp.timeline_size(), zfp_timeline, exact);
+  } else {
+    // A chunk is needed if the interval that it covers overlaps [t_min, t_max].
+    // The interval covered by a chunk extends to the end of the previous chunk
+    // and to the beginning of the next chunk, so that evaluation in the gaps
+    // has the points it needs.
+    for (int i = 0; i < zfp.chunk_size(); ++i) {
+      auto const& chunk = zfp.chunk(i);
+      Instant const covered_t_min =
+          Instant::ReadFromMessage(i == 0 ? chunk.t_min()
+                                          : zfp.chunk(i - 1).t_max());
+      Instant const covered_t_max =
+          Instant::ReadFromMessage(i == zfp.chunk_size() - 1
+                                       ? chunk.t_max()
+                                       : zfp.chunk(i + 1).t_min());
+      bool const needed = covered_t_min <= t_max && covered_t_max >= t_min;
+      if (needed) {
+        segment.ReadZfpChunkFromMessage(
+            chunk.size(), zfp_timeline.substr(chunk.offset()), exact);
+      }
+      if (i == zfp.chunk_size() - 1) {
+        end_restored = needed;
+      }
     }
   }
 
@@ -319,7 +381,61 @@ DiscreteTrajectorySegment<Frame>::ReadFromMessage(
         .tolerance = Length::ReadFromMessage(
             message.downsampling_parameters().tolerance())};
     CHECK(message.has_number_of_dense_points());
-    segment.number_of_dense_points_ = message.number_of_dense_points();
+    // The dense points are at the end of the timeline.  The chunks that were
+    // decompressed are contiguous, so if the end of the timeline was restored,
+    // the restored dense points are at the end of |segment.timeline_|.
+    // Otherwise none of the points of |segment.timeline_| is at the end of
+    // the timeline, and we conservatively treat them all as non-dense.
+    segment.number_of_dense_points_ =
+        end_restored ? std::min<std::int64_t>(message.number_of_dense_points(),
+                                              segment.timeline_.size())
+                     : 0;
+  }
+
+  return segment;
+}
+
+template<typename Frame>
+template<typename F, typename>
+DiscreteTrajectorySegment<Frame>
+DiscreteTrajectorySegment<Frame>::ReadFromMessage(
+    serialization::DiscreteTrajectorySegment const& message,
+    std::vector<Array<double const>> const& points,
+    DiscreteTrajectorySegmentIterator<Frame> const self) {
+  CHECK(!message.has_zfp()) << "Points serialized in the message";
+  DiscreteTrajectorySegment<Frame> segment(self);
+
+  // Read the points before restoring the downsampling parameters to avoid
+  // re-downsampling.
+  for (auto const& array : points) {
+    CHECK_EQ(0, array.size % doubles_per_point) << array.size;
+    for (std::int64_t i = 0; i < array.size; i += doubles_per_point) {
+      double const* const point = &array.data[i];
+      segment.Append(
+          Instant{} + point[0] * Second,
+          DegreesOfFreedom<Frame>(
+              Frame::origin + Displacement<Frame>({point[1] * Metre,
+                                                   point[2] * Metre,
+                                                   point[3] * Metre}),
+              Velocity<Frame>({point[4] * (Metre / Second),
+                               point[5] * (Metre / Second),
+                               point[6] * (Metre / Second)}))).IgnoreError();
+    }
+  }
+
+  CHECK_EQ(message.has_downsampling_parameters(),
+           message.has_number_of_dense_points())
+      << message.DebugString();
+  segment.was_downsampled_ = message.was_downsampled();
+  if (message.has_downsampling_parameters()) {
+    segment.downsampling_parameters_ = DownsamplingParameters{
+        .max_dense_intervals =
+            message.downsampling_parameters().max_dense_intervals(),
+        .tolerance = Length::ReadFromMessage(
+            message.downsampling_parameters().tolerance())};
+    segment.number_of_dense_points_ =
+        std::min<std::int64_t>(message.number_of_dense_points(),
+                               segment.timeline_.size());
   }
 
   return segment;
@@ -371,6 +487,7 @@ void DiscreteTrajectorySegment<Frame>::Prepend(
   CHECK(!timeline_.empty() || t < timeline_.cbegin()->time)
       << "Prepend out of order at " << t << ", first time is "
       << timeline_.cbegin()->time;
+  RecordChange(t);
   timeline_.emplace_hint(timeline_.cbegin(), t, degrees_of_freedom);
 }
 
@@ -388,6 +505,9 @@ void DiscreteTrajectorySegment<Frame>::ForgetAfter(
       std::max<std::int64_t>(
           0, number_of_dense_points_ - number_of_points_to_remove);
 
+  if (begin != timeline_.cend()) {
+    RecordChange(begin->time);
+  }
   timeline_.erase(begin, timeline_.cend());
 }
 
@@ -445,7 +565,11 @@ void DiscreteTrajectorySegment<Frame>::Merge(
     DiscreteTrajectorySegment<Frame> segment) {
   if (segment.timeline_.empty()) {
     return;
-  } else if (timeline_.empty()) {
+  }
+  // The points of |segment| are new to this object, and may come before its
+  // own points.
+  RecordChange(segment.timeline_.cbegin()->time);
+  if (timeline_.empty()) {
     downsampling_parameters_ = segment.downsampling_parameters_;
     timeline_ = std::move(segment.timeline_);
     number_of_dense_points_ = segment.number_of_dense_points_;
@@ -495,6 +619,16 @@ void DiscreteTrajectorySegment<Frame>::Merge(
 
 #undef PRINCIPIA_MERGE_STRICT_CONSISTENCY
 
+template<typename Frame>
+void DiscreteTrajectorySegment<Frame>::MarkUnchanged() {
+  earliest_change_ = InfiniteFuture;
+}
+
+template<typename Frame>
+void DiscreteTrajectorySegment<Frame>::RecordChange(Instant const& t) {
+  earliest_change_ = std::min(earliest_change_, t);
+}
+
 template<typename Frame>
 void DiscreteTrajectorySegment<Frame>::SetStartOfDenseTimeline(
     Instant const& t) {
@@ -505,6 +639,7 @@ void DiscreteTrajectorySegment<Frame>::SetStartOfDenseTimeline(
 
 template<typename Frame>
 void DiscreteTrajectorySegment<Frame>::SetForkPoint(value_type const& point) {
+  RecordChange(point.time);
   auto const it = timeline_.emplace_hint(
       timeline_.begin(), point.time, point.degrees_of_freedom);
   CHECK(it == timeline_.begin())
@@ -563,6 +698,9 @@ absl::Status DiscreteTrajectorySegment<Frame>::DownsampleIfNeeded() {
     for (Instant const& right : right_endpoints_times) {
       ++left_it;
       auto const right_it = timeline_.find(right);
+      if (left_it != right_it) {
+        RecordChange(left_it->time);
+      }
       left_it = timeline_.erase(left_it, right_it);
     }
     number_of_dense_points_ = std::distance(left_it, timeline_.cend());
@@ -599,6 +737,12 @@ DiscreteTrajectorySegment<Frame>::timeline_end() const {
   return timeline_.cend();
 }
 
+template<typename Frame>
+typename DiscreteTrajectorySegment<Frame>::Timeline::const_iterator
+DiscreteTrajectorySegment<Frame>::timeline_iterator(iterator const it) const {
+  return it == end() ? timeline_.cend() : iterator::iterator(it.point_);
+}
+
 template<typename Frame>
 bool DiscreteTrajectorySegment<Frame>::timeline_empty() const {
   return timeline_.empty();
@@ -610,13 +754,52 @@ std::int64_t DiscreteTrajectorySegment<Frame>::timeline_size() const {
 }
 
 template<typename Frame>
-void DiscreteTrajectorySegment<Frame>::WriteToMessage(
-    not_null<serialization::DiscreteTrajectorySegment*> message,
-    typename Timeline::const_iterator const timeline_begin,
-    typename Timeline::const_iterator const timeline_end,
+void DiscreteTrajectorySegment<Frame>::ReadZfpChunkFromMessage(
+    std::int64_t const size,
+    std::string_view zfp_chunk,
+    Timeline const& exact) {
+  ZfpCompressor const decompressor;
+
+  std::vector<double> t(size);
+  std::vector<double> qx(size);
+  std::vector<double> qy(size);
+  std::vector<double> qz(size);
+  std::vector<double> px(size);
+  std::vector<double> py(size);
+  std::vector<double> pz(size);
+
+  decompressor.ReadFromMessageMultidimensional<2>(t, zfp_chunk);
+  decompressor.ReadFromMessageMultidimensional<2>(qx, zfp_chunk);
+  decompressor.ReadFromMessageMultidimensional<2>(qy, zfp_chunk);
+  decompressor.ReadFromMessageMultidimensional<2>(qz, zfp_chunk);
+  decompressor.ReadFromMessageMultidimensional<2>(px, zfp_chunk);
+  decompressor.ReadFromMessageMultidimensional<2>(py, zfp_chunk);
+  decompressor.ReadFromMessageMultidimensional<2>(pz, zfp_chunk);
+
+  for (std::int64_t i = 0; i < size; ++i) {
+    Position<Frame> const q =
+        Frame::origin +
+        Displacement<Frame>({qx[i] * Metre, qy[i] * Metre, qz[i] * Metre});
+    Velocity<Frame> const p({px[i] * (Metre / Second),
+                             py[i] * (Metre / Second),
+                             pz[i] * (Metre / Second)});
+
+    // See if this is a point whose degrees of freedom must be restored
+    // exactly.
+    Instant const time = Instant() + t[i] * Second;
+    if (auto it = exact.find(time); it == exact.cend()) {
+      Append(time, DegreesOfFreedom<Frame>(q, p)).IgnoreError();
+    } else {
+      Append(time, it->degrees_of_freedom).IgnoreError();
+    }
+  }
+}
+
+template<typename Frame>
+void DiscreteTrajectorySegment<Frame>::WriteDownsamplingToMessage(
+    not_null<serialization::DiscreteTrajectorySegment*> const message,
     std::int64_t const timeline_size,
-    std::int64_t const number_of_points_to_skip_at_end,
-    std::vector<iterator> const& exact) const {
+    std::int64_t const number_of_points_to_skip_at_end) const {
   if (downsampling_parameters_.has_value()) {
     auto* const serialized_downsampling_parameters =
         message->mutable_downsampling_parameters();
@@ -630,6 +813,18 @@ void DiscreteTrajectorySegment<Frame>::WriteToMessage(
             0, number_of_dense_points_ - number_of_points_to_skip_at_end)));
   }
   message->set_was_downsampled(was_downsampled_);
+}
+
+template<typename Frame>
+void DiscreteTrajectorySegment<Frame>::WriteToMessage(
+    not_null<serialization::DiscreteTrajectorySegment*> message,
+    typename Timeline::const_iterator const timeline_begin,
+    typename Timeline::const_iterator const timeline_end,
+    std::int64_t const timeline_size,
+    std::int64_t const number_of_points_to_skip_at_end,
+    std::vector<iterator> const& exact) const {
+  WriteDownsamplingToMessage(
+      message, timeline_size, number_of_points_to_skip_at_end);
 
   // Convert the |exact| vector into a set, and add the extremities.  This
   // ensures that we don't have redundancies.  The set is sorted by time to
@@ -677,8 +872,9 @@ void DiscreteTrajectorySegment<Frame>::WriteToMessage(
   px.reserve(timeline_size);
   py.reserve(timeline_size);
   pz.reserve(timeline_size);
+  std::vector<Time> Δt;
+  Δt.reserve(timeline_size);
   std::optional<Instant> previous_instant;
-  Time max_Δt;
   std::string* const zfp_timeline = zfp->mutable_timeline();
   for (auto it = timeline_begin; it != timeline_end; ++it) {
     auto const& [instant, degrees_of_freedom] = *it;
@@ -691,33 +887,64 @@ void DiscreteTrajectorySegment<Frame>::WriteToMessage(
     px.push_back(p.coordinates().x / (Metre / Second));
     py.push_back(p.coordinates().y / (Metre / Second));
     pz.push_back(p.coordinates().z / (Metre / Second));
-    if (previous_instant.has_value()) {
-      max_Δt = std::max(max_Δt, instant - *previous_instant);
-    }
+    Δt.push_back(previous_instant.has_value() ? instant - *previous_instant
+                                              : Time());
     previous_instant = instant;
   }
 
   // Times are exact.
-  ZfpCompressor time_compressor(0);
+  ZfpCompressor const time_compressor(0);
   // Lengths are approximated to the downsampling tolerance if downsampling is
   // enabled, otherwise they are exact.
   Length const length_tolerance = downsampling_parameters_.has_value()
                                       ? downsampling_parameters_->tolerance
                                       : Length();
-  ZfpCompressor length_compressor(length_tolerance / Metre);
-  // Speeds are approximated based on the length tolerance and the maximum
-  // step in the timeline.
-  ZfpCompressor const speed_compressor((length_tolerance / max_Δt) /
-                                        (Metre / Second));
+  ZfpCompressor const length_compressor(length_tolerance / Metre);
 
   ZfpCompressor::WriteVersion(message);
-  time_compressor.WriteToMessageMultidimensional<2>(t, zfp_timeline);
-  length_compressor.WriteToMessageMultidimensional<2>(qx, zfp_timeline);
-  length_compressor.WriteToMessageMultidimensional<2>(qy, zfp_timeline);
-  length_compressor.WriteToMessageMultidimensional<2>(qz, zfp_timeline);
-  speed_compressor.WriteToMessageMultidimensional<2>(px, zfp_timeline);
-  speed_compressor.WriteToMessageMultidimensional<2>(py, zfp_timeline);
-  speed_compressor.WriteToMessageMultidimensional<2>(pz, zfp_timeline);
+
+  // The timeline is split into chunks that are compressed independently, and
+  // an index is written to make it possible to only decompress the chunks
+  // that cover a given interval.
+  for (std::int64_t chunk_begin = 0;
+       chunk_begin < timeline_size;
+       chunk_begin += points_per_zfp_chunk) {
+    std::int64_t const chunk_end =
+        std::min(timeline_size, chunk_begin + points_per_zfp_chunk);
+
+    auto* const chunk = zfp->add_chunk();
+    (Instant{} + t[chunk_begin] * Second).WriteToMessage(
+        chunk->mutable_t_min());
+    (Instant{} + t[chunk_end - 1] * Second).WriteToMessage(
+        chunk->mutable_t_max());
+    chunk->set_size(chunk_end - chunk_begin);
+    chunk->set_offset(zfp_timeline->size());
+
+    // Speeds are approximated based on the length tolerance and the maximum
+    // step in the chunk (including the step leading to it).  This adapts the
+    // accuracy to the local density of the timeline.
+    Time const max_Δt = *std::max_element(Δt.begin() + chunk_begin,
+                                          Δt.begin() + chunk_end);
+    auto const speed_compressor = ZfpCompressor::WithAdaptiveAccuracy(
+        length_tolerance / Metre, max_Δt / Second);
+
+    auto const write_column = [chunk_begin, chunk_end, zfp_timeline](
+                                  ZfpCompressor const& compressor,
+                                  std::vector<double> const& column) {
+      // The compressor pads its input, so we cannot give it a view of the
+      // entire column.
+      std::vector<double> chunk_column(column.begin() + chunk_begin,
+                                       column.begin() + chunk_end);
+      compressor.WriteToMessageMultidimensional<2>(chunk_column, zfp_timeline);
+    };
+    write_column(time_compressor, t);
+    write_column(length_compressor, qx);
+    write_column(length_compressor, qy);
+    write_column(length_compressor, qz);
+    write_column(speed_compressor, px);
+    write_column(speed_compressor, py);
+    write_column(speed_compressor, pz);
+  }
 }
 
 }  // namespace internal
@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 
+#include "base/array.hpp"
 #include "base/not_null.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/instant.hpp"
@@ -27,6 +28,7 @@ namespace physics {
 using ::testing::Eq;
 using ::testing::Le;
 using ::testing::Lt;
+using namespace principia::base::_array;
 using namespace principia::base::_not_null;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_instant;
@@ -66,6 +68,10 @@ class DiscreteTrajectorySegmentTest : public ::testing::Test {
     EXPECT_OK(segment_->Append(t0_ + 11 * Second, unmoving_origin_));
   }
 
+  void Append(Instant const& t) {
+    EXPECT_OK(segment_->Append(t, unmoving_origin_));
+  }
+
   void ForgetAfter(Instant const& t) {
     segment_->ForgetAfter(t);
   }
@@ -84,6 +90,10 @@ class DiscreteTrajectorySegmentTest : public ::testing::Test {
     segment.ForgetBefore(t);
   }
 
+  void MarkUnchanged() {
+    segment_->MarkUnchanged();
+  }
+
   static DiscreteTrajectorySegmentIterator<World> MakeIterator(
       not_null<Segments*> const segments,
       typename Segments::iterator iterator) {
@@ -100,6 +110,11 @@ class DiscreteTrajectorySegmentTest : public ::testing::Test {
     return segments;
   }
 
+  static std::int64_t number_of_dense_points(
+      DiscreteTrajectorySegment<World> const& segment) {
+    return segment.number_of_dense_points_;
+  }
+
   DiscreteTrajectorySegment<World>* segment_;
   not_null<std::unique_ptr<Segments>> segments_;
   Instant const t0_;
@@ -205,6 +220,27 @@ TEST_F(DiscreteTrajectorySegmentTest, ForgetBeforeTheBeginning) {
   EXPECT_EQ(t0_ + 2 * Second, segment_->begin()->time);
 }
 
+TEST_F(DiscreteTrajectorySegmentTest, EarliestChange) {
+  EXPECT_EQ(InfinitePast, segment_->earliest_change());
+  MarkUnchanged();
+  EXPECT_EQ(InfiniteFuture, segment_->earliest_change());
+
+  // Appending and forgetting at the beginning are not changes.
+  Append(t0_ + 13 * Second);
+  ForgetBefore(t0_ + 3 * Second);
+  EXPECT_EQ(InfiniteFuture, segment_->earliest_change());
+
+  ForgetAfter(t0_ + 7 * Second);
+  EXPECT_EQ(t0_ + 7 * Second, segment_->earliest_change());
+  ForgetAfter(t0_ + 4 * Second);
+  EXPECT_EQ(t0_ + 5 * Second, segment_->earliest_change());
+  Append(t0_ + 17 * Second);
+  EXPECT_EQ(t0_ + 5 * Second, segment_->earliest_change());
+
+  MarkUnchanged();
+  EXPECT_EQ(InfiniteFuture, segment_->earliest_change());
+}
+
 TEST_F(DiscreteTrajectorySegmentTest, Evaluate) {
   auto const segments = MakeSegments(1);
   auto& circle = *segments->begin();
@@ -536,5 +572,187 @@ TEST_F(DiscreteTrajectorySegmentTest, SerializationRange) {
   EXPECT_THAT(message1, EqualsProto(message2));
 }
 
+TEST_F(DiscreteTrajectorySegmentTest, SerializationWithPoints) {
+  auto const circle_segments = MakeSegments(1);
+  auto& circle = *circle_segments->begin();
+  circle.SetDownsampling(
+      {.max_dense_intervals = 50, .tolerance = 1 * Milli(Metre)});
+  AngularFrequency const ω = 3 * Radian / Second;
+  Length const r = 2 * Metre;
+  Time const Δt = 10 * Milli(Second);
+  Instant const t1 = t0_;
+  Instant const t2 = t0_ + 5 * Second;
+  AppendTrajectoryTimeline(
+      NewCircularTrajectoryTimeline<World>(ω, r, Δt, t1, t2),
+      /*to=*/circle);
+
+  serialization::DiscreteTrajectorySegment message1;
+  std::vector<double> points;
+  circle.WriteToMessage(&message1, circle.begin(), circle.end());
+  circle.WritePoints(circle.begin(), circle.end(), &points);
+  EXPECT_FALSE(message1.has_zfp());
+  EXPECT_EQ(circle.size() * DiscreteTrajectorySegment<World>::doubles_per_point,
+            points.size());
+
+  // Split the points in two arrays to check that they are concatenated.
+  std::int64_t const split =
+      (circle.size() / 2) * DiscreteTrajectorySegment<World>::doubles_per_point;
+  auto const deserialized_circle_segments = MakeSegments(1);
+  auto& deserialized_circle = *deserialized_circle_segments->begin();
+  deserialized_circle = DiscreteTrajectorySegment<World>::ReadFromMessage(
+      message1,
+      {Array<double const>(points.data(), split),
+       Array<double const>(points.data() + split, points.size() - split)},
+      /*self=*/MakeIterator(deserialized_circle_segments.get(),
+                            deserialized_circle_segments->begin()));
+
+  EXPECT_EQ(circle.size(), deserialized_circle.size());
+  for (auto it1 = circle.begin(), it2 = deserialized_circle.begin();
+       it1 != circle.end();
+       ++it1, ++it2) {
+    EXPECT_EQ(it1->time, it2->time);
+    EXPECT_EQ(it1->degrees_of_freedom, it2->degrees_of_freedom);
+  }
+
+  serialization::DiscreteTrajectorySegment message2;
+  deserialized_circle.WriteToMessage(&message2,
+                                     deserialized_circle.begin(),
+                                     deserialized_circle.end());
+  EXPECT_THAT(message2, EqualsProto(message1));
+}
+
+TEST_F(DiscreteTrajectorySegmentTest, SerializationChunks) {
+  auto const circle_segments = MakeSegments(1);
+  auto& circle = *circle_segments->begin();
+  AngularFrequency const ω = 3 * Radian / Second;
+  Length const r = 2 * Metre;
+  // A time step that is exactly representable to avoid rounding errors.
+  Time const Δt = 1.0 / 128.0 * Second;
+  Instant const t1 = t0_;
+  Instant const t2 = t0_ + 5000 * Δt;
+  AppendTrajectoryTimeline(
+      NewCircularTrajectoryTimeline<World>(ω, r, Δt, t1, t2),
+      /*to=*/circle);
+  EXPECT_THAT(circle.size(), Eq(5000));
+
+  serialization::DiscreteTrajectorySegment message;
+  circle.WriteToMessage(&message, /*exact=*/{});
+  EXPECT_EQ(5, message.zfp().chunk_size());
+  EXPECT_EQ(0, message.zfp().chunk(0).offset());
+  EXPECT_EQ(1024, message.zfp().chunk(0).size());
+  EXPECT_EQ(904, message.zfp().chunk(4).size());
+
+  // Reading the entire segment restores all the points exactly since there is
+  // no downsampling.
+  {
+    auto const deserialized_circle_segments = MakeSegments(1);
+    auto& deserialized_circle = *deserialized_circle_segments->begin();
+    deserialized_circle = DiscreteTrajectorySegment<World>::ReadFromMessage(
+        message,
+        /*self=*/MakeIterator(deserialized_circle_segments.get(),
+                              deserialized_circle_segments->begin()));
+    EXPECT_THAT(deserialized_circle.size(), Eq(circle.size()));
+    for (auto it1 = circle.begin(), it2 = deserialized_circle.begin();
+         it1 != circle.end();
+         ++it1, ++it2) {
+      EXPECT_EQ(it1->time, it2->time);
+      EXPECT_EQ(it1->degrees_of_freedom, it2->degrees_of_freedom);
+    }
+  }
+
+  // Reading an interval that straddles two chunks only decompresses these two
+  // chunks.
+  {
+    Instant const t_min = t0_ + 15 * Second;
+    Instant const t_max = t0_ + 17 * Second;
+    auto const deserialized_circle_segments = MakeSegments(1);
+    auto& deserialized_circle = *deserialized_circle_segments->begin();
+    deserialized_circle = DiscreteTrajectorySegment<World>::ReadFromMessage(
+        message,
+        t_min,
+        t_max,
+        /*self=*/MakeIterator(deserialized_circle_segments.get(),
+                              deserialized_circle_segments->begin()));
+    EXPECT_THAT(deserialized_circle.size(), Eq(2048));
+    EXPECT_EQ(t0_ + 1024 * Δt, deserialized_circle.t_min());
+    EXPECT_EQ(t0_ + 3071 * Δt, deserialized_circle.t_max());
+    for (auto it = circle.lower_bound(t_min);
+         it != circle.upper_bound(t_max);
+         ++it) {
+      EXPECT_EQ(it->degrees_of_freedom,
+                deserialized_circle.find(it->time)->degrees_of_freedom);
+    }
+    EXPECT_EQ(circle.EvaluateDegreesOfFreedom(t_min + Δt / 2),
+              deserialized_circle.EvaluateDegreesOfFreedom(t_min + Δt / 2));
+  }
+}
+
+TEST_F(DiscreteTrajectorySegmentTest, SerializationChunksDensePoints) {
+  auto const circle_segments = MakeSegments(1);
+  auto& circle = *circle_segments->begin();
+  AngularFrequency const ω = 3 * Radian / Second;
+  Length const r = 2 * Metre;
+  Time const Δt = 1.0 / 128.0 * Second;
+  Instant const t1 = t0_;
+  Instant const t2 = t0_ + 5000 * Δt;
+  AppendTrajectoryTimeline(
+      NewCircularTrajectoryTimeline<World>(ω, r, Δt, t1, t2),
+      /*to=*/circle);
+
+  // Pretend that the last 1500 points of the segment are dense; they span the
+  // last two chunks.
+  serialization::DiscreteTrajectorySegment message;
+  circle.WriteToMessage(&message, /*exact=*/{});
+  message.set_was_downsampled(false);
+  message.set_number_of_dense_points(1500);
+  auto* const downsampling_parameters =
+      message.mutable_downsampling_parameters();
+  downsampling_parameters->set_max_dense_intervals(10'000);
+  (1 * Metre).WriteToMessage(downsampling_parameters->mutable_tolerance());
+
+  // When the end of the timeline is not restored, none of the restored points
+  // are dense, even those that are in the dense part of the original timeline.
+  {
+    auto const deserialized_circle_segments = MakeSegments(1);
+    auto& deserialized_circle = *deserialized_circle_segments->begin();
+    deserialized_circle = DiscreteTrajectorySegment<World>::ReadFromMessage(
+        message,
+        /*t_min=*/t0_ + 3500 * Δt,
+        /*t_max=*/t0_ + 3600 * Δt,
+        /*self=*/MakeIterator(deserialized_circle_segments.get(),
+                              deserialized_circle_segments->begin()));
+    EXPECT_EQ(t0_ + 4095 * Δt, deserialized_circle.t_max());
+    EXPECT_EQ(0, number_of_dense_points(deserialized_circle));
+  }
+
+  // When the end of the timeline is restored, all the dense points are.
+  {
+    auto const deserialized_circle_segments = MakeSegments(1);
+    auto& deserialized_circle = *deserialized_circle_segments->begin();
+    deserialized_circle = DiscreteTrajectorySegment<World>::ReadFromMessage(
+        message,
+        /*t_min=*/t0_ + 3500 * Δt,
+        /*t_max=*/t0_ + 5000 * Δt,
+        /*self=*/MakeIterator(deserialized_circle_segments.get(),
+                              deserialized_circle_segments->begin()));
+    EXPECT_EQ(t0_ + 4999 * Δt, deserialized_circle.t_max());
+    EXPECT_EQ(1500, number_of_dense_points(deserialized_circle));
+  }
+
+  // When only the last chunk is restored, all its points are dense.
+  {
+    auto const deserialized_circle_segments = MakeSegments(1);
+    auto& deserialized_circle = *deserialized_circle_segments->begin();
+    deserialized_circle = DiscreteTrajectorySegment<World>::ReadFromMessage(
+        message,
+        /*t_min=*/t0_ + 4900 * Δt,
+        /*t_max=*/t0_ + 5000 * Δt,
+        /*self=*/MakeIterator(deserialized_circle_segments.get(),
+                              deserialized_circle_segments->begin()));
+    EXPECT_EQ(t0_ + 4096 * Δt, deserialized_circle.t_min());
+    EXPECT_EQ(904, number_of_dense_points(deserialized_circle));
+  }
+}
+
 }  // namespace physics
 }  // namespace principia
@@ -1,9 +1,11 @@
 #include "physics/discrete_trajectory.hpp"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "astronomy/time_scales.hpp"
+#include "base/array.hpp"
 #include "base/serialization.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/instant.hpp"
@@ -33,6 +35,7 @@ using ::testing::Eq;
 using ::testing::HasSubstr;
 using ::testing::Not;
 using namespace principia::astronomy::_time_scales;
+using namespace principia::base::_array;
 using namespace principia::base::_serialization;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_instant;
@@ -832,6 +835,46 @@ TEST_F(DiscreteTrajectoryTest, SerializationRange) {
   EXPECT_THAT(message1, EqualsProto(message2));
 }
 
+TEST_F(DiscreteTrajectoryTest, SerializationWithPoints) {
+  auto const trajectory = MakeTrajectory();
+  auto const trajectory_second_segment =
+      std::next(trajectory.segments().begin());
+
+  serialization::DiscreteTrajectory message1;
+  std::vector<std::pair<DiscreteTrajectory<World>::iterator,
+                        DiscreteTrajectory<World>::iterator>>
+      segment_ranges;
+  trajectory.WriteToMessage(&message1,
+                            /*begin=*/trajectory.begin(),
+                            /*end=*/trajectory.end(),
+                            /*tracked=*/{trajectory_second_segment},
+                            segment_ranges);
+  ASSERT_EQ(message1.segment_size(), segment_ranges.size());
+
+  std::vector<std::vector<double>> points(segment_ranges.size());
+  std::vector<std::vector<Array<double const>>> arrays;
+  auto sit = trajectory.segments().begin();
+  for (int i = 0; i < segment_ranges.size(); ++i, ++sit) {
+    auto const& [begin, end] = segment_ranges[i];
+    sit->WritePoints(begin, end, &points[i]);
+    arrays.push_back({points[i]});
+  }
+
+  DiscreteTrajectorySegmentIterator<World> deserialized_second_segment;
+  auto const deserialized_trajectory =
+      DiscreteTrajectory<World>::ReadFromMessage(
+          message1, /*tracked=*/{&deserialized_second_segment}, arrays);
+  EXPECT_EQ(t0_ + 4 * Second, deserialized_second_segment->begin()->time);
+  EXPECT_EQ(t0_ + 9 * Second, deserialized_second_segment->rbegin()->time);
+  EXPECT_EQ(trajectory.size(), deserialized_trajectory.size());
+  for (auto it1 = trajectory.begin(), it2 = deserialized_trajectory.begin();
+       it1 != trajectory.end();
+       ++it1, ++it2) {
+    EXPECT_EQ(it1->time, it2->time);
+    EXPECT_EQ(it1->degrees_of_freedom, it2->degrees_of_freedom);
+  }
+}
+
 TEST_F(DiscreteTrajectoryTest, DISABLED_SerializationPreHamiltonCompatibility) {
   StringLogSink log_warning(google::WARNING);
   auto const serialized_message = ReadFromBinaryFile(
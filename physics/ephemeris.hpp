@@ -9,8 +9,10 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
+#include "base/array.hpp"
 #include "base/recurring_thread.hpp"
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/grassmann.hpp"
 #include "geometry/instant.hpp"
 #include "geometry/space.hpp"
@@ -36,8 +38,10 @@ namespace physics {
 namespace _ephemeris {
 namespace internal {
 
+using namespace principia::base::_array;
 using namespace principia::base::_not_null;
 using namespace principia::base::_recurring_thread;
+using namespace principia::base::_thread_pool;
 using namespace principia::base::_traits;
 using namespace principia::geometry::_grassmann;
 using namespace principia::geometry::_instant;
@@ -133,6 +137,8 @@ class Ephemeris {
 
   virtual FixedStepSizeIntegrator<NewtonianMotionEquation> const&
   planetary_integrator() const;
+  // The step of the integration of the massive bodies.
+  virtual Time planetary_step() const;
 
   virtual absl::Status last_severe_integration_status() const;
 
@@ -140,6 +146,12 @@ class Ephemeris {
   // is stopped.  After a successful call, |t_max() >= t|.
   virtual absl::Status Prolong(Instant const& t) EXCLUDES(lock_);
 
+  // Same as above, but the trajectories of the massive bodies are extended,
+  // and their polynomials fitted, concurrently on |thread_pool|.  This is
+  // useful to warm up an ephemeris with many bodies.
+  virtual absl::Status Prolong(Instant const& t,
+                               ThreadPool<void>& thread_pool) EXCLUDES(lock_);
+
   // Asks the reanimator thread to asynchronously reconstruct the past so that
   // the |t_min()| of the ephemeris ultimately ends up at or before
   // |desired_t_min|.
@@ -254,6 +266,26 @@ class Ephemeris {
       Instant const& desired_t_min,
       serialization::Ephemeris const& message) EXCLUDES(lock_);
 
+  // Same as above, but the polynomials of the trajectories are not written to
+  // |message|.  Instead, those of the |i|th trajectory of |message| are
+  // appended to |polynomials[i]|, see |ContinuousTrajectory::WriteToMessage|.
+  // Only the checkpoints and the polynomials that are strictly after |after|
+  // are written.
+  virtual void WriteToMessage(
+      not_null<serialization::Ephemeris*> message,
+      Instant const& after,
+      std::vector<std::vector<double>>& polynomials) const EXCLUDES(lock_);
+  // Same as above, for a |message| written without the polynomials of its
+  // trajectories.  Those of the |i|th trajectory are read from
+  // |polynomials[i]|.
+  template<typename F = Frame,
+           typename = std::enable_if_t<is_serializable_v<F>>>
+  static not_null<std::unique_ptr<Ephemeris>> ReadFromMessage(
+      Instant const& desired_t_min,
+      serialization::Ephemeris const& message,
+      std::vector<std::vector<Array<double const>>> const& polynomials)
+      EXCLUDES(lock_);
+
  protected:
   // For mocking purposes, leaves everything uninitialized and uses the given
   // |integrator|.
@@ -261,6 +293,19 @@ class Ephemeris {
                          Frame>::NewtonianMotionEquation> const& integrator);
 
  private:
+  // Implementation of serialization.  If |polynomials| is null, the
+  // polynomials are written to |message|.
+  void WriteToMessage(not_null<serialization::Ephemeris*> message,
+                      Instant const& after,
+                      std::vector<std::vector<double>>* polynomials) const
+      EXCLUDES(lock_);
+  // Implementation of deserialization.  If |polynomials| is null, the
+  // polynomials are read from |message|.
+  static not_null<std::unique_ptr<Ephemeris>> ReadFromMessage(
+      Instant const& desired_t_min,
+      serialization::Ephemeris const& message,
+      std::vector<std::vector<Array<double const>>> const* polynomials);
+
   // Checkpointing support.
   void WriteToCheckpointIfNeeded(Instant const& time) const
       SHARED_LOCKS_REQUIRED(lock_);
@@ -280,6 +325,10 @@ class Ephemeris {
       Instant const& t_initial,
       Instant const& t_final) EXCLUDES(lock_);
 
+  // Prolongs the ephemeris up to at least |t|, appending the states of the
+  // massive bodies on |append_thread_pool_| if it is not null.
+  absl::Status ProlongLocked(Instant const& t) REQUIRES(lock_);
+
   // Callbacks for the integrators.
   void AppendMassiveBodiesState(
       typename NewtonianMotionEquation::State const& state)
@@ -288,6 +337,10 @@ class Ephemeris {
   static std::vector<absl::Status> AppendMassiveBodiesStateToTrajectories(
       typename NewtonianMotionEquation::State const& state,
       std::vector<not_null<ContinuousTrajectoryPtr>> const& trajectories);
+  static std::vector<absl::Status> AppendMassiveBodiesStateToTrajectories(
+      typename NewtonianMotionEquation::State const& state,
+      std::vector<not_null<ContinuousTrajectory<Frame>*>> const& trajectories,
+      ThreadPool<void>& thread_pool);
   static void AppendMasslessBodiesStateToTrajectories(
       typename NewtonianMotionEquation::State const& state,
       std::vector<not_null<DiscreteTrajectory<Frame>*>> const& trajectories);
@@ -446,6 +499,9 @@ class Ephemeris {
       instance_ GUARDED_BY(lock_);
 
   absl::Status last_severe_integration_status_ GUARDED_BY(lock_);
+
+  // Only set for the duration of a call to |Prolong| with a thread pool.
+  ThreadPool<void>* append_thread_pool_ GUARDED_BY(lock_) = nullptr;
 };
 
 }  // namespace internal
@@ -3,7 +3,9 @@
 #include "physics/ephemeris.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <future>
 #include <limits>
 #include <optional>
 #include <utility>
@@ -215,6 +217,11 @@ Ephemeris<Frame>::planetary_integrator() const {
   return fixed_step_parameters_.integrator();
 }
 
+template<typename Frame>
+Time Ephemeris<Frame>::planetary_step() const {
+  return fixed_step_parameters_.step();
+}
+
 template<typename Frame>
 absl::Status Ephemeris<Frame>::last_severe_integration_status() const {
   absl::ReaderMutexLock l(&lock_);
@@ -275,28 +282,23 @@ absl::Status Ephemeris<Frame>::Prolong(Instant const& t) {
     return absl::OkStatus();
   }
 
-  // Note that |t| may be before the last time that we integrated and still
-  // after |t_max()|.  In this case we want to make sure that the integrator
-  // makes progress.
-  Instant t_final;
-  Instant const instance_time = this->instance_time();
-  if (t <= instance_time) {
-    t_final = instance_time + fixed_step_parameters_.step();
-  } else {
-    t_final = t;
-  }
-
-  // Perform the integration.  Note that we may have to iterate until |t_max()|
-  // actually reaches |t| because the last series may not be fully determined
-  // after the first integration.
   absl::MutexLock l(&lock_);
-  while (t_max_locked() < t) {
-    instance_->Solve(t_final).IgnoreError();
-    RETURN_IF_STOPPED;
-    t_final += fixed_step_parameters_.step();
+  return ProlongLocked(t);
+}
+
+template<typename Frame>
+absl::Status Ephemeris<Frame>::Prolong(Instant const& t,
+                                       ThreadPool<void>& thread_pool) {
+  // Short-circuit without locking.
+  if (t <= t_max()) {
+    return absl::OkStatus();
   }
 
-  return absl::OkStatus();
+  absl::MutexLock l(&lock_);
+  append_thread_pool_ = &thread_pool;
+  absl::Status const status = ProlongLocked(t);
+  append_thread_pool_ = nullptr;
+  return status;
 }
 
 template<typename Frame>
@@ -651,13 +653,46 @@ not_null<MassiveBody const*> Ephemeris<Frame>::body_for_serialization_index(
 template<typename Frame>
 void Ephemeris<Frame>::WriteToMessage(
     not_null<serialization::Ephemeris*> const message) const {
+  WriteToMessage(message, /*after=*/InfinitePast, /*polynomials=*/nullptr);
+}
+
+template<typename Frame>
+template<typename, typename>
+not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
+    Instant const& desired_t_min,
+    serialization::Ephemeris const& message) {
+  return ReadFromMessage(desired_t_min, message, /*polynomials=*/nullptr);
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::WriteToMessage(
+    not_null<serialization::Ephemeris*> const message,
+    Instant const& after,
+    std::vector<std::vector<double>>& polynomials) const {
+  WriteToMessage(message, after, &polynomials);
+}
+
+template<typename Frame>
+template<typename, typename>
+not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
+    Instant const& desired_t_min,
+    serialization::Ephemeris const& message,
+    std::vector<std::vector<Array<double const>>> const& polynomials) {
+  return ReadFromMessage(desired_t_min, message, &polynomials);
+}
+
+template<typename Frame>
+void Ephemeris<Frame>::WriteToMessage(
+    not_null<serialization::Ephemeris*> const message,
+    Instant const& after,
+    std::vector<std::vector<double>>* const polynomials) const {
   LOG(INFO) << __FUNCTION__;
   absl::ReaderMutexLock l(&lock_);
 
   // Make sure that a checkpoint exists, otherwise we would not serialize some
   // parts of the state.
   WriteToCheckpointIfNeeded(instance_->time().value);
-  checkpointer_->WriteToMessage(message->mutable_checkpoint());
+  checkpointer_->WriteToMessage(message->mutable_checkpoint(), after);
 
   // The bodies are serialized in the order in which they were given at
   // construction.
@@ -666,8 +701,18 @@ void Ephemeris<Frame>::WriteToMessage(
   }
   // The trajectories are serialized in the order resulting from the separation
   // between oblate and spherical bodies.
-  for (auto const& trajectory : trajectories_) {
-    trajectory->WriteToMessage(message->add_trajectory());
+  if (polynomials == nullptr) {
+    CHECK_EQ(InfinitePast, after);
+    for (auto const& trajectory : trajectories_) {
+      trajectory->WriteToMessage(message->add_trajectory());
+    }
+  } else {
+    polynomials->resize(trajectories_.size());
+    for (int i = 0; i < trajectories_.size(); ++i) {
+      trajectories_[i]->WriteToMessage(message->add_trajectory(),
+                                       after,
+                                       (*polynomials)[i]);
+    }
   }
   fixed_step_parameters_.WriteToMessage(
       message->mutable_fixed_step_parameters());
@@ -678,10 +723,10 @@ void Ephemeris<Frame>::WriteToMessage(
 }
 
 template<typename Frame>
-template<typename, typename>
 not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
     Instant const& desired_t_min,
-    serialization::Ephemeris const& message) {
+    serialization::Ephemeris const& message,
+    std::vector<std::vector<Array<double const>>> const* const polynomials) {
   bool const is_pre_ἐρατοσθένης = !message.has_accuracy_parameters();
   bool const is_pre_fatou = !message.has_checkpoint_time();
   bool const is_pre_grassmann = message.checkpoint_size() == 0;
@@ -721,11 +766,18 @@ not_null<std::unique_ptr<Ephemeris<Frame>>> Ephemeris<Frame>::ReadFromMessage(
   int index = 0;
   ephemeris->bodies_to_trajectories_.clear();
   ephemeris->trajectories_.clear();
+  if (polynomials != nullptr) {
+    CHECK_EQ(message.trajectory_size(), polynomials->size());
+  }
   for (auto const& trajectory : message.trajectory()) {
     not_null<MassiveBody const*> const body = ephemeris->bodies_[index].get();
     not_null<std::unique_ptr<ContinuousTrajectory<Frame>>>
-        deserialized_trajectory = ContinuousTrajectory<Frame>::ReadFromMessage(
-            desired_t_min, trajectory);
+        deserialized_trajectory =
+            polynomials == nullptr
+                ? ContinuousTrajectory<Frame>::ReadFromMessage(desired_t_min,
+                                                               trajectory)
+                : ContinuousTrajectory<Frame>::ReadFromMessage(
+                      desired_t_min, trajectory, (*polynomials)[index]);
     ephemeris->trajectories_.push_back(deserialized_trajectory.get());
     ephemeris->bodies_to_trajectories_.emplace(
         body, std::move(deserialized_trajectory));
@@ -934,14 +986,44 @@ absl::Status Ephemeris<Frame>::ReanimateOneCheckpoint(
   return absl::OkStatus();
 }
 
+template<typename Frame>
+absl::Status Ephemeris<Frame>::ProlongLocked(Instant const& t) {
+  lock_.AssertHeld();
+
+  // Note that |t| may be before the last time that we integrated and still
+  // after |t_max()|.  In this case we want to make sure that the integrator
+  // makes progress.
+  Instant t_final;
+  Instant const instance_time = instance_->time().value;
+  if (t <= instance_time) {
+    t_final = instance_time + fixed_step_parameters_.step();
+  } else {
+    t_final = t;
+  }
+
+  // Perform the integration.  Note that we may have to iterate until |t_max()|
+  // actually reaches |t| because the last series may not be fully determined
+  // after the first integration.
+  while (t_max_locked() < t) {
+    instance_->Solve(t_final).IgnoreError();
+    RETURN_IF_STOPPED;
+    t_final += fixed_step_parameters_.step();
+  }
+
+  return absl::OkStatus();
+}
+
 template<typename Frame>
 void Ephemeris<Frame>::AppendMassiveBodiesState(
     typename NewtonianMotionEquation::State const& state) {
   lock_.AssertHeld();
 
   // Extend the trajectories.
-  auto const statuses = AppendMassiveBodiesStateToTrajectories(state,
-                                                               trajectories_);
+  auto const statuses =
+      append_thread_pool_ == nullptr
+          ? AppendMassiveBodiesStateToTrajectories(state, trajectories_)
+          : AppendMassiveBodiesStateToTrajectories(
+                state, trajectories_, *append_thread_pool_);
 
   // Handle the apocalypse.
   for (int i = 0; i < statuses.size(); ++i) {
@@ -981,6 +1063,43 @@ Ephemeris<Frame>::AppendMassiveBodiesStateToTrajectories(
   return statuses;
 }
 
+template<typename Frame>
+std::vector<absl::Status>
+Ephemeris<Frame>::AppendMassiveBodiesStateToTrajectories(
+    typename NewtonianMotionEquation::State const& state,
+    std::vector<not_null<ContinuousTrajectory<Frame>*>> const& trajectories,
+    ThreadPool<void>& thread_pool) {
+  std::vector<absl::Status> statuses(trajectories.size());
+  Instant const time = state.time.value;
+  // The trajectories are split in contiguous ranges, one per thread.  Most
+  // calls to |Append| are cheap, but those that fit a polynomial happen at the
+  // same step for all the trajectories.
+  std::int64_t const size = trajectories.size();
+  std::int64_t const ranges = std::min(thread_pool.size(), size);
+  std::vector<std::future<void>> futures;
+  futures.reserve(ranges);
+  for (std::int64_t range = 0; range < ranges; ++range) {
+    futures.push_back(thread_pool.Add(
+        [begin = range * size / ranges,
+         end = (range + 1) * size / ranges,
+         time,
+         &state,
+         &statuses,
+         &trajectories]() {
+          for (std::int64_t index = begin; index < end; ++index) {
+            statuses[index] = trajectories[index]->Append(
+                time,
+                DegreesOfFreedom<Frame>(state.positions[index].value,
+                                        state.velocities[index].value));
+          }
+        }));
+  }
+  for (auto const& future : futures) {
+    future.wait();
+  }
+  return statuses;
+}
+
 template<typename Frame>
 void Ephemeris<Frame>::AppendMasslessBodiesStateToTrajectories(
     typename NewtonianMotionEquation::State const& state,
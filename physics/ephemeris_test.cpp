@@ -51,8 +51,10 @@ namespace physics {
 
 using ::testing::AllOf;
 using ::testing::AnyOf;
+using ::testing::ElementsAre;
 using ::testing::Eq;
 using ::testing::Gt;
+using ::testing::IsEmpty;
 using ::testing::Lt;
 using ::testing::Ref;
 using namespace principia::astronomy::_frames;
@@ -632,6 +634,15 @@ TEST_P(EphemerisTest, Serialization) {
   serialization::Ephemeris message;
   ephemeris.WriteToMessage(&message);
 
+  // The trajectories are restored from the checkpoints, so there are no
+  // polynomials to write separately.
+  serialization::Ephemeris message_without_polynomials;
+  std::vector<std::vector<double>> polynomials;
+  ephemeris.WriteToMessage(
+      &message_without_polynomials, /*after=*/InfinitePast, polynomials);
+  EXPECT_THAT(message_without_polynomials, EqualsProto(message));
+  EXPECT_THAT(polynomials, ElementsAre(IsEmpty(), IsEmpty()));
+
   auto const ephemeris_read = Ephemeris<ICRS>::ReadFromMessage(
       /*desired_t_min=*/InfiniteFuture,
       message);
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/frame.hpp"
 #include "geometry/identity.hpp"
 #include "physics/degrees_of_freedom.hpp"
@@ -18,6 +19,7 @@ namespace _hierarchical_system {
 namespace internal {
 
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_kepler_orbit;
 using namespace principia::physics::_massive_body;
@@ -46,6 +48,10 @@ class HierarchicalSystem final {
   // |*this| is invalid after a call to |ConsumeBarycentricSystem()|.
   BarycentricSystem ConsumeBarycentricSystem();
 
+  // Same as above, but the satellite subsystems of the primary (e.g., the
+  // planetary systems) are converted concurrently on |thread_pool|.
+  BarycentricSystem ConsumeBarycentricSystem(ThreadPool<void>& thread_pool);
+
   void WriteToMessage(
       not_null<serialization::HierarchicalSystem*> message) const;
 
@@ -84,8 +90,16 @@ class HierarchicalSystem final {
     std::vector<RelativeDegreesOfFreedom<Frame>> barycentric_degrees_of_freedom;
   };
 
-  // Invalidates its argument.
-  static BarycentricSubsystem ToBarycentric(System& system);
+  // Invalidates its argument.  If |thread_pool| is not null, the satellite
+  // subsystems of |system| are converted concurrently on it; their own
+  // satellites are converted sequentially.
+  static BarycentricSubsystem ToBarycentric(System& system,
+                                            ThreadPool<void>* thread_pool);
+
+  // Puts the barycentre of |barycentric_subsystem| at the motionless origin of
+  // |Frame|.
+  static BarycentricSystem ToBarycentricSystem(
+      BarycentricSubsystem barycentric_subsystem);
 
   static void WriteToMessage(
       std::vector<not_null<std::unique_ptr<Subsystem>>> const& subsystems,
@@ -3,6 +3,7 @@
 #include "physics/hierarchical_system.hpp"
 
 #include <algorithm>
+#include <future>
 #include <iterator>
 #include <vector>
 
@@ -45,16 +46,14 @@ void HierarchicalSystem<Frame>::Add(
 template<typename Frame>
 typename HierarchicalSystem<Frame>::BarycentricSystem
 HierarchicalSystem<Frame>::ConsumeBarycentricSystem() {
-  BarycentricSystem result;
-  auto barycentric_result = ToBarycentric(system_);
-  result.bodies = std::move(barycentric_result.bodies);
-  static DegreesOfFreedom<Frame> const system_barycentre = {Frame::origin,
-                                                            Frame::unmoving};
-  for (auto const& barycentric_dof :
-       barycentric_result.barycentric_degrees_of_freedom) {
-    result.degrees_of_freedom.emplace_back(system_barycentre + barycentric_dof);
-  }
-  return std::move(result);
+  return ToBarycentricSystem(ToBarycentric(system_, /*thread_pool=*/nullptr));
+}
+
+template<typename Frame>
+typename HierarchicalSystem<Frame>::BarycentricSystem
+HierarchicalSystem<Frame>::ConsumeBarycentricSystem(
+    ThreadPool<void>& thread_pool) {
+  return ToBarycentricSystem(ToBarycentric(system_, &thread_pool));
 }
 
 template<typename Frame>
@@ -67,7 +66,9 @@ void HierarchicalSystem<Frame>::WriteToMessage(
 
 template<typename Frame>
 typename HierarchicalSystem<Frame>::BarycentricSubsystem
-HierarchicalSystem<Frame>::ToBarycentric(System& system) {
+HierarchicalSystem<Frame>::ToBarycentric(
+    System& system,
+    ThreadPool<void>* const thread_pool) {
   auto const semimajor_axis_less_than = [](
       not_null<std::unique_ptr<Subsystem>> const& left,
       not_null<std::unique_ptr<Subsystem>> const& right) -> bool {
@@ -122,11 +123,37 @@ HierarchicalSystem<Frame>::ToBarycentric(System& system) {
   std::vector<std::vector<RelativeDegreesOfFreedom<Frame>>>
       satellite_degrees_of_freedom;
 
+  // The satellite subsystems are independent from each other, so they may be
+  // converted concurrently.
+  std::vector<BarycentricSubsystem> barycentric_satellite_subsystems(
+      system.satellites.size());
+  if (thread_pool == nullptr) {
+    for (int n = 0; n < system.satellites.size(); ++n) {
+      barycentric_satellite_subsystems[n] =
+          ToBarycentric(*system.satellites[n], /*thread_pool=*/nullptr);
+    }
+  } else {
+    std::vector<std::future<void>> futures;
+    for (int n = 0; n < system.satellites.size(); ++n) {
+      futures.push_back(thread_pool->Add(
+          [&barycentric_satellite_subsystem =
+               barycentric_satellite_subsystems[n],
+           &subsystem = *system.satellites[n]]() {
+            barycentric_satellite_subsystem =
+                ToBarycentric(subsystem, /*thread_pool=*/nullptr);
+          }));
+    }
+    for (auto const& future : futures) {
+      future.wait();
+    }
+  }
+
   // Fill |satellite_degrees_of_freedom|, |jacobi_coordinates|, and
   // |result.bodies|.
-  for (auto const& subsystem : system.satellites) {
-    BarycentricSubsystem barycentric_satellite_subsystem =
-        ToBarycentric(*subsystem);
+  for (int n = 0; n < system.satellites.size(); ++n) {
+    auto const& subsystem = system.satellites[n];
+    BarycentricSubsystem& barycentric_satellite_subsystem =
+        barycentric_satellite_subsystems[n];
     satellite_degrees_of_freedom.emplace_back(std::move(
         barycentric_satellite_subsystem.barycentric_degrees_of_freedom));
     jacobi_coordinates.Add(*barycentric_satellite_subsystem.equivalent_body,
@@ -170,6 +197,21 @@ HierarchicalSystem<Frame>::ToBarycentric(System& system) {
   return std::move(result);
 }
 
+template<typename Frame>
+typename HierarchicalSystem<Frame>::BarycentricSystem
+HierarchicalSystem<Frame>::ToBarycentricSystem(
+    BarycentricSubsystem barycentric_subsystem) {
+  BarycentricSystem result;
+  result.bodies = std::move(barycentric_subsystem.bodies);
+  static DegreesOfFreedom<Frame> const system_barycentre = {Frame::origin,
+                                                            Frame::unmoving};
+  for (auto const& barycentric_dof :
+       barycentric_subsystem.barycentric_degrees_of_freedom) {
+    result.degrees_of_freedom.emplace_back(system_barycentre + barycentric_dof);
+  }
+  return result;
+}
+
 template<typename Frame>
 void HierarchicalSystem<Frame>::WriteToMessage(
     std::vector<not_null<std::unique_ptr<Subsystem>>> const& subsystems,
@@ -4,6 +4,7 @@
 #include <map>
 #include <vector>
 
+#include "base/thread_pool.hpp"
 #include "geometry/frame.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -15,6 +16,7 @@ namespace physics {
 
 using ::testing::ElementsAre;
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_frame;
 using namespace principia::physics::_degrees_of_freedom;
 using namespace principia::physics::_hierarchical_system;
@@ -140,5 +142,65 @@ TEST_F(HierarchicalSystemTest, FromMeanMotions) {
                           AlmostEquals(1 * Metre, 0, 1)));
 }
 
+// The concurrent conversion gives the same result as the sequential one.
+TEST_F(HierarchicalSystemTest, Concurrent) {
+  // i, and Ω are 0 by default.
+  KeplerianElements<World> elements;
+  elements.eccentricity = 0.1;
+  elements.argument_of_periapsis = 0 * Radian;
+
+  // A primary with 5 satellites, each with 3 satellites of its own.  Returns
+  // the bodies in the order of construction.
+  auto const make_system = [&elements](
+      std::vector<not_null<MassiveBody const*>>& bodies) {
+    auto primary = make_not_null_unique<MassiveBody>(1000 * Kilogram);
+    bodies.push_back(primary.get());
+    auto system =
+        std::make_unique<HierarchicalSystem<World>>(std::move(primary));
+    for (int i = 0; i < 5; ++i) {
+      auto planet = make_not_null_unique<MassiveBody>((10 + i) * Kilogram);
+      not_null<MassiveBody const*> const unowned_planet = planet.get();
+      bodies.push_back(unowned_planet);
+      elements.semimajor_axis = (100 + 20 * i) * Metre;
+      elements.mean_anomaly = i * Radian;
+      system->Add(std::move(planet), /*parent=*/bodies.front(), elements);
+      for (int j = 0; j < 3; ++j) {
+        auto moon = make_not_null_unique<MassiveBody>((1 + j) * Kilogram);
+        bodies.push_back(moon.get());
+        elements.semimajor_axis = (1 + j) * Metre;
+        elements.mean_anomaly = j * Radian;
+        system->Add(std::move(moon), /*parent=*/unowned_planet, elements);
+      }
+    }
+    return system;
+  };
+
+  std::vector<not_null<MassiveBody const*>> sequential_bodies;
+  std::vector<not_null<MassiveBody const*>> concurrent_bodies;
+  auto const sequential_system =
+      make_system(sequential_bodies)->ConsumeBarycentricSystem();
+  ThreadPool<void> thread_pool(/*pool_size=*/3);
+  auto const concurrent_system =
+      make_system(concurrent_bodies)->ConsumeBarycentricSystem(thread_pool);
+
+  ASSERT_EQ(21, sequential_system.bodies.size());
+  ASSERT_EQ(21, concurrent_system.bodies.size());
+  for (int i = 0; i < sequential_system.bodies.size(); ++i) {
+    int const sequential_index =
+        std::find(sequential_bodies.begin(),
+                  sequential_bodies.end(),
+                  sequential_system.bodies[i].get()) -
+        sequential_bodies.begin();
+    int const concurrent_index =
+        std::find(concurrent_bodies.begin(),
+                  concurrent_bodies.end(),
+                  concurrent_system.bodies[i].get()) -
+        concurrent_bodies.begin();
+    EXPECT_EQ(sequential_index, concurrent_index) << i;
+    EXPECT_EQ(sequential_system.degrees_of_freedom[i],
+              concurrent_system.degrees_of_freedom[i]) << i;
+  }
+}
+
 }  // namespace physics
 }  // namespace principia
@@ -42,8 +42,13 @@ class MockEphemeris : public Ephemeris<Frame> {
               planetary_integrator,
               (),
               (const, override));
+  MOCK_METHOD(Time, planetary_step, (), (const, override));
 
   MOCK_METHOD(absl::Status, Prolong, (Instant const& t), (override));
+  MOCK_METHOD(absl::Status,
+              Prolong,
+              (Instant const& t, ThreadPool<void>& thread_pool),
+              (override));
   MOCK_METHOD(
       not_null<std::unique_ptr<
           typename Integrator<NewtonianMotionEquation>::Instance>>,
@@ -97,6 +102,12 @@ class MockEphemeris : public Ephemeris<Frame> {
               WriteToMessage,
               (not_null<serialization::Ephemeris*> message),
               (const, override));
+  MOCK_METHOD(void,
+              WriteToMessage,
+              (not_null<serialization::Ephemeris*> message,
+               Instant const& after,
+               std::vector<std::vector<double>>& polynomials),
+              (const, override));
 
   MOCK_METHOD(Instant, t_min_locked, (), (const, override));
 };
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "base/not_null.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/instant.hpp"
 #include "integrators/ordinary_differential_equations.hpp"
 #include "physics/body.hpp"
@@ -26,6 +27,7 @@ namespace _solar_system {
 namespace internal {
 
 using namespace principia::base::_not_null;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_instant;
 using namespace principia::physics::_continuous_trajectory;
 using namespace principia::physics::_degrees_of_freedom;
@@ -43,6 +45,19 @@ serialization::GravityModel ParseGravityModel(
 serialization::InitialState ParseInitialState(
     std::filesystem::path const& initial_state_filename);
 
+// Same as above, but the parsed messages are cached in binary form in
+// |cache_directory|, in files named after the version of the cache format and
+// the fingerprint of the text of the given file.  The cache holds the messages
+// as parsed; they are checked by the callers as if they came from the text.  If
+// the file has not changed since it was last parsed, the text format parsing
+// is skipped.  Failures to write to the cache are not fatal.
+serialization::GravityModel ParseGravityModel(
+    std::filesystem::path const& gravity_model_filename,
+    std::filesystem::path const& cache_directory);
+serialization::InitialState ParseInitialState(
+    std::filesystem::path const& initial_state_filename,
+    std::filesystem::path const& cache_directory);
+
 template<typename Frame>
 class SolarSystem final {
  public:
@@ -52,6 +67,13 @@ class SolarSystem final {
               std::filesystem::path const& initial_state_filename,
               bool ignore_frame = false);
 
+  // Same as above, but uses the binary cache in |cache_directory| to avoid
+  // parsing the files if they have not changed.
+  SolarSystem(std::filesystem::path const& gravity_model_filename,
+              std::filesystem::path const& initial_state_filename,
+              std::filesystem::path const& cache_directory,
+              bool ignore_frame = false);
+
   // Construct a solar system from the given messages.
   SolarSystem(serialization::GravityModel gravity_model,
               serialization::InitialState initial_state,
@@ -71,6 +93,15 @@ class SolarSystem final {
       typename Ephemeris<Frame>::FixedStepParameters const&
           fixed_step_parameters) const;
 
+  // Same as above, but the bodies and, for a hierarchical system, the
+  // barycentric conversions of the subsystems are computed concurrently on
+  // |thread_pool|.  The result is the same.
+  not_null<std::unique_ptr<Ephemeris<Frame>>> MakeEphemeris(
+      typename Ephemeris<Frame>::AccuracyParameters const& accuracy_parameters,
+      typename Ephemeris<Frame>::FixedStepParameters const&
+          fixed_step_parameters,
+      ThreadPool<void>& thread_pool) const;
+
   std::vector<not_null<std::unique_ptr<MassiveBody const>>>
   MakeAllMassiveBodies() const;
 
@@ -161,7 +192,14 @@ class SolarSystem final {
   static not_null<std::unique_ptr<typename OblateBody<Frame>::Parameters>>
   MakeOblateBodyParameters(serialization::GravityModel::Body const& body);
 
-  std::vector<DegreesOfFreedom<Frame>> MakeAllDegreesOfFreedom() const;
+  // If |thread_pool| is not null, these functions use it to construct the
+  // bodies and the barycentric conversions concurrently.
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>>
+  MakeAllMassiveBodies(ThreadPool<void>* thread_pool) const;
+  std::vector<DegreesOfFreedom<Frame>> MakeAllDegreesOfFreedom(
+      ThreadPool<void>* thread_pool) const;
+  not_null<std::unique_ptr<HierarchicalSystem<Frame>>> MakeHierarchicalSystem(
+      ThreadPool<void>* thread_pool) const;
 
   // If a frame is specified in a message it must match the frame of this
   // instance.  Otherwise the frame of the instance is used.  This is convenient
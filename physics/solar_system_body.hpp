@@ -2,14 +2,19 @@
 
 #include "physics/solar_system.hpp"
 
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <iterator>
 #include <map>
+#include <random>
 #include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/strings/str_cat.h"
 #include "astronomy/epoch.hpp"
 #include "astronomy/frames.hpp"
 #include "astronomy/time_scales.hpp"
@@ -79,6 +84,93 @@ inline serialization::InitialState ParseInitialState(
   return initial_state.initial_state();
 }
 
+// The version of the format of the entries of the solar system cache.  Must be
+// incremented whenever the binary form of the cached messages changes
+// incompatibly, e.g., when a field of |SolarSystemFile| changes meaning.
+constexpr int solar_system_cache_version = 1;
+
+// Parses the text format |SolarSystemFile| in |filename|, or reads it from the
+// binary cache in |cache_directory| if the cache has an entry for the format
+// version and the fingerprint of the text.  Populates the cache on a miss.  The
+// entries are the unchecked messages, exactly as parsed from the text.
+inline serialization::SolarSystemFile ParseSolarSystemFile(
+    std::filesystem::path const& filename,
+    std::filesystem::path const& cache_directory) {
+  std::ifstream ifstream(filename, std::ios::binary);
+  CHECK(ifstream.good()) << filename;
+  std::string const text{std::istreambuf_iterator<char>(ifstream),
+                         std::istreambuf_iterator<char>()};
+  std::uint64_t const fingerprint = Fingerprint2011(text.data(), text.size());
+  std::filesystem::path const cache_filename =
+      cache_directory /
+      absl::StrCat("v",
+                   solar_system_cache_version,
+                   "_",
+                   absl::Hex(fingerprint, absl::kZeroPad16),
+                   ".pb");
+
+  serialization::SolarSystemFile solar_system_file;
+  {
+    std::ifstream cache_ifstream(cache_filename, std::ios::binary);
+    if (cache_ifstream.good() &&
+        solar_system_file.ParseFromIstream(&cache_ifstream)) {
+      return solar_system_file;
+    }
+  }
+
+  solar_system_file.Clear();
+  CHECK(google::protobuf::TextFormat::ParseFromString(text,
+                                                      &solar_system_file))
+      << filename;
+
+  // Write to a temporary file and rename it so that a concurrent or
+  // interrupted writer never leaves a truncated entry in the cache.  The name
+  // of the temporary file is random so that concurrent writers, possibly in
+  // different processes, don't write to the same file.
+  std::error_code error;
+  std::filesystem::create_directories(cache_directory, error);
+  std::random_device random_device;
+  std::uint64_t const random =
+      static_cast<std::uint64_t>(random_device()) << 32 | random_device();
+  std::filesystem::path temporary_filename = cache_filename;
+  temporary_filename +=
+      absl::StrCat(".", absl::Hex(random, absl::kZeroPad16), ".tmp");
+  {
+    std::ofstream cache_ofstream(temporary_filename,
+                                 std::ios::binary | std::ios::trunc);
+    if (!cache_ofstream.good() ||
+        !solar_system_file.SerializeToOstream(&cache_ofstream)) {
+      LOG(WARNING) << "Unable to write " << temporary_filename;
+      return solar_system_file;
+    }
+  }
+  std::filesystem::rename(temporary_filename, cache_filename, error);
+  if (error) {
+    LOG(WARNING) << "Unable to rename " << temporary_filename << " to "
+                 << cache_filename << ": " << error.message();
+    std::filesystem::remove(temporary_filename, error);
+  }
+  return solar_system_file;
+}
+
+inline serialization::GravityModel ParseGravityModel(
+    std::filesystem::path const& gravity_model_filename,
+    std::filesystem::path const& cache_directory) {
+  auto gravity_model =
+      ParseSolarSystemFile(gravity_model_filename, cache_directory);
+  CHECK(gravity_model.has_gravity_model());
+  return std::move(*gravity_model.mutable_gravity_model());
+}
+
+inline serialization::InitialState ParseInitialState(
+    std::filesystem::path const& initial_state_filename,
+    std::filesystem::path const& cache_directory) {
+  auto initial_state =
+      ParseSolarSystemFile(initial_state_filename, cache_directory);
+  CHECK(initial_state.has_initial_state());
+  return std::move(*initial_state.mutable_initial_state());
+}
+
 template<typename Frame>
 SolarSystem<Frame>::SolarSystem(
     std::filesystem::path const& gravity_model_filename,
@@ -88,6 +180,16 @@ SolarSystem<Frame>::SolarSystem(
                   ParseInitialState(initial_state_filename),
                   ignore_frame) {}
 
+template<typename Frame>
+SolarSystem<Frame>::SolarSystem(
+    std::filesystem::path const& gravity_model_filename,
+    std::filesystem::path const& initial_state_filename,
+    std::filesystem::path const& cache_directory,
+    bool const ignore_frame)
+    : SolarSystem(ParseGravityModel(gravity_model_filename, cache_directory),
+                  ParseInitialState(initial_state_filename, cache_directory),
+                  ignore_frame) {}
+
 template<typename Frame>
 SolarSystem<Frame>::SolarSystem(
     serialization::GravityModel gravity_model,
@@ -158,7 +260,7 @@ SolarSystem<Frame>::SolarSystem(
   // Call these two functions to parse all the data, so that errors are detected
   // at initialization.  Drop their results on the floor.
   MakeAllMassiveBodies();
-  MakeAllDegreesOfFreedom();
+  MakeAllDegreesOfFreedom(/*thread_pool=*/nullptr);
 }
 
 template<typename Frame>
@@ -166,21 +268,31 @@ not_null<std::unique_ptr<Ephemeris<Frame>>> SolarSystem<Frame>::MakeEphemeris(
     typename Ephemeris<Frame>::AccuracyParameters const& accuracy_parameters,
     typename Ephemeris<Frame>::FixedStepParameters const& fixed_step_parameters)
     const {
-  return make_not_null_unique<Ephemeris<Frame>>(MakeAllMassiveBodies(),
-                                                MakeAllDegreesOfFreedom(),
-                                                epoch_,
-                                                accuracy_parameters,
-                                                fixed_step_parameters);
+  return make_not_null_unique<Ephemeris<Frame>>(
+      MakeAllMassiveBodies(),
+      MakeAllDegreesOfFreedom(/*thread_pool=*/nullptr),
+      epoch_,
+      accuracy_parameters,
+      fixed_step_parameters);
+}
+
+template<typename Frame>
+not_null<std::unique_ptr<Ephemeris<Frame>>> SolarSystem<Frame>::MakeEphemeris(
+    typename Ephemeris<Frame>::AccuracyParameters const& accuracy_parameters,
+    typename Ephemeris<Frame>::FixedStepParameters const& fixed_step_parameters,
+    ThreadPool<void>& thread_pool) const {
+  return make_not_null_unique<Ephemeris<Frame>>(
+      MakeAllMassiveBodies(&thread_pool),
+      MakeAllDegreesOfFreedom(&thread_pool),
+      epoch_,
+      accuracy_parameters,
+      fixed_step_parameters);
 }
 
 template<typename Frame>
 std::vector<not_null<std::unique_ptr<MassiveBody const>>>
 SolarSystem<Frame>::MakeAllMassiveBodies() const {
-  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
-  for (auto const& [_, body] : gravity_model_map_) {
-    bodies.emplace_back(MakeMassiveBody(*body));
-  }
-  return bodies;
+  return MakeAllMassiveBodies(/*thread_pool=*/nullptr);
 }
 
 template<typename Frame>
@@ -431,44 +543,7 @@ SolarSystem<Frame>::MakeOblateBody(
 template<typename Frame>
 not_null<std::unique_ptr<HierarchicalSystem<Frame>>>
 SolarSystem<Frame>::MakeHierarchicalSystem() const {
-  // First, construct all the bodies and find the primary body of the system.
-  std::string primary;
-  std::map<std::string,
-            not_null<std::unique_ptr<MassiveBody const>>> owned_bodies;
-  std::map<std::string, not_null<MassiveBody const*>> unowned_bodies;
-  for (auto const& [name, body] : keplerian_initial_state_map_) {
-    CHECK_EQ(body->has_parent(), body->has_elements()) << name;
-    if (!body->has_parent()) {
-      CHECK(primary.empty()) << name;
-      primary = name;
-    }
-    auto owned_body = MakeMassiveBody(gravity_model_message(name));
-    unowned_bodies.emplace(name, owned_body.get());
-    owned_bodies.emplace(name, std::move(owned_body));
-  }
-
-  // Construct a hierarchical system rooted at the primary and add the other
-  // bodies layer by layer.
-  auto hierarchical_system = make_not_null_unique<HierarchicalSystem<Frame>>(
-      std::move(FindOrDie(owned_bodies, primary)));
-  std::set<std::string> previous_layer = {primary};
-  std::set<std::string> current_layer;
-  do {
-    for (auto const& [name, body] : keplerian_initial_state_map_) {
-      if (Contains(previous_layer, body->parent())) {
-        current_layer.insert(name);
-        KeplerianElements<Frame> const elements =
-            MakeKeplerianElements(body->elements());
-        hierarchical_system->Add(std::move(FindOrDie(owned_bodies, name)),
-                                 FindOrDie(unowned_bodies, body->parent()),
-                                 elements);
-      }
-    }
-    previous_layer = current_layer;
-    current_layer.clear();
-  } while (!previous_layer.empty());
-
-  return hierarchical_system;
+  return MakeHierarchicalSystem(/*thread_pool=*/nullptr);
 }
 
 template<typename Frame>
@@ -644,9 +719,93 @@ SolarSystem<Frame>::MakeOblateBodyParameters(
   }
 }
 
+template<typename Frame>
+std::vector<not_null<std::unique_ptr<MassiveBody const>>>
+SolarSystem<Frame>::MakeAllMassiveBodies(
+    ThreadPool<void>* const thread_pool) const {
+  std::vector<not_null<std::unique_ptr<MassiveBody const>>> bodies;
+  if (thread_pool == nullptr) {
+    for (auto const& [_, body] : gravity_model_map_) {
+      bodies.emplace_back(MakeMassiveBody(*body));
+    }
+  } else {
+    // The conversion of the geopotential coefficients may be costly, and the
+    // bodies are independent from each other.
+    std::vector<std::unique_ptr<MassiveBody const>> unchecked_bodies(
+        gravity_model_map_.size());
+    std::vector<std::future<void>> futures;
+    int index = 0;
+    for (auto const& [_, body] : gravity_model_map_) {
+      futures.push_back(thread_pool->Add(
+          [&unchecked_body = unchecked_bodies[index], body = body]() {
+            unchecked_body = MakeMassiveBody(*body);
+          }));
+      ++index;
+    }
+    for (auto const& future : futures) {
+      future.wait();
+    }
+    for (auto& body : unchecked_bodies) {
+      bodies.emplace_back(check_not_null(std::move(body)));
+    }
+  }
+  return bodies;
+}
+
+template<typename Frame>
+not_null<std::unique_ptr<HierarchicalSystem<Frame>>>
+SolarSystem<Frame>::MakeHierarchicalSystem(
+    ThreadPool<void>* const thread_pool) const {
+  // First, construct all the bodies and find the primary body of the system.
+  // The bodies are in the order of |names_|, which is also that of
+  // |keplerian_initial_state_map_|.
+  auto all_bodies = MakeAllMassiveBodies(thread_pool);
+  std::string primary;
+  std::map<std::string,
+            not_null<std::unique_ptr<MassiveBody const>>> owned_bodies;
+  std::map<std::string, not_null<MassiveBody const*>> unowned_bodies;
+  int index = 0;
+  for (auto const& [name, body] : keplerian_initial_state_map_) {
+    CHECK_EQ(body->has_parent(), body->has_elements()) << name;
+    if (!body->has_parent()) {
+      CHECK(primary.empty()) << name;
+      primary = name;
+    }
+    auto& owned_body = all_bodies[index];
+    CHECK_EQ(name, owned_body->name());
+    unowned_bodies.emplace(name, owned_body.get());
+    owned_bodies.emplace(name, std::move(owned_body));
+    ++index;
+  }
+
+  // Construct a hierarchical system rooted at the primary and add the other
+  // bodies layer by layer.
+  auto hierarchical_system = make_not_null_unique<HierarchicalSystem<Frame>>(
+      std::move(FindOrDie(owned_bodies, primary)));
+  std::set<std::string> previous_layer = {primary};
+  std::set<std::string> current_layer;
+  do {
+    for (auto const& [name, body] : keplerian_initial_state_map_) {
+      if (Contains(previous_layer, body->parent())) {
+        current_layer.insert(name);
+        KeplerianElements<Frame> const elements =
+            MakeKeplerianElements(body->elements());
+        hierarchical_system->Add(std::move(FindOrDie(owned_bodies, name)),
+                                 FindOrDie(unowned_bodies, body->parent()),
+                                 elements);
+      }
+    }
+    previous_layer = current_layer;
+    current_layer.clear();
+  } while (!previous_layer.empty());
+
+  return hierarchical_system;
+}
+
 template<typename Frame>
 std::vector<DegreesOfFreedom<Frame>>
-SolarSystem<Frame>::MakeAllDegreesOfFreedom() const {
+SolarSystem<Frame>::MakeAllDegreesOfFreedom(
+    ThreadPool<void>* const thread_pool) const {
   std::vector<DegreesOfFreedom<Frame>> degrees_of_freedom;
   if (!cartesian_initial_state_map_.empty()) {
     for (auto const& [_, body] : cartesian_initial_state_map_) {
@@ -654,12 +813,15 @@ SolarSystem<Frame>::MakeAllDegreesOfFreedom() const {
     }
   }
   if (!keplerian_initial_state_map_.empty()) {
-    auto const hierarchical_system = MakeHierarchicalSystem();
+    auto const hierarchical_system = MakeHierarchicalSystem(thread_pool);
 
     // Construct a barycentric system and fill a map from body name to degrees
     // of freedom.
     typename HierarchicalSystem<Frame>::BarycentricSystem const
-        barycentric_system = hierarchical_system->ConsumeBarycentricSystem();
+        barycentric_system =
+            thread_pool == nullptr
+                ? hierarchical_system->ConsumeBarycentricSystem()
+                : hierarchical_system->ConsumeBarycentricSystem(*thread_pool);
     std::map<std::string, DegreesOfFreedom<Frame>> name_to_degrees_of_freedom;
     for (int i = 0; i < barycentric_system.bodies.size(); ++i) {
       auto const& body = barycentric_system.bodies[i];
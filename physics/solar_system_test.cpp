@@ -1,25 +1,35 @@
 #include "physics/solar_system.hpp"
 
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <ios>
+#include <iterator>
+#include <random>
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
 #include "astronomy/frames.hpp"
 #include "base/fingerprint2011.hpp"
+#include "base/thread_pool.hpp"
 #include "geometry/instant.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "integrators/methods.hpp"
 #include "integrators/symplectic_runge_kutta_nyström_integrator.hpp"
 #include "quantities/si.hpp"
+#include "serialization/astronomy.pb.h"
+#include "testing_utilities/matchers.hpp"
 #include "testing_utilities/numerics.hpp"
 
 namespace principia {
 namespace physics {
 
 using ::testing::ElementsAreArray;
+using ::testing::StartsWith;
 using namespace principia::astronomy::_frames;
 using namespace principia::base::_fingerprint2011;
+using namespace principia::base::_thread_pool;
 using namespace principia::geometry::_frame;
 using namespace principia::geometry::_instant;
 using namespace principia::integrators::_methods;
@@ -27,6 +37,7 @@ using namespace principia::integrators::_symplectic_runge_kutta_nyström_integra
 using namespace principia::physics::_ephemeris;
 using namespace principia::physics::_solar_system;
 using namespace principia::quantities::_si;
+using namespace principia::testing_utilities::_matchers;
 using namespace principia::testing_utilities::_numerics;
 
 class SolarSystemTest : public ::testing::Test {};
@@ -302,5 +313,119 @@ TEST_F(SolarSystemTest, FingerprintKeplerian) {
   CHECK_NE(fingerprint3, fingerprint4);
 }
 
+// The concurrent construction and prolongation of the ephemeris give the same
+// results as the sequential ones.
+TEST_F(SolarSystemTest, ConcurrentInitialization) {
+  using KSP = Frame<struct KSPTag, Inertial>;
+
+  SolarSystem<KSP> solar_system(
+      SOLUTION_DIR / "astronomy" / "kerbol_gravity_model.proto.txt",
+      SOLUTION_DIR / "astronomy" / "kerbol_initial_state_0_0.proto.txt");
+  Ephemeris<KSP>::AccuracyParameters const accuracy_parameters(
+      /*fitting_tolerance=*/1 * Milli(Metre),
+      /*geopotential_tolerance=*/0x1p-24);
+  Ephemeris<KSP>::FixedStepParameters const fixed_step_parameters(
+      SymplecticRungeKuttaNyströmIntegrator<
+          McLachlanAtela1992Order4Optimal,
+          Ephemeris<KSP>::NewtonianMotionEquation>(),
+      /*step=*/10 * Minute);
+  Instant const t_final = solar_system.epoch() + 10 * Day;
+
+  auto const sequential_ephemeris =
+      solar_system.MakeEphemeris(accuracy_parameters, fixed_step_parameters);
+  EXPECT_OK(sequential_ephemeris->Prolong(t_final));
+
+  ThreadPool<void> thread_pool(/*pool_size=*/4);
+  auto const concurrent_ephemeris = solar_system.MakeEphemeris(
+      accuracy_parameters, fixed_step_parameters, thread_pool);
+  EXPECT_OK(concurrent_ephemeris->Prolong(t_final, thread_pool));
+
+  EXPECT_EQ(sequential_ephemeris->t_max(), concurrent_ephemeris->t_max());
+  for (std::string const& name : solar_system.names()) {
+    auto const& sequential_trajectory =
+        solar_system.trajectory(*sequential_ephemeris, name);
+    auto const& concurrent_trajectory =
+        solar_system.trajectory(*concurrent_ephemeris, name);
+    for (Instant t = solar_system.epoch(); t <= t_final; t += 1 * Hour) {
+      EXPECT_EQ(sequential_trajectory.EvaluateDegreesOfFreedom(t),
+                concurrent_trajectory.EvaluateDegreesOfFreedom(t))
+          << name << " " << t;
+    }
+  }
+}
+
+TEST_F(SolarSystemTest, Cache) {
+  auto const gravity_model_filename =
+      SOLUTION_DIR / "astronomy" / "kerbol_gravity_model.proto.txt";
+  auto const initial_state_filename =
+      SOLUTION_DIR / "astronomy" / "kerbol_initial_state_0_0.proto.txt";
+  // A directory unique to this run, so that concurrent runs of this test don't
+  // interfere.
+  std::random_device random_device;
+  auto const cache_directory =
+      TEMP_DIR / absl::StrCat("solar_system_cache_test_",
+                              absl::Hex(random_device(), absl::kZeroPad8));
+  ASSERT_FALSE(std::filesystem::exists(cache_directory));
+
+  auto const gravity_model = ParseGravityModel(gravity_model_filename);
+  auto const initial_state = ParseInitialState(initial_state_filename);
+
+  // A cold start populates the cache with one entry per file.
+  EXPECT_THAT(ParseGravityModel(gravity_model_filename, cache_directory),
+              EqualsProto(gravity_model));
+  EXPECT_THAT(ParseInitialState(initial_state_filename, cache_directory),
+              EqualsProto(initial_state));
+  EXPECT_EQ(2,
+            std::distance(std::filesystem::directory_iterator(cache_directory),
+                          std::filesystem::directory_iterator()));
+  for (auto const& entry :
+       std::filesystem::directory_iterator(cache_directory)) {
+    EXPECT_THAT(entry.path().filename().string(), StartsWith("v1_"));
+  }
+
+  // A warm start gives the same messages.
+  EXPECT_THAT(ParseGravityModel(gravity_model_filename, cache_directory),
+              EqualsProto(gravity_model));
+  EXPECT_THAT(ParseInitialState(initial_state_filename, cache_directory),
+              EqualsProto(initial_state));
+  EXPECT_EQ(
+      SolarSystem<ICRS>(gravity_model, initial_state).Fingerprint(),
+      SolarSystem<ICRS>(
+          gravity_model_filename, initial_state_filename, cache_directory)
+          .Fingerprint());
+
+  // Check that a warm start does not parse the text by tampering with the
+  // cache entry for the gravity model.
+  for (auto const& entry :
+       std::filesystem::directory_iterator(cache_directory)) {
+    serialization::SolarSystemFile message;
+    {
+      std::ifstream ifstream(entry.path(), std::ios::binary);
+      ASSERT_TRUE(message.ParseFromIstream(&ifstream));
+    }
+    if (message.has_gravity_model()) {
+      message.mutable_gravity_model()->mutable_body()->RemoveLast();
+      std::ofstream ofstream(entry.path(), std::ios::binary | std::ios::trunc);
+      ASSERT_TRUE(message.SerializeToOstream(&ofstream));
+    }
+  }
+  EXPECT_EQ(
+      gravity_model.body_size() - 1,
+      ParseGravityModel(gravity_model_filename, cache_directory).body_size());
+
+  // A corrupted entry is ignored and rewritten.
+  for (auto const& entry :
+       std::filesystem::directory_iterator(cache_directory)) {
+    std::ofstream ofstream(entry.path(), std::ios::binary | std::ios::trunc);
+    ofstream << "garbage";
+  }
+  EXPECT_THAT(ParseGravityModel(gravity_model_filename, cache_directory),
+              EqualsProto(gravity_model));
+  EXPECT_THAT(ParseGravityModel(gravity_model_filename, cache_directory),
+              EqualsProto(gravity_model));
+
+  std::filesystem::remove_all(cache_directory);
+}
+
 }  // namespace physics
 }  // namespace principia
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cctype>
+#include <filesystem>
 #include <set>
 #include <string>
 #include <vector>
@@ -110,12 +111,17 @@ SolarSystemFactory::MakeAccuracyParameters(Length const& fitting_tolerance,
   base::noreturn();
 }
 
+// The solar systems are built by many tests, so the parsed files are cached.
+inline std::filesystem::path const solar_system_cache_directory =
+    TEMP_DIR / "solar_system_cache";
+
 inline not_null<std::unique_ptr<SolarSystem<ICRS>>>
 SolarSystemFactory::AtСпутник1Launch(Accuracy const accuracy) {
   auto solar_system = make_not_null_unique<SolarSystem<ICRS>>(
       SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
       SOLUTION_DIR / "astronomy" /
-          "sol_initial_state_jd_2436116_311504629.proto.txt");
+          "sol_initial_state_jd_2436116_311504629.proto.txt",
+      solar_system_cache_directory);
   AdjustAccuracy(accuracy, *solar_system);
   return solar_system;
 }
@@ -125,7 +131,8 @@ SolarSystemFactory::AtСпутник2Launch(Accuracy const accuracy) {
   auto solar_system = make_not_null_unique<SolarSystem<ICRS>>(
       SOLUTION_DIR / "astronomy" / "sol_gravity_model.proto.txt",
       SOLUTION_DIR / "astronomy" /
-          "sol_initial_state_jd_2436145_604166667.proto.txt");
+          "sol_initial_state_jd_2436145_604166667.proto.txt",
+      solar_system_cache_directory);
   AdjustAccuracy(accuracy, *solar_system);
   return solar_system;
 }